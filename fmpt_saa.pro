@@ -14,6 +14,7 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 LIBS += /usr/lib/x86_64-linux-gnu/libuuid.so
 LIBS += /usr/lib/x86_64-linux-gnu/libjsoncpp.so
+LIBS += -lpthread
 
 TARGET = FMPT_SAA
 CONFIG   += console
@@ -34,12 +35,18 @@ SOURCES += \
     src/Strings.cpp \
     src/StrPR.cpp \
     src/TextFile.cpp \
+    src/JSONWriter.cpp \
+    src/Log.cpp \
+    src/OutputWriter.cpp \
     #---------------------------------------------------------
     src/SlideArray.cpp \
     src/PointersSlideArray.cpp \
     src/ItemsList.cpp \
     src/PointersList.cpp \
     src/Vector.cpp \
+    src/SharedItem.cpp \
+    src/SmallList.cpp \
+    src/Arena.cpp \
     #---------------------------------------------------------
     src/Quantificator.cpp \
     src/Function.cpp \
@@ -65,9 +72,12 @@ SOURCES += \
     src/Cilinder.cpp \
     src/Actuator.cpp \
     src/RoboticPositioner.cpp \
+    src/AdjacencyGraph.cpp \
     src/RoboticPositionerList1.cpp \
     src/RoboticPositionerList2.cpp \
     src/RoboticPositionerList3.cpp \
+    src/RoboticPositionerSet.cpp \
+    src/ReachabilityIndex.cpp \
     #---------------------------------------------------------
     src/FiberMOSModel.cpp \
     src/FiberConnectionModel.cpp \
@@ -85,9 +95,11 @@ SOURCES += \
     #---------------------------------------------------------
     src/PositionerCenter.cpp \
     src/FileMethods.cpp \
+    src/LazyInstanceLoader.cpp \
     src/FMOSA.cpp \
     src/OutputsParkProg.cpp \
     src/OutputsPairPPDP.cpp \
+    src/RequestServer.cpp \
     #---------------------------------------------------------
     src/main.cpp
 
@@ -103,12 +115,18 @@ HEADERS += \
     src/Strings.h \
     src/StrPR.h \
     src/TextFile.h \
+    src/JSONWriter.h \
+    src/Log.h \
+    src/OutputWriter.h \
     #---------------------------------------------------------
     src/SlideArray.h \
     src/PointersSlideArray.h \
     src/PointersList.h \
     src/ItemsList.h \
     src/Vector.h \
+    src/SharedItem.h \
+    src/SmallList.h \
+    src/Arena.h \
     #---------------------------------------------------------
     src/Quantificator.h \
     src/Function.h \
@@ -136,9 +154,12 @@ HEADERS += \
     src/Cilinder.h \
     src/Actuator.h \
     src/RoboticPositioner.h \
+    src/AdjacencyGraph.h \
     src/RoboticPositionerList1.h \
     src/RoboticPositionerList2.h \
     src/RoboticPositionerList3.h \
+    src/RoboticPositionerSet.h \
+    src/ReachabilityIndex.h \
     #---------------------------------------------------------
     src/FiberMOSModel.h \
     src/FiberConnectionModel.h \
@@ -156,8 +177,10 @@ HEADERS += \
     #---------------------------------------------------------
     src/PositionerCenter.h \
     src/FileMethods.h \
+    src/LazyInstanceLoader.h \
     src/FMOSA.h \
     src/OutputsParkProg.h \
     src/OutputsPairPPDP.h \
+    src/RequestServer.h \
     #----------------------------------------------
     src/globalconsts.h
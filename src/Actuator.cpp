@@ -1049,7 +1049,7 @@ AnsiString TActuator::getStatusText(void) const
     S += AnsiString("\r\n    AdjacentEAs = ")+AdjacentEAs.getIdText();
     //S += AnsiString("\r\n    AdjacentEAs.Dmins = ")+AdjacentEAs.getDminText();
     //S += AnsiString("\r\n    AdjacentEAs.Dends = ")+AdjacentEAs.getDendText();
-    S += AnsiString("\r\n    AdjacentRPs = ")+AdjacentRPs.getText();
+    S += AnsiString("\r\n    AdjacentRPs = ")+AdjacentRPs.getIdText();
     //S += AnsiString("\r\n    AdjacentRPs.Dmins = ")+AdjacentRPs.getDminText();
     //S += AnsiString("\r\n    AdjacentRPs.Dends = ")+AdjacentRPs.getDendText();
     S += AnsiString("\r\n    Pending = ")+getPendingText();
@@ -1881,6 +1881,19 @@ void TActuator::calculateSafeParameters(void)
     }
     p_theta_2rad = max(0., gettheta_1min()) + M_PI/2;
 }
+//asigna las propiedades de seguridad calculadas previamente:
+//      {r_min, r_saf, r_2saf, theta___2saf, theta___3saf, theta_2rad}
+void TActuator::setSafeParameters(double r_min, double r_saf, double r_2saf,
+                                  double theta___2saf, double theta___3saf,
+                                  double theta_2rad)
+{
+    p_r_min = r_min;
+    p_r_saf = r_saf;
+    p_r_2saf = r_2saf;
+    p_theta___2saf = theta___2saf;
+    p_theta___3saf = theta___3saf;
+    p_theta_2rad = theta_2rad;
+}
 
 //-------------------------------------------------------------------
 //MÉTODOS DE ASIGNACIÓN CONJUNTA:
@@ -1941,16 +1954,26 @@ void TActuator::setQuantification(double SB1)
 {
     //DEFINE LA FUNCIÓN F A PARTIR DE SB1:
 
+    //si es la función por defecto, la comparte
+    if(SB1 == MEGARA_SB1) {
+        p_F = getDefaultF();
+        p_G = getDefaultG();
+        processateFG();
+        settheta_1(gettheta_1());
+        return;
+    }
+
     //inicializa la función
-    p_F.Clear();
+    TFunction& F = p_F.getWritable();
+    F.Clear();
     //añade los puntos de la función de compresión
-    p_F.Add(-M_2PI, -double(SB1));
-    p_F.Add(0., 0.);
-    p_F.Add(M_2PI, double(SB1));
-    p_F.Add(double(2*M_2PI), double(2*SB1));
+    F.Add(-M_2PI, -double(SB1));
+    F.Add(0., 0.);
+    F.Add(M_2PI, double(SB1));
+    F.Add(double(2*M_2PI), double(2*SB1));
     //elimina las incongruencias del formato texto
     //de la función de compansión
-    p_F.setPointsText(getF().getPointsText());
+    F.setPointsText(F.getPointsText());
 
     //asimila F
     processateF();
@@ -2843,16 +2866,7 @@ double TActuator::distanceMin(const TExclusionArea *EA)
     if(i >= AdjacentEAs.getCount())
         throw EImproperArgument("pointer EA should be an adjacent exclusion area");
 
-    //calcula la distancia con la barrera del EA
-    double dm = distanceMin(&(EA->Barrier));
-
-    //actualiza la distancia mínima
-    if(dm < AdjacentEAs[i].Dmin)
-        AdjacentEAs[i].Dmin = dm;
-    //actualiza la distancia final
-    AdjacentEAs[i].Dend = dm;
-
-    return dm;
+    return distanceMinAdjacentEA(i);
 }
 //determina la distancia mínima con un actuador
 double TActuator::distanceMin(const TActuator *Actuator)
@@ -2870,8 +2884,39 @@ double TActuator::distanceMin(const TActuator *Actuator)
     if(i >= AdjacentRPs.getCount())
         throw EImproperArgument("pointer RP should be an adjacent robotic positioner");
 
+    return distanceMinAdjacentRP(i);
+}
+//determina la distancia mínima con el EA adyacente
+//en la posición i de la lista AdjacentEAs
+double TActuator::distanceMinAdjacentEA(int i)
+{
+    //comprueba las precondiciones
+    if(i<0 || AdjacentEAs.getCount()<=i)
+        throw EImproperArgument("index i should indicate an adjacent exclusion area");
+
+    //calcula la distancia con la barrera del EA
+    const TExclusionArea *EA = AdjacentEAs[i].EA;
+    double dm = distanceMin(&(EA->Barrier));
+
+    //actualiza la distancia mínima
+    if(dm < AdjacentEAs[i].Dmin)
+        AdjacentEAs[i].Dmin = dm;
+    //actualiza la distancia final
+    AdjacentEAs[i].Dend = dm;
+
+    return dm;
+}
+//determina la distancia mínima con el RP adyacente
+//en la posición i de la lista AdjacentRPs
+double TActuator::distanceMinAdjacentRP(int i)
+{
+    //comprueba las precondiciones
+    if(i<0 || AdjacentRPs.getCount()<=i)
+        throw EImproperArgument("index i should indicate an adjacent robotic positioner");
+
     //calcula la distancia mínima
     //con el brazo o la barrera, en función de PAkd
+    const TActuator *Actuator = AdjacentRPs[i].RP->getActuator();
     double dm;
     if(Actuator->getPAkd() != kdUnk) {
         if(getPAkd() != kdUnk)
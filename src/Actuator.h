@@ -812,6 +812,12 @@ public:
     //calcula las propiedades de seguridad:
     //      {r_min, r_saf, r_2saf, theta___2saf, theta___3saf, theta_2rad}
     void calculateSafeParameters(void);
+    //asigna las propiedades de seguridad calculadas previamente:
+    //      {r_min, r_saf, r_2saf, theta___2saf, theta___3saf, theta_2rad}
+    //(used for restore an snapshot of an assimilated FMM)
+    void setSafeParameters(double r_min, double r_saf, double r_2saf,
+                           double theta___2saf, double theta___3saf,
+                           double theta_2rad);
 
     //Los métodos para:
     //      determinar la posición relativa;
@@ -995,6 +1001,12 @@ public:
     double distanceMin(const TExclusionArea*);
     //determina la distancia mínima con un actuador
     double distanceMin(const TActuator*);
+    //determina la distancia mínima con el EA adyacente
+    //en la posición i de la lista AdjacentEAs
+    double distanceMinAdjacentEA(int i);
+    //determina la distancia mínima con el RP adyacente
+    //en la posición i de la lista AdjacentRPs
+    double distanceMinAdjacentRP(int i);
 
     //determina si hay colisión con un EA
     bool thereIsCollision(const TExclusionArea*);
@@ -0,0 +1,122 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: AdjacencyGraph.cpp
+//Content: graph of adjacency of the RPs in compressed format
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "AdjacencyGraph.h"
+#include "RoboticPositionerList1.h"
+
+#include <map>
+
+//---------------------------------------------------------------------------
+
+//namespace for models
+namespace Models {
+
+//---------------------------------------------------------------------------
+//TAdjacencyGraph
+//---------------------------------------------------------------------------
+
+//build an empty graph
+TAdjacencyGraph::TAdjacencyGraph(void) :
+    p_Built(false), p_RPs(), p_EAs(),
+    p_RPOffsets(1, 0), p_RPEdges(), p_EAOffsets(1, 0), p_EAEdges(),
+    p_RPPairsCount(0)
+{
+}
+
+//build the graph of the RPs of a list
+//from the lists of adjacents of their actuators
+void TAdjacencyGraph::build(const TRoboticPositionerList1& RPL)
+{
+    Clear();
+
+    int N = RPL.getCount();
+    p_RPs.resize(N);
+    p_RPOffsets.resize(N + 1);
+    p_EAOffsets.resize(N + 1);
+
+    //index of each EA, in order of appearance
+    map<const TExclusionArea*, int> EAindices;
+
+    //build the edges of each RP
+    for(int i=0; i<N; i++) {
+        TRoboticPositioner *RP = RPL[i];
+        const TActuator *A = RP->getActuator();
+        p_RPs[i] = RP;
+
+        for(int j=0; j<A->AdjacentRPs.getCount(); j++) {
+            int k = RPL.search(A->AdjacentRPs[j].RP);
+            if(k < N) {
+                TAdjacencyEdge E = {k, j, -1};
+                p_RPEdges.push_back(E);
+            }
+        }
+        p_RPOffsets[i+1] = int(p_RPEdges.size());
+
+        for(int j=0; j<A->AdjacentEAs.getCount(); j++) {
+            TExclusionArea *EA = A->AdjacentEAs[j].EA;
+            pair<map<const TExclusionArea*, int>::iterator, bool> it =
+                    EAindices.insert(pair<const TExclusionArea*, int>(EA, int(p_EAs.size())));
+            if(it.second)
+                p_EAs.push_back(EA);
+            TAdjacencyEdge E = {it.first->second, j, int(p_EAEdges.size())};
+            p_EAEdges.push_back(E);
+        }
+        p_EAOffsets[i+1] = int(p_EAEdges.size());
+    }
+
+    //assign the same pair to the two edges between two RPs
+    for(int i=0; i<N; i++)
+        for(int e=p_RPOffsets[i]; e<p_RPOffsets[i+1]; e++) {
+            TAdjacencyEdge& E = p_RPEdges[e];
+            if(E.Pair >= 0)
+                continue;
+            E.Pair = p_RPPairsCount++;
+            int k = E.Target;
+            for(int f=p_RPOffsets[k]; f<p_RPOffsets[k+1]; f++)
+                if(p_RPEdges[f].Target==i && p_RPEdges[f].Pair<0) {
+                    p_RPEdges[f].Pair = E.Pair;
+                    break;
+                }
+        }
+
+    p_Built = true;
+}
+//empty the graph
+void TAdjacencyGraph::Clear(void)
+{
+    p_Built = false;
+    p_RPs.clear();
+    p_EAs.clear();
+    p_RPOffsets.assign(1, 0);
+    p_RPEdges.clear();
+    p_EAOffsets.assign(1, 0);
+    p_EAEdges.clear();
+    p_RPPairsCount = 0;
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,151 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: AdjacencyGraph.h
+//Content: graph of adjacency of the RPs in compressed format
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef ADJACENCYGRAPH_H
+#define ADJACENCYGRAPH_H
+
+#include <vector>
+#include <cstddef> //NULL
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+//namespace for models
+namespace Models {
+
+class TRoboticPositioner;
+class TRoboticPositionerList1;
+class TExclusionArea;
+
+//---------------------------------------------------------------------------
+//TAdjacencyEdge
+//---------------------------------------------------------------------------
+
+//edge from a RP to an adjacent item (RP or EA)
+struct TAdjacencyEdge {
+    //index of the adjacent item in the graph
+    int Target;
+    //position of the adjacent item in the list of adjacents
+    //of the actuator of the RP, where are its (Dmin, Dend)
+    int Slot;
+    //index of the pair of adjacent items,
+    //which is the same for the two edges between two RPs
+    int Pair;
+};
+
+//---------------------------------------------------------------------------
+//TAdjacencyGraph
+//---------------------------------------------------------------------------
+
+//The adjacency graph contains the adjacents of all RPs of a list
+//in compressed sparse row format: the edges from each RP are stored
+//consecutively in a same array, in the order of the list of adjacents
+//of its actuator, and the RPs are identified by their position
+//in the RP list. The EAs are identified by their order of appearance.
+//
+//The edges from the RP i are in the range [beginRPs(i), endRPs(i))
+//and the edges to EAs in [beginEAs(i), endEAs(i)). E.g:
+//
+//  for(const TAdjacencyEdge *E=G.beginRPs(i); E!=G.endRPs(i); E++) {
+//      TRoboticPositioner *RPA = G.getRP(E->Target);
+//      double Dmin = G.getRP(i)->getActuator()->AdjacentRPs[E->Slot].Dmin;
+//      ...
+//  }
+//
+//The adjacent RPs which are not in the list are not included in the graph.
+
+//class adjacency graph
+class TAdjacencyGraph {
+    //indicates if the graph has been built
+    bool p_Built;
+
+    //RPs of the graph
+    vector<TRoboticPositioner*> p_RPs;
+    //EAs of the graph
+    vector<TExclusionArea*> p_EAs;
+
+    //position of the first edge from each RP to other RPs,
+    //plus the number of edges
+    vector<int> p_RPOffsets;
+    //edges from each RP to other RPs
+    vector<TAdjacencyEdge> p_RPEdges;
+    //position of the first edge from each RP to EAs,
+    //plus the number of edges
+    vector<int> p_EAOffsets;
+    //edges from each RP to EAs
+    vector<TAdjacencyEdge> p_EAEdges;
+
+    //number of pairs of adjacent RPs
+    int p_RPPairsCount;
+
+    //first edge of an array of edges
+    static const TAdjacencyEdge *first(const vector<TAdjacencyEdge>& Edges) {
+        return Edges.empty() ? NULL : &Edges[0];
+    }
+
+public:
+    //indicates if the graph has been built
+    bool getBuilt(void) const {return p_Built;}
+
+    //number of RPs of the graph
+    int getRPsCount(void) const {return int(p_RPs.size());}
+    //number of EAs of the graph
+    int getEAsCount(void) const {return int(p_EAs.size());}
+    //number of pairs of adjacent RPs
+    int getRPPairsCount(void) const {return p_RPPairsCount;}
+    //number of pairs of adjacent (RP, EA)
+    int getEAPairsCount(void) const {return int(p_EAEdges.size());}
+
+    //access to the RP i
+    TRoboticPositioner *getRP(int i) const {return p_RPs[i];}
+    //access to the EA k
+    TExclusionArea *getEA(int k) const {return p_EAs[k];}
+
+    //edges from the RP i to its adjacent RPs
+    const TAdjacencyEdge *beginRPs(int i) const {return first(p_RPEdges) + p_RPOffsets[i];}
+    const TAdjacencyEdge *endRPs(int i) const {return first(p_RPEdges) + p_RPOffsets[i+1];}
+    //edges from the RP i to its adjacent EAs
+    const TAdjacencyEdge *beginEAs(int i) const {return first(p_EAEdges) + p_EAOffsets[i];}
+    const TAdjacencyEdge *endEAs(int i) const {return first(p_EAEdges) + p_EAOffsets[i+1];}
+
+    //number of RPs adjacent to the RP i
+    int getRPDegree(int i) const {return p_RPOffsets[i+1] - p_RPOffsets[i];}
+
+    //build an empty graph
+    TAdjacencyGraph(void);
+
+    //build the graph of the RPs of a list
+    //from the lists of adjacents of their actuators
+    void build(const TRoboticPositionerList1& RPL);
+    //empty the graph
+    void Clear(void);
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
+#endif // ADJACENCYGRAPH_H
@@ -27,6 +27,8 @@
 #include "Strings.h" //StrTrim
 #include "StrPR.h" //StrReadInt
 
+#include <pthread.h> //pthread_mutex_t, pthread_mutex_lock, pthread_mutex_unlock
+
 using namespace Strings;
 
 //---------------------------------------------------------------------------
@@ -44,6 +46,10 @@ namespace Positioning {
 //list of built objects
 TItemsList<TAllocation*> TAllocation::Builts;
 
+//mutex for access to the list of built objects,
+//so objects can be built and destroyed from several threads
+static pthread_mutex_t BuiltsMutex = PTHREAD_MUTEX_INITIALIZER;
+
 //---------------------------------------------------------------------------
 //PROPERTIES IN TEXT FORMAT:
 
@@ -205,9 +211,12 @@ TAllocation::TAllocation(TRoboticPositioner *RP, double x, double y)
     //check the preconditions
     if(RP == NULL)
         throw EImproperArgument("pointer RP should point to built robotic positioner");
+    pthread_mutex_lock(&BuiltsMutex);
     for(int i=0; i<Builts.getCount(); i++)
-        if(RP == Builts[i]->getRP())
+        if(RP == Builts[i]->getRP()) {
+            pthread_mutex_unlock(&BuiltsMutex);
             throw EImproperArgument("robotic positioner RP should not be allocated to an previously built allocation");
+        }
 
     //assigns the inicialization values
     p_RP = RP;
@@ -216,15 +225,19 @@ TAllocation::TAllocation(TRoboticPositioner *RP, double x, double y)
 
     //appoints the new allocation in the built allocation list
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 TAllocation::TAllocation(TRoboticPositioner *RP, TDoublePoint t_PP)
 {
     //check the preconditions
     if(RP == NULL)
         throw EImproperArgument("pointer RP should point to built robotic positioner");
+    pthread_mutex_lock(&BuiltsMutex);
     for(int i=0; i<Builts.getCount(); i++)
-        if(RP == Builts[i]->getRP())
+        if(RP == Builts[i]->getRP()) {
+            pthread_mutex_unlock(&BuiltsMutex);
             throw EImproperArgument("robotic positioner RP should not be allocated to an previously built allocation");
+        }
 
     //assigns the inicialization values
     p_RP = RP;
@@ -232,15 +245,20 @@ TAllocation::TAllocation(TRoboticPositioner *RP, TDoublePoint t_PP)
 
     //appoints the new allocation in the built allocation list
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 //destroy a TAllocation
 //if thereisn't a built allocation
 //  throw an exception EImproperCall
 TAllocation::~TAllocation()
 {
+    pthread_mutex_lock(&BuiltsMutex);
+
     //debe haber algún punto objetivo construido
-    if(Builts.getCount() < 1)
+    if(Builts.getCount() < 1) {
+        pthread_mutex_unlock(&BuiltsMutex);
         throw EImproperCall("should be some allocation built");
+    }
 
     //busca el posicionador que se va a destruir en la lista de construidos
     int i = 0;
@@ -248,12 +266,16 @@ TAllocation::~TAllocation()
         i++;
 
     //si no lo encuentra
-    if(i >= Builts.getCount())
+    if(i >= Builts.getCount()) {
+        pthread_mutex_unlock(&BuiltsMutex);
         //indica que no se encuentra un punto objetivo previamente contruido
         throw EImpossibleError("dont find a previously allocation built");
+    }
 
     //borra el puntero de la lista
     Builts.Delete(i);
+
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 
 //---------------------------------------------------------------------------
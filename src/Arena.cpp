@@ -0,0 +1,185 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: Arena.cpp
+//Content: arena of memory for the objects built during a request
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "Arena.h"
+
+#include <new> //operator new
+
+//---------------------------------------------------------------------------
+
+//namespace for lists
+namespace Lists {
+
+//---------------------------------------------------------------------------
+//class TArena
+//---------------------------------------------------------------------------
+
+//Each block starts with a header which points to the arena where it has
+//been allocated, or NULL if it has been allocated in the heap,
+//followed by the size of the block. The header has the size of
+//two pointers, so the blocks keep the alignment of the chunks.
+
+//round the size up to a multiple of the header size
+static inline size_t align(size_t size)
+{
+    return (size + TArena::HeaderSize - 1) & ~(TArena::HeaderSize - 1);
+}
+
+//arena open in the thread, or NULL
+__thread TArena *TArena::p_Current = NULL;
+
+//build an empty arena
+TArena::TArena(void) : p_Chunks(NULL), p_Lock(0), p_Refs(1)
+{
+    for(size_t i=0; i<sizeof(p_Free)/sizeof(p_Free[0]); i++)
+        p_Free[i] = NULL;
+}
+//release the chunks of the arena
+TArena::~TArena()
+{
+    while(p_Chunks != NULL) {
+        TChunk *C = p_Chunks;
+        p_Chunks = C->Next;
+        ::operator delete(C);
+    }
+}
+
+//reserve a block of memory of the indicated size,
+//reusing a free block of the same size, if any
+void *TArena::reserve(size_t size)
+{
+    //reuse a free block of the same size class, if any
+    if(size <= MaxReusedSize) {
+        TFreeBlock *B;
+        while(__sync_lock_test_and_set(&p_Lock, 1));
+        B = p_Free[size/HeaderSize];
+        if(B != NULL)
+            p_Free[size/HeaderSize] = B->Next;
+        __sync_lock_release(&p_Lock);
+        if(B != NULL)
+            return B;
+    }
+
+    //if there isn't space enough in the last chunk, add other
+    if(p_Chunks == NULL || p_Chunks->Size - p_Chunks->Used < size) {
+        size_t Size = align(sizeof(TChunk)) + (size > ChunkSize ? size : ChunkSize);
+        TChunk *C = (TChunk*)::operator new(Size);
+        C->Next = p_Chunks;
+        C->Size = Size;
+        C->Used = align(sizeof(TChunk));
+        p_Chunks = C;
+    }
+
+    char *ptr = (char*)p_Chunks + p_Chunks->Used;
+    p_Chunks->Used += size;
+    return ptr;
+}
+//keep a block of memory to be reused, if it isn't too big
+void TArena::recycle(void *block, size_t size)
+{
+    if(size > MaxReusedSize)
+        return;
+
+    TFreeBlock *B = (TFreeBlock*)block;
+    while(__sync_lock_test_and_set(&p_Lock, 1));
+    B->Next = p_Free[size/HeaderSize];
+    p_Free[size/HeaderSize] = B;
+    __sync_lock_release(&p_Lock);
+}
+//release a reference to the arena
+void TArena::release(void)
+{
+    if(__sync_sub_and_fetch(&p_Refs, 1) == 0)
+        delete this;
+}
+
+//number of chunks of the arena
+int TArena::getChunksCount(void) const
+{
+    int count = 0;
+    for(TChunk *C=p_Chunks; C!=NULL; C=C->Next)
+        count++;
+    return count;
+}
+
+//allocate a block of memory in the arena open in the thread,
+//or in the heap if there isn't an open arena
+void *TArena::allocate(size_t size)
+{
+    TArena *A = p_Current;
+    size_t Size = HeaderSize + align(size);
+    char *ptr;
+    if(A == NULL)
+        ptr = (char*)::operator new(Size);
+    else {
+        ptr = (char*)A->reserve(Size);
+        __sync_add_and_fetch(&A->p_Refs, 1);
+    }
+
+    *(TArena**)ptr = A;
+    *(size_t*)(ptr + sizeof(void*)) = Size;
+    return ptr + HeaderSize;
+}
+//free a block of memory allocated with allocate
+void TArena::deallocate(void *ptr)
+{
+    if(ptr == NULL)
+        return;
+
+    char *block = (char*)ptr - HeaderSize;
+    TArena *A = *(TArena**)block;
+    if(A == NULL)
+        ::operator delete(block);
+    else {
+        A->recycle(block, *(size_t*)(block + sizeof(void*)));
+        A->release();
+    }
+}
+
+//---------------------------------------------------------------------------
+//class TArenaScope
+//---------------------------------------------------------------------------
+
+//open an arena in the thread, if there isn't other
+TArenaScope::TArenaScope(void) : p_Arena(NULL)
+{
+    if(TArena::p_Current == NULL) {
+        p_Arena = new TArena();
+        TArena::p_Current = p_Arena;
+    }
+}
+//close the arena opened by the scope
+TArenaScope::~TArenaScope()
+{
+    if(p_Arena != NULL) {
+        TArena::p_Current = NULL;
+        p_Arena->release();
+    }
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Lists
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,161 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: Arena.h
+//Content: arena of memory for the objects built during a request
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef> //size_t, NULL
+
+//---------------------------------------------------------------------------
+
+//namespace for lists
+namespace Lists {
+
+//---------------------------------------------------------------------------
+//class TArena
+//---------------------------------------------------------------------------
+
+//The arena serves the memory of the objects of the classes derived
+//from TArenaItem, which are built while the arena is open in the thread,
+//taking it from big chunks instead of requesting it to the heap object
+//by object. The objects built in the same request are contiguous,
+//and the chunks are released all together, when the arena has been closed
+//and the last of its objects has been destroyed.
+//
+//The blocks of the objects destroyed while the arena is alive are kept
+//in a list of free blocks for each size class, and they are reused by
+//the next objects of the same size class, so the arena doesn't grow
+//when the objects are built and destroyed repeatedly (like the copies
+//of a MP during its compaction).
+//
+//The objects built when there isn't an open arena in the thread
+//are allocated in the heap as usual. The objects can be destroyed
+//from any thread, but the arena can be open only in a thread.
+
+//class arena of memory
+class TArena {
+    //chunk of memory
+    struct TChunk {
+        TChunk *Next;
+        size_t Size;
+        size_t Used;
+    };
+    //block of memory free to be reused
+    struct TFreeBlock {
+        TFreeBlock *Next;
+    };
+
+    //list of chunks of the arena
+    TChunk *p_Chunks;
+    //lists of free blocks of each size class
+    //(1 + MaxReusedSize/HeaderSize lists)
+    TFreeBlock *p_Free[1 + 1024/(2*sizeof(void*))];
+    //lock for access to the lists of free blocks
+    //(the blocks can be freed from any thread)
+    int p_Lock;
+    //number of references to the arena:
+    //one for the scope plus one for each object allocated in the arena
+    int p_Refs;
+
+    //arena open in the thread, or NULL
+    static __thread TArena *p_Current;
+
+    //build an empty arena
+    TArena(void);
+    //release the chunks of the arena
+    ~TArena();
+
+    //reserve a block of memory of the indicated size,
+    //reusing a free block of the same size, if any
+    void *reserve(size_t size);
+    //keep a block of memory to be reused, if it isn't too big
+    void recycle(void *block, size_t size);
+    //release a reference to the arena
+    void release(void);
+
+    friend class TArenaScope;
+
+public:
+    //size of the chunks of memory
+    static const size_t ChunkSize = 64*1024;
+    //size of the header of the blocks,
+    //which is also the granularity of the size classes
+    static const size_t HeaderSize = 2*sizeof(void*);
+    //maximun size of the blocks which are reused
+    static const size_t MaxReusedSize = 1024;
+
+    //get the arena open in the thread, or NULL
+    static const TArena *getCurrent(void) {return p_Current;}
+    //number of chunks of the arena
+    int getChunksCount(void) const;
+
+    //allocate a block of memory in the arena open in the thread,
+    //or in the heap if there isn't an open arena
+    static void *allocate(size_t size);
+    //free a block of memory allocated with allocate
+    static void deallocate(void *ptr);
+};
+
+//---------------------------------------------------------------------------
+//class TArenaScope
+//---------------------------------------------------------------------------
+
+//The scope opens an arena in the thread when it is built, and close it
+//when it is destroyed. When there is already an open arena in the thread,
+//the scope does nothing, so the nested scopes use the arena
+//of the outer scope.
+
+//class scope of an arena
+class TArenaScope {
+    //arena opened by the scope, or NULL
+    TArena *p_Arena;
+
+    //the scope can't be copied
+    TArenaScope(const TArenaScope&);
+    TArenaScope& operator=(const TArenaScope&);
+
+public:
+    //open an arena in the thread, if there isn't other
+    TArenaScope(void);
+    //close the arena opened by the scope
+    ~TArenaScope();
+};
+
+//---------------------------------------------------------------------------
+//class TArenaItem
+//---------------------------------------------------------------------------
+
+//base class for the objects which can be allocated in an arena
+class TArenaItem {
+public:
+    static void *operator new(size_t size) {return TArena::allocate(size);}
+    static void operator delete(void *ptr) {TArena::deallocate(ptr);}
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Lists
+
+//---------------------------------------------------------------------------
+#endif // ARENA_H
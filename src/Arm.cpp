@@ -44,6 +44,67 @@ namespace Models {
 //ADVERTENCIA: el contructor se ejecutará antes
 //de que se inicialicen las variables estáticas.
 
+//---------------------------------------------------------------------------
+//DEFAULT TEMPLATES:
+
+//The default templates are built only once, and shared by all arms
+//built by default, until they are modified.
+
+//build the default template of the contour of the arm
+static TSharedItem<TContourFigureList> buildDefaultContour____(void)
+{
+    TContourFigureList Contour____;
+    Contour____.setText(MEGARA_Contour____Text);
+    TSharedItem<TContourFigureList> SI(destroyFigures);
+    SI.renew().Copy(Contour____);
+    Destroy(Contour____);
+    return SI;
+}
+//get the default template of the contour of the arm
+static const TSharedItem<TContourFigureList>& getDefaultContour____(void)
+{
+    static const TSharedItem<TContourFigureList> Contour____ = buildDefaultContour____();
+    return Contour____;
+}
+
+//build the default function F of the arm
+static TSharedItem<TFunction> buildDefaultF(void)
+{
+    TSharedItem<TFunction> SI;
+    TFunction& F = SI.renew();
+    F.Label = "F2";
+    //añade los puntos de la función de compresión
+    F.Add(-M_2PI, -double(MEGARA_SB2));
+    F.Add(0., 0.);
+    F.Add(M_2PI, double(MEGARA_SB2));
+    F.Add(2*M_2PI, double(2*MEGARA_SB2));
+    //elimina las incongruencias del formato texto
+    //de la función de compansión
+    F.setPointsText(F.getPointsText());
+    return SI;
+}
+//get the default function F of the arm
+static const TSharedItem<TFunction>& getDefaultF(void)
+{
+    static const TSharedItem<TFunction> F = buildDefaultF();
+    return F;
+}
+//build the default function G of the arm
+static TSharedItem<TFunction> buildDefaultG(void)
+{
+    TSharedItem<TFunction> SI;
+    TFunction& G = SI.renew();
+    G.Label = "G2";
+    G.Inverse(getDefaultF().get());
+    return SI;
+}
+//get the default function G of the arm
+static const TSharedItem<TFunction>& getDefaultG(void)
+{
+    static const TSharedItem<TFunction> G = buildDefaultG();
+    return G;
+}
+
 //---------------------------------------------------------------------------
 //MÉTODOS DE ASIMILACIÓN:
 
@@ -94,12 +155,23 @@ void TArm::processateF(void)
 {
     try {
         //determina la función G (inversa de F)
-        p_G.Inverse(getF());
+        p_G.getWritable().Inverse(getF());
     } catch(Exception& E) {
         E.Message.Insert(1, "getting inverse of F: ");
         throw;
     }
 
+    //asimila F y G
+    processateFG();
+}
+//A partir de:
+//  {F(theta___3), G(p___3)}
+//Determina:
+//  {SB2, rbs}
+//  {theta___3min, theta___3max}
+//  {Q(p___3)}
+void TArm::processateFG(void)
+{
     //ADVERTENCIA: es posible que F no esté definida en 0 y/o en M_2PI.
 
     //selecciona el intervalo a partir del cual va a calcular
@@ -287,16 +359,29 @@ void TArm::setContour____(const TContourFigureList &_Contour____)
     if(!_Contour____.isAContourSorted())
         throw EImproperArgument("the contour (Contour____) should be sorted");
 
-    //libera las figuras de la plantilla previa
-    Destroy((TContourFigureList&)getContour____());
-
     //asigna el nuevo valor
-    p_Contour____.Copy(_Contour____);
+    //(la plantilla previa puede estar compartida con otros brazos,
+    //así que no debe ser modificada)
+    p_Contour____.renew().Copy(_Contour____);
 
     //asimila el contorno
     processateTemplate();
     calculateImage();
 }
+//assign the template of the contour of other arm, sharing it
+void TArm::shareContour____(const TArm *Arm)
+{
+    //check the preconditions
+    if(Arm == NULL)
+        throw EImproperArgument("pointer Arm should point to built arm");
+
+    //share the template
+    p_Contour____ = Arm->p_Contour____;
+
+    //assimilate the contour
+    processateTemplate();
+    calculateImage();
+}
 
 //--------------------------------------------------------------------------
 //PROPIEDADES DE ORIENTACIÓN EN RADIANES
@@ -604,7 +689,7 @@ void TArm::setF(const TFunction &F)
     //      La función F(theta___3) debe estar definida en M_2PI.
 
     //asigna la función F
-    p_F = F;
+    p_F.getWritable() = F;
 
     //asimila la función F
     processateF();
@@ -616,6 +701,21 @@ void TArm::setF(const TFunction &F)
     //hará que se desplace a la posición estable más próxima
     //la cual será asimilada.
 }
+//assign the function F of other arm, sharing it (and its inverse G)
+void TArm::shareF(const TArm *Arm)
+{
+    //check the preconditions
+    if(Arm == NULL)
+        throw EImproperArgument("pointer Arm should point to built arm");
+
+    //share the functions
+    p_F = Arm->p_F;
+    p_G = Arm->p_G;
+
+    //assimilate the functions
+    processateFG();
+    calculateImage();
+}
 
 //interruptor de cuantificación de p___3
 //indica si deben cuantificarse los valores asignados a p___3
@@ -845,7 +945,7 @@ void TArm::setR3Text(const AnsiString &S)
 //dirección en memoria de la propiedad compuesta Contour____
 AnsiString TArm::getContour____AddressText(void) const
 {
-    return IntToHex(intptr_t(&p_Contour____));
+    return IntToHex(intptr_t(&getContour____()));
 }
 //propiedad Contour____ en formato texto lista
 void TArm::setContour____Text(const AnsiString &S)
@@ -1063,7 +1163,7 @@ void TArm::settheta2Text(const AnsiString &S)
 //dirección en memoria de la función F
 AnsiString TArm::getFAddressText(void) const
 {
-    return IntToHex(intptr_t(&p_F));
+    return IntToHex(intptr_t(&getF()));
 }
 //puntos de lafunción F enformato lista
 void TArm::setFPointsText(const AnsiString &S)
@@ -1138,7 +1238,7 @@ void TArm::setQuantify___Text(const AnsiString &S)
 //dirección en memoria de la función G
 AnsiString TArm::getGAddressText(void) const
 {
-    return IntToHex(intptr_t(&p_G));
+    return IntToHex(intptr_t(&getG()));
 }
 
 AnsiString TArm::getSB2Text(void) const
@@ -1498,9 +1598,10 @@ void  TArm::readInstance(TArm *A, const AnsiString& S, int &i)
 //con la posición y orientación indicadas
 TArm::TArm(TDoublePoint P1, double thetaO2) :
     //construye las propiedades privadas
-    p_Contour____(8),
-    p_F(),
-    p_G(), p_Q(),
+    //compartiendo las plantillas por defecto
+    p_Contour____(getDefaultContour____()),
+    p_F(getDefaultF()),
+    p_G(getDefaultG()), p_Q(),
     p_Contour(8),
     //construye las propiedades públicas
     P____1(0, 0),
@@ -1515,8 +1616,8 @@ TArm::TArm(TDoublePoint P1, double thetaO2) :
     p_theta____3 = 0; //recuerde que theta__O3 es igual que theta____3
     p_R3 = 0.75;
 
-    //inicializa el contorno
-    setContour____Text(MEGARA_Contour____Text);
+    //el contorno se inicializa compartiendo
+    //la plantilla por defecto: MEGARA_Contour____Text
 
     //INICIALIZA LAS PROPIEDADES DE ORIENTACIÓN:
 
@@ -1534,18 +1635,10 @@ TArm::TArm(TDoublePoint P1, double thetaO2) :
 
     //INICIALIZA LAS PROPIEDADES DE CUANTIFICACIÓN:
 
-    //nombra las funciones
-    p_F.Label = "F2";
-    p_G.Label = "G2";
-
-    //añade los puntos de la función de compresión
-    p_F.Add(-M_2PI, -double(MEGARA_SB2));
-    p_F.Add(0., 0.);
-    p_F.Add(M_2PI, double(MEGARA_SB2));
-    p_F.Add(2*M_2PI, double(2*MEGARA_SB2));
-    //elimina las incongruencias del formato texto
-    //de la función de compansión
-    p_F.setPointsText(getF().getPointsText());
+    //las funciones F y G se inicializan compartiendo
+    //las funciones por defecto, nombradas F2 y G2:
+    //  {(-M_2PI, -MEGARA_SB2), (0, 0),
+    //  (M_2PI, MEGARA_SB2), (2*M_2PI, 2*MEGARA_SB2)}
 
     //F debe estar definida en el intervalo [-M_2PI, 2*M_2PI]
     //para permitir el ajuste olgado de [theta___3min, theta___3max].
@@ -1583,7 +1676,8 @@ TArm::TArm(TDoublePoint P1, double thetaO2) :
     //      {Q(p___3)}
     //Restricciones:
     //      La función F(theta___3) debe ser monótona creciente.
-    processateF();
+    //La función G ya es la inversa de la función F por defecto.
+    processateFG();
 
     //ASIMILA LOS VALORES DE ORIENTACIÓN Y LOCACLIZACIÓN:
 
@@ -1614,19 +1708,19 @@ void TArm::clone(TArm *Arm)
     p_theta____3 = Arm->gettheta____3();
     p_P____3 = Arm->getP____3();
     p_R3 = Arm->getR3();
-    p_Contour____.Clone(Arm->getContour____());
+    p_Contour____ = Arm->p_Contour____; //shared
 
     //copia las propiedades de plantilla de solo lectura
     p_L1V = Arm->getL1V();
     p_V____ = Arm->getV____();
 
     //copia las propiedades de cuanticiación delectura/escritura
-    p_F.Clone(Arm->getF());
+    p_F = Arm->p_F; //shared
     p_Quantify___ = Arm->getQuantify___();
     Quantify___s.Clone(Arm->Quantify___s);
 
     //copia las propiedades de cuantificación de solo lectura
-    p_G.Clone(Arm->getG());
+    p_G = Arm->p_G; //shared
     p_SB2 = Arm->getSB2();
     p_rbs = Arm->getrbs();
     p_Q.Clone(Arm->getQ());
@@ -1649,7 +1743,8 @@ void TArm::clone(TArm *Arm)
     p_Contour.Clone(Arm->getContour());
 }
 //contruye un clon de un brazo
-TArm::TArm(TArm *Arm)
+TArm::TArm(TArm *Arm) :
+    p_Contour____(destroyFigures)
 {
     //el puntero Arm debería apuntar a un brazo contruido
     if(Arm == NULL)
@@ -1662,7 +1757,8 @@ TArm::TArm(TArm *Arm)
 TArm::~TArm()
 {
     Destroy(p_Contour);
-    Destroy(p_Contour____);
+
+    //the template of the contour is destroyed with its last reference
 }
 
 //--------------------------------------------------------------------------
@@ -1821,16 +1917,26 @@ void TArm::setQuantification(double SB2)
 {
     //DEFINE LA FUNCIÓN F A PARTIR DE SB2:
 
+    //si es la función por defecto, la comparte
+    if(SB2 == MEGARA_SB2) {
+        p_F = getDefaultF();
+        p_G = getDefaultG();
+        processateFG();
+        calculateImage();
+        return;
+    }
+
     //inicializa la función
-    p_F.Clear();
+    TFunction& F = p_F.getWritable();
+    F.Clear();
     //añade los puntos de la función de compresión
-    p_F.Add(-M_2PI, -double(SB2));
-    p_F.Add(0., 0.);
-    p_F.Add(M_2PI, double(SB2));
-    p_F.Add(2*M_2PI, double(2*SB2));
+    F.Add(-M_2PI, -double(SB2));
+    F.Add(0., 0.);
+    F.Add(M_2PI, double(SB2));
+    F.Add(2*M_2PI, double(2*SB2));
     //elimina las incongruencias del formato texto
     //de la función de compansión
-    p_F.setPointsText(getF().getPointsText());
+    F.setPointsText(F.getPointsText());
 
     //asimila F
     processateF();
@@ -2076,6 +2182,11 @@ void TArm::set(TDoublePoint P1, double thetaO3, double theta___3)
         //cuantifica el nuevo valor
         theta___3 = Qtheta___3(theta___3);
 
+    //asigna los nuevos valores
+    setQuantified(P1, thetaO3, theta___3);
+}
+void TArm::setQuantified(TDoublePoint P1, double thetaO3, double theta___3)
+{
     //si alguno de los nuevos valores difiere del actual
     if(P1!=getP1() || thetaO3!=getthetaO3() || theta___3!=gettheta___3()) {
         //asigna los nuevos valores
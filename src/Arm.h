@@ -30,6 +30,7 @@
 #include "Function.h"
 #include "FiberMOSModelConstants.h"
 #include "Constants.h"
+#include "SharedItem.h"
 
 //---------------------------------------------------------------------------
 
@@ -119,7 +120,8 @@ protected:
 
     double p_R3;
 
-    TContourFigureList p_Contour____;
+    //the template of the contour is shared by the arms with the same template
+    TSharedItem<TContourFigureList> p_Contour____;
 
     //PROPIEDADES DE PLANTILLA
     //DE SOLO LECTURA:
@@ -141,14 +143,15 @@ protected:
     //PROPIEDADES DE CUANTIFICACIÓN
     //DE LECTURA/ESCRITURA:
 
-    TFunction p_F;
+    //the functions F and G are shared by the arms with the same functions
+    TSharedItem<TFunction> p_F;
 
     bool p_Quantify___;
 
     //PROPIEDADES DE CUANTIFICACIÓN
     //DE SOLO LECTURA:
 
-    TFunction p_G;
+    TSharedItem<TFunction> p_G;
 
     double p_SB2;
     double p_rbs;
@@ -196,6 +199,13 @@ protected:
     //Restricciones:
     //  La función F(theta___3) debe ser monótona creciente.
     void processateF(void);
+    //A partir de:
+    //  {F(theta___3), G(p___3)}
+    //Determina:
+    //  {SB2, rbs}
+    //  {theta___3min, theta___3max}
+    //  {Q(p___3)}
+    void processateFG(void);
 
     //Nótese que no se imponen las siguientes restricciones:
     //  La función F(theta___3) debe estar definida en 0.
@@ -274,8 +284,10 @@ public:
     //plantilla del contorno del brazo en S4
     //valor por defecto: MEGARA_Contour____Text
     const TContourFigureList &getContour____(void) const {
-        return (const TContourFigureList&)p_Contour____;}
+        return p_Contour____.get();}
     void setContour____(const TContourFigureList &_Contour____);
+    //assign the template of the contour of other arm, sharing it
+    void shareContour____(const TArm *Arm);
 
     //ADVERTENCIA: la escritura de Contour____.Text conviene hacerla
     //a tavés de la propiedad Contour____.Text, con un valor previamente
@@ -533,8 +545,10 @@ public:
     //  {(M_2PI, MEGARA_SB2),
     //  (0, 0),
     //  (M_2PI, MEGARA_SB2)}
-    const TFunction& getF(void) const {return (const TFunction&)p_F;}
+    const TFunction& getF(void) const {return p_F.get();}
     void setF(const TFunction &_F);
+    //assign the function F of other arm, sharing it (and its inverse G)
+    void shareF(const TArm *Arm);
 
     //Nótese que no se imponen las siguientes restricciones:
     //  La función F(theta___3) debe estar definida en 0.
@@ -579,7 +593,7 @@ public:
 
     //función de transformación de pasos a radianes
     //es la inversa de F
-    const TFunction& getG(void) const {return (const TFunction&)p_G;}
+    const TFunction& getG(void) const {return p_G.get();}
 
     //número de pasos de una vuelta completa del eje 2 (SB: Steps Back)
     //es un número real ya que a la salida de la reductora
@@ -1117,6 +1131,10 @@ public:
     //  la orientación del del origen de coordenadas de S3;
     //  la orientación del brazo respecto de su origen de coordenadas.
     void set(TDoublePoint P1, double thetaO3, double theta___3);
+    //Cambia simultaneamente lo mismo que set, pero con theta___3
+    //ya cuantificado cuando la cuantificación está activada,
+    //sin comprobar que theta___3 está en su dominio.
+    void setQuantified(TDoublePoint P1, double thetaO3, double theta___3);
 
     //como la orientación del brazo es guardada en radianes
     //resulta apropiado pasarlo ya en radianes
@@ -40,16 +40,57 @@ namespace Models {
 //---------------------------------------------------------------------------
 //clase TBarrier:
 
+//build the default contour of the barrier of a RP
+static TSharedItem<TContourFigureList> buildDefaultContour_(void)
+{
+    TContourFigureList Contour_;
+    Contour_.setText(MEGARA_Contour_Text);
+    TSharedItem<TContourFigureList> SI(destroyFigures);
+    SI.renew().Copy(Contour_);
+    Destroy(Contour_);
+    return SI;
+}
+//get the default contour of the barrier of a RP,
+//shared by all barriers built by default
+static const TSharedItem<TContourFigureList>& getDefaultContour_(void)
+{
+    static const TSharedItem<TContourFigureList> Contour_ = buildDefaultContour_();
+    return Contour_;
+}
+
 //PROPIEDADES DE DEFINICION:
 
 void TBarrier::setContour_(const TContourFigureList& Contour_)
 {
-    //libera las figuras de la plantilla previa
-    Destroy((TContourFigureList&)getContour_());
+    //libera las figuras de la imagen previa
     Destroy((TContourFigureList&)getContour());
 
     //asigna la plantilla
-    p_Contour_.Copy(Contour_);
+    //(la plantilla previa puede estar compartida con otras barreras,
+    //así que no debe ser modificada)
+    p_Contour_.renew().Copy(Contour_);
+
+    //asimila r_max
+    calculater_max();
+
+    //copia la plantilla
+    p_Contour.Copy(getContour_());
+
+    //calcula la imagen de la plantilla
+    calculateImage();
+}
+//assign the contour of other barrier, sharing it
+void TBarrier::shareContour_(const TBarrier *B)
+{
+    //check the preconditions
+    if(B == NULL)
+        throw EImproperArgument("pointer B should point to built barrier");
+
+    //libera las figuras de la imagen previa
+    Destroy((TContourFigureList&)getContour());
+
+    //comparte la plantilla
+    p_Contour_ = B->p_Contour_;
 
     //asimila r_max
     calculater_max();
@@ -223,12 +264,13 @@ void TBarrier::calculateImage(void)
 
 //contruye una barrera
 TBarrier::TBarrier(TDoublePoint P0, double thetaO1) :
-    p_Contour_(),
+    //share the default value of the contour
+    p_Contour_(getDefaultContour_()),
     p_P0(P0), p_thetaO1(thetaO1),
     p_Contour()
 {
-    //set the default value to the contour
-    setContour_Text(MEGARA_Contour_Text);
+    //build the image of the contour
+    p_Contour.Copy(getContour_());
 
     //a partir de:
     //    {Contour_}
@@ -254,7 +296,7 @@ void TBarrier::clone(const TBarrier *B)
     if(B == NULL)
         throw EImproperArgument("pointer B should point to built barrier");
 
-    p_Contour_.Clone(B->getContour_());
+    p_Contour_ = B->p_Contour_; //shared
     p_r_max = B->getr_max();
     p_P0 = B->getP0();
     p_thetaO1 = B->getthetaO1();
@@ -263,7 +305,8 @@ void TBarrier::clone(const TBarrier *B)
 }
 
 //contruye un clon de una barrera
-TBarrier::TBarrier(const TBarrier *B)
+TBarrier::TBarrier(const TBarrier *B) :
+    p_Contour_(destroyFigures)
 {
     //comprueba las precondiciones
     if(B == NULL)
@@ -275,7 +318,8 @@ TBarrier::TBarrier(const TBarrier *B)
 TBarrier::~TBarrier()
 {
     Destroy(p_Contour);
-    Destroy(p_Contour_);
+
+    //the contour is destroyed with its last reference
 }
 
 //determina si tiene todos los valores por defecto
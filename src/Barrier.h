@@ -28,6 +28,7 @@
 //#include <stdint.h>
 
 #include "ContourFigureList.h"
+#include "SharedItem.h"
 //#include "Function.h"
 //#include "Quantificator.h"
 //#include "Vector.h"
@@ -49,7 +50,8 @@ class TArm;
 class TBarrier {
     //PROPIEDADES DE DEFINICION:
 
-    TContourFigureList p_Contour_;
+    //the contour is shared by the barriers with the same contour
+    TSharedItem<TContourFigureList> p_Contour_;
 
     double p_r_max;
 
@@ -83,8 +85,10 @@ public:
     //contorno de la barrera en S1
     //valor por defecto: MEGARA_Contour_Text (asignado mediante setContour_Text)
     const TContourFigureList &getContour_(void) const {
-        return (const TContourFigureList&)p_Contour_;}
+        return p_Contour_.get();}
     void setContour_(const TContourFigureList &_Contour_);
+    //assign the contour of other barrier, sharing it
+    void shareContour_(const TBarrier *B);
 
     //distancia entre el origen de coordenadas de S1
     //y el punto más alejado de Contour_
@@ -119,7 +123,7 @@ public:
     //PROPIEDADES EN FORMATO TEXTO:
 
     AnsiString getContour_AddressText(void) const {
-        return IntToHex(intptr_t(&p_Contour_));}
+        return IntToHex(intptr_t(&getContour_()));}
     void setContour_Text(const AnsiString&);
     void setContour_ColumnText(const AnsiString&);
 
@@ -198,7 +198,7 @@ void TCilinder::setF(const TFunction &F)
     //      La función F(theta___3) debe estar definida en M_2PI.
 
     //asigna la función F
-    p_F = F;
+    p_F.getWritable() = F;
 
     //asimila F
     processateF();
@@ -209,6 +209,21 @@ void TCilinder::setF(const TFunction &F)
     //hará que se desplace a la posición estable más próxima
     //la cual será asimilada.
 }
+//assign the function F of other cilinder, sharing it (and its inverse G)
+void TCilinder::shareF(const TCilinder *C)
+{
+    //check the preconditions
+    if(C == NULL)
+        throw EImproperArgument("pointer C should point to built cilinder");
+
+    //share the functions
+    p_F = C->p_F;
+    p_G = C->p_G;
+
+    //assimilate the functions
+    processateFG();
+    settheta_1(gettheta_1());
+}
 
 void TCilinder::setQuantify_(bool Quantify_)
 {
@@ -648,7 +663,7 @@ AnsiString TCilinder::getthetaO3Text(void) const
 
 AnsiString TCilinder::getFAddressText(void) const
 {
-    return IntToHex(intptr_t(&p_F));
+    return IntToHex(intptr_t(&getF()));
 }
 void TCilinder::setFPointsText(const AnsiString &S)
 {
@@ -718,7 +733,7 @@ void TCilinder::setQuantify_Text(AnsiString &S)
 
 AnsiString TCilinder::getGAddressText(void) const
 {
-    return IntToHex(intptr_t(&p_G));
+    return IntToHex(intptr_t(&getG()));
 }
 
 AnsiString TCilinder::getSB1Text(void) const
@@ -1010,12 +1025,23 @@ void TCilinder::processateF(void)
 {
     try {
         //determina la función G (inversa de F)
-        p_G.Inverse(getF());
+        p_G.getWritable().Inverse(getF());
     } catch(Exception& E) {
         E.Message.Insert(1, "getting inverse of F: ");
         throw;
     }
 
+    //asimila F y G
+    processateFG();
+}
+//A partir de:
+//      {F(theta_1), G(p_1)}.
+//Determina:
+//      {SB1, rbs},
+//      {theta_1min, theta_1max}.
+//      {Q(p_1)}
+void TCilinder::processateFG(void)
+{
     //ADVERTENCIA: esposible que F no esté definida en 0 y/o en M_2PI.
 
     //selecciona el intervalo a partir del cual va a calcular
@@ -1057,12 +1083,52 @@ TDoublePoint TCilinder::newP1(void)
     return P1;
 }
 
+//build the default function F of the cilinder
+static TSharedItem<TFunction> buildDefaultF(void)
+{
+    TSharedItem<TFunction> SI;
+    TFunction& F = SI.renew();
+    F.Label = "F1";
+    //añade los puntos de la función de compresión
+    F.Add(-M_2PI, -double(MEGARA_SB1));
+    F.Add(0., 0.);
+    F.Add(M_2PI, double(MEGARA_SB1));
+    F.Add(2*M_2PI, double(2*MEGARA_SB1));
+    //elimina las incongruencias del formato texto
+    //de la función de compansión
+    F.setPointsText(F.getPointsText());
+    return SI;
+}
+//default function F, shared by all cilinders built by default
+const TSharedItem<TFunction>& TCilinder::getDefaultF(void)
+{
+    static const TSharedItem<TFunction> F = buildDefaultF();
+    return F;
+}
+//build the default function G of the cilinder
+static TSharedItem<TFunction> buildDefaultG(const TFunction& F)
+{
+    TSharedItem<TFunction> SI;
+    TFunction& G = SI.renew();
+    G.Label = "G1";
+    G.Inverse(F);
+    return SI;
+}
+//default function G, shared by all cilinders built by default
+const TSharedItem<TFunction>& TCilinder::getDefaultG(void)
+{
+    static const TSharedItem<TFunction> G = buildDefaultG(getDefaultF().get());
+    return G;
+}
+
 //---------------------------------------------------------------------------
 //MÉTODOS DE CONTRUCCION, COPIA Y DESTRUCCIÓN:
 
 //construye un actuador de fibra
 //con la posición y orientación indicadas
 TCilinder::TCilinder(TDoublePoint P0, double thetaO1) :
+    //share the default functions
+    p_F(getDefaultF()), p_G(getDefaultG()),
     p_Q(),
     theta_1s(), Quantify_s(2, NULL, NULL, NULL, StrPrintBool)
 {
@@ -1084,18 +1150,10 @@ TCilinder::TCilinder(TDoublePoint P0, double thetaO1) :
 
     //INICIALIZA LAS PROPIEDADES DE CUANTIFICACIÓN:
 
-    //nombra las funciones
-    p_F.Label = "F1";
-    p_G.Label = "G1";
-
-    //añade los puntos de la función de compresión
-    p_F.Add(-M_2PI, -double(MEGARA_SB1));
-    p_F.Add(0., 0.);
-    p_F.Add(M_2PI, double(MEGARA_SB1));
-    p_F.Add(2*M_2PI, double(2*MEGARA_SB1));
-    //elimina las incongruencias del formato texto
-    //de la función de compansión
-    p_F.setPointsText(getF().getPointsText());
+    //las funciones F y G se inicializan compartiendo
+    //las funciones por defecto, nombradas F1 y G1:
+    //  {(-M_2PI, -MEGARA_SB1), (0, 0),
+    //  (M_2PI, MEGARA_SB1), (2*M_2PI, 2*MEGARA_SB1)}
 
     //F debe estar definida en el intervalo [-M_2PI, 2*M_2PI]
     //para permitir el ajuste olgado de [theta___3min, theta___3max].
@@ -1117,7 +1175,8 @@ TCilinder::TCilinder(TDoublePoint P0, double thetaO1) :
     //      {Q(p_1)}
     //Restricciones:
     //      La función F(theta_1) debe ser monótona creciente.
-    processateF();
+    //La función G ya es la inversa de la función F por defecto.
+    processateFG();
 
     //ADVERTENCIA: se necesita conocer L01 para calcular NewP1.
 
@@ -1126,8 +1185,9 @@ TCilinder::TCilinder(TDoublePoint P0, double thetaO1) :
 
     //construye la barrera del área de exclusión con sus propiedades por defecto
     p_Barrier = new TBarrier(getP0(), getthetaO1());
-    //set the contour of the barrier of a RP
-    p_Barrier->setContour_Text(MEGARA_Contour_Text);
+
+    //The barrier is built with the contour of the barrier of a RP
+    //(MEGARA_Contour_Text) by default.
 }
 
 //copia un conjunto de propiedades de un cilindro
@@ -1160,10 +1220,10 @@ void TCilinder::copyQuantification(const TCilinder *C)
         throw EImproperArgument("pointer C should point to built cilinder");
 
     //copia las propiedades
-    p_F.Clone(C->p_F);
+    p_F = C->p_F; //shared
     p_Quantify_ = C->p_Quantify_;
     Quantify_s.Clone(C->Quantify_s);
-    p_G.Copy(C->p_G);
+    p_G = C->p_G; //shared
     p_SB1 = C->p_SB1;
     p_rbs = C->p_rbs;
     p_Q = C->p_Q;
@@ -1530,6 +1590,20 @@ void TCilinder::setAnglesSteps(double p_1, double p___3)
         getArm()->set(newP1(), getthetaO3(), theta___3);
     }
 }
+//asigna conjuntamente theta_1 y theta___3 ya cuantificados
+//cuando la cuantificación de su rotor está activada,
+//sin comprobar que están en sus dominios
+void TCilinder::setAnglesQuantified(double theta_1, double theta___3)
+{
+    //si alguno de los nuevos valores difiere del actual
+    if(theta_1!=gettheta_1() || theta___3!=getArm()->gettheta___3()) {
+        //asigna el nuevo valor
+        p_theta_1 = theta_1;
+
+        //mueve el brazo
+        getArm()->setQuantified(newP1(), getthetaO3(), theta___3);
+    }
+}
 
 //mueve los rotores hasta el origen de coordenadas
 void TCilinder::setAnglesZeroSteps(void)
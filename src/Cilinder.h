@@ -64,13 +64,14 @@ protected:
 
     //QUANTIFICATION PROPERTIES R/W:
 
-    TFunction p_F;
+    //the functions F and G are shared by the cilinders with the same functions
+    TSharedItem<TFunction> p_F;
 
     bool p_Quantify_;
 
     //QUANTIFICATION PROPERTIES R:
 
-    TFunction p_G;
+    TSharedItem<TFunction> p_G;
 
     double p_SB1;
     double p_rbs;
@@ -98,6 +99,13 @@ protected:
     //Restrictions:
     //  the function F(theta_1) must be monotonous growing.
     void processateF(void);
+    //From:
+    //  {F(theta_1), G(p_1)}.
+    //Determine:
+    //  {SB1, rbs},
+    //  {theta_1min, theta_1max}.
+    //  {Q(p_1)}
+    void processateFG(void);
 
     //Note that the following restriction are not impossed:
     //  The funtion F(theta_1) must be defined 0.
@@ -107,6 +115,10 @@ protected:
     //calculate P1 according to (P0, theta_1)
     TDoublePoint newP1(void);
 
+    //default functions F and G, shared by all cilinders built by default
+    static const TSharedItem<TFunction>& getDefaultF(void);
+    static const TSharedItem<TFunction>& getDefaultG(void);
+
 public:
     //------------------------------------------------------------------
     //SIZING RPOPERTIES R/w:
@@ -245,8 +257,10 @@ public:
     //default value:
     //  {(M_2PI, MEGARA_SB1), (0, 0), (M_2PI, MEGARA_SB1),
     //  2*(M_2PI, MEGARA_SB1)}
-    const TFunction& getF(void) const {return (const TFunction&)p_F;}
+    const TFunction& getF(void) const {return p_F.get();}
     void setF(const TFunction &_F);
+    //assign the function F of other cilinder, sharing it (and its inverse G)
+    void shareF(const TCilinder *C);
 
     //Note that the following restriction are not impossed:
     //  The funtion F(theta_1) must be defined 0.
@@ -308,7 +322,7 @@ public:
     //is the inferse of F
     //default value:
     //  G.Inverse(getF());;
-    const TFunction& getG(void) const {return (const TFunction&)p_G;}
+    const TFunction& getG(void) const {return p_G.get();}
 
     //steps back for rotor 1
     //default value: F(M_2PI) steps
@@ -783,6 +797,10 @@ public:
     void setAnglesRadians(double theta_1, double theta___3);
     //asigna conjuntamente p_1 y p___3
     void setAnglesSteps(double p_1, double p___3);
+    //asigna conjuntamente theta_1 y theta___3 ya cuantificados
+    //cuando la cuantificación de su rotor está activada,
+    //sin comprobar que están en sus dominios
+    void setAnglesQuantified(double theta_1, double theta___3);
 
     //mueve los rotores hasta el origen de coordenadas
     void setAnglesZeroSteps(void);
@@ -768,6 +768,12 @@ void TContourFigureList::getSecurityContour(TContourFigureList& contour, double
 //--------------------------------------------------------------------------
 //FUNCIONES RELACIONADAS:
 
+//destruye las figuras de una lista de figuras
+void destroyFigures(TContourFigureList &C)
+{
+    Destroy(C);
+}
+
 /*//segrega las figuras de esta lista en listas de figuras engarzadas
 //devuelve falso si encuentra más de dos vértices engarzados entre si
 bool segregate(TPointersList<TContourFigureList> &LC, TContourFigureList &C)
@@ -145,6 +145,10 @@ public:
 //--------------------------------------------------------------------------
 //FUNCIONES RELACIONADAS:
 
+//destruye las figuras de una lista de figuras
+//(función de liberación de los contornos compartidos)
+void destroyFigures(TContourFigureList &C);
+
 //segrega las figuras de una lista en listas de figuras concatenadas
 //devuelve falso si encuentra más de dos vértices engarzados entre si
 //bool segregate(TPointersList<TContourFigureList> &LC, TContourFigureList &C);
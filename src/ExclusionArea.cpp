@@ -30,6 +30,8 @@
 #include "TextFile.h"
 #include "RoboticPositioner.h"
 
+#include <pthread.h> //pthread_mutex_t, pthread_mutex_lock, pthread_mutex_unlock
+
 //---------------------------------------------------------------------------
 
 using namespace Strings;
@@ -47,6 +49,10 @@ namespace Models {
 //lista de objetos construidos
 TItemsList<TExclusionArea*> TExclusionArea::Builts;
 
+//mutex for access to the list of built objects,
+//so objects can be built and destroyed from several threads
+static pthread_mutex_t BuiltsMutex = PTHREAD_MUTEX_INITIALIZER;
+
 //---------------------------------------------------------------------------
 //PROPIEDADES:
 
@@ -411,7 +417,9 @@ TExclusionArea::TExclusionArea(void) :
     calculateSPM();
 
     //añade el objeto a la lista de contruidos
+    pthread_mutex_lock(&BuiltsMutex);
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 //construye un área de exclusión
 //con los valores indicados
@@ -432,7 +440,9 @@ TExclusionArea::TExclusionArea(int Id, TDoublePoint P0, double thetaO1) :
     calculateSPM();
 
     //añade el objeto a la lista de contruidos
+    pthread_mutex_lock(&BuiltsMutex);
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 
 //clona un área de exclusión
@@ -463,16 +473,22 @@ TExclusionArea::TExclusionArea(const TExclusionArea *EA) :
     clone(EA);
 
     //añade el objeto a la lista de contruidos
+    pthread_mutex_lock(&BuiltsMutex);
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 
 //libera la memoria dinámica y borra el objeto de Builts
 //si el objeto no está en Builts lanza EImproperCall
 TExclusionArea::~TExclusionArea()
 {
+    pthread_mutex_lock(&BuiltsMutex);
+
     //debe haber algún objeto para destruir
-    if(Builts.getCount() < 1)
+    if(Builts.getCount() < 1) {
+        pthread_mutex_unlock(&BuiltsMutex);
         throw EImproperCall("there isn't an object to destroy");
+    }
 
     //busca el objeto a destruir en la lista
     int i = 0;
@@ -480,12 +496,16 @@ TExclusionArea::~TExclusionArea()
         i++;
 
     //si no ha encontrado el objeto
-    if(i >= Builts.getCount())
+    if(i >= Builts.getCount()) {
+        pthread_mutex_unlock(&BuiltsMutex);
         //indica que está intentando destruir un objeto no contruido
         throw EImproperCall("destruction attempt of non built object: "+IntToHex(intptr_t(this)).str);
+    }
 
     //borra el puntero de la lista de construídos
     Builts.Delete(i);
+
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 
 //---------------------------------------------------------------------------
@@ -27,6 +27,9 @@
 #include "StrPR.h"
 
 #include <algorithm> //transform
+#include <sstream> //ostringstream
+#include <cstring> //strlen, strncmp
+#include <cctype> //isprint
 
 using namespace Strings;
 
@@ -35,6 +38,189 @@ using namespace Strings;
 //namespace for models
 namespace Models {
 
+//---------------------------------------------------------------------------
+//FUNCTIONS FOR PARSE FMOSA TEXTS:
+
+//A FMOSA text is parsed in a single pass over the source buffer.
+//The lines and the fields are ranges [first, last) of the buffer,
+//and only the text values (comments, Name and Comment) are copied.
+
+//cursor to the lines of a buffer delimited by "\r\n"
+//(like StrDivideInLines)
+class TLineCursor {
+    //pos-last char of the buffer
+    const char *p_end;
+    //first char of the next line (NULL if there isn't next line)
+    const char *p_next;
+
+    //search the pos-last char of the line starting in first
+    void searchLast(void);
+
+public:
+    //limits [first, last) of the actual line
+    const char *first;
+    const char *last;
+    //number of the actual line (1, 2, ...)
+    int row;
+
+    //build a cursor to the first line of the buffer [first, last)
+    TLineCursor(const char *_first, const char *_last) :
+        p_end(_last), p_next(NULL), first(_first), last(_first), row(1) {
+        searchLast();
+    }
+
+    //determines if the actual line is in the buffer
+    bool exists(void) const {return first != NULL;}
+    //go to the next line
+    void next(void);
+};
+
+void TLineCursor::searchLast(void)
+{
+    //The char after a '\r' is always part of the line
+    //(except '\n'), and the '\r' in the pos-last position
+    //of the buffer is discarded.
+
+    const char *p = first;
+    p_next = NULL;
+    while(p < p_end) {
+        if(*p == '\r') {
+            if(p+1 == p_end)
+                break;
+            if(p[1] == '\n') {
+                p_next = p + 2;
+                break;
+            }
+            p += 2;
+        } else
+            p++;
+    }
+    last = (p < p_end) ? p : p_end;
+}
+void TLineCursor::next(void)
+{
+    if(p_next != NULL) {
+        first = p_next;
+        searchLast();
+    } else
+        first = last = NULL;
+    row++;
+}
+
+//determines if a char is kept by StrTrim
+static bool isTrimmedChar(char c)
+{
+    return (isprint(c) || islatinprint(c)) && c!=' ';
+}
+//trim the range [first, last) of a buffer (like StrTrim)
+static void trimRange(const char *&first, const char *&last)
+{
+    while(first<last && !isTrimmedChar(*first))
+        first++;
+    while(first<last && !isTrimmedChar(last[-1]))
+        last--;
+}
+//determines if the trimmed range [first, last) is equal to a label
+static bool trimmedRangeIs(const char *first, const char *last,
+                           const char *label)
+{
+    trimRange(first, last);
+    size_t length = strlen(label);
+    return size_t(last - first) == length &&
+            strncmp(first, label, length) == 0;
+}
+//determines if the first nonseparator char of a line is '#'
+//(like strFirstNonseparatorChar)
+static bool isComment(const char *first, const char *last)
+{
+    const char *p = first;
+    while(p < last) {
+        if(*p==' ' || *p=='\t')
+            p++;
+        else if(*p == '\r') {
+            if(p+1>=last || p[1]!='\n')
+                throw EImproperArgument("\r should be followed by \n");
+            p += 2;
+        } else
+            return *p == '#';
+    }
+    return false;
+}
+//determines if a line is a comment or is empty
+static bool isCommentOrEmpty(const char *first, const char *last)
+{
+    if(isComment(first, last))
+        return true;
+    trimRange(first, last);
+    return first == last;
+}
+
+//split the range [first, last) of a buffer in fields delimited by '|'
+//(like StrSplit) and get the limits of the fields, up to count
+//returns the number of fields
+static int splitFields(const char *firsts[], const char *lasts[], int count,
+                       const char *first, const char *last)
+{
+    if(first == last)
+        return 0;
+
+    int n = 0;
+    const char *p = first;
+    for(const char *q=first; q<last; q++)
+        if(*q == '|') {
+            if(n < count) {
+                firsts[n] = p;
+                lasts[n] = q;
+            }
+            n++;
+            p = q + 1;
+        }
+    if(n < count) {
+        firsts[n] = p;
+        lasts[n] = last;
+    }
+    n++;
+
+    return n;
+}
+
+//translate the range [first, last) of a buffer to TPointType
+static TPointType readPointType(const char *first, const char *last)
+{
+    //the labels without leading separators are translated in place
+    const char *p = first;
+    while(p<last && (*p==' ' || *p=='\t'))
+        p++;
+    const char *labels[] = {"REFERENCE", "UNKNOWN", "SOURCE", "BLANK"};
+    const TPointType values[] = {ptREFERENCE, ptUNKNOWN, ptSOURCE, ptBLANK};
+    for(int k=0; k<4; k++) {
+        size_t length = strlen(labels[k]);
+        if(size_t(last - p) >= length && strncmp(p, labels[k], length) == 0)
+            return values[k];
+    }
+
+    //other cases are translated (or rejected) by strToPointType
+    return strToPointType(string(first, last));
+}
+//translate the range [first, last) of a buffer to bool
+static bool readBool(const char *first, const char *last)
+{
+    //the values '0' and '1' between spaces are translated in place
+    const char *p = first;
+    while(p<last && (*p==' ' || *p=='\t'))
+        p++;
+    if(p<last && (*p=='0' || *p=='1')) {
+        const char *q = p + 1;
+        while(q<last && (*q==' ' || *q=='\t'))
+            q++;
+        if(q == last)
+            return *p == '1';
+    }
+
+    //other cases are translated (or rejected) by strToBool
+    return strToBool(string(first, last));
+}
+
 //---------------------------------------------------------------------------
 //class TObservingSource:
 
@@ -148,38 +334,89 @@ Json::Value TObservingSource::getJSON(void) const
     return OS_JSON;
 }
 
+//write the structure in JSON format
+//(like getJSON, but without build the JSON object)
+void TObservingSource::writeJSON(TJSONWriter& W) const
+{
+    W.beginObject();
+    W.name("Angle");
+    W.value(Angle);
+    W.name("Bid");
+    if(there_is_Bid)
+        W.value(Bid);
+    else
+        W.value(0);
+    W.name("Comment");
+    W.value(Comment);
+    W.name("Dec");
+    W.value(Dec);
+    W.name("Enabled");
+    W.value(Enabled);
+    W.name("Mag");
+    if(there_is_Mag)
+        W.value(Mag);
+    else
+        W.value(0);
+    W.name("Name");
+    W.value(Name);
+    W.name("Pid");
+    W.value(Pid);
+    W.name("Pr");
+    if(there_is_Pr)
+        W.value(Pr);
+    else
+        W.value(0);
+    W.name("RA");
+    W.value(RA);
+    W.name("Type");
+    W.value(pointTypeToStr(Type));
+    W.name("X");
+    W.value(X);
+    W.name("Y");
+    W.value(Y);
+    W.endObject();
+}
+
 //set the structure in text format
 void TObservingSource::setText(const string& str)
 {
+    const char *p;
+    setRow(str.data(), str.data() + str.length(), p);
+}
+//set the structure in row format from the range [first, last) of a buffer
+void TObservingSource::setRow(const char *first, const char *last,
+                              const char *&p)
+{
+    p = first;
+
     try {
         //decompose the row in fields
-        TStrings Strings;
-        StrSplit(Strings, str, '|');
+        const char *f[13], *l[13];
+        int count = splitFields(f, l, 13, first, last);
 
         //check the number of fields
-        if(Strings.getCount() != 13)
+        if(count != 13)
             throw EImproperArgument("should have 13 fields separated by '|': \"<Name> | <RA> | <Dec> | <Mag> | <Type> | <Pr> | <Bid> | <Pid> | <X(mm)> | <Y(mm)> | <Angle(deg)> | <Enabled> | <Comment>\"");
 
         //translate the values and assign to a tampon variable
         TObservingSource OS;
 
         //trims Name property
-        try {
-            OS.Name = StrTrim(Strings[0]).str;
-        } catch(Exception& E) {
-            E.Message.Insert(1, "reading Name: ");
-            throw;
-        }
+        p = f[0];
+        trimRange(f[0], l[0]);
+        OS.Name.assign(f[0], l[0]);
 
         //translate the (RA, Dec) properties
         try {
-            OS.RA = strToFloat(Strings[1].str);
+            p = f[1];
+            OS.RA = strToFloat(f[1], l[1]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Ra: ");
             throw;
         }
         try {
-            OS.Dec = strToFloat(Strings[2].str);
+            p = f[2];
+            OS.Dec = strToFloat(f[2], l[2]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Dec: ");
             throw;
@@ -187,9 +424,10 @@ void TObservingSource::setText(const string& str)
 
         //translate Mag property (if it is not empty)
         try {
-            string aux = StrTrim(Strings[3]).str;
-            if(aux.length() > 0) {
-                OS.Mag = strToFloat(aux);
+            p = f[3];
+            trimRange(f[3], l[3]);
+            if(f[3] < l[3]) {
+                OS.Mag = strToFloat(f[3], l[3]);
                 OS.there_is_Mag = true;
             } else
                 OS.there_is_Mag = false;
@@ -200,7 +438,8 @@ void TObservingSource::setText(const string& str)
 
         //translate Type property
         try {
-            OS.Type = strToPointType(Strings[4].str);
+            p = f[4];
+            OS.Type = readPointType(f[4], l[4]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Type: ");
             throw;
@@ -208,9 +447,10 @@ void TObservingSource::setText(const string& str)
 
         //translate Pr property (if it is not empty)
         try {
-            string aux = StrTrim(Strings[5]).str;
-            if(aux.length() > 0) {
-                int Pr = strToInt(aux);
+            p = f[5];
+            trimRange(f[5], l[5]);
+            if(f[5] < l[5]) {
+                int Pr = strToInt(f[5], l[5]);
                 if(Pr < 0)
                     throw EImproperArgument("priority Pr should be nonnegative");
                 OS.Pr = (unsigned int)Pr;
@@ -224,9 +464,10 @@ void TObservingSource::setText(const string& str)
 
         //translate Bid property (if it is not empty)
         try {
-            string aux = StrTrim(Strings[6]).str;
-            if(aux.length() > 0) {
-                int Bid = strToInt(aux);
+            p = f[6];
+            trimRange(f[6], l[6]);
+            if(f[6] < l[6]) {
+                int Bid = strToInt(f[6], l[6]);
                 if(Bid < 0)
                     throw EImproperArgument("block identifier Bid should be nonnegative");
                 OS.Bid = (unsigned int)Bid;
@@ -240,7 +481,8 @@ void TObservingSource::setText(const string& str)
 
         //translate projection point properties
         try {
-            int Pid = strToInt(Strings[7].str);
+            p = f[7];
+            int Pid = strToInt(f[7], l[7]);
             if(Pid < 0)
                 throw EImproperArgument("positioner identifier Pid should be nonnegative");
             OS.Pid = (unsigned int)Pid;
@@ -249,59 +491,41 @@ void TObservingSource::setText(const string& str)
             throw;
         }
         try {
-            OS.X = strToFloat(Strings[8].str);
+            p = f[8];
+            OS.X = strToFloat(f[8], l[8]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading X: ");
             throw;
         }
         try {
-            OS.Y = strToFloat(Strings[9].str);
+            p = f[9];
+            OS.Y = strToFloat(f[9], l[9]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Y: ");
             throw;
         }
         try {
-            OS.Angle = strToFloat(Strings[10].str);
+            p = f[10];
+            OS.Angle = strToFloat(f[10], l[10]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Angle: ");
             throw;
         }
         try {
-            OS.Enabled = strToBool(Strings[11].str);
+            p = f[11];
+            OS.Enabled = readBool(f[11], l[11]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Enabled: ");
             throw;
         }
 
-        ////translate notAllocated property (if it is not empty)
-        //aux = StrTrim(Strings[11]).str;
-        //if(aux.length() > 0) {
-        //    OS.notAllocated = strtobool(aux);
-        //    OS.there_is_notAllocated = true;
-        //} else
-        //    OS.there_is_notAllocated = false;
-
-        ////translate allocateInAll property (if it is not empty)
-        //aux = StrTrim(Strings[12]).str;
-        //if(aux.length() > 0) {
-        //    OS.allocateInAll = strtobool(aux);
-        //    OS.there_is_allocateInAll = true;
-        //} else
-        //    OS.there_is_allocateInAll = false;
-
-        //OS.there_is_notAllocated = true;
-        //OS.there_is_allocateInAll = true;
-
         //trims Comment property
-        try {
-            OS.Comment = StrTrim(Strings[12]).str;
-        } catch(Exception& E) {
-            E.Message.Insert(1, "reading Comment: ");
-            throw;
-        }
+        p = f[12];
+        trimRange(f[12], l[12]);
+        OS.Comment.assign(f[12], l[12]);
 
         //check the precondition
-        if(there_is_Bid && (!there_is_Mag || !there_is_Pr/* || !there_is_notAllocated || !there_is_allocateInAll*/))
+        if(there_is_Bid && (!there_is_Mag || !there_is_Pr))
             throw EImproperArgument("if field Bid is not empty, all fields (except Name) shall be filled");
 
         //assign the tampon variable
@@ -410,20 +634,23 @@ bool TObservingSource::operator!=(const TObservingSource& OS)
 
 //read the OB section in tampon variables
 void TFMOSA::readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
-                             const string& str)
+                        const char *first, const char *last, const char *&p)
 {
+    p = first;
+
     try {
         //decompose the row in fields
-        TStrings Strings;
-        StrSplit(Strings, str, '|');
+        const char *f[4], *l[4];
+        int count = splitFields(f, l, 4, first, last);
 
         //check the number of fields
-        if(Strings.getCount() != 4)
+        if(count != 4)
             throw EImproperArgument("should have 4 fields separated by '|': \"<Id> | <Ra> | <Dec> | <Pos>\"");
 
         //trims Id property
         try {
-            int aux = strToInt(Strings[0].str);
+            p = f[0];
+            int aux = strToInt(f[0], l[0]);
             if(aux < 0)
                 throw EImproperArgument("value for block identifier Id shouldbe nonnegative");
             _Id = (unsigned int)aux;
@@ -434,13 +661,15 @@ void TFMOSA::readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
 
         //translate the (RA, Dec) properties
         try {
-            _Ra = strToFloat(Strings[1].str);
+            p = f[1];
+            _Ra = strToFloat(f[1], l[1]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Ra: ");
             throw;
         }
         try {
-            _Dec = strToFloat(Strings[2].str);
+            p = f[2];
+            _Dec = strToFloat(f[2], l[2]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Dec: ");
             throw;
@@ -448,7 +677,8 @@ void TFMOSA::readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
 
         //translate Pos property (if it is not empty)
         try {
-            _Pos = strToFloat(Strings[3].str);
+            p = f[3];
+            _Pos = strToFloat(f[3], l[3]);
         } catch(Exception& E) {
             E.Message.Insert(1, "reading Pos: ");
             throw;
@@ -463,31 +693,30 @@ void TFMOSA::readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
 //set a FMOSA in text format
 void TFMOSA::setTableText(unsigned int& Bid, const string& str)
 {
-    int i; //index to rows
+    //cursor to the lines of the string
+    TLineCursor L(str.data(), str.data() + str.length());
+    //position of the last field read in the actual line
+    const char *p = L.first;
 
     try {
-        //divide the string str in lines
-        TStrings Strings;
-        StrDivideInLines(Strings, str);
-
-        //--------------------------------------------------------------
-
-        //initialize the index to the first line
-        i = 0;
-
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("label @@SOB@@ not found");
 
         //--------------------------------------------------------------
 
         //discard the empty lines and read the comments
         TFMOSA t_FMOSA;
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0)) {
-            if(strFirstNonseparatorChar(Strings[i].str)=='#')
-                t_FMOSA.comments.Add(StrTrim(Strings[i]));
-            i++;
+        while(L.exists() && isCommentOrEmpty(L.first, L.last)) {
+            if(isComment(L.first, L.last)) {
+                const char *first = L.first;
+                const char *last = L.last;
+                trimRange(first, last);
+                t_FMOSA.comments.Add(AnsiString(string(first, last)));
+            }
+            L.next();
         }
+        p = L.first;
 
         //delete the header of the OB
         try {
@@ -517,88 +746,94 @@ void TFMOSA::setTableText(unsigned int& Bid, const string& str)
         }
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("label @@SOB@@ not found");
 
         //check if actual line contains the label @@SOB@@
-        if(StrTrim(Strings[i]) != AnsiString("@@SOB@@"))
+        if(!trimmedRangeIs(L.first, L.last, "@@SOB@@"))
             throw EImproperArgument("label @@SOB@@ not found");
 
         //discard the label @@SOB@@
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
+        while(L.exists() && isCommentOrEmpty(L.first, L.last))
+            L.next();
+        p = L.first;
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("OB parameters not found: <Id> | <Ra> | <Dec> | <Pos>");
 
         //read the OB section in tampon variables
         int t_Id;
-        readOBText(t_Id, t_FMOSA.Ra, t_FMOSA.Dec, t_FMOSA.Pos, Strings[i].str);
+        readOBText(t_Id, t_FMOSA.Ra, t_FMOSA.Dec, t_FMOSA.Pos, L.first, L.last, p);
 
         //contabilize the readed line
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
+        while(L.exists() && isCommentOrEmpty(L.first, L.last))
+            L.next();
+        p = L.first;
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("label @@EOB@@ not found");
 
         //check if actual line contains the label @@EOB@@
-        if(StrTrim(Strings[i]) != AnsiString("@@EOB@@"))
+        if(!trimmedRangeIs(L.first, L.last, "@@EOB@@"))
             throw EImproperArgument("label @@EOB@@ not found");
 
         //discard the label @@EOB@@
-        i++;
+        L.next();
+        p = L.first;
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("label @@SOS@@ not found");
 
         //--------------------------------------------------------------
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i]).Length()<=0))
-            i++;
+        while(L.exists() && isCommentOrEmpty(L.first, L.last))
+            L.next();
+        p = L.first;
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("label @@SOS@@ not found");
 
         //check if actual line contains the label @@SOS@@
-        if(StrTrim(Strings[i]) != AnsiString("@@SOS@@"))
+        if(!trimmedRangeIs(L.first, L.last, "@@SOS@@"))
             throw EImproperArgument("label @@SOS@@ not found");
 
         //discard the label @@SOS@@
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
+        while(L.exists() && isCommentOrEmpty(L.first, L.last))
+            L.next();
+        p = L.first;
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("OS parameters not found: \"<Name> | <RA> | <Dec> | <Mag> | <Type> | <Pr> | <Bid> | <Pid> | <X(mm)> | <Y(mm)> | | <Angle(deg)> | <Enabled> | <Comment>\"");
 
         //read all lines (using a tampon variable) until the close label @@EOS@
         try {
-            while(i<Strings.getCount() && StrTrim(Strings[i])!=AnsiString("@@EOS@@")) {
+            while(L.exists() && !trimmedRangeIs(L.first, L.last, "@@EOS@@")) {
                 TObservingSource *OS = new TObservingSource();
                 t_FMOSA.Add(OS);
-                OS->setText(Strings[i].str);
+                OS->setRow(L.first, L.last, p);
 
                 //check the precondition
                 if(OS->Type != ptUNKNOWN)
                     if(OS->Bid != (unsigned int)t_Id)
                         throw EImproperArgument("all Bid should be equal to Id");
 
-                i++;
+                L.next();
+                p = L.first;
             }
         }
         catch(Exception& E) {
@@ -607,26 +842,28 @@ void TFMOSA::setTableText(unsigned int& Bid, const string& str)
         }
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
+        while(L.exists() && isCommentOrEmpty(L.first, L.last))
+            L.next();
+        p = L.first;
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.exists())
             throw EImproperArgument("label @@EOS@@ not found");
 
         //check if actual line contains the label @@EOS@@
-        if(StrTrim(Strings[i]) != AnsiString("@@EOS@@"))
+        if(!trimmedRangeIs(L.first, L.last, "@@EOS@@"))
             throw EImproperArgument("label @@EOS@@ not found");
 
         //discard the label @@EOS@@
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i]).Length()<=0))
-            i++;
+        while(L.exists() && isCommentOrEmpty(L.first, L.last))
+            L.next();
+        p = L.first;
 
         //look for unexpected text
-        if(i < Strings.getCount())
+        if(L.exists())
             throw EImproperArgument("only should to be OB and OS block");
 
         //--------------------------------------------------------------
@@ -647,7 +884,11 @@ void TFMOSA::setTableText(unsigned int& Bid, const string& str)
         Bid = Id;
     }
     catch(Exception& E) {
-        E.Message.Insert(1, "setting FMOSA in text format in row "+inttostr(i+1)+": ");
+        //the column is 1 when the error isn't in a field
+        int col = 1;
+        if(L.exists() && p!=NULL && L.first<=p && p<=L.last)
+            col = int(p - L.first) + 1;
+        E.Message.Insert(1, "setting FMOSA in text format in row "+inttostr(L.row)+" and column "+inttostr(col)+": ");
         throw;
     }
 }
@@ -658,18 +899,34 @@ void TFMOSA::getTableText(string& str) const
     if(str_original.length() > 0)
         str = str_original;
     else {
-        str = "# Id| Ra\t | Dec\t      | Pos";
-        str += "\r\n@@SOB@@";
+        ostringstream os;
+        writeTableText(os);
+        str = os.str();
+    }
+}
+//write the FMOSA in text format in a stream
+void TFMOSA::writeTableText(ostream& os) const
+{
+    if(str_original.length() > 0)
+        os << str_original;
+    else {
+        os << "# Id| Ra\t | Dec\t      | Pos";
+        os << "\r\n@@SOB@@";
         string aux = inttostr(Id);
         while(aux.length() < 7)
             aux += ' ';
-        str += "\r\n"+aux+" |"+floattostr_fixed(Ra, 6)+" |"+floattostr_fixed(Dec, 6)+" |"+floattostr_fixed(Pos, 6);
-        str += "\r\n@@EOB@@";
+        os << "\r\n" << aux << " |" << floattostr_fixed(Ra, 6) << " |" << floattostr_fixed(Dec, 6) << " |" << floattostr_fixed(Pos, 6);
+        os << "\r\n@@EOB@@";
 
-        str += "\r\n#      Name         |    RA   |    Dec  | Mag |     Type       |Pr|Bid|Pid| X(mm)  | Y(mm)  | Angle(deg) | Enabled| Comment";
-        str += "\r\n@@SOS@@";
-        str += "\r\n"+getColumnText().str;
-        str += "\r\n@@EOS@@";
+        os << "\r\n#      Name         |    RA   |    Dec  | Mag |     Type       |Pr|Bid|Pid| X(mm)  | Y(mm)  | Angle(deg) | Enabled| Comment";
+        os << "\r\n@@SOS@@";
+        os << "\r\n";
+        for(int i=0; i<getCount(); i++) {
+            if(i > 0)
+                os << "\r\n";
+            os << Items[i]->getRowText().str;
+        }
+        os << "\r\n@@EOS@@";
     }
 }
 
@@ -704,6 +961,48 @@ Json::Value TFMOSA::getJSON(void) const
     return FMOSA_JSON;
 }
 
+//write the FMOSA in format JSON
+//(like getJSON, but without build the JSON object)
+void TFMOSA::writeJSON(TJSONWriter& W) const
+{
+    W.beginObject();
+
+    //write the OB
+    W.name("OB");
+    W.beginObject();
+    W.name("Dec");
+    W.value(Dec);
+    W.name("Id");
+    W.value(Id);
+    W.name("Pos");
+    W.value(Pos);
+    W.name("RA");
+    W.value(Ra);
+    W.endObject();
+
+    //write the OSs (an empty JSON array is a null value)
+    W.name("OS");
+    if(getCount() > 0) {
+        W.beginArray();
+        for(int i=0; i<getCount(); i++)
+            Items[i]->writeJSON(W);
+        W.endArray();
+    } else
+        W.valueNull();
+
+    //write the comments (an empty JSON array is a null value)
+    W.name("comments");
+    if(comments.getCount() > 0) {
+        W.beginArray();
+        for(int i=0; i<comments.getCount(); i++)
+            W.value(comments[i].str);
+        W.endArray();
+    } else
+        W.valueNull();
+
+    W.endObject();
+}
+
 //get the Pids of the OSs which accomplish:
 //  there_is_Bid
 //  Pid is not found in the FMM
@@ -810,6 +1109,29 @@ void TFMOSA::getAllocations(TAllocationList& AL)
     }
 }
 
+//transfer the allocations of the replaced RPs to the replacement RPs
+void TFMOSA::transferAllocations(const TVector<int>& Replaced,
+                                 const TVector<int>& Replacements)
+{
+    //check the preconditions
+    if(Replacements.getCount() != Replaced.getCount())
+        throw EImproperArgument("list Replacements should contain an identifier for each identifier of the list Replaced");
+
+    //for each replaced RP
+    for(int i=0; i<Replaced.getCount(); i++) {
+        //reallocate the allocated OSs to the replacement RP
+        for(int j=0; j<getCount(); j++) {
+            TObservingSource *OS = Items[j];
+            if(OS->there_is_Bid && OS->Enabled && int(OS->Pid)==Replaced[i])
+                OS->Pid = (unsigned int)Replacements[i];
+        }
+    }
+
+    //discard the original text, which contains the replaced RPs
+    if(Replaced.getCount() > 0)
+        str_original = "";
+}
+
 //build a FMOSA by default
 TFMOSA::TFMOSA(void) : TPointersList<TObservingSource>(),
     str_original(""), comments(),
@@ -94,9 +94,16 @@ public:
 
     //get the structure in JSON format
     Json::Value getJSON(void) const;
+    //write the structure in JSON format
+    //(like getJSON, but without build the JSON object)
+    void writeJSON(TJSONWriter& W) const;
 
     //set the structure in text format
     void setText(const string& str);
+    //set the structure in row format from the range [first, last)
+    //of a buffer, without copy the numeric fields
+    //if an exception is throwed, p will indicate the field where it was
+    void setRow(const char *first, const char *last, const char *&p);
 
     //print the properties of an OS in a string
     //in row format
@@ -122,8 +129,10 @@ public:
 
 class TFMOSA : public TPointersList<TObservingSource> {
     //read the OB section in tampon variables
+    //from the range [first, last) of a buffer
+    //if an exception is throwed, p will indicate the field where it was
     void readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
-                    const string& str);
+                    const char *first, const char *last, const char *&p);
 
 public:
     //last valid setted FMOSA in text format including comments
@@ -140,13 +149,20 @@ public:
     double Pos; //
 
     //set a FMOSA in text format
+    //the text is parsed in a single pass, and the errors are reported
+    //indicating the row and the column where they was found
     void setTableText(unsigned int& Bid, const string& str);
 
     //get the FMOSA in text format
     void getTableText(string& str) const;
+    //write the FMOSA in text format in a stream
+    void writeTableText(ostream& os) const;
 
     //get the FMOSA in format JSON
     Json::Value getJSON(void) const;
+    //write the FMOSA in format JSON
+    //(like getJSON, but without build the JSON object)
+    void writeJSON(TJSONWriter& W) const;
 
     //get the Pids of the OSs which accomplish:
     //  there_is_Bid
@@ -174,6 +190,19 @@ public:
     //Allocations to not operative (although enabled) RPs, can be got,
     //but motion programs can will be generated only by force.
 
+    //transfer the allocations of the replaced RPs to the replacement RPs
+    //Inputs:
+    //  Replaced: list of identifiers of the replaced RPs.
+    //  Replacements: list of identifiers of the replacement RPs,
+    //      in the same order than the list Replaced.
+    //Postconditions:
+    //  The OSs allocated to a replaced RP will be allocated
+    //  to the corresponding replacement RP.
+    //  The original text will be discarded, so that the FMOSA
+    //  will be written from their OSs.
+    void transferAllocations(const TVector<int>& Replaced,
+                             const TVector<int>& Replacements);
+
     //build a FMOSA by default
     TFMOSA(void);
 
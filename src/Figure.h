@@ -28,6 +28,7 @@
 //##include "..\5_Graphics\PloterShapes.h"
 #include "Vectors.h"
 #include "VCLemu.h"
+#include "Arena.h"
 
 //---------------------------------------------------------------------------
 
@@ -60,8 +61,11 @@ class TArc;
 //- permite acceder a los vértices Pa y Pb de segmentos y arcos
 //  mediante un puntero a TContourFigure.
 
+//Las figuras se construyen en la arena abierta en el hilo, si la hay,
+//de modo que las figuras de una misma petición quedan contiguas.
+
 //clase abstracta figura geométrica
-class TFigure {
+class TFigure : public Lists::TArenaItem {
 public:
     //PROPIEDADES ESTÁTICAS:
 
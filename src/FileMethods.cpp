@@ -25,6 +25,21 @@
 #include "FileMethods.h"
 #include "TextFile.h" //StrReadFromFile, StrWriteToFile
 
+#include <algorithm> //std::sort
+#include <cstdio> //rename, snprintf
+#include <cstdlib> //getenv, realpath, free
+#include <cstring> //memcpy, memcmp
+#include <fstream> //std::ifstream, std::ofstream
+#include <map> //std::map
+#include <stdint.h> //uint32_t, uint64_t
+#include <typeinfo> //typeid
+#include <vector> //std::vector
+#include <dirent.h> //opendir, readdir, closedir
+#include <fcntl.h> //open
+#include <sys/mman.h> //mmap, munmap
+#include <sys/stat.h> //stat, fstat
+#include <unistd.h> //read, close, getpid
+
 using namespace Strings;
 
 //---------------------------------------------------------------------------
@@ -55,15 +70,73 @@ void readAndAssign(TRoboticPositioner& RP, const string& dir)
     //must be set after.
 }
 
+//search the RP from which share a template read
+//if there isn't, return NULL
+static TRoboticPositioner *findTemplateSource(const TTemplateSources& Sources,
+                                              const string& data)
+{
+    TTemplateSources::const_iterator it = Sources.find(data);
+    if(it == Sources.end())
+        return NULL;
+    return it->second;
+}
+
+//read and assign the content of the files of a RP Instance,
+//sharing the templates of the RPs read from files with the same content
+static void readAndAssign(TRoboticPositioner& RP, const string& dir,
+                          TRPTemplateSources& Sources)
+{
+    string Contour____, Contour_, Instance, F1, F2;
+    strReadFromFile(Contour____, dir+"/Contour____.txt");
+    strReadFromFile(Contour_, dir+"/Contour_.txt");
+    strReadFromFile(Instance, dir+"/Instance.txt");
+    strReadFromFile(F1, dir+"/F1.txt");
+    strReadFromFile(F2, dir+"/F2.txt");
+
+    TActuator *A = RP.getActuator();
+    TRoboticPositioner *Source;
+
+    Source = findTemplateSource(Sources.Contours____, Contour____);
+    if(Source != NULL)
+        A->getArm()->shareContour____(Source->getActuator()->getArm());
+    else
+        A->getArm()->setContour____ColumnText(Contour____);
+    Source = findTemplateSource(Sources.Contours_, Contour_);
+    if(Source != NULL)
+        A->getBarrier()->shareContour_(Source->getActuator()->getBarrier());
+    else
+        A->getBarrier()->setContour_ColumnText(Contour_);
+
+    RP.setInstanceText(Instance);
+
+    Source = findTemplateSource(Sources.F1s, F1);
+    if(Source != NULL)
+        A->shareF(Source->getActuator());
+    else
+        A->setFTableText(F1);
+    Source = findTemplateSource(Sources.F2s, F2);
+    if(Source != NULL)
+        A->getArm()->shareF(Source->getActuator()->getArm());
+    else
+        A->getArm()->setFTableText(F2);
+
+    //WARNING: set the instance of a RP, produces the reset of F1 and F2
+    //according the SB1 and SB2 respectively. Reason why F1 and F2
+    //must be set after.
+
+    //annotate the RP as source of the templates which it doesn't share,
+    //once all of them have been read
+    Sources.Contours____.insert(make_pair(Contour____, &RP));
+    Sources.Contours_.insert(make_pair(Contour_, &RP));
+    Sources.F1s.insert(make_pair(F1, &RP));
+    Sources.F2s.insert(make_pair(F2, &RP));
+}
+
 //read an instance of a RP
 //from a directory
 void readInstanceFromDir(TRoboticPositioner& RP, const string& dir)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //build a tampon variable
         TRoboticPositioner t_RP;
         //read and assign the content of the files
@@ -79,6 +152,22 @@ void readInstanceFromDir(TRoboticPositioner& RP, const string& dir)
         throw EImproperFileLoadedValue("reading instance of RP"+RP.getActuator()->getIdText().str+": " + E.Message.str);
     }
 }
+//read an instance of a RP from a directory, sharing the templates
+//of the RPs read previously from files with the same content
+void readInstanceFromDir(TRoboticPositioner& RP, const string& dir,
+                         TRPTemplateSources& Sources)
+{
+    try {
+        readAndAssign(RP, dir, Sources);
+    }
+    catch(ECantComplete& E) {
+        E.Message.Insert(1, "reading instance of RP"+RP.getActuator()->getIdText().str+": ");
+        throw;
+    }
+    catch(Exception& E) {
+        throw EImproperFileLoadedValue("reading instance of RP"+RP.getActuator()->getIdText().str+": " + E.Message.str);
+    }
+}
 
 //---------------------------------------------------------------------------
 //FILE FUNCTIONS FOR EXCLUSION AREA LIST:
@@ -88,10 +177,6 @@ void readInstanceFromDir(TRoboticPositioner& RP, const string& dir)
 void writeInstanceToDir(const string& dir, const TExclusionAreaList& EAL)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         string str;
         string path;
         string aux;
@@ -141,10 +226,6 @@ void writeInstanceToDir(const string& dir, const TExclusionAreaList& EAL)
 void readInstanceFromDir(TExclusionAreaList& EAL, const string& dir)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //contruye una lista tampón
         TExclusionAreaList t_EAL;
 
@@ -198,15 +279,12 @@ void readInstanceFromDir(TExclusionAreaList& EAL, const string& dir)
 //---------------------------------------------------------------------------
 //FILE FUNCTIONS FOR ROBOTIC POSITIONER LISTS:
 
+
 //write the instance of a RP list
 //in a directory
 void writeInstanceToDir(const string& dir, const TRoboticPositionerList& RPL)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         string str;
         string path;
         string aux;
@@ -297,10 +375,6 @@ void readInstanceFromDir(TRoboticPositionerList& RPL, const string& dir,
                          const TExclusionAreaList& EAL)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //contruye una lista tampón
         TRoboticPositionerList t_RPL;
 
@@ -309,6 +383,10 @@ void readInstanceFromDir(TRoboticPositionerList& RPL, const string& dir,
         strReadFromFile(str, dir+"/RoboticPositionerOriginsTable.txt");
         t_RPL.setOriginsTableText(str);
 
+        //The RPs whose templates are read from files with the same content
+        //share the same template, instead of parse it again.
+        TRPTemplateSources Sources;
+
         //por cada posicionador de la lista
         for(int i=0; i<t_RPL.getCount(); i++) {
             //apunta el posicionador indicado para facilitar su acceso
@@ -317,29 +395,8 @@ void readInstanceFromDir(TRoboticPositionerList& RPL, const string& dir,
             //construye el nombre del subdirectorio que contiene la instancia del posicionador
             string subdir = dir+"/RoboticPositioner"+RP->getActuator()->getIdText().str;
 
-            //lee y asigna el contorno del brazo
-            strReadFromFile(str, subdir+AnsiString("/Contour____.txt").str);
-            RP->getActuator()->getArm()->setContour____ColumnText(str);
-
-            //lee y asigna el contorno de la barrera
-            strReadFromFile(str, subdir+"/Contour_.txt");
-            RP->getActuator()->getBarrier()->setContour_ColumnText(str);
-
-            //lee y asigna la instancia del posicionador
-            strReadFromFile(str, subdir+"/Instance.txt");
-            RP->setInstanceText(str);
-
-            //WARNING: set the isntance produces the reset of F1 and F2
-            //according the SB1 and SB2 respectively. Reason why F1 and F2
-            //must be setted below.
-
-            //lee y asigna la función de compresión del rotor 1
-            strReadFromFile(str, subdir+"/F1.txt");
-            RP->getActuator()->setFTableText(str);
-
-            //lee y asigna la función de compresión del rotor 2
-            strReadFromFile(str, subdir+"/F2.txt");
-            RP->getActuator()->getArm()->setFTableText(str);
+            //lee y asigna los contornos, la instancia y las funciones de compresión
+            readAndAssign(*RP, subdir, Sources);
         }
 
 /*        //lee y asigna la instancia de la lista de posicionadores
@@ -379,10 +436,6 @@ void readInstanceFromDir(TRoboticPositionerList& RPL, const string& dir,
 void writeInstanceToDir(const string& dir, const TFiberMOSModel& FMM)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //fuerza la creación del directorio
         ForceDirectories(dir);
 
@@ -413,10 +466,6 @@ void writeInstanceToDir(const string& dir, const TFiberMOSModel& FMM)
 void readInstanceFromDir(TFiberMOSModel& FMM, const string& dir)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //contruye una variable tampón
         TFiberMOSModel t_FMM;
 
@@ -451,6 +500,907 @@ void readInstanceFromDir(TFiberMOSModel& FMM, const string& dir)
     }
 }
 
+//---------------------------------------------------------------------------
+//SNAPSHOT FUNCTIONS FOR Fiber MOS Models:
+
+//identifier of the snapshot files
+static const char SNAPSHOT_MAGIC[8] = {'F','M','P','T','S','N','A','P'};
+//version of the snapshot format
+static const uint32_t SNAPSHOT_VERSION = 2;
+//mark for detect snapshots written with other byte order
+static const uint32_t SNAPSHOT_BYTEORDER = 0x01020304;
+
+//header of a snapshot file
+struct TSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteorder;
+    uint64_t source;    //checksum of the instance directory
+    uint64_t size;      //size of the payload in bytes
+    uint64_t checksum;  //checksum of the payload
+};
+
+//initial value of a FNV-1a hash
+static const uint64_t FNV1A_BASIS = 14695981039346656037ULL;
+
+//accumulate a block of bytes in a FNV-1a hash
+static uint64_t fnv1a(uint64_t h, const void *data, size_t n)
+{
+    const unsigned char *p = (const unsigned char*)data;
+    for(size_t i=0; i<n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+//read the content of a file in binary mode
+static void readBinaryFile(string& content, const string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        throw ECantComplete("can't open file '"+path+"'");
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        close(fd);
+        throw ECantComplete("can't stat file '"+path+"'");
+    }
+    content.resize(st.st_size);
+    size_t n = 0;
+    while(n < content.size()) {
+        ssize_t r = read(fd, &content[n], content.size() - n);
+        if(r <= 0)
+            break;
+        n += r;
+    }
+    close(fd);
+    if(n != content.size())
+        throw ECantComplete("can't read file '"+path+"'");
+}
+
+//get the relative paths of the regular files of a directory, recursively
+static void getFilesOfDir(vector<string>& files, const string& dir,
+                          const string& rel)
+{
+    string path = dir+"/"+rel;
+    DIR *d = opendir(path.c_str());
+    if(d == NULL)
+        throw ECantComplete("can't open directory '"+path+"'");
+    vector<string> names;
+    struct dirent *entry;
+    while((entry = readdir(d)) != NULL)
+        names.push_back(entry->d_name);
+    closedir(d);
+
+    for(unsigned int i=0; i<names.size(); i++) {
+        const string& name = names[i];
+        if(name == "." || name == ".." || name.find(".snapshot") != string::npos)
+            continue;
+        struct stat st;
+        if(stat((path+name).c_str(), &st) != 0)
+            throw ECantComplete("can't stat '"+path+name+"'");
+        if(S_ISDIR(st.st_mode))
+            getFilesOfDir(files, dir, rel+name+"/");
+        else if(S_ISREG(st.st_mode))
+            files.push_back(rel+name);
+    }
+}
+
+//calculate the checksum of the content of an instance directory
+//(relative path and content of all regular files, recursively,
+//except the snapshot files)
+unsigned long long checksumInstanceDir(const string& dir)
+{
+    try {
+        vector<string> files;
+        getFilesOfDir(files, dir, "");
+        sort(files.begin(), files.end());
+
+        uint64_t h = FNV1A_BASIS;
+        string content;
+        for(unsigned int i=0; i<files.size(); i++) {
+            readBinaryFile(content, dir+"/"+files[i]);
+            uint64_t size = content.size();
+            h = fnv1a(h, files[i].c_str(), files[i].length() + 1);
+            h = fnv1a(h, &size, sizeof(size));
+            h = fnv1a(h, content.data(), content.size());
+        }
+        return h;
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "calculating checksum of dir '"+dir+"': ");
+        throw;
+    }
+}
+
+//get the path of the snapshot of an instance directory
+string getSnapshotPath(const string& dir)
+{
+    string path = dir;
+    while(path.length() > 1 && path[path.length() - 1] == '/')
+        path.erase(path.length() - 1);
+    return path+".snapshot";
+}
+//get the path of the snapshot of an instance directory
+//in the cache of the user
+string getSnapshotCachePath(const string& dir)
+{
+    //determines the cache directory of the user
+    string cache;
+    const char *env = getenv("XDG_CACHE_HOME");
+    if(env != NULL && env[0] == '/')
+        cache = env;
+    else {
+        env = getenv("HOME");
+        if(env == NULL || env[0] != '/')
+            return "";
+        cache = string(env)+"/.cache";
+    }
+
+    //identify the instance directory by its absolute path
+    char *resolved = realpath(dir.c_str(), NULL);
+    if(resolved == NULL)
+        return "";
+    string abs_dir = resolved;
+    free(resolved);
+
+    string name = abs_dir.substr(abs_dir.find_last_of('/') + 1);
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016llx",
+             (unsigned long long)fnv1a(FNV1A_BASIS, abs_dir.data(), abs_dir.length()));
+
+    return cache+"/megara-fmpt/"+name+"-"+hash+".snapshot";
+}
+
+//functions for write the payload of a snapshot:
+
+static void putUInt(string& buffer, uint32_t x)
+{
+    buffer.append((const char*)&x, sizeof(x));
+}
+static void putInt(string& buffer, int x)
+{
+    int32_t aux = x;
+    buffer.append((const char*)&aux, sizeof(aux));
+}
+static void putDouble(string& buffer, double x)
+{
+    buffer.append((const char*)&x, sizeof(x));
+}
+static void putContour(string& buffer, const TContourFigureList& Contour)
+{
+    putUInt(buffer, Contour.getCount());
+    for(int i=0; i<Contour.getCount(); i++) {
+        const TContourFigure *cf = Contour[i];
+        if(typeid(*cf) == typeid(TSegment)) {
+            putUInt(buffer, 0);
+            putDouble(buffer, cf->getPa().x);
+            putDouble(buffer, cf->getPa().y);
+            putDouble(buffer, cf->getPb().x);
+            putDouble(buffer, cf->getPb().y);
+        }
+        else if(typeid(*cf) == typeid(TArc)) {
+            const TArc *arc = (const TArc*)cf;
+            putUInt(buffer, 1);
+            putDouble(buffer, arc->getPa().x);
+            putDouble(buffer, arc->getPa().y);
+            putDouble(buffer, arc->getPb().x);
+            putDouble(buffer, arc->getPb().y);
+            putDouble(buffer, arc->getPc().x);
+            putDouble(buffer, arc->getPc().y);
+            putDouble(buffer, arc->getR());
+        }
+        else
+            throw EImproperArgument("contour should contains only segments and arcs");
+    }
+}
+static void putFunction(string& buffer, const TFunction& F)
+{
+    putUInt(buffer, F.getCount());
+    for(int i=0; i<F.getCount(); i++) {
+        putDouble(buffer, F.getX(i));
+        putDouble(buffer, F.getY(i));
+    }
+}
+
+//functions for read the payload of a snapshot:
+
+//cursor in the payload of a snapshot
+struct TSnapshotCursor {
+    const char *p;
+    const char *end;
+};
+
+static void getBytes(void *data, size_t n, TSnapshotCursor& C)
+{
+    if(size_t(C.end - C.p) < n)
+        throw EImproperFileLoadedValue("unexpected end of snapshot");
+    memcpy(data, C.p, n);
+    C.p += n;
+}
+static uint32_t getUInt(TSnapshotCursor& C)
+{
+    uint32_t x;
+    getBytes(&x, sizeof(x), C);
+    return x;
+}
+static int getInt(TSnapshotCursor& C)
+{
+    int32_t x;
+    getBytes(&x, sizeof(x), C);
+    return x;
+}
+static double getDouble(TSnapshotCursor& C)
+{
+    double x;
+    getBytes(&x, sizeof(x), C);
+    return x;
+}
+//get a number of items, each one with a size of least item_size bytes
+static uint32_t getCount(TSnapshotCursor& C, size_t item_size)
+{
+    uint32_t n = getUInt(C);
+    if(size_t(C.end - C.p)/item_size < n)
+        throw EImproperFileLoadedValue("improper number of items in snapshot");
+    return n;
+}
+//get a contour, which must be destroyed by the caller
+static void getContour(TContourFigureList& Contour, TSnapshotCursor& C)
+{
+    uint32_t n = getCount(C, sizeof(uint32_t) + 4*sizeof(double));
+    for(uint32_t i=0; i<n; i++) {
+        uint32_t type = getUInt(C);
+        TDoublePoint Pa, Pb;
+        Pa.x = getDouble(C);
+        Pa.y = getDouble(C);
+        Pb.x = getDouble(C);
+        Pb.y = getDouble(C);
+        if(type == 0) {
+            TSegment *S = new TSegment();
+            Contour.Add(S);
+            S->SetValues(Pa, Pb);
+        }
+        else if(type == 1) {
+            TDoublePoint Pc;
+            Pc.x = getDouble(C);
+            Pc.y = getDouble(C);
+            double R = getDouble(C);
+            TArc *A = new TArc();
+            Contour.Add(A);
+            A->SetValues(Pa, Pb, Pc, R);
+        }
+        else
+            throw EImproperFileLoadedValue("unknown type of figure in snapshot");
+    }
+}
+static void getFunction(TFunction& F, TSnapshotCursor& C)
+{
+    uint32_t n = getCount(C, 2*sizeof(double));
+    TVector<double> X, Y;
+    for(uint32_t i=0; i<n; i++) {
+        X.Add(getDouble(C));
+        Y.Add(getDouble(C));
+    }
+    F.Set(X, Y);
+}
+//get an index to an item of a list of n items
+static int getIndex(TSnapshotCursor& C, unsigned int n)
+{
+    uint32_t i = getUInt(C);
+    if(i >= n)
+        throw EImproperFileLoadedValue("index out of range in snapshot");
+    return int(i);
+}
+
+//check the header of a snapshot
+static void checkSnapshotHeader(const TSnapshotHeader& H)
+{
+    if(memcmp(H.magic, SNAPSHOT_MAGIC, sizeof(H.magic)) != 0)
+        throw EImproperFileLoadedValue("file isn't a snapshot of a FMM");
+    if(H.byteorder != SNAPSHOT_BYTEORDER)
+        throw EImproperFileLoadedValue("snapshot written with other byte order");
+    if(H.version != SNAPSHOT_VERSION)
+        throw EImproperFileLoadedValue("snapshot version "+inttostr(int(H.version))+" not supported");
+}
+//read the header of a snapshot file
+//if the file can't be read or isn't a snapshot of this version return false
+static bool readSnapshotHeader(TSnapshotHeader& H, const string& path)
+{
+    ifstream file(path.c_str(), ios::in | ios::binary);
+    if(!file.read((char*)&H, sizeof(H)))
+        return false;
+    try {
+        checkSnapshotHeader(H);
+    }
+    catch(Exception&) {
+        return false;
+    }
+    return true;
+}
+
+//write a snapshot of a Fiber MOS Model in a file,
+//tagged with a given checksum of the instance directory
+static void writeSnapshotTagged(const string& path, const TFiberMOSModel& FMM,
+                                uint64_t source)
+{
+    //index the EAs and RPs for reference the adjacents
+    map<const TExclusionArea*, int> EAindices;
+    for(int i=0; i<FMM.EAL.getCount(); i++)
+        EAindices[FMM.EAL[i]] = i;
+    map<const TRoboticPositioner*, int> RPindices;
+    for(int i=0; i<FMM.RPL.getCount(); i++)
+        RPindices[FMM.RPL[i]] = i;
+
+    string buffer;
+
+    //tolerances of the FMM
+    putDouble(buffer, FMM.RPL.getPAem());
+    putDouble(buffer, FMM.RPL.getPem());
+
+    //instances of the EAs
+    putUInt(buffer, FMM.EAL.getCount());
+    for(int i=0; i<FMM.EAL.getCount(); i++) {
+        const TExclusionArea *EA = FMM.EAL[i];
+        putInt(buffer, EA->getId());
+        putDouble(buffer, EA->Barrier.getP0().x);
+        putDouble(buffer, EA->Barrier.getP0().y);
+        putDouble(buffer, EA->Barrier.getthetaO1());
+        putContour(buffer, EA->Barrier.getContour_());
+        putDouble(buffer, EA->getEo());
+        putDouble(buffer, EA->getEp());
+    }
+
+    //instances of the RPs
+    putUInt(buffer, FMM.RPL.getCount());
+    for(int i=0; i<FMM.RPL.getCount(); i++) {
+        const TRoboticPositioner *RP = FMM.RPL[i];
+        const TActuator *A = RP->getActuator();
+        const TArm *Arm = A->getArm();
+
+        putInt(buffer, A->getId());
+        putDouble(buffer, A->getP0().x);
+        putDouble(buffer, A->getP0().y);
+        putDouble(buffer, A->getthetaO1());
+        putContour(buffer, Arm->getContour____());
+        putContour(buffer, A->getBarrier()->getContour_());
+
+        putDouble(buffer, A->getL01());
+        putDouble(buffer, A->gettheta_1min());
+        putDouble(buffer, A->gettheta_1max());
+        putDouble(buffer, A->gettheta_1());
+        putDouble(buffer, A->gettheta_O3o());
+        putDouble(buffer, Arm->getL12());
+        putDouble(buffer, Arm->getL13());
+        putDouble(buffer, Arm->gettheta__O3());
+        putDouble(buffer, Arm->getR3());
+        putDouble(buffer, Arm->gettheta___3min());
+        putDouble(buffer, Arm->gettheta___3max());
+        putDouble(buffer, Arm->gettheta___3());
+        putDouble(buffer, A->getSPMmin());
+        putDouble(buffer, A->getSPMsim());
+        putInt(buffer, int(A->getPAkd()));
+
+        putDouble(buffer, RP->CMF.getSF1()->getvmaxabs());
+        putDouble(buffer, RP->CMF.getSF2()->getvmaxabs());
+        putDouble(buffer, RP->CMF.getRF1()->getvmaxabs());
+        putDouble(buffer, RP->CMF.getRF2()->getvmaxabs());
+        putDouble(buffer, RP->CMF.getRF1()->getamaxabs());
+        putDouble(buffer, RP->CMF.getRF2()->getamaxabs());
+        putInt(buffer, int(RP->CMF.getMFM()));
+        putInt(buffer, int(RP->CMF.getSSM()));
+        putInt(buffer, int(RP->CMF.getRSM()));
+        putInt(buffer, RP->CMF.getId1());
+        putInt(buffer, RP->CMF.getId2());
+
+        putDouble(buffer, RP->getEo());
+        putDouble(buffer, RP->getEp());
+        putDouble(buffer, RP->getTstop());
+        putDouble(buffer, RP->getTshiff());
+        putDouble(buffer, RP->getSPMadd());
+        putInt(buffer, RP->Disabled ? 1 : 0);
+        putDouble(buffer, RP->getFaultProbability());
+        putInt(buffer, int(RP->FaultType));
+
+        putFunction(buffer, A->getF());
+        putFunction(buffer, Arm->getF());
+    }
+
+    //assimilated properties of the RPs
+    for(int i=0; i<FMM.RPL.getCount(); i++) {
+        const TActuator *A = FMM.RPL[i]->getActuator();
+
+        putUInt(buffer, A->AdjacentEAs.getCount());
+        for(int j=0; j<A->AdjacentEAs.getCount(); j++) {
+            map<const TExclusionArea*, int>::const_iterator it = EAindices.find(A->AdjacentEAs[j].EA);
+            if(it == EAindices.end())
+                throw EImproperArgument("adjacent EAs should be in the FMM");
+            putUInt(buffer, it->second);
+        }
+        putUInt(buffer, A->AdjacentRPs.getCount());
+        for(int j=0; j<A->AdjacentRPs.getCount(); j++) {
+            map<const TRoboticPositioner*, int>::const_iterator it = RPindices.find(A->AdjacentRPs[j].RP);
+            if(it == RPindices.end())
+                throw EImproperArgument("adjacent RPs should be in the FMM");
+            putUInt(buffer, it->second);
+        }
+
+        putDouble(buffer, A->getr_min());
+        putDouble(buffer, A->getr_saf());
+        putDouble(buffer, A->getr_2saf());
+        putDouble(buffer, A->gettheta___2saf());
+        putDouble(buffer, A->gettheta___3saf());
+        putDouble(buffer, A->gettheta_2rad());
+    }
+
+    //assimilated properties of the EAs
+    for(int i=0; i<FMM.EAL.getCount(); i++) {
+        const TExclusionArea *EA = FMM.EAL[i];
+        putUInt(buffer, EA->AdjacentRPs.getCount());
+        for(int j=0; j<EA->AdjacentRPs.getCount(); j++) {
+            map<const TRoboticPositioner*, int>::const_iterator it = RPindices.find(EA->AdjacentRPs[j]);
+            if(it == RPindices.end())
+                throw EImproperArgument("adjacent RPs should be in the FMM");
+            putUInt(buffer, it->second);
+        }
+    }
+
+    //map of the RPs
+    putDouble(buffer, FMM.RPL.getxmin());
+    putDouble(buffer, FMM.RPL.getxmax());
+    putDouble(buffer, FMM.RPL.getymin());
+    putDouble(buffer, FMM.RPL.getymax());
+    putUInt(buffer, FMM.RPL.getI());
+    putUInt(buffer, FMM.RPL.getJ());
+    for(int i=0; i<FMM.RPL.getI(); i++)
+        for(int j=0; j<FMM.RPL.getJ(); j++) {
+            const TItemsList<TRoboticPositioner*>& Cell = FMM.RPL.getMapCell(i, j);
+            putUInt(buffer, Cell.getCount());
+            for(int k=0; k<Cell.getCount(); k++) {
+                map<const TRoboticPositioner*, int>::const_iterator it = RPindices.find(Cell[k]);
+                if(it == RPindices.end())
+                    throw EImproperArgument("mapped RPs should be in the FMM");
+                putUInt(buffer, it->second);
+            }
+        }
+
+    //build the header
+    TSnapshotHeader H;
+    memcpy(H.magic, SNAPSHOT_MAGIC, sizeof(H.magic));
+    H.version = SNAPSHOT_VERSION;
+    H.byteorder = SNAPSHOT_BYTEORDER;
+    H.source = source;
+    H.size = buffer.size();
+    H.checksum = fnv1a(FNV1A_BASIS, buffer.data(), buffer.size());
+
+    //write a temporal file and replace the snapshot,
+    //so that the readers never see a snapshot partially written
+    string tmp_path = path+".tmp"+inttostr(int(getpid()));
+    ofstream file(tmp_path.c_str(), ios::out | ios::binary | ios::trunc);
+    if(!file.is_open())
+        throw ECantComplete("can't open file '"+tmp_path+"'");
+    file.write((const char*)&H, sizeof(H));
+    file.write(buffer.data(), buffer.size());
+    file.close();
+    if(file.fail() || rename(tmp_path.c_str(), path.c_str()) != 0) {
+        unlink(tmp_path.c_str());
+        throw ECantComplete("can't write file '"+path+"'");
+    }
+}
+
+//write a snapshot of a Fiber MOS Model in a file,
+//tagged with the checksum of the directory of its instance
+void writeSnapshot(const string& path, const TFiberMOSModel& FMM,
+                   const string& dir)
+{
+    try {
+        writeSnapshotTagged(path, FMM, checksumInstanceDir(dir));
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "writing snapshot of FMM to file '"+path+"': ");
+        throw;
+    }
+}
+
+//read-only mapping of a file in memory
+class TMappedFile {
+    int fd;
+    void *addr;
+
+    //forbid the copy
+    TMappedFile(const TMappedFile&);
+    TMappedFile& operator=(const TMappedFile&);
+
+public:
+    const char *data;
+    size_t size;
+
+    //map a file
+    //if the file can't be mapped:
+    //  throw ECantComplete
+    TMappedFile(const string& path) : fd(-1), addr(MAP_FAILED), data(NULL), size(0) {
+        fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            throw ECantComplete("can't open file '"+path+"'");
+        struct stat st;
+        if(fstat(fd, &st) != 0) {
+            close(fd);
+            throw ECantComplete("can't stat file '"+path+"'");
+        }
+        size = st.st_size;
+        if(size > 0) {
+            addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr == MAP_FAILED) {
+                close(fd);
+                throw ECantComplete("can't map file '"+path+"'");
+            }
+            data = (const char*)addr;
+        }
+    }
+    //unmap the file
+    ~TMappedFile() {
+        if(addr != MAP_FAILED)
+            munmap(addr, size);
+        close(fd);
+    }
+};
+
+//decode the payload of a snapshot in a Fiber MOS Model
+static void decodeSnapshot(TFiberMOSModel& FMM, TSnapshotCursor& C)
+{
+    //The objects are decoded out of the FMM, so that it is not modified
+    //when the snapshot is not valid.
+    vector<TExclusionArea*> EAs;
+    vector<TRoboticPositioner*> RPs;
+    bool assigned = false;
+
+    try {
+        //tolerances of the FMM
+        double PAem = getDouble(C);
+        double Pem = getDouble(C);
+
+        //instances of the EAs
+        uint32_t NEA = getCount(C, sizeof(int32_t) + 3*sizeof(double));
+        for(uint32_t i=0; i<NEA; i++) {
+            TExclusionArea *EA = new TExclusionArea();
+            EAs.push_back(EA);
+
+            int Id = getInt(C);
+            double x0 = getDouble(C);
+            double y0 = getDouble(C);
+            double thetaO1 = getDouble(C);
+            EA->setOrigins(Id, x0, y0, thetaO1);
+
+            TContourFigureList Contour;
+            try {
+                getContour(Contour, C);
+                EA->Barrier.setContour_(Contour);
+            } catch(...) {
+                Destroy(Contour);
+                throw;
+            }
+            Destroy(Contour);
+
+            double Eo = getDouble(C);
+            double Ep = getDouble(C);
+            EA->setEo(Eo);
+            EA->setEp(Ep);
+        }
+
+        //instances of the RPs
+        //(the RPs with the same templates share them)
+        TRPTemplateSources Sources;
+        TRoboticPositioner *Source;
+        string data;
+        const char *begin;
+        uint32_t NRP = getCount(C, sizeof(int32_t) + 3*sizeof(double));
+        for(uint32_t i=0; i<NRP; i++) {
+            TRoboticPositioner *RP = new TRoboticPositioner();
+            RPs.push_back(RP);
+            TActuator *A = RP->getActuator();
+            TArm *Arm = A->getArm();
+
+            int Id = getInt(C);
+            double x0 = getDouble(C);
+            double y0 = getDouble(C);
+            double thetaO1 = getDouble(C);
+            A->setOrigins(Id, x0, y0, thetaO1);
+
+            TContourFigureList Contour;
+            try {
+                begin = C.p;
+                getContour(Contour, C);
+                data.assign(begin, C.p);
+                Source = findTemplateSource(Sources.Contours____, data);
+                if(Source != NULL)
+                    Arm->shareContour____(Source->getActuator()->getArm());
+                else {
+                    Arm->setContour____(Contour);
+                    Sources.Contours____[data] = RP;
+                }
+                Destroy(Contour);
+                begin = C.p;
+                getContour(Contour, C);
+                data.assign(begin, C.p);
+                Source = findTemplateSource(Sources.Contours_, data);
+                if(Source != NULL)
+                    A->getBarrier()->shareContour_(Source->getActuator()->getBarrier());
+                else {
+                    A->getBarrier()->setContour_(Contour);
+                    Sources.Contours_[data] = RP;
+                }
+            } catch(...) {
+                Destroy(Contour);
+                throw;
+            }
+            Destroy(Contour);
+
+            //set the instance in the same order than readInstance
+            double L01 = getDouble(C);
+            double theta_1min = getDouble(C);
+            double theta_1max = getDouble(C);
+            double theta_1 = getDouble(C);
+            double theta_O3o = getDouble(C);
+            double L12 = getDouble(C);
+            double L13 = getDouble(C);
+            double theta__O3 = getDouble(C);
+            double R3 = getDouble(C);
+            double theta___3min = getDouble(C);
+            double theta___3max = getDouble(C);
+            double theta___3 = getDouble(C);
+            double SPMmin = getDouble(C);
+            double SPMsim = getDouble(C);
+            int PAkd = getInt(C);
+            A->setL01(L01);
+            Arm->setTemplate(L12, L13, theta__O3, R3);
+            Arm->setOrientationRadians(theta___3min, theta___3max, theta___3);
+            A->setSPMmin(SPMmin);
+            A->setSPMsim(SPMsim);
+            A->setPAkd(TKnowledgeDegree(PAkd));
+            A->setOrientationRadians(theta_1min, theta_1max, theta_1, theta_O3o);
+
+            double aux = getDouble(C);
+            RP->CMF.getSF1()->setvmaxabs(aux);
+            aux = getDouble(C);
+            RP->CMF.getSF2()->setvmaxabs(aux);
+            aux = getDouble(C);
+            RP->CMF.getRF1()->setvmaxabs(aux);
+            aux = getDouble(C);
+            RP->CMF.getRF2()->setvmaxabs(aux);
+            aux = getDouble(C);
+            RP->CMF.getRF1()->setamaxabs(aux);
+            aux = getDouble(C);
+            RP->CMF.getRF2()->setamaxabs(aux);
+            int aux_i = getInt(C);
+            RP->CMF.setMFM(TMotionFunctionMode(aux_i));
+            aux_i = getInt(C);
+            RP->CMF.setSSM(TSquareSynchronismMode(aux_i));
+            aux_i = getInt(C);
+            RP->CMF.setRSM(TRampSynchronismMode(aux_i));
+            aux_i = getInt(C);
+            RP->CMF.setId1(aux_i);
+            aux_i = getInt(C);
+            RP->CMF.setId2(aux_i);
+
+            aux = getDouble(C);
+            RP->setEo(aux);
+            aux = getDouble(C);
+            RP->setEp(aux);
+            aux = getDouble(C);
+            RP->setTstop(aux);
+            aux = getDouble(C);
+            RP->setTshiff(aux);
+            aux = getDouble(C);
+            RP->setSPMadd(aux);
+            RP->Disabled = getInt(C) != 0;
+            aux = getDouble(C);
+            RP->setFaultProbability(aux);
+            aux_i = getInt(C);
+            RP->FaultType = TFaultType(aux_i);
+
+            //F1 and F2 must be set after the instance
+            TFunction F;
+            begin = C.p;
+            getFunction(F, C);
+            data.assign(begin, C.p);
+            Source = findTemplateSource(Sources.F1s, data);
+            if(Source != NULL)
+                A->shareF(Source->getActuator());
+            else {
+                A->setF(F);
+                Sources.F1s[data] = RP;
+            }
+            begin = C.p;
+            getFunction(F, C);
+            data.assign(begin, C.p);
+            Source = findTemplateSource(Sources.F2s, data);
+            if(Source != NULL)
+                Arm->shareF(Source->getActuator()->getArm());
+            else {
+                Arm->setF(F);
+                Sources.F2s[data] = RP;
+            }
+        }
+
+        //assimilated properties of the RPs
+        vector<vector<int> > AdjacentEAs(NRP), AdjacentRPs(NRP);
+        vector<vector<double> > SafeParameters(NRP);
+        for(uint32_t i=0; i<NRP; i++) {
+            uint32_t n = getCount(C, sizeof(uint32_t));
+            for(uint32_t j=0; j<n; j++)
+                AdjacentEAs[i].push_back(getIndex(C, NEA));
+            n = getCount(C, sizeof(uint32_t));
+            for(uint32_t j=0; j<n; j++)
+                AdjacentRPs[i].push_back(getIndex(C, NRP));
+            for(int k=0; k<6; k++)
+                SafeParameters[i].push_back(getDouble(C));
+        }
+
+        //assimilated properties of the EAs
+        vector<vector<int> > AdjacentRPsOfEAs(NEA);
+        for(uint32_t i=0; i<NEA; i++) {
+            uint32_t n = getCount(C, sizeof(uint32_t));
+            for(uint32_t j=0; j<n; j++)
+                AdjacentRPsOfEAs[i].push_back(getIndex(C, NRP));
+        }
+
+        //map of the RPs
+        double xmin = getDouble(C);
+        double xmax = getDouble(C);
+        double ymin = getDouble(C);
+        double ymax = getDouble(C);
+        uint32_t I = getCount(C, sizeof(uint32_t));
+        uint32_t J = getCount(C, sizeof(uint32_t));
+        if(size_t(C.end - C.p)/sizeof(uint32_t)/(J > 0 ? J : 1) < I)
+            throw EImproperFileLoadedValue("improper number of cells in snapshot");
+        vector<vector<int> > Cells(I*J);
+        for(uint32_t k=0; k<Cells.size(); k++) {
+            uint32_t n = getCount(C, sizeof(uint32_t));
+            for(uint32_t l=0; l<n; l++)
+                Cells[k].push_back(getIndex(C, NRP));
+        }
+
+        if(C.p != C.end)
+            throw EImproperFileLoadedValue("unexpected data at the end of snapshot");
+
+        //assign the objects to the FMM
+        FMM.Destroy();
+        assigned = true;
+        for(unsigned int i=0; i<EAs.size(); i++)
+            FMM.EAL.Add(EAs[i]);
+        for(unsigned int i=0; i<RPs.size(); i++)
+            FMM.RPL.Add(RPs[i]);
+        FMM.RPL.setTolerance(PAem, Pem);
+
+        //assimilate the FMM as TFiberMOSModel::assimilate, but restoring
+        //the adjacents, the safe parameters and the map instead of determine them
+        FMM.EAL.assimilate();
+        FMM.RPL.calculateSPMcomponents();
+        for(uint32_t i=0; i<NRP; i++) {
+            TActuator *A = RPs[i]->getActuator();
+            for(unsigned int j=0; j<AdjacentEAs[i].size(); j++)
+                A->AdjacentEAs.Add(TAdjacentEA(EAs[AdjacentEAs[i][j]]));
+            for(unsigned int j=0; j<AdjacentRPs[i].size(); j++)
+                A->AdjacentRPs.Add(TAdjacentRP(RPs[AdjacentRPs[i][j]]));
+            const vector<double>& SP = SafeParameters[i];
+            A->setSafeParameters(SP[0], SP[1], SP[2], SP[3], SP[4], SP[5]);
+        }
+        FMM.RPL.calculateSizingParameters();
+        FMM.RPL.calculateAreaParameters();
+        FMM.RPL.setMapInterval(xmin, xmax, ymin, ymax);
+        FMM.RPL.setMapDimensions(I, J);
+        FMM.RPL.setMapCellsIndices(Cells);
+        for(uint32_t i=0; i<NEA; i++)
+            for(unsigned int j=0; j<AdjacentRPsOfEAs[i].size(); j++)
+                EAs[i]->AdjacentRPs.Add(RPs[AdjacentRPsOfEAs[i][j]]);
+    }
+    catch(...) {
+        if(assigned)
+            FMM.Destroy();
+        else {
+            for(unsigned int i=0; i<EAs.size(); i++)
+                delete EAs[i];
+            for(unsigned int i=0; i<RPs.size(); i++)
+                delete RPs[i];
+        }
+        throw;
+    }
+}
+
+//read a snapshot of a Fiber MOS Model from a file
+void readSnapshot(TFiberMOSModel& FMM, const string& path)
+{
+    try {
+        TMappedFile file(path);
+
+        //check the header
+        TSnapshotHeader H;
+        if(file.size < sizeof(H))
+            throw EImproperFileLoadedValue("file isn't a snapshot of a FMM");
+        memcpy(&H, file.data, sizeof(H));
+        checkSnapshotHeader(H);
+        if(H.size != file.size - sizeof(H))
+            throw EImproperFileLoadedValue("improper size of snapshot");
+        const char *payload = file.data + sizeof(H);
+        if(fnv1a(FNV1A_BASIS, payload, H.size) != H.checksum)
+            throw EImproperFileLoadedValue("corrupted snapshot");
+
+        //decode the payload
+        TSnapshotCursor C = {payload, payload + H.size};
+        decodeSnapshot(FMM, C);
+    }
+    catch(ECantComplete& E) {
+        E.Message.Insert(1, "reading snapshot of FMM from file '"+path+"': ");
+        throw;
+    }
+    catch(Exception& E) {
+        throw EImproperFileLoadedValue("reading snapshot of FMM from file '"+path+"': " + E.Message.str);
+    }
+}
+
+//determine if a snapshot file is valid for this version
+//and was written from the actual content of a directory
+bool snapshotIsUpToDate(const string& path, const string& dir)
+{
+    TSnapshotHeader H;
+    if(!readSnapshotHeader(H, path))
+        return false;
+    try {
+        return H.source == checksumInstanceDir(dir);
+    }
+    catch(Exception&) {
+        return false;
+    }
+}
+
+//read an instance of a Fiber MOS Model from a directory
+//through its snapshot
+void readInstanceFromDirUsingSnapshot(TFiberMOSModel& FMM, const string& dir)
+{
+    uint64_t source;
+    try {
+        source = checksumInstanceDir(dir);
+    }
+    catch(ECantComplete& E) {
+        E.Message.Insert(1, "reading instance of FMM: ");
+        throw;
+    }
+
+    //the snapshot is searched next to the directory,
+    //and in the cache of the user
+    string paths[2] = {getSnapshotPath(dir), getSnapshotCachePath(dir)};
+
+    //if a snapshot is up to date, read it
+    for(int i=0; i<2; i++) {
+        TSnapshotHeader H;
+        if(paths[i].length() > 0 && readSnapshotHeader(H, paths[i]) && H.source == source) {
+            try {
+                readSnapshot(FMM, paths[i]);
+                return;
+            }
+            catch(Exception&) {
+                //the snapshot is corrupted: it will be rewritten
+            }
+        }
+    }
+
+    //read the directory and (re)write the snapshot
+    readInstanceFromDir(FMM, dir);
+    for(int i=0; i<2; i++) {
+        if(paths[i].length() <= 0)
+            continue;
+        try {
+            if(i > 0)
+                mkpath(paths[i].substr(0, paths[i].find_last_of('/')));
+            writeSnapshotTagged(paths[i], FMM, source);
+            return;
+        }
+        catch(Exception&) {
+            //the snapshot is only a cache, so the instance directory
+            //can be in a read-only location: try the cache of the user
+        }
+    }
+}
+
 //---------------------------------------------------------------------------
 //FILE FUNCTIONS FOR Fiber Connection Models:
 
@@ -459,10 +1409,6 @@ void readInstanceFromDir(TFiberMOSModel& FMM, const string& dir)
 void writeInstanceToDir(const string& dir, const TFiberConnectionModel& FCM)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         string str;
         string path;
         string aux;
@@ -487,10 +1433,6 @@ void writeInstanceToDir(const string& dir, const TFiberConnectionModel& FCM)
 void readInstanceFromDir(TFiberConnectionModel& FCM, const string& dir)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //lee la tabla de conexiones de la pseudoslit en una cadena de texto
         string str;
         strReadFromFile(str, dir+"/Connections.txt");
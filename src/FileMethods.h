@@ -28,6 +28,8 @@
 #include "FiberMOSModel.h"
 #include "FiberConnectionModel.h"
 
+#include <map>
+
 //---------------------------------------------------------------------------
 
 //namespace for models
@@ -41,6 +43,29 @@ namespace Models {
 //from a directory
 void readInstanceFromDir(TRoboticPositioner&, const string& dir);
 
+//RPs from which share the templates read, indexed by the read data
+typedef map<string, TRoboticPositioner*> TTemplateSources;
+
+//sources of the templates of the RPs read from files:
+//the RPs read from files with the same content share
+//the same templates, instead of parse them again
+class TRPTemplateSources {
+public:
+    TTemplateSources Contours____;
+    TTemplateSources Contours_;
+    TTemplateSources F1s;
+    TTemplateSources F2s;
+};
+
+//read an instance of a RP from a directory, sharing the templates
+//of the RPs read previously from files with the same content
+//  Sources: RPs whose templates can be shared, where the RP is annotated
+//      as source of its new templates when all files have been read
+//if the files can't be read or contains improper values:
+//  throw an exception and the RP can remain partially modified
+void readInstanceFromDir(TRoboticPositioner&, const string& dir,
+                         TRPTemplateSources& Sources);
+
 //---------------------------------------------------------------------------
 //FILE FUNCTIONS FOR EXCLUSION AREA LIST:
 //---------------------------------------------------------------------------
@@ -75,6 +100,55 @@ void writeInstanceToDir(const string& dir, const TFiberMOSModel&);
 //from a directory
 void readInstanceFromDir(TFiberMOSModel&, const string& dir);
 
+//---------------------------------------------------------------------------
+//SNAPSHOT FUNCTIONS FOR Fiber MOS Models:
+//---------------------------------------------------------------------------
+
+//A snapshot is a versioned binary image of a Fiber MOS Model assimilated
+//(adjacents, safe parameters and map included), tagged with the checksum of
+//the directory from which the instance was read. Reading a snapshot avoids
+//the parsing of the text files and the assimilation by simulation.
+
+//calculate the checksum of the content of an instance directory
+//(relative path and content of all regular files, recursively,
+//except the snapshot files)
+//if the directory can't be read:
+//  throw ECantComplete
+unsigned long long checksumInstanceDir(const string& dir);
+
+//get the path of the snapshot of an instance directory:
+//  <dir>.snapshot
+string getSnapshotPath(const string& dir);
+//get the path of the snapshot of an instance directory in the cache
+//of the user, used when the directory is in a read-only location:
+//  $XDG_CACHE_HOME/megara-fmpt/<name>-<hash of absolute dir>.snapshot
+//  (XDG_CACHE_HOME by default: $HOME/.cache)
+//if the cache or the directory can't be determined, return ""
+string getSnapshotCachePath(const string& dir);
+
+//write a snapshot of a Fiber MOS Model in a file,
+//tagged with the checksum of the directory of its instance
+void writeSnapshot(const string& path, const TFiberMOSModel&,
+                   const string& dir);
+//read a snapshot of a Fiber MOS Model from a file
+//if the file can't be read:
+//  throw ECantComplete
+//if the file isn't a valid snapshot of this version:
+//  throw EImproperFileLoadedValue
+void readSnapshot(TFiberMOSModel&, const string& path);
+
+//determine if a snapshot file is valid for this version
+//and was written from the actual content of a directory
+bool snapshotIsUpToDate(const string& path, const string& dir);
+
+//read an instance of a Fiber MOS Model from a directory
+//through its snapshot:
+//  if the snapshot next to the directory or in the cache of the user
+//  is up to date, read the snapshot;
+//  else read the directory and try (re)write the snapshot next to
+//  the directory, or in the cache of the user.
+void readInstanceFromDirUsingSnapshot(TFiberMOSModel&, const string& dir);
+
 //---------------------------------------------------------------------------
 //FILE FUNCTIONS FOR Fiber Connection Models:
 //---------------------------------------------------------------------------
@@ -42,6 +42,66 @@ namespace Operators {
 //en los métodos de esa clase al pasar vectores de enteros como argumento
 static TVector<int> VI(1);
 
+//Construye las celdas de anchura uniforme de una secuencia creciente
+//de valores U[0] < U[1] < ... < U[n-1], indicando para cada celda
+//el primer valor U[i], con i en [1, n-1], que alcanza la celda.
+template <class V> static void buildCells(std::vector<int>& Cells,
+                                          double& Min, double& Scale,
+                                          const V& U, int n)
+{
+    int M = 2*(n - 1); //número de celdas
+    Min = U[0];
+    Scale = M/(U[n-1] - U[0]);
+
+    Cells.resize(M);
+    int i = 1;
+    for(int k=0; k<M; k++) {
+        double u = Min + k/Scale;
+        while(i < n-1 && U[i] < u)
+            i++;
+        Cells[k] = i;
+    }
+}
+//Busca el primer valor U[i] >= u, con i en [1, n-1],
+//partiendo del valor indicado por la celda que contiene u.
+template <class V> static int searchCells(const std::vector<int>& Cells,
+                                          double Min, double Scale,
+                                          const V& U, int n, double u)
+{
+    //determina la celda que contiene u
+    double c = (u - Min)*Scale;
+    int k;
+    if(!(c > 0))
+        k = 0;
+    else if(c >= double(Cells.size()))
+        k = int(Cells.size()) - 1;
+    else
+        k = int(c);
+
+    //corrige el redondeo de los límites de las celdas
+    int i = Cells[k];
+    while(i > 1 && U[i-1] >= u)
+        i--;
+    while(i < n-1 && U[i] < u)
+        i++;
+
+    return i;
+}
+
+//copia la forma compilada de otra función
+void TFunction::copyCompiled(const TFunction& F)
+{
+    p_Compiled = F.p_Compiled;
+    p_XCells = F.p_XCells;
+    p_XCellsMin = F.p_XCellsMin;
+    p_XCellsScale = F.p_XCellsScale;
+    p_YSign = F.p_YSign;
+    p_U = F.p_U;
+    p_UCells = F.p_UCells;
+    p_UCellsMin = F.p_UCellsMin;
+    p_UCellsScale = F.p_UCellsScale;
+}
+
 //activa o desactiva la periodicidad afectando al los métodos de evaluación
 //de la función.
 void TFunction::setPeriodic(bool Periodic)
@@ -55,6 +115,7 @@ void TFunction::setPeriodic(bool Periodic)
 
     //asigna el nuevo valor
     p_Periodic = Periodic;
+    Compile();
 }
 
 //Establece o cambia el periodo T. Si la función es periódica,
@@ -67,6 +128,7 @@ void TFunction::setT(double T)
         throw EImproperArgument("sample point dont belong to [0, T)");
 
     p_T = T;
+    invalidateCompiled();
 }
 
 //---------------------------------------------------------------------------
@@ -88,6 +150,9 @@ void TFunction::Set(const TVector<double>& X, const TVector<double>& Y)
     p_X = X;
     p_Y = Y;
     p_Count = X.getCount();
+
+    //construye la forma compilada
+    Compile();
 }
 
 double TFunction::getX(int i) const
@@ -161,6 +226,7 @@ void TFunction::setX(int i, double x)
     }
 
     p_X[i] = x; //asigna la abcisa al punto indicado
+    invalidateCompiled();
 }
 
 double TFunction::getY(int i) const
@@ -207,6 +273,7 @@ void TFunction::setY(int i, double y)
     }
 
     p_Y[i] = y; //asigna la ordenada al punto indicado
+    invalidateCompiled();
 }
 
 TDoublePoint TFunction::getP(int i) const
@@ -279,6 +346,7 @@ void TFunction::setP(int i, TDoublePoint p)
     //asigna el punto
     p_X[i] = p.x;
     p_Y[i] = p.y;
+    invalidateCompiled();
 }
 
 //--------------------------------------------------------------------------
@@ -433,6 +501,7 @@ void  TFunction::ReadPoints(TFunction *F, const AnsiString &S,int &i)
         TFunction t_F;
         for(int i=0; i<Pairs.getCount(); i++)
             t_F.Add(Pairs[i].x, Pairs[i].y);
+        t_F.Compile();
 
         //copia la función
         *F = t_F;
@@ -487,7 +556,9 @@ void  TFunction::ReadTable(TFunction *F, const AnsiString &S,
 //constructor de funciones aperiódicas
 TFunction::TFunction(int Capacity) :
     p_Periodic(false), p_T(0),
-    p_Count(0), p_X(1), p_Y(1)
+    p_Count(0), p_X(1), p_Y(1),
+    p_Compiled(false), p_XCells(), p_XCellsMin(0), p_XCellsScale(0),
+    p_YSign(0), p_U(), p_UCells(), p_UCellsMin(0), p_UCellsScale(0)
 {
     //comprueba las precondiciones
     if(Capacity < 1)
@@ -500,7 +571,9 @@ TFunction::TFunction(int Capacity) :
 //Constructor de funciones T-periódicas
 TFunction::TFunction(double T, int Capacity) :
     p_Periodic(true),
-    p_Count(0), p_X(1), p_Y(1)
+    p_Count(0), p_X(1), p_Y(1),
+    p_Compiled(false), p_XCells(), p_XCellsMin(0), p_XCellsScale(0),
+    p_YSign(0), p_U(), p_UCells(), p_UCellsMin(0), p_UCellsScale(0)
 {
     //El periodo debe ser positivo
     if(Capacity < 1 || T <= 0)
@@ -526,6 +599,7 @@ void TFunction::Copy(const TFunction *F)
     p_Count = F->p_Count;
     p_X = F->p_X;
     p_Y = F->p_Y;
+    copyCompiled(*F);
 }
 void TFunction::Copy(const TFunction& F)
 {
@@ -536,6 +610,7 @@ void TFunction::Copy(const TFunction& F)
     p_Count = F.p_Count;
     p_X = F.p_X;
     p_Y = F.p_Y;
+    copyCompiled(F);
 }
 
 //clona una función
@@ -552,6 +627,7 @@ void TFunction::Clone(const TFunction *F)
     p_Count = F->p_Count;
     p_X.Clone(F->p_X);
     p_Y.Clone(F->p_Y);
+    copyCompiled(*F);
 }
 void TFunction::Clone(const TFunction &F)
 {
@@ -562,10 +638,12 @@ void TFunction::Clone(const TFunction &F)
     p_Count = F.p_Count;
     p_X.Clone(F.p_X);
     p_Y.Clone(F.p_Y);
+    copyCompiled(F);
 }
 
 //construye un clon de una función
-TFunction::TFunction(const TFunction *F)
+TFunction::TFunction(const TFunction *F) :
+    p_Compiled(false), p_YSign(0)
 {
     //el puntro F debería pauntar a una función contruida
     if(F == NULL)
@@ -583,6 +661,7 @@ void TFunction::Clear(void)
     p_X.Clear();
     p_Y.Clear();
     p_Count = 0;
+    invalidateCompiled();
 }
 
 //añade un nuevo punto devolviendo la posición de inserción
@@ -621,6 +700,7 @@ int TFunction::Add(double x, double y)
     }
 
     p_Count++; //contabiliza el nuevo punto
+    invalidateCompiled();
 
     return i + p_Count*ncycles; //devuelve la posición de inserción
 }
@@ -641,6 +721,7 @@ void TFunction::PushLast(double x, double y)
 
         p_X.PushLast(x);
         p_Y.PushLast(y);
+        invalidateCompiled();
     }
     else //si la función está vacía no se puede empujar
         throw EImproperCall("empty function");
@@ -656,6 +737,7 @@ void TFunction::DelFirst(int n)
     p_X.DelFirst(n);
     p_Y.DelFirst(n);
     p_Count -= n;
+    invalidateCompiled();
 }
 
 //elimina el punto i-ésimo p.a. [0, Count-1] (si aperiódica)
@@ -675,6 +757,7 @@ void TFunction::Delete(int i)
     p_X.Delete(i);
     p_Y.Delete(i);
     p_Count--;
+    invalidateCompiled();
 }
 
 //--------------------------------------------------------------------------
@@ -692,6 +775,9 @@ void TFunction::Random(int n, double ymin, double ymax)
     else
         for(int i=0; i<n; i++)
             Add(double(i), RandomUniform(ymin, ymax));
+
+    //construye la forma compilada
+    Compile();
 }
 
 //Genera n puntos con imagen igual a cero.
@@ -706,6 +792,9 @@ void TFunction::Zeros(int n)
     } else
         for(int i=0; i<n; i++)
             Add(double(i), 0);
+
+    //construye la forma compilada
+    Compile();
 }
 
 //--------------------------------------------------------------------------
@@ -717,6 +806,7 @@ TFunction& TFunction::operator=(const TFunction &F)
     p_Count = F.p_Count;
     p_X = F.p_X;
     p_Y = F.p_Y;
+    copyCompiled(F);
 
     //no vacia los vectores porque podrían asignarse a sí mismos
 
@@ -753,6 +843,7 @@ void TFunction::SortInc(void)
 {
     if(p_Y.getCount() > 2)
         p_Y.SortInc(0, p_Y.getCount()-1);
+    invalidateCompiled();
 }
 
 //--------------------------------------------------------------------------
@@ -787,11 +878,29 @@ double TFunction::Image(double x) const
         if(!BelongToDomain(x))
             throw EImproperArgument("x dont belong to Domain");
 
+    //si la función está compilada, busca el segmento en su celda
+    if(p_Compiled) {
+        int i = searchCells(p_XCells, p_XCellsMin, p_XCellsScale, p_X, p_Count, x);
+        if(x == p_X[i])
+            return p_Y[i];
+        if(x == p_X[i-1])
+            return p_Y[i-1];
+
+        //interpola x entre los vértices del segmento
+        double x1 = p_X[i-1], y1 = p_Y[i-1];
+        double x2 = p_X[i], y2 = p_Y[i];
+        return y1 + (x - x1)*(y2 - y1)/(x2 - x1);
+    }
+
     //busca el primer X[i]>=x
     int i = p_X.FirstUpperOrEqualTo(x);
     //si es periódica, i indicará un punto en [0, Count]
     //si no, i índicará un punto en [0, Count-1]
 
+    //si x coincide con una abcisa, devuelve su ordenada
+    if(i < p_Count && x == p_X[i])
+        return p_Y[i];
+
     //determina los vértices del segmento que contiene el punto
     double x1, y1; //coordenadas del punto origen del segmento
     double x2, y2; //coordenadas del punto final del segmento
@@ -1128,6 +1237,74 @@ void TFunction::Inverse(const TFunction &F)
             //añadelacoordenada transpuesta
             Add(x, F.p_X[i]);
     }
+
+    //construye la forma compilada
+    Compile();
+}
+
+//construye la forma compilada si la función es aperiódica,
+//tiene al menos dos puntos y es monótona
+void TFunction::Compile(void)
+{
+    //descarta la forma compilada previa
+    invalidateCompiled();
+
+    //la forma compilada requiere que haya al menos un segmento
+    if(p_Periodic || p_Count < 2)
+        return;
+
+    //determina la monotonía de las ordenadas
+    bool increasing = true;
+    bool decreasing = true;
+    bool strict = true;
+    for(int i=1; i<p_Count; i++) {
+        if(p_Y[i] < p_Y[i-1])
+            increasing = false;
+        else if(p_Y[i] > p_Y[i-1])
+            decreasing = false;
+        else
+            strict = false;
+    }
+    //si no es monótona no la compila
+    if(!increasing && !decreasing)
+        return;
+
+    //construye las celdas de abcisas
+    buildCells(p_XCells, p_XCellsMin, p_XCellsScale, p_X, p_Count);
+    p_Compiled = true;
+
+    //si es estrictamente monótona, construye las celdas de ordenadas
+    if(strict) {
+        p_YSign = increasing ? 1 : -1;
+        p_U.resize(p_Count);
+        for(int i=0; i<p_Count; i++)
+            p_U[i] = p_YSign*p_Y[i];
+        buildCells(p_UCells, p_UCellsMin, p_UCellsScale, p_U, p_Count);
+    }
+}
+
+//retorna la abcisa cuya imagen es y, en tiempo constante
+double TFunction::InverseImage(double y) const
+{
+    //comprueba las precondiciones
+    if(p_YSign == 0)
+        throw EImproperCall("function should be compiled and strictly monotone");
+    double u = p_YSign*y;
+    if(!(p_U[0] <= u && u <= p_U[p_Count-1]))
+        throw EImproperArgument("y dont belong to the image of the function");
+
+    //busca el segmento en su celda
+    int i = searchCells(p_UCells, p_UCellsMin, p_UCellsScale, p_U, p_Count, u);
+    if(y == p_Y[i])
+        return p_X[i];
+    if(y == p_Y[i-1])
+        return p_X[i-1];
+
+    //interpola y desde el vértice de ordenada menor,
+    //igual que la evaluación de la función inversa
+    int a = (p_YSign > 0) ? i-1 : i;
+    int b = (p_YSign > 0) ? i : i-1;
+    return p_X[a] + (y - p_Y[a])*(p_X[b] - p_X[a])/(p_Y[b] - p_Y[a]);
 }
 
 //asigna la función normalizada de F
@@ -1146,6 +1323,9 @@ void TFunction::Normalized(const TFunction &F)
             //añade el punto d emuestreo normalizado
             Add(F.p_X[i], F.p_Y[i]/ymax);
     }
+
+    //construye la forma compilada
+    Compile();
 }
 
 //actualiza las ordenadas
@@ -1167,6 +1347,7 @@ void TFunction::OrdinatesMin(TFunction &F)
     for(int i=0; i<p_Count; i++)
         //asigna la ordenada mínima
         p_Y[i] = min(p_Y[i], F.p_Y[i]);
+    Compile();
 }
 //actualiza las ordenadas
 //      Y[i] = Y[i]*((n-1)/n) + F.Y[i]/n
@@ -1191,6 +1372,7 @@ void TFunction::OrdinatesAve(TFunction &F, int n)
     for(int i=0; i<p_Count; i++)
         //asigna la ordenada mínima
         p_Y[i] = p_Y[i]*((n-1)/n) + F.p_Y[i]/n;
+    Compile();
 }
 //actualiza las ordenadas
 //      Y[i] = max(Y[i], F.Y[i])
@@ -1211,6 +1393,7 @@ void TFunction::OrdinatesMax(TFunction &F)
     for(int i=0; i<p_Count; i++)
         //asigna la ordenada máxima
         p_Y[i] = max(p_Y[i], F.p_Y[i]);
+    Compile();
 }
 
 //---------------------------------------------------------------------------
@@ -27,6 +27,8 @@
 
 #include "Vector.h"
 
+#include <vector>
+
 //---------------------------------------------------------------------------
 
 using namespace Lists;
@@ -69,6 +71,40 @@ protected:
     TVector<double> p_X; //vector de ordenadas
     TVector<double> p_Y; //vector de abcisas
 
+    //FORMA COMPILADA:
+
+    //The compiled form of a monotone aperiodic function divides the
+    //interval [XFirst, XLast] in cells of uniform width, and indicates
+    //for each cell the first sample point which reach it, so the segment
+    //containing x is found in constant time. When the function is
+    //strictly monotone, the image is divided in the same way, to
+    //evaluate the inverse in constant time.
+    //
+    //The compiled form is built by the methods which assign all sample
+    //points (Set, Inverse and the setters in text format), and it is
+    //discarded by the methods which modify some sample point.
+
+    //indica si la forma compilada es válida
+    bool p_Compiled;
+    //primer punto que alcanza cada celda de abcisas
+    std::vector<int> p_XCells;
+    //origen y celdas por unidad de las celdas de abcisas
+    double p_XCellsMin, p_XCellsScale;
+    //signo de la monotonía estricta: 1 (creciente), -1 (decreciente)
+    //ó 0 si la forma compilada no contiene la inversa
+    int p_YSign;
+    //ordenadas multiplicadas por YSign, que quedan en orden creciente
+    std::vector<double> p_U;
+    //primer punto que alcanza cada celda de ordenadas
+    std::vector<int> p_UCells;
+    //origen y celdas por unidad de las celdas de ordenadas
+    double p_UCellsMin, p_UCellsScale;
+
+    //descarta la forma compilada
+    void invalidateCompiled(void) {p_Compiled = false; p_YSign = 0;}
+    //copia la forma compilada de otra función
+    void copyCompiled(const TFunction&);
+
 public:
     AnsiString Label; //texto descriptivo de la función
     bool getPeriodic(void) const {return p_Periodic;}
@@ -94,16 +130,16 @@ public:
 
     //primera abcisa
     double getXFirst(void) const {return p_X.getFirst();}
-    void setXFirst(double XFirst) {p_X.setFirst(XFirst);}
+    void setXFirst(double XFirst) {p_X.setFirst(XFirst); invalidateCompiled();}
     //úñtima abcisa
     double getXLast(void) const {return p_X.getLast();}
-    void setXLast(double XLast) {p_X.setLast(XLast);}
+    void setXLast(double XLast) {p_X.setLast(XLast); invalidateCompiled();}
     //primera ordenada
     double getYFirst(void) const {return p_Y.getFirst();}
-    void setYFirst(double YFirst) {p_Y.setFirst(YFirst);}
+    void setYFirst(double YFirst) {p_Y.setFirst(YFirst); invalidateCompiled();}
     //última ordenada
     double getYLast(void) const {return p_Y.getLast();}
-    void setYLast(double YLast) {p_Y.setLast(YLast);}
+    void setYLast(double YLast) {p_Y.setLast(YLast); invalidateCompiled();}
     //odenada mínima
     double getYMin(void) const {return p_Y.getMin();}
     //ordenada máxima
@@ -194,6 +230,7 @@ public:
     //devuelve verdadero si x p.a. dominio de definición de la función
     bool BelongToDomain(double x) const;
     //retorna la imagen de x p.a. Dom{x}
+    //si x coincide con una abcisa, retorna exactamente su ordenada
     double Image(double x) const;
     //busca el punto (virtual) que contiene la abcisa x
     bool Find(double x, int &i) const;
@@ -238,6 +275,20 @@ public:
     //asigna la función normalizada de F
     void Normalized(const TFunction &F);
 
+    //construye la forma compilada si la función es aperiódica,
+    //tiene al menos dos puntos y es monótona
+    void Compile(void);
+    //indica si la función está compilada, en cuyo caso
+    //la evaluación de Image tiene complejidad constante
+    bool getCompiled(void) const {return p_Compiled;}
+    //indica si la forma compilada contiene la inversa,
+    //lo que requiere que la función sea estrictamente monótona
+    bool getCompiledInverse(void) const {return p_YSign != 0;}
+    //retorna la abcisa cuya imagen es y, en tiempo constante
+    //si y coincide con una ordenada, retorna exactamente su abcisa
+    //si la forma compilada no contiene la inversa lanza EImproperCall
+    double InverseImage(double y) const;
+
     //actualiza las ordenadas
     //      Y[i] = min(Y[i], F.Y[i])
     //las abcisas debén coincidir
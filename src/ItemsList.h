@@ -231,6 +231,17 @@ public:
     //clona una lista de elementos
     void Clone(const TItemsList<T>&);
 
+#ifdef FMPT_MOVE_SEMANTICS
+    //construye una lista tomando los elementos de otra,
+    //sin copiarlos, dejando la otra lista vacía
+    TItemsList(TItemsList&&);
+    //toma los elementos de una lista sin copiarlos
+    TItemsList<T>& operator=(TItemsList<T>&& L) {Items.swap(L.Items); return *this;}
+#endif
+
+    //intercambia los elementos con otra lista sin copiarlos
+    void swap(TItemsList<T>& L) {Items.swap(L.Items);}
+
     //libera la memoria ocupada por la lista de elementos
     ~TItemsList();
 
@@ -270,6 +281,13 @@ public:
 
     //añade un elemento al final de la lista
     inline void Add(const T&);
+#ifdef FMPT_MOVE_SEMANTICS
+    //añade un elemento al final de la lista moviéndolo
+    inline void Add(T&& item) {Items.AddLast(std::move(item));}
+    //construye un elemento al final de la lista con los argumentos indicados
+    template <class... Args> T& Emplace(Args&&... args) {
+        return Items.EmplaceLast(std::forward<Args>(args)...);}
+#endif
     //añade los elementos de una lista
     void Add(TItemsList<T>&);
     //añade los elementos [i1, i2] de L en esta lista
@@ -511,8 +529,8 @@ template <class T> void  TItemsList<T>::ReadSeparatedForBuiltItems(TItemsList<T>
         throw;
     }
 
-    //clona la lista tampón
-    L->Items.Clone(Items);
+    //asigna la lista tampón sin copiarla
+    L->Items.swap(Items);
 }
 
 //imprime una lista en una cadena de texto
@@ -1311,6 +1329,21 @@ template <class T> TItemsList<T>::TItemsList(const TItemsList& ItemList) /*#:
     Read = ItemList.Read;
 }
 
+#ifdef FMPT_MOVE_SEMANTICS
+//construye una lista tomando los elementos de otra,
+//sin copiarlos, dejando la otra lista vacía
+template <class T> TItemsList<T>::TItemsList(TItemsList&& ItemList) :
+    Items(std::move(ItemList.Items))
+{
+    //apunta a las mismas funciones externas
+    Compare = ItemList.Compare;
+    Evaluate = ItemList.Evaluate;
+    Assign = ItemList.Assign;
+    Print = ItemList.Print;
+    Read = ItemList.Read;
+}
+#endif
+
 //clona una lista de elementos
 template <class T> void TItemsList<T>::Clone(const TItemsList<T>& ItemsList)
 {
@@ -1540,13 +1573,13 @@ template <class T> void TItemsList<T>::Delete(int i)
     if(i < getCount()/2) { //el elemento está en la primera mitad
         //Desplaza los elementos
         for(int j=i; j>0; j--)
-            Items[j] = Items[j-1];
+            Items[j] = FMPT_MOVE(Items[j-1]);
         //libera el elemento
         Items.DelFirst();
     } else { //el elemento está en la segunda mitad
         //Desplaza los elementos
         for(int j=i+1; j<getCount(); j++)
-            Items[j-1] = Items[j];
+            Items[j-1] = FMPT_MOVE(Items[j]);
         //libera el elemento
         Items.DelLast();
     }
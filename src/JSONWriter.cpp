@@ -0,0 +1,422 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: JSONWriter.cpp
+//Content: writer of JSON texts in streams
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "JSONWriter.h"
+#include "Exceptions.h"
+#include "VCLemu.h"
+
+#include <math.h> //isfinite
+
+//---------------------------------------------------------------------------
+
+//namespace for strings
+namespace Strings {
+
+//---------------------------------------------------------------------------
+
+//maximun length of the arrays written in a line (like Json::StyledWriter)
+#define JSON_RIGHT_MARGIN 74
+
+//---------------------------------------------------------------------------
+//TJSONWriter:
+//---------------------------------------------------------------------------
+
+//PRIVATE:
+
+//write a string in the stream
+void TJSONWriter::write(const string& str)
+{
+    if(str.length() > 0) {
+        p_os.write(str.data(), str.length());
+        p_last = str[str.length() - 1];
+    }
+}
+void TJSONWriter::write(const char *str)
+{
+    for(; *str != '\0'; str++) {
+        p_os.put(*str);
+        p_last = *str;
+    }
+}
+//write a new line and the indentation
+//if the last char written isn't a space
+void TJSONWriter::writeIndent(void)
+{
+    if(p_last != 0) {
+        if(p_last == ' ') //already indented
+            return;
+        if(p_last != '\n')
+            write("\n");
+    }
+    write(p_indent);
+}
+
+//write the start delimiter of the frame indicated
+//and of all their containers
+void TJSONWriter::start(unsigned int i)
+{
+    if(p_Frames[i].started)
+        return;
+
+    //a non empty object or array is written in separated lines
+    //of its container array
+    if(i > 0 && p_Frames[i-1].isArray) {
+        start(i-1);
+        TFrame& Container = p_Frames[i-1];
+        if(Container.count > 0)
+            write(",");
+        writeIndent();
+        Container.count++;
+    }
+
+    TFrame& F = p_Frames[i];
+    write(F.isArray ? "[" : "{");
+    p_indent += "   ";
+    F.started = true;
+
+    //write the pending elements in separated lines
+    for(unsigned int j=0; j<F.values.size(); j++) {
+        if(j > 0)
+            write(",");
+        writeIndent();
+        write(F.values[j]);
+    }
+    F.count = F.values.size();
+    F.values.clear();
+    F.length = 0;
+}
+//write a value as element or member of the last frame
+//  composite: the value is a non empty object or array
+void TJSONWriter::writeValue(const string& str, bool composite)
+{
+    //a value out of any object or array is the JSON text
+    if(p_Frames.size() <= 0) {
+        write(str);
+        return;
+    }
+
+    //a value in an object is written after its name
+    unsigned int i = p_Frames.size() - 1;
+    if(!p_Frames[i].isArray) {
+        write(str);
+        return;
+    }
+
+    //a non empty object or array in an array,
+    //force the array to be written in separated lines
+    if(composite)
+        start(i);
+
+    TFrame& F = p_Frames[i];
+
+    //if the array is written in separated lines,
+    //write the value in a new line
+    if(F.started) {
+        if(F.count > 0)
+            write(",");
+        writeIndent();
+        write(str);
+        F.count++;
+        return;
+    }
+
+    //keep the value pending to be written in a line
+    F.values.push_back(str);
+    F.length += str.length();
+
+    //if the line would be too long,
+    //write the array in separated lines
+    unsigned int n = F.values.size();
+    if(n*3 >= JSON_RIGHT_MARGIN || 4 + (n - 1)*2 + F.length >= JSON_RIGHT_MARGIN)
+        start(i);
+}
+
+//PUBLIC:
+
+//build a JSON writer attached to a stream
+TJSONWriter::TJSONWriter(ostream& os) :
+    p_os(os), p_last(0), p_indent(), p_Frames()
+{
+}
+
+//write the start of an object
+void TJSONWriter::beginObject(void)
+{
+    p_Frames.push_back(TFrame(false));
+}
+//write the end of an object
+void TJSONWriter::endObject(void)
+{
+    if(p_Frames.size() <= 0 || p_Frames.back().isArray)
+        throw EImproperCall("there isn't an object opened");
+
+    //an empty object is written as a value
+    if(!p_Frames.back().started) {
+        p_Frames.pop_back();
+        writeValue("{}");
+        return;
+    }
+
+    p_indent.resize(p_indent.length() - 3);
+    writeIndent();
+    write("}");
+    p_Frames.pop_back();
+}
+//write the start of an array
+void TJSONWriter::beginArray(void)
+{
+    p_Frames.push_back(TFrame(true));
+}
+//write the end of an array
+void TJSONWriter::endArray(void)
+{
+    if(p_Frames.size() <= 0 || !p_Frames.back().isArray)
+        throw EImproperCall("there isn't an array opened");
+
+    //an array pending to be written in a line, is written as a value
+    if(!p_Frames.back().started) {
+        const vector<string>& values = p_Frames.back().values;
+        string str;
+        bool composite = values.size() > 0;
+        if(composite) {
+            str = "[ ";
+            for(unsigned int i=0; i<values.size(); i++) {
+                if(i > 0)
+                    str += ", ";
+                str += values[i];
+            }
+            str += " ]";
+        } else
+            str = "[]";
+        p_Frames.pop_back();
+        writeValue(str, composite);
+        return;
+    }
+
+    p_indent.resize(p_indent.length() - 3);
+    writeIndent();
+    write("]");
+    p_Frames.pop_back();
+}
+
+//write the name of a member of the last object
+void TJSONWriter::name(const string& name)
+{
+    if(p_Frames.size() <= 0 || p_Frames.back().isArray)
+        throw EImproperCall("there isn't an object opened");
+
+    unsigned int i = p_Frames.size() - 1;
+    if(p_Frames[i].count > 0 && !(p_Frames[i].lastName < name))
+        throw EImproperArgument("member \""+name+"\" should be written before member \""+p_Frames[i].lastName+"\"");
+
+    start(i);
+
+    TFrame& F = p_Frames[i];
+    if(F.count > 0)
+        write(",");
+    writeIndent();
+    write(strToJSON(name));
+    write(" : ");
+    F.count++;
+    F.lastName = name;
+}
+
+//write a value
+void TJSONWriter::value(const string& value)
+{
+    writeValue(strToJSON(value));
+}
+void TJSONWriter::value(const char *value)
+{
+    writeValue(strToJSON(string(value)));
+}
+void TJSONWriter::value(int value)
+{
+    writeValue(inttostr(value));
+}
+void TJSONWriter::value(unsigned int value)
+{
+    writeValue(uinttostr(value));
+}
+void TJSONWriter::value(double value)
+{
+    writeValue(floattoJSON(value));
+}
+void TJSONWriter::value(bool value)
+{
+    writeValue(value ? "true" : "false");
+}
+void TJSONWriter::valueNull(void)
+{
+    writeValue("null");
+}
+//write each line of a text (separated by "\r\n") as a string value
+void TJSONWriter::valueLines(const string& text)
+{
+    string::size_type first = 0;
+    string::size_type last;
+    while((last = text.find("\r\n", first)) != string::npos) {
+        value(text.substr(first, last - first));
+        first = last + 2;
+    }
+    value(text.substr(first));
+}
+
+//write the end of line which ends the JSON text
+void TJSONWriter::end(void)
+{
+    if(p_Frames.size() > 0)
+        throw EImproperCall("there are objects or arrays opened");
+
+    write("\n");
+}
+
+//---------------------------------------------------------------------------
+
+//get the code point of the UTF-8 char pointed by p,
+//and point p to the last byte of the char
+static unsigned int utf8ToCodePoint(const char *&p, const char *end)
+{
+    const unsigned int REPLACEMENT_CHARACTER = 0xFFFD;
+
+    unsigned int first = (unsigned char)p[0];
+    if(first < 0x80)
+        return first;
+
+    if(first < 0xE0) {
+        if(end - p < 2)
+            return REPLACEMENT_CHARACTER;
+        unsigned int c = ((first & 0x1F) << 6) | ((unsigned int)p[1] & 0x3F);
+        p += 1;
+        return c < 0x80 ? REPLACEMENT_CHARACTER : c;
+    }
+
+    if(first < 0xF0) {
+        if(end - p < 3)
+            return REPLACEMENT_CHARACTER;
+        unsigned int c = ((first & 0x0F) << 12) | (((unsigned int)p[1] & 0x3F) << 6) |
+                ((unsigned int)p[2] & 0x3F);
+        p += 2;
+        if(c >= 0xD800 && c <= 0xDFFF)
+            return REPLACEMENT_CHARACTER;
+        return c < 0x800 ? REPLACEMENT_CHARACTER : c;
+    }
+
+    if(first < 0xF8) {
+        if(end - p < 4)
+            return REPLACEMENT_CHARACTER;
+        unsigned int c = ((first & 0x07) << 18) | (((unsigned int)p[1] & 0x3F) << 12) |
+                (((unsigned int)p[2] & 0x3F) << 6) | ((unsigned int)p[3] & 0x3F);
+        p += 3;
+        return c < 0x10000 ? REPLACEMENT_CHARACTER : c;
+    }
+
+    return REPLACEMENT_CHARACTER;
+}
+//add a code point to a string in format "\uXXXX"
+static void addHex(string& str, unsigned int c)
+{
+    const char *digits = "0123456789abcdef";
+    str += "\\u";
+    str += digits[(c >> 12) & 0xF];
+    str += digits[(c >> 8) & 0xF];
+    str += digits[(c >> 4) & 0xF];
+    str += digits[c & 0xF];
+}
+
+//get a string in format JSON (quoted and escaped)
+//(the non ASCII chars are escaped, like Json::StyledWriter)
+string strToJSON(const string& str)
+{
+    string JSON;
+    JSON.reserve(str.length() + 2);
+    JSON += '"';
+
+    const char *end = str.data() + str.length();
+    for(const char *p=str.data(); p<end; p++) {
+        switch(*p) {
+        case '"': JSON += "\\\""; break;
+        case '\\': JSON += "\\\\"; break;
+        case '\b': JSON += "\\b"; break;
+        case '\f': JSON += "\\f"; break;
+        case '\n': JSON += "\\n"; break;
+        case '\r': JSON += "\\r"; break;
+        case '\t': JSON += "\\t"; break;
+        default:
+            unsigned int c = utf8ToCodePoint(p, end);
+            if(c < 0x20)
+                addHex(JSON, c);
+            else if(c < 0x80)
+                JSON += char(c);
+            else if(c < 0x10000)
+                addHex(JSON, c);
+            else {
+                c -= 0x10000;
+                addHex(JSON, 0xD800 + ((c >> 10) & 0x3FF));
+                addHex(JSON, 0xDC00 + (c & 0x3FF));
+            }
+        }
+    }
+
+    JSON += '"';
+    return JSON;
+}
+
+//get a double in format JSON (17 significant digits)
+string floattoJSON(double value)
+{
+    //the non finite values are written like Json::StyledWriter
+    if(!isfinite(value)) {
+        if(value != value)
+            return "null";
+        return value < 0 ? "-1e+9999" : "1e+9999";
+    }
+
+    char c_str[32];
+#ifdef FMPT_CHARCONV
+    to_chars_result result = to_chars(c_str, c_str + sizeof(c_str) - 3, value,
+                                      chars_format::general, 17);
+    if(result.ec != errc())
+        throw EImproperArgument("can't convert double to string");
+    string str(c_str, result.ptr);
+#else
+    snprintf(c_str, sizeof(c_str), "%.17g", value);
+    string str(c_str);
+    for(unsigned int i=0; i<str.length(); i++)
+        if(str[i] == ',')
+            str[i] = '.';
+#endif
+
+    //the doubles are written always as reals
+    if(str.find('.') == string::npos && str.find('e') == string::npos)
+        str += ".0";
+
+    return str;
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Strings
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,153 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: JSONWriter.h
+//Content: writer of JSON texts in streams
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+//namespace for strings
+namespace Strings {
+
+//---------------------------------------------------------------------------
+//TJSONWriter:
+//---------------------------------------------------------------------------
+
+//The JSON writer writes a JSON value in a stream incrementally,
+//without build the JSON object (DOM) in memory, and produces the same text
+//as Json::StyledWriter:
+//  the members of the objects are written indented in separated lines;
+//  the arrays of short lists of values are written in a line,
+//  otherwise their elements are written indented in separated lines;
+//  the doubles are written with 17 significant digits.
+//
+//The members of each object shall be written in lexicographic order
+//of their names, which is the order of the JSON objects of jsoncpp.
+//
+//Only the elements of an array of values pending to be written
+//in a line are kept in memory (less than a line).
+
+//class writer of JSON texts
+class TJSONWriter {
+    //stream where the text is written
+    ostream& p_os;
+    //last char written in the stream, or zero if none
+    char p_last;
+    //indentation string
+    string p_indent;
+
+    //an opened object or array
+    class TFrame {
+    public:
+        //indicates if the frame is an array
+        bool isArray;
+        //indicates if the start delimiter has been written
+        bool started;
+        //number of members or elements written
+        unsigned int count;
+        //name of the last member (only for objects)
+        string lastName;
+        //elements pending to be written in a line (only for arrays)
+        vector<string> values;
+        //length of the line of the pending elements
+        unsigned int length;
+
+        TFrame(bool t_isArray) : isArray(t_isArray), started(false),
+            count(0), lastName(), values(), length(0) {;}
+    };
+    //opened objects and arrays
+    vector<TFrame> p_Frames;
+
+    //write a string in the stream
+    void write(const string& str);
+    void write(const char *str);
+    //write a new line and the indentation
+    //if the last char written isn't a space
+    void writeIndent(void);
+
+    //write the start delimiter of the frame indicated
+    //and of all their containers
+    void start(unsigned int i);
+    //write a value as element or member of the last frame
+    //  composite: the value is a non empty object or array
+    void writeValue(const string& str, bool composite=false);
+
+public:
+    //build a JSON writer attached to a stream
+    TJSONWriter(ostream& os);
+
+    //write the start of an object
+    void beginObject(void);
+    //write the end of an object
+    //if there isn't an object opened:
+    //  throw EImproperCall
+    void endObject(void);
+    //write the start of an array
+    void beginArray(void);
+    //write the end of an array
+    //if there isn't an array opened:
+    //  throw EImproperCall
+    void endArray(void);
+
+    //write the name of a member of the last object
+    //if there isn't an object opened:
+    //  throw EImproperCall
+    //if name isn't upper than the name of the previous member:
+    //  throw EImproperArgument
+    void name(const string& name);
+
+    //write a value
+    void value(const string& value);
+    void value(const char *value);
+    void value(int value);
+    void value(unsigned int value);
+    void value(double value);
+    void value(bool value);
+    void valueNull(void);
+    //write each line of a text (separated by "\r\n") as a string value
+    void valueLines(const string& text);
+
+    //write the end of line which ends the JSON text
+    //if there are objects or arrays opened:
+    //  throw EImproperCall
+    void end(void);
+};
+
+//get a string in format JSON (quoted and escaped)
+string strToJSON(const string& str);
+//get a double in format JSON (17 significant digits)
+string floattoJSON(double value);
+
+//---------------------------------------------------------------------------
+
+} //namespace Strings
+
+//---------------------------------------------------------------------------
+#endif // JSONWRITER_H
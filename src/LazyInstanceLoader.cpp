@@ -0,0 +1,342 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: LazyInstanceLoader.cpp
+//Content: on-demand loader of the RPs of a FMM Instance
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "LazyInstanceLoader.h"
+#include "TextFile.h" //strReadFromFile
+
+#include <algorithm> //std::sort, std::unique
+#include <cstdio> //snprintf
+#include <cstdlib> //strtol
+#include <map> //std::map
+
+//---------------------------------------------------------------------------
+
+using namespace Strings;
+
+//namespace for models
+namespace Models {
+
+//---------------------------------------------------------------------------
+
+//read the neighbours of each RP of a RPL from its instance map:
+//two RPs are neighbours when they are in a same cell
+static void readNeighbours(vector<vector<int> >& Neighbours,
+                           const TRoboticPositionerList& RPL, const AnsiString& S)
+{
+    Neighbours.clear();
+    Neighbours.resize(RPL.getCount());
+
+    //index the RPs by identifier
+    map<int, int> Indices;
+    for(int k=0; k<RPL.getCount(); k++)
+        Indices.insert(make_pair(RPL[k]->getActuator()->getId(), k));
+
+    //read the mapping interval and the dimensions of the cell matrix
+    TRoboticPositionerList2 aux;
+    int i = 1;
+    TRoboticPositionerList2::readInterval(&aux, S, i);
+    int I, J;
+    TRoboticPositionerList2::readIText(I, S, i);
+    TRoboticPositionerList2::readJText(J, S, i);
+
+    //for each cell of the matrix
+    //(read directly from the text, because there are thousands)
+    const string& str = S.str;
+    size_t p = i - 1;
+    vector<int> indices;
+    for(int k=0; k<I; k++)
+        for(int l=0; l<J; l++) {
+            //travel the label "Cells[k][l] = {"
+            char label[64];
+            int length = snprintf(label, sizeof(label), "Cells[%d][%d]", k, l);
+            p = str.find_first_not_of(" \t\r\n", p);
+            if(p == string::npos || str.compare(p, length, label) != 0)
+                throw EImproperFileLoadedValue("label '"+string(label)+"' not found in instance map");
+            p = str.find_first_not_of(" \t", p + length);
+            if(p == string::npos || str[p] != '=')
+                throw EImproperFileLoadedValue("'=' not found after label '"+string(label)+"'");
+            p = str.find_first_not_of(" \t", p + 1);
+            if(p == string::npos || str[p] != '{')
+                throw EImproperFileLoadedValue("'{' not found after label '"+string(label)+"'");
+            p++;
+
+            //read the identifiers of the RPs of the cell
+            indices.clear();
+            while(true) {
+                p = str.find_first_not_of(" \t", p);
+                if(p == string::npos)
+                    throw EImproperFileLoadedValue("'}' not found after label '"+string(label)+"'");
+                if(str[p] == '}' && indices.size() <= 0) {
+                    p++;
+                    break;
+                }
+                char *end;
+                long Id = strtol(str.c_str() + p, &end, 10);
+                if(end == str.c_str() + p)
+                    throw EImproperFileLoadedValue("improper identifier in cell '"+string(label)+"'");
+                p = end - str.c_str();
+                map<int, int>::const_iterator it = Indices.find(int(Id));
+                if(it == Indices.end())
+                    throw EImproperFileLoadedValue("identified RP '"+inttostr(int(Id))+"' is not in the RP list");
+                indices.push_back(it->second);
+                p = str.find_first_not_of(" \t", p);
+                if(p != string::npos && str[p] == ',')
+                    p++;
+                else if(p != string::npos && str[p] == '}') {
+                    p++;
+                    break;
+                }
+                else
+                    throw EImproperFileLoadedValue("improper list of identifiers in cell '"+string(label)+"'");
+            }
+
+            //the RPs of the cell are neighbours between them
+            for(unsigned int m=0; m<indices.size(); m++)
+                for(unsigned int n=0; n<indices.size(); n++)
+                    if(indices[m] != indices[n])
+                        Neighbours[indices[m]].push_back(indices[n]);
+        }
+
+    if(str.find_first_not_of(" \t\r\n", p) != string::npos)
+        throw EImproperFileLoadedValue("unexpected text in instance map");
+
+    //remove the repeated neighbours
+    for(unsigned int k=0; k<Neighbours.size(); k++) {
+        vector<int>& N = Neighbours[k];
+        sort(N.begin(), N.end());
+        N.erase(unique(N.begin(), N.end()), N.end());
+    }
+}
+
+//---------------------------------------------------------------------------
+//TLazyInstanceLoader:
+//---------------------------------------------------------------------------
+
+//PRIVATE:
+
+//search the index of a RP of the FMM
+int TLazyInstanceLoader::searchIndex(int Id) const
+{
+    if(p_FMM == NULL)
+        throw EImproperCall("the loader should have an instance opened");
+
+    int i = p_FMM->RPL.searchId(Id);
+    if(i >= p_FMM->RPL.getCount())
+        throw EImproperArgument("RP"+inttostr(Id)+" should be in the FMM");
+    return i;
+}
+
+//read the directory of the RP indicated, if it isn't loaded
+bool TLazyInstanceLoader::load(int i)
+{
+    if(p_Loaded[i])
+        return false;
+
+    TRoboticPositioner *RP = p_FMM->RPL[i];
+    string subdir = p_dir+"/RoboticPositioner"+RP->getActuator()->getIdText().str;
+
+    //the RP is restored if it can't be read
+    TRoboticPositioner Backup(RP);
+    try {
+        readInstanceFromDir(*RP, subdir, p_Sources);
+    }
+    catch(...) {
+        RP->clone(&Backup);
+        throw;
+    }
+
+    p_Loaded[i] = true;
+    p_LoadedCount++;
+    return true;
+}
+
+//assimilate the FMM from the initial safe parameters of the RPs
+void TLazyInstanceLoader::assimilate(void)
+{
+    for(int i=0; i<p_FMM->RPL.getCount(); i++) {
+        const vector<double>& SP = p_InitialSafeParameters[i];
+        p_FMM->RPL[i]->getActuator()->setSafeParameters(SP[0], SP[1], SP[2], SP[3], SP[4], SP[5]);
+    }
+
+    //the map is regenerated without the RPs mapped previously
+    TRoboticPositionerList& RPL = p_FMM->RPL;
+    RPL.setMapCellsIndices(vector<vector<int> >(RPL.getI()*RPL.getJ()));
+
+    p_FMM->assimilate();
+}
+
+//PUBLIC:
+
+//determines if a RP has been loaded
+bool TLazyInstanceLoader::isLoaded(int Id) const
+{
+    return p_Loaded[searchIndex(Id)];
+}
+//get the identifiers of the neighbours of a RP
+void TLazyInstanceLoader::getNeighbours(vector<int>& Ids, int Id) const
+{
+    const vector<int>& N = p_Neighbours[searchIndex(Id)];
+    Ids.clear();
+    for(unsigned int i=0; i<N.size(); i++)
+        Ids.push_back(p_FMM->RPL[N[i]]->getActuator()->getId());
+}
+
+//build a lazy instance loader without instance
+TLazyInstanceLoader::TLazyInstanceLoader(void) :
+    p_FMM(NULL), p_dir(),
+    p_Loaded(), p_LoadedCount(0), p_Neighbours(),
+    p_InitialSafeParameters(), p_Sources()
+{
+}
+
+//open an instance directory in a FMM, reading all except
+//the directories of the RPs, and assimilate the FMM
+void TLazyInstanceLoader::open(TFiberMOSModel& FMM, const string& dir)
+{
+    try {
+        //contruye una variable tampón
+        TFiberMOSModel t_FMM;
+
+        //lee la instancia de la lista de EAs
+        readInstanceFromDir(t_FMM.EAL, dir);
+
+        //lee la tabla de orígenes de los RPs,
+        //que quedan con sus valores por defecto
+        string str;
+        strReadFromFile(str, dir+"/RoboticPositionerOriginsTable.txt");
+        t_FMM.RPL.setOriginsTableText(str);
+
+        //lee las demás propiedades de la instancia
+        strReadFromFile(str, dir+"/Instance.txt");
+        t_FMM.setInstanceText(str);
+
+        //lee los vecinos de cada RP en el mapa
+        vector<vector<int> > Neighbours;
+        strReadFromFile(str, dir+"/InstanceMap.txt");
+        readNeighbours(Neighbours, t_FMM.RPL, AnsiString(str));
+
+        //guarda los parámetros de seguridad iniciales
+        vector<vector<double> > SafeParameters(t_FMM.RPL.getCount());
+        for(int i=0; i<t_FMM.RPL.getCount(); i++) {
+            const TActuator *A = t_FMM.RPL[i]->getActuator();
+            vector<double>& SP = SafeParameters[i];
+            SP.push_back(A->getr_min());
+            SP.push_back(A->getr_saf());
+            SP.push_back(A->getr_2saf());
+            SP.push_back(A->gettheta___2saf());
+            SP.push_back(A->gettheta___3saf());
+            SP.push_back(A->gettheta_2rad());
+        }
+
+        //Note that the RPs are indexed by their position in the list,
+        //which is kept by the clonation.
+
+        //clona la variable tampón
+        FMM.Clone(&t_FMM);
+
+        //asigna las variables del cargador
+        p_FMM = &FMM;
+        p_dir = dir;
+        p_Loaded.assign(FMM.RPL.getCount(), false);
+        p_LoadedCount = 0;
+        p_Neighbours.swap(Neighbours);
+        p_InitialSafeParameters.swap(SafeParameters);
+        p_Sources = TRPTemplateSources();
+
+        //asimila las propiedades
+        assimilate();
+    }
+    catch(ECantComplete& E) {
+        E.Message.Insert(1, "opening instance of FMM: ");
+        throw;
+    }
+    catch(Exception& E) {
+        throw EImproperFileLoadedValue("opening instance of FMM: " + E.Message.str);
+    }
+}
+
+//load the RPs indicated and their neighbours if they aren't loaded,
+//and assimilate the FMM if some RP has been loaded
+int TLazyInstanceLoader::touch(int Id)
+{
+    return touch(vector<int>(1, Id));
+}
+int TLazyInstanceLoader::touch(const vector<int>& Ids)
+{
+    //search all RPs before load any of them
+    vector<int> indices;
+    for(unsigned int i=0; i<Ids.size(); i++)
+        indices.push_back(searchIndex(Ids[i]));
+
+    //load the RPs and their neighbours
+    int count = 0;
+    try {
+        for(unsigned int i=0; i<indices.size(); i++) {
+            if(load(indices[i]))
+                count++;
+            const vector<int>& N = p_Neighbours[indices[i]];
+            for(unsigned int j=0; j<N.size(); j++)
+                if(load(N[j]))
+                    count++;
+        }
+    }
+    catch(...) {
+        //the RPs loaded shall be assimilated anyway
+        if(count > 0)
+            assimilate();
+        throw;
+    }
+
+    if(count > 0)
+        assimilate();
+    return count;
+}
+//load all RPs not loaded yet
+int TLazyInstanceLoader::loadAll(void)
+{
+    if(p_FMM == NULL)
+        throw EImproperCall("the loader should have an instance opened");
+
+    int count = 0;
+    try {
+        for(unsigned int i=0; i<p_Loaded.size(); i++)
+            if(load(i))
+                count++;
+    }
+    catch(...) {
+        if(count > 0)
+            assimilate();
+        throw;
+    }
+
+    if(count > 0)
+        assimilate();
+    return count;
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: LazyInstanceLoader.h
+//Content: on-demand loader of the RPs of a FMM Instance
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef LAZYINSTANCELOADER_H
+#define LAZYINSTANCELOADER_H
+
+#include "FileMethods.h"
+
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+//namespace for models
+namespace Models {
+
+//---------------------------------------------------------------------------
+//TLazyInstanceLoader:
+//---------------------------------------------------------------------------
+
+//The lazy instance loader opens an instance directory of a FMM reading
+//only the instance of the FMM, the EAs, the origins of the RPs and the
+//map of the RPs (InstanceMap.txt). The directory of each RP
+//(RoboticPositioner<Id>) is read only when the RP, or a neighbour of it,
+//is touched, so the requests involving a few RPs don't have to wait
+//the reading of the complete instance.
+//
+//Two RPs are neighbours when they are in a same cell of the map,
+//so the adjacents of a RP touched are always loaded.
+//
+//The RPs not loaded yet keep their values by default,
+//so only the RPs loaded shall be used by the requests.
+//
+//The safe parameters of a RP are calculated as the minimun
+//of their previous values and the values determined by its adjacents,
+//so they are restored before each assimilation. Otherwise, the values
+//determined when the neighbours weren't loaded would remain.
+
+//class lazy instance loader
+class TLazyInstanceLoader {
+    //FMM where the instance is loaded
+    TFiberMOSModel *p_FMM;
+    //instance directory
+    std::string p_dir;
+
+    //indicates for each RP of the FMM if it has been loaded
+    std::vector<bool> p_Loaded;
+    //number of RPs loaded
+    int p_LoadedCount;
+    //indices of the neighbours of each RP of the FMM
+    std::vector<std::vector<int> > p_Neighbours;
+    //safe parameters of each RP of the FMM before the first assimilation
+    std::vector<std::vector<double> > p_InitialSafeParameters;
+
+    //RPs from which share the templates read
+    TRPTemplateSources p_Sources;
+
+    //search the index of a RP of the FMM
+    //if the RP is not found:
+    //  throw an exception EImproperArgument
+    int searchIndex(int Id) const;
+    //read the directory of the RP indicated, if it isn't loaded
+    //return true if the RP has been read
+    bool load(int i);
+    //assimilate the FMM from the initial safe parameters of the RPs
+    void assimilate(void);
+
+public:
+    //PROPERTIES:
+
+    //FMM where the instance is loaded
+    //default value: NULL
+    TFiberMOSModel *getFMM(void) const {return p_FMM;}
+    //instance directory
+    //default value: ""
+    const std::string& getDir(void) const {return p_dir;}
+
+    //number of RPs loaded
+    int getLoadedCount(void) const {return p_LoadedCount;}
+    //determines if all RPs have been loaded
+    bool allLoaded(void) const {return p_LoadedCount >= int(p_Loaded.size());}
+    //determines if a RP has been loaded
+    //if the RP is not found:
+    //  throw an exception EImproperArgument
+    bool isLoaded(int Id) const;
+    //get the identifiers of the neighbours of a RP
+    //if the RP is not found:
+    //  throw an exception EImproperArgument
+    void getNeighbours(std::vector<int>& Ids, int Id) const;
+
+    //BUILDING METHODS:
+
+    //build a lazy instance loader without instance
+    TLazyInstanceLoader(void);
+
+    //LOADING METHODS:
+
+    //open an instance directory in a FMM, reading all except
+    //the directories of the RPs, and assimilate the FMM
+    //Preconditions:
+    //  The FMM shall not be rebuilt while the loader is used.
+    //if the instance can't be read:
+    //  throw an exception ECantComplete or EImproperFileLoadedValue
+    //  and the FMM and the loader remain unchanged
+    void open(TFiberMOSModel& FMM, const std::string& dir);
+
+    //load the RPs indicated and their neighbours if they aren't loaded,
+    //and assimilate the FMM if some RP has been loaded
+    //return the number of RPs loaded
+    //if some RP is not found:
+    //  throw an exception EImproperArgument
+    //if some RP can't be read:
+    //  throw an exception ECantComplete or EImproperFileLoadedValue,
+    //  and the RP remains unloaded
+    int touch(int Id);
+    int touch(const std::vector<int>& Ids);
+    //load all RPs not loaded yet
+    //and assimilate the FMM if some RP has been loaded
+    //return the number of RPs loaded
+    int loadAll(void);
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
+#endif // LAZYINSTANCELOADER_H
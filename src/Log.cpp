@@ -0,0 +1,417 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: Log.cpp
+//Content: buffered log files
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "Log.h"
+#include "TextFile.h" //TTextOutputBuffer
+#include "Exceptions.h"
+
+#include <map>
+#include <exception> //set_terminate
+#include <pthread.h> //pthread_create, pthread_join, pthread_mutex_t
+#include <fcntl.h> //open
+#include <time.h> //clock_gettime, localtime_r, strftime
+#include <stdlib.h> //atexit, abort
+#include <stdio.h> //snprintf
+
+//---------------------------------------------------------------------------
+
+//namespace for strings
+namespace Strings {
+
+//---------------------------------------------------------------------------
+
+//a log file opened
+class TLogSink {
+public:
+    //mutex for access to the sink
+    pthread_mutex_t mutex;
+    //buffer attached to the log file
+    TTextOutputBuffer buffer;
+    //indicates if the next char written will be the first of a line
+    bool atLineStart;
+
+    //build a sink attached to a file descriptor
+    TLogSink(int fd) : buffer(fd, true, true), atLineStart(true) {
+        pthread_mutex_init(&mutex, NULL);
+    }
+    //write the buffered text and close the file
+    ~TLogSink() {
+        buffer.close();
+        pthread_mutex_destroy(&mutex);
+    }
+};
+
+//mutex for access to the list of sinks and the configuration
+static pthread_mutex_t logMutex = PTHREAD_MUTEX_INITIALIZER;
+//sinks of the log files opened, indexed by path
+//(never destroyed, so they are available until the exit of the process)
+static map<string, TLogSink*> *logSinks = NULL;
+//minimun level of the messages written in the log files
+static TLogLevel logMinLevel = llINFO;
+//indicates if the lines shall be prefixed with their timestamp
+static bool logTimestamps = false;
+//indicates if the handlers for the exit of the process have been installed
+static bool logHandlersInstalled = false;
+//previous handler of the uncaught exceptions
+static terminate_handler logPreviousTerminate = NULL;
+
+//status of the flusher thread
+static pthread_mutex_t logFlusherMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t logFlusherCond = PTHREAD_COND_INITIALIZER;
+static pthread_t logFlusher;
+static bool logFlusherRunning = false;
+static unsigned int logFlusherPeriod = 1000;
+
+//---------------------------------------------------------------------------
+
+//write the buffered text of all log files,
+//skipping the sinks which are being used
+//(for be called when the process is being aborted)
+static void logFlushAllIfAvailable(void)
+{
+    if(pthread_mutex_trylock(&logMutex) != 0)
+        return;
+    if(logSinks != NULL)
+        for(map<string, TLogSink*>::iterator it=logSinks->begin(); it!=logSinks->end(); it++) {
+            TLogSink *S = it->second;
+            if(pthread_mutex_trylock(&S->mutex) == 0) {
+                S->buffer.pubsync();
+                pthread_mutex_unlock(&S->mutex);
+            }
+        }
+    pthread_mutex_unlock(&logMutex);
+}
+
+//handler of the exit of the process
+static void logAtExit(void)
+{
+    logStopFlusher();
+    logFlushAll();
+}
+
+//handler of the uncaught exceptions
+static void logTerminate(void)
+{
+    logFlushAllIfAvailable();
+    if(logPreviousTerminate != NULL)
+        logPreviousTerminate();
+    abort();
+}
+
+//install the handlers for the exit of the process
+//(shall be called with logMutex locked)
+static void logInstallHandlers(void)
+{
+    if(logHandlersInstalled)
+        return;
+    atexit(logAtExit);
+    logPreviousTerminate = set_terminate(logTerminate);
+    logHandlersInstalled = true;
+}
+
+//get the sink of a log file locked, opening the file if necessary
+//  reset: indicates if the file shall be truncated
+//  timestamps: if not NULL, get the value of logTimestamps
+//if the file can't be opened:
+//  throw ECantComplete
+static TLogSink *logLockSink(const string& path, bool reset, bool *timestamps=NULL)
+{
+    pthread_mutex_lock(&logMutex);
+    logInstallHandlers();
+    if(logSinks == NULL)
+        logSinks = new map<string, TLogSink*>();
+
+    TLogSink *S = NULL;
+    map<string, TLogSink*>::iterator it = logSinks->find(path);
+    if(it != logSinks->end()) {
+        if(!reset)
+            S = it->second;
+        else {
+            //write the buffered text before truncate the file
+            TLogSink *old = it->second;
+            logSinks->erase(it);
+            pthread_mutex_lock(&old->mutex);
+            pthread_mutex_unlock(&old->mutex);
+            delete old;
+        }
+    }
+
+    if(S == NULL) {
+        int flags = O_WRONLY | O_CREAT | O_APPEND;
+        if(reset)
+            flags |= O_TRUNC;
+        int fd = open(path.c_str(), flags, 0666);
+        if(fd < 0) {
+            pthread_mutex_unlock(&logMutex);
+            throw ECantComplete(AnsiString("can't open file: ")+AnsiString(path));
+        }
+        S = new TLogSink(fd);
+        (*logSinks)[path] = S;
+    }
+
+    if(timestamps != NULL)
+        *timestamps = logTimestamps;
+
+    pthread_mutex_lock(&S->mutex);
+    pthread_mutex_unlock(&logMutex);
+    return S;
+}
+
+//write the prefix of a line: "YYYY-MM-DD hh:mm:ss.mmm [LEVEL] "
+static void logWritePrefix(TLogSink *S, TLogLevel level)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    struct tm t;
+    localtime_r(&ts.tv_sec, &t);
+
+    char prefix[64];
+    size_t n = strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", &t);
+    n += snprintf(prefix + n, sizeof(prefix) - n, ".%03d [%s] ",
+                  int(ts.tv_nsec/1000000), logLevelToStr(level));
+    if(n >= sizeof(prefix))
+        n = sizeof(prefix) - 1;
+    S->buffer.sputn(prefix, n);
+}
+
+//write a text in a sink
+static void logWriteInSink(TLogSink *S, const string& str, TLogLevel level,
+                           bool timestamps)
+{
+    if(str.length() <= 0)
+        return;
+
+    if(!timestamps) {
+        S->buffer.sputn(str.data(), str.length());
+        S->atLineStart = str[str.length() - 1] == '\n';
+        return;
+    }
+
+    //prefix each line with its timestamp
+    string::size_type first = 0;
+    while(first < str.length()) {
+        if(S->atLineStart) {
+            logWritePrefix(S, level);
+            S->atLineStart = false;
+        }
+        string::size_type last = str.find('\n', first);
+        if(last == string::npos) {
+            S->buffer.sputn(str.data() + first, str.length() - first);
+            break;
+        }
+        S->buffer.sputn(str.data() + first, last + 1 - first);
+        S->atLineStart = true;
+        first = last + 1;
+    }
+}
+
+//write a message in a log file
+static void logWriteMessage(const string& path, const string& str, TLogLevel level)
+{
+    bool timestamps;
+    TLogSink *S = logLockSink(path, false, &timestamps);
+    logWriteInSink(S, str, level, timestamps);
+    //the errors are written immediately, because the process
+    //could be finished by an unexpected way
+    if(level >= llERROR)
+        S->buffer.pubsync();
+    pthread_mutex_unlock(&S->mutex);
+}
+
+//body of the flusher thread
+static void *logFlusherMain(void *)
+{
+    pthread_mutex_lock(&logFlusherMutex);
+    while(logFlusherRunning) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += logFlusherPeriod/1000;
+        deadline.tv_nsec += long(logFlusherPeriod%1000)*1000000;
+        if(deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&logFlusherCond, &logFlusherMutex, &deadline);
+        if(!logFlusherRunning)
+            break;
+
+        pthread_mutex_unlock(&logFlusherMutex);
+        logFlushAll();
+        pthread_mutex_lock(&logFlusherMutex);
+    }
+    pthread_mutex_unlock(&logFlusherMutex);
+    return NULL;
+}
+
+//---------------------------------------------------------------------------
+
+//get the label of a level of severity
+const char *logLevelToStr(TLogLevel level)
+{
+    switch(level) {
+    case llDEBUG: return "DEBUG";
+    case llINFO: return "INFO";
+    case llWARNING: return "WARNING";
+    case llERROR: return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+//set the minimun level of the messages written in the log files
+void logSetMinLevel(TLogLevel level)
+{
+    pthread_mutex_lock(&logMutex);
+    logMinLevel = level;
+    pthread_mutex_unlock(&logMutex);
+}
+//get the minimun level of the messages written in the log files
+TLogLevel logGetMinLevel(void)
+{
+    pthread_mutex_lock(&logMutex);
+    TLogLevel level = logMinLevel;
+    pthread_mutex_unlock(&logMutex);
+    return level;
+}
+
+//set if each line of the log files shall be prefixed with
+//its timestamp and the level of its message
+void logSetTimestamps(bool timestamps)
+{
+    pthread_mutex_lock(&logMutex);
+    logTimestamps = timestamps;
+    pthread_mutex_unlock(&logMutex);
+}
+
+//create or truncate a log file
+void logReset(const string& path)
+{
+    TLogSink *S = logLockSink(path, true);
+    pthread_mutex_unlock(&S->mutex);
+}
+//write a message in a log file, followed by an end of line
+void logWrite(const string& path, const string& str, TLogLevel level)
+{
+    if(level < logGetMinLevel())
+        return;
+    logWriteMessage(path, str+"\r\n", level);
+}
+//write a message in a log file, without end of line
+void logWriteWithoutEndl(const string& path, const string& str, TLogLevel level)
+{
+    if(level < logGetMinLevel())
+        return;
+    logWriteMessage(path, str, level);
+}
+
+//write the buffered text of a log file
+void logFlush(const string& path)
+{
+    pthread_mutex_lock(&logMutex);
+    TLogSink *S = NULL;
+    if(logSinks != NULL) {
+        map<string, TLogSink*>::iterator it = logSinks->find(path);
+        if(it != logSinks->end()) {
+            S = it->second;
+            pthread_mutex_lock(&S->mutex);
+        }
+    }
+    pthread_mutex_unlock(&logMutex);
+
+    if(S != NULL) {
+        S->buffer.pubsync();
+        pthread_mutex_unlock(&S->mutex);
+    }
+}
+//write the buffered text of all log files
+void logFlushAll(void)
+{
+    pthread_mutex_lock(&logMutex);
+    if(logSinks != NULL)
+        for(map<string, TLogSink*>::iterator it=logSinks->begin(); it!=logSinks->end(); it++) {
+            TLogSink *S = it->second;
+            pthread_mutex_lock(&S->mutex);
+            S->buffer.pubsync();
+            pthread_mutex_unlock(&S->mutex);
+        }
+    pthread_mutex_unlock(&logMutex);
+}
+//write the buffered text of a log file, and close it
+void logClose(const string& path)
+{
+    pthread_mutex_lock(&logMutex);
+    TLogSink *S = NULL;
+    if(logSinks != NULL) {
+        map<string, TLogSink*>::iterator it = logSinks->find(path);
+        if(it != logSinks->end()) {
+            S = it->second;
+            logSinks->erase(it);
+            //wait until the sink isn't being used
+            pthread_mutex_lock(&S->mutex);
+            pthread_mutex_unlock(&S->mutex);
+        }
+    }
+    pthread_mutex_unlock(&logMutex);
+
+    delete S;
+}
+
+//start the thread which writes the buffered text
+//of all log files periodically
+void logStartFlusher(unsigned int period)
+{
+    pthread_mutex_lock(&logMutex);
+    logInstallHandlers();
+    pthread_mutex_unlock(&logMutex);
+
+    pthread_mutex_lock(&logFlusherMutex);
+    logFlusherPeriod = period > 0 ? period : 1;
+    if(!logFlusherRunning) {
+        logFlusherRunning = true;
+        //if the thread can't be created, the text is written
+        //when the buffers are full or are flushed explicitly
+        if(pthread_create(&logFlusher, NULL, logFlusherMain, NULL) != 0)
+            logFlusherRunning = false;
+    }
+    pthread_mutex_unlock(&logFlusherMutex);
+}
+//stop the thread which writes the buffered text periodically
+void logStopFlusher(void)
+{
+    pthread_mutex_lock(&logFlusherMutex);
+    if(!logFlusherRunning) {
+        pthread_mutex_unlock(&logFlusherMutex);
+        return;
+    }
+    logFlusherRunning = false;
+    pthread_cond_signal(&logFlusherCond);
+    pthread_mutex_unlock(&logFlusherMutex);
+
+    pthread_join(logFlusher, NULL);
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Strings
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: Log.h
+//Content: buffered log files
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <string>
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+//namespace for strings
+namespace Strings {
+
+//---------------------------------------------------------------------------
+
+//The log files are written through a buffered sink per file and process,
+//which keeps the file opened and writes the text by blocks, instead of
+//open, write and close the file for each message.
+//
+//The buffered text is written in the file:
+//  when the buffer is full;
+//  when a message of level llERROR is written;
+//  when the log is flushed or closed explicitly;
+//  periodically, if the flusher thread has been started;
+//  at the exit of the process, and before abort the process
+//  by an uncaught exception.
+//
+//The chars '\r' are discarded (like strWriteToFile), and each line
+//can be prefixed with its timestamp and the level of its message.
+//
+//All functions can be called from several threads.
+
+//levels of severity of the log messages
+enum TLogLevel {llDEBUG, llINFO, llWARNING, llERROR};
+
+//get the label of a level of severity
+const char *logLevelToStr(TLogLevel level);
+
+//set the minimun level of the messages written in the log files
+//default value: llINFO
+void logSetMinLevel(TLogLevel level);
+//get the minimun level of the messages written in the log files
+TLogLevel logGetMinLevel(void);
+
+//set if each line of the log files shall be prefixed with
+//its timestamp and the level of its message, like:
+//  "2017-01-31 12:00:00.000 [INFO] text of the line"
+//default value: false
+void logSetTimestamps(bool timestamps);
+
+//create or truncate a log file
+//if the file can't be opened:
+//  throw ECantComplete
+void logReset(const string& path);
+//write a message in a log file, followed by an end of line
+//if the file can't be opened:
+//  throw ECantComplete
+void logWrite(const string& path, const string& str, TLogLevel level=llINFO);
+//write a message in a log file, without end of line
+//if the file can't be opened:
+//  throw ECantComplete
+void logWriteWithoutEndl(const string& path, const string& str,
+                         TLogLevel level=llINFO);
+
+//write the buffered text of a log file
+void logFlush(const string& path);
+//write the buffered text of all log files
+void logFlushAll(void);
+//write the buffered text of a log file, and close it
+void logClose(const string& path);
+
+//start the thread which writes the buffered text
+//of all log files periodically
+//  period: time between two flushes in milliseconds
+void logStartFlusher(unsigned int period=1000);
+//stop the thread which writes the buffered text periodically
+void logStopFlusher(void);
+
+//---------------------------------------------------------------------------
+
+} //namespace Strings
+
+//---------------------------------------------------------------------------
+#endif // LOG_H
@@ -29,6 +29,7 @@
 
 #include "Vector.h"
 #include "Instruction.h"
+#include "Arena.h"
 
 using namespace Lists;
 
@@ -41,8 +42,11 @@ namespace Models {
 //TMessageInstruction:
 //--------------------------------------------------------------------------
 
+//The MIs are built in the arena open in the thread, if any,
+//so the MIs of a generated MP are contiguous.
+
 //class MI (message instruction)
-class TMessageInstruction {
+class TMessageInstruction : public TArenaItem {
         int p_Id;
         string p_CommentDsec;
         string p_CommentDmin;
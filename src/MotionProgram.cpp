@@ -25,6 +25,14 @@
 #include "MotionProgram.h"
 #include "Strings.h"
 
+#include <sstream> //ostringstream
+#include <map>
+#include <vector>
+#include <math.h> //floor, fabs, signbit
+#include <string.h> //memcpy, memcmp
+#include <stdint.h> //uint64_t
+#include <limits.h> //INT_MAX
+
 //---------------------------------------------------------------------------
 
 using namespace Strings; //StrIndent
@@ -196,7 +204,7 @@ void TMotionProgram::excludeRP(int Id)
     }
 }
 
-//Get a motion progam in the format of the MCS.
+//Write a motion progam in the format of the MCS in a stream.
 //Inputs:
 //  label: type of MP ["pos", "depos"].
 //  Bid: identifier of the CB.
@@ -204,7 +212,7 @@ void TMotionProgram::excludeRP(int Id)
 //Preconditions:
 //  All PPAs of the SPL must be referred to different RPs.
 //  All RPs included in the MP, must be in included in the SPL.
-void TMotionProgram::getMCStext(string& str, const string& label, unsigned int Bid,
+void TMotionProgram::writeMCStext(ostream& os, const string& label, unsigned int Bid,
     const TPairPositionAnglesList& SPL) const
 {
     //CHECK THE PRECONDITIONS:
@@ -225,14 +233,21 @@ void TMotionProgram::getMCStext(string& str, const string& label, unsigned int B
 
     //PRINT THE MOTION PROGRAM:
 
-    str = ""; //initialize the output
-
-    //print the label of the motion program and their start delimiter
-    str += label+"_"+inttostr(int(Bid))+" {";
-
     //actualize the actual position list
     TPairPositionAnglesList APL = SPL;
 
+    writeMCSprogram(os, label, Bid, &APL);
+}
+
+//Write a motion program in the format of the MCS in a stream,
+//actualizing the actual position list APL.
+//If APL is NULL, all instructions shall be MM.
+void TMotionProgram::writeMCSprogram(ostream& os, const string& label, unsigned int Bid,
+    TPairPositionAnglesList *APL) const
+{
+    //print the label of the motion program and their start delimiter
+    os << label << "_" << inttostr(int(Bid)) << " {";
+
     //for each list of message of instructions of the motion program
     //  print a group
     for(int i=0; i<getCount(); i++) {
@@ -242,7 +257,7 @@ void TMotionProgram::getMCStext(string& str, const string& label, unsigned int B
         //PRINT THE GROUP CORRESPONDING TO THE INDICATED MESSAGE LIST:
 
         //print the label of the indicated group and their start delimiter
-        str += "\r\n\tgroup_"+inttostr(i+1)+" {";
+        os << "\r\n\tgroup_" << inttostr(i+1) << " {";
 
         //print the label of the indicated group and their start delimiter
         //inserting zeros on the left:	
@@ -254,11 +269,15 @@ void TMotionProgram::getMCStext(string& str, const string& label, unsigned int B
             const TMessageInstruction *MI = ML->GetPointer(j);
 
             //search and point the corresponding PPA
-            int id = MI->getId();
-            int k = APL.searchId(id);
-            if(k >= APL.getCount())
+            //(the MM instructions don't need it)
+            TPairPositionAngles *PPA = NULL;
+            if(APL != NULL) {
+                int k = APL->searchId(MI->getId());
+                if(k >= APL->getCount())
+                    throw EImpossibleError("lateral effect");
+                PPA = APL->GetPointer(k);
+            } else if(MI->Instruction.getName() != "MM")
                 throw EImpossibleError("lateral effect");
-            TPairPositionAngles *PPA = APL.GetPointer(k);
 
             //print the corresponding instruction in the MCS format
             if(MI->Instruction.getName() == "M1") {
@@ -267,10 +286,10 @@ void TMotionProgram::getMCStext(string& str, const string& label, unsigned int B
                 double r2_final_position = PPA->p___3;
 
                 //print the instruction in the MCS format
-                str += "\r\n\trp"+MI->getIdText().str+" r1";
-                str += " "+floattostr(r1_final_position);
-                str += "\r\n\trp"+MI->getIdText().str+" r2";
-                str += " "+floattostr(-r2_final_position);
+                os << "\r\n\trp" << MI->getIdText().str << " r1";
+                os << " " << floattostr(r1_final_position);
+                os << "\r\n\trp" << MI->getIdText().str << " r2";
+                os << " " << floattostr(-r2_final_position);
 
                 //print the instruction in the MCS format
                 //inserting zeros on the left:
@@ -288,10 +307,10 @@ void TMotionProgram::getMCStext(string& str, const string& label, unsigned int B
                 double r2_final_position = MI->Instruction.Args[0];
 
                 //print the instruction in the MCS format
-                str += "\r\n\trp"+MI->getIdText().str+" r1";
-                str += " "+floattostr(r1_final_position);
-                str += "\r\n\trp"+MI->getIdText().str+" r2";
-                str += " "+floattostr(-r2_final_position);
+                os << "\r\n\trp" << MI->getIdText().str << " r1";
+                os << " " << floattostr(r1_final_position);
+                os << "\r\n\trp" << MI->getIdText().str << " r2";
+                os << " " << floattostr(-r2_final_position);
 
                 //print the instruction in the MCS format
                 //inserting zeros on the left:
@@ -309,10 +328,10 @@ void TMotionProgram::getMCStext(string& str, const string& label, unsigned int B
                 double r2_final_position = MI->Instruction.Args[1];
 
                 //print the instruction in the MCS format
-                str += "\r\n\trp"+MI->getIdText().str+" r1";
-                str += " "+floattostr(r1_final_position);
-                str += "\r\n\trp"+MI->getIdText().str+" r2";
-                str += " "+floattostr(-r2_final_position);
+                os << "\r\n\trp" << MI->getIdText().str << " r1";
+                os << " " << floattostr(r1_final_position);
+                os << "\r\n\trp" << MI->getIdText().str << " r2";
+                os << " " << floattostr(-r2_final_position);
 
                 //print the instruction in the MCS format
                 //inserting zeros on the left:
@@ -322,18 +341,29 @@ void TMotionProgram::getMCStext(string& str, const string& label, unsigned int B
                 //str += " "+floattostr(r2_final_position);
 
                 //actualice the actual position
-                PPA->p_1 = r1_final_position;
-                PPA->p___3 = r2_final_position;
+                if(PPA != NULL) {
+                    PPA->p_1 = r1_final_position;
+                    PPA->p___3 = r2_final_position;
+                }
 
             } else
                 throw EImpossibleError("lateral effect");
         }
 
         //print the end delimiter of the indicated group
-        str += "\r\n\t}";
+        os << "\r\n\t}";
     }
     //print the end delimiter of motion program
-    str += "\r\n}";
+    os << "\r\n}";
+}
+
+//Get a motion progam in the format of the MCS.
+void TMotionProgram::getMCStext(string& str, const string& label, unsigned int Bid,
+    const TPairPositionAnglesList& SPL) const
+{
+    ostringstream os;
+    writeMCStext(os, label, Bid, SPL);
+    str = os.str();
 }
 
 //get the motion program in format JSON
@@ -460,6 +490,91 @@ Json::Value TMotionProgram::getJSON(const TPairPositionAnglesList& SPL) const
     return MP_json;
 }
 
+//write the motion program in format JSON
+//(like getJSON, but without build the JSON object)
+void TMotionProgram::writeJSON(TJSONWriter& W, const TPairPositionAnglesList& SPL) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(SPL.notAllAreReferredToDifferentRPs())
+        throw EImproperArgument("all PPAs of the SPL must be referred to different RPs");
+
+    TVector<int> Ids;
+    getAllIncludedIds(Ids);
+    if(SPL.notAllIdsAreFound(Ids))
+        throw EImproperArgument("all RPs included in the MP, must be in included in the SPL");
+
+    //PRINT THE MOTION PROGRAM:
+
+    //an empty JSON array is a null value
+    if(getCount() <= 0) {
+        W.valueNull();
+        return;
+    }
+
+    //actualize the actual position list
+    TPairPositionAnglesList APL = SPL;
+
+    //for each list of message of instructions of the motion program
+    //  print a group
+    W.beginArray();
+    for(int i=0; i<getCount(); i++) {
+        //points the indicated message list to facilitate its access
+        const TMessageList *ML = Items[i];
+
+        //an empty JSON array is a null value
+        if(ML->getCount() <= 0) {
+            W.valueNull();
+            continue;
+        }
+
+        //for each MI of the list, prints the corresponding instruction, and actualice the APL
+        W.beginArray();
+        for(int j=0; j<ML->getCount(); j++) {
+            //point the indicated MI to facilitate its access
+            const TMessageInstruction *MI = ML->GetPointer(j);
+
+            //search and point the corresponding PPA
+            int id = MI->getId();
+            int k = APL.searchId(id);
+            if(k >= APL.getCount())
+                throw EImpossibleError("lateral effect");
+            TPairPositionAngles *PPA = APL.GetPointer(k);
+
+            //get the final position of the rotors, and actualice the actual position
+            double r1_final_position;
+            double r2_final_position;
+            if(MI->Instruction.getName() == "M1") {
+                r1_final_position = MI->Instruction.Args[0];
+                r2_final_position = PPA->p___3;
+                PPA->p_1 = r1_final_position;
+            } else if(MI->Instruction.getName() == "M2") {
+                r1_final_position = PPA->p_1;
+                r2_final_position = MI->Instruction.Args[0];
+                PPA->p___3 = r2_final_position;
+            } else if(MI->Instruction.getName() == "MM") {
+                r1_final_position = MI->Instruction.Args[0];
+                r2_final_position = MI->Instruction.Args[1];
+                PPA->p_1 = r1_final_position;
+                PPA->p___3 = r2_final_position;
+            } else
+                throw EImpossibleError("lateral effect");
+
+            //print the instruction in the MCS format
+            W.beginObject();
+            W.name("r1");
+            W.value(round(r1_final_position));
+            W.name("r2");
+            W.value(round(-r2_final_position));
+            W.name("rp");
+            W.value(MI->getId());
+            W.endObject();
+        }
+        W.endArray();
+    }
+    W.endArray();
+}
+
 //Set a motion progam in the MCS format of the MCS.
 void TMotionProgram::setMCStext(string& label, unsigned int& Bid, const string& str)
 {
@@ -631,6 +746,391 @@ void TMotionProgram::setMCStext(string& label, unsigned int& Bid, const string&
     Bid = (unsigned int)t_Bid;
 }
 
+//Write a motion program in the MCS format in a stream,
+//when all its instructions are MM (like the MPs set by setMCStext),
+//so the SPL isn't necessary.
+void TMotionProgram::writeMCStext(ostream& os, const string& label, unsigned int Bid) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(label!="pos" && label!="depos")
+        throw EImproperArgument("MP label should be \"pos\" or \"depos\"");
+
+    if(int(Bid) < 0)
+        throw EImproperArgument("block identifier Bid should be less maximun integer value");
+
+    for(int i=0; i<getCount(); i++) {
+        const TMessageList *ML = Items[i];
+        for(int j=0; j<ML->getCount(); j++)
+            if(ML->GetPointer(j)->Instruction.getName() != "MM")
+                throw EImproperCall("all instructions should be MM for write the MP without SPL");
+    }
+
+    //PRINT THE MOTION PROGRAM:
+
+    writeMCSprogram(os, label, Bid, NULL);
+}
+
+//---------------------------------------------------------------------------
+//COMPACT BINARY FORMAT OF THE MPs:
+
+//identifier of the MPs in binary format
+static const char MPBIN_MAGIC[4] = {'F','M','P','B'};
+//version of the binary format of the MPs
+static const unsigned char MPBIN_VERSION = 1;
+
+//table of opcodes of the instructions, and their number of arguments
+static const char *MPBIN_OPCODES[8] = {"", "MA", "MS", "M1", "M2", "MM", "ST", "SP"};
+static const int MPBIN_NARGS[8] = {0, 0, 0, 1, 1, 2, 0, 0};
+//opcode of the instruction M2, which moves the rotor 2
+#define MPBIN_OPCODE_M2 4
+
+//fields of the header byte of a MI
+#define MPBIN_OPCODE 0x07
+#define MPBIN_DSEC 0x08
+#define MPBIN_DMIN 0x10
+#define MPBIN_DEND 0x20
+#define MPBIN_RAW 0x40 //flag of the first argument written raw
+
+//maximun absolute value of the positions written as integers
+//(2^53, so that all integers are exactly representable in a double)
+static const long long MPBIN_MAX_STEPS = 9007199254740992LL;
+
+//last positions of the rotors of a RP
+struct TMPBinRotors {
+    long long p[2];
+};
+
+//identifiers of RP less than this are indexed in a dense vector,
+//and the others (which are unusual) in a map
+static const int MPBIN_DENSE_IDS = 65536;
+
+//last positions of the rotors of each RP, indexed by identifier
+class TMPBinLast {
+    vector<TMPBinRotors> dense;
+    map<int, TMPBinRotors> sparse;
+
+public:
+    //get the last positions of the rotors of a RP
+    //(the references are valid until the next call)
+    TMPBinRotors& get(int Id) {
+        if(Id >= MPBIN_DENSE_IDS)
+            return sparse[Id];
+        if(Id >= int(dense.size())) {
+            TMPBinRotors R = {{0, 0}};
+            dense.resize(Id + 1, R);
+        }
+        return dense[Id];
+    }
+};
+
+//functions for write a MP in binary format:
+
+static void putVarUInt(string& bin, unsigned long long x)
+{
+    while(x >= 0x80) {
+        bin += char((x & 0x7F) | 0x80);
+        x >>= 7;
+    }
+    bin += char(x);
+}
+static void putVarInt(string& bin, long long x)
+{
+    putVarUInt(bin, ((unsigned long long)x << 1) ^ (unsigned long long)(x >> 63));
+}
+static void putRawDouble(string& bin, double x)
+{
+    uint64_t aux;
+    memcpy(&aux, &x, sizeof(aux));
+    for(int i=0; i<8; i++) {
+        bin += char(aux & 0xFF);
+        aux >>= 8;
+    }
+}
+static void putString(string& bin, const string& str)
+{
+    putVarUInt(bin, str.length());
+    bin += str;
+}
+//determine if a position can be written as an integer
+static bool isSteps(double x)
+{
+    return x == floor(x) && fabs(x) <= double(MPBIN_MAX_STEPS) &&
+            !(x == 0 && signbit(x));
+}
+
+//functions for read a MP in binary format:
+
+//cursor in a MP in binary format
+struct TMPBinCursor {
+    const char *p;
+    const char *end;
+};
+
+static unsigned char getByte(TMPBinCursor& C)
+{
+    if(C.p >= C.end)
+        throw EImproperArgument("unexpected end of binary");
+    return (unsigned char)*C.p++;
+}
+static unsigned long long getVarUInt(TMPBinCursor& C)
+{
+    unsigned long long x = 0;
+    for(int shift=0; shift<64; shift+=7) {
+        unsigned char b = getByte(C);
+        x |= (unsigned long long)(b & 0x7F) << shift;
+        if(b < 0x80)
+            return x;
+    }
+    throw EImproperArgument("improper varint");
+}
+static long long getVarInt(TMPBinCursor& C)
+{
+    unsigned long long x = getVarUInt(C);
+    return (long long)(x >> 1) ^ -(long long)(x & 1);
+}
+static double getRawDouble(TMPBinCursor& C)
+{
+    if(C.end - C.p < 8)
+        throw EImproperArgument("unexpected end of binary");
+    uint64_t aux = 0;
+    for(int i=7; i>=0; i--)
+        aux = (aux << 8) | (unsigned char)C.p[i];
+    C.p += 8;
+    double x;
+    memcpy(&x, &aux, sizeof(x));
+    return x;
+}
+static void getString(string& str, TMPBinCursor& C)
+{
+    unsigned long long n = getVarUInt(C);
+    if((unsigned long long)(C.end - C.p) < n)
+        throw EImproperArgument("unexpected end of binary");
+    str.assign(C.p, n);
+    C.p += n;
+}
+//get a number of items, each one with a size of least one byte
+static int getItemsCount(TMPBinCursor& C)
+{
+    unsigned long long n = getVarUInt(C);
+    if((unsigned long long)(C.end - C.p) < n)
+        throw EImproperArgument("improper number of items");
+    return int(n);
+}
+//get a nonnegative integer
+static int getNonnegativeInt(TMPBinCursor& C)
+{
+    unsigned long long x = getVarUInt(C);
+    if(x > (unsigned long long)INT_MAX)
+        throw EImproperArgument("integer out of range");
+    return int(x);
+}
+
+//Encode the motion program in the compact binary format.
+void TMotionProgram::encode(string& bin, const string& label, unsigned int Bid) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(int(Bid) < 0)
+        throw EImproperArgument("block identifier Bid should be less maximun integer value");
+
+    //ENCODE THE MOTION PROGRAM:
+
+    string t_bin;
+    t_bin.append(MPBIN_MAGIC, sizeof(MPBIN_MAGIC));
+    t_bin += char(MPBIN_VERSION);
+    putString(t_bin, label);
+    putVarUInt(t_bin, Bid);
+
+    //last positions of the rotors of each RP
+    TMPBinLast last;
+
+    putVarUInt(t_bin, getCount());
+    for(int i=0; i<getCount(); i++) {
+        const TMessageList *ML = Items[i];
+        putVarUInt(t_bin, ML->getCount());
+        for(int j=0; j<ML->getCount(); j++) {
+            const TMessageInstruction *MI = ML->GetPointer(j);
+            const TInstruction& I = MI->Instruction;
+
+            //search the opcode of the instruction
+            string name = I.getName().str;
+            int op = 0;
+            while(op < 8 && name != MPBIN_OPCODES[op])
+                op++;
+            if(op >= 8)
+                throw EImpossibleError("lateral effect");
+            if(I.Args.getCount() != MPBIN_NARGS[op])
+                throw EImproperCall("instruction "+name+" should have "+inttostr(MPBIN_NARGS[op])+" arguments");
+
+            //build the header byte
+            unsigned char header = op;
+            if(MI->getCommentDsec().length() > 0)
+                header |= MPBIN_DSEC;
+            if(MI->getCommentDmin().length() > 0)
+                header |= MPBIN_DMIN;
+            if(MI->getCommentDend().length() > 0)
+                header |= MPBIN_DEND;
+            for(int k=0; k<I.Args.getCount(); k++)
+                if(!isSteps(I.Args[k]))
+                    header |= MPBIN_RAW << k;
+
+            t_bin += char(header);
+            putVarUInt(t_bin, MI->getId());
+
+            //write the arguments
+            if(I.Args.getCount() > 0) {
+                TMPBinRotors& R = last.get(MI->getId());
+                for(int k=0; k<I.Args.getCount(); k++) {
+                    if(header & (MPBIN_RAW << k))
+                        putRawDouble(t_bin, I.Args[k]);
+                    else {
+                        long long& p = R.p[op == MPBIN_OPCODE_M2 ? 1 : k];
+                        long long x = (long long)I.Args[k];
+                        putVarInt(t_bin, x - p);
+                        p = x;
+                    }
+                }
+            }
+
+            //write the non empty comments
+            if(header & MPBIN_DSEC)
+                putString(t_bin, MI->getCommentDsec());
+            if(header & MPBIN_DMIN)
+                putString(t_bin, MI->getCommentDmin());
+            if(header & MPBIN_DEND)
+                putString(t_bin, MI->getCommentDend());
+        }
+    }
+
+    bin = t_bin;
+}
+
+//Decode a motion program in the compact binary format.
+void TMotionProgram::decode(string& label, unsigned int& Bid, const string& bin)
+{
+    try {
+        TMPBinCursor C = {bin.data(), bin.data() + bin.length()};
+
+        //check the identifier and the version
+        if(bin.length() < sizeof(MPBIN_MAGIC) ||
+                memcmp(C.p, MPBIN_MAGIC, sizeof(MPBIN_MAGIC)) != 0)
+            throw EImproperArgument("binary isn't a motion program");
+        C.p += sizeof(MPBIN_MAGIC);
+        unsigned char version = getByte(C);
+        if(version != MPBIN_VERSION)
+            throw EImproperArgument("version "+inttostr(int(version))+" not supported");
+
+        //tampon variables
+        TMotionProgram MP;
+        string t_label;
+        unsigned int t_Bid;
+
+        getString(t_label, C);
+        t_Bid = getNonnegativeInt(C);
+
+        //last positions of the rotors of each RP
+        TMPBinLast last;
+
+        //instruction of each opcode, which is copied in the MIs
+        //instead of set the name of each one
+        TInstruction Instructions[8];
+        for(int op=0; op<8; op++)
+            Instructions[op].setName(MPBIN_OPCODES[op]);
+
+        int nML = getItemsCount(C);
+        MP.setCapacity(max(1, nML));
+        for(int i=0; i<nML; i++) {
+            int nMI = getItemsCount(C);
+            TMessageList *ML = new TMessageList(max(1, nMI));
+            MP.Add(ML);
+            for(int j=0; j<nMI; j++) {
+                unsigned char header = getByte(C);
+                int op = header & MPBIN_OPCODE;
+                int nargs = MPBIN_NARGS[op];
+                if(header & ~((MPBIN_RAW << nargs) - 1))
+                    throw EImproperArgument("improper flags of raw arguments");
+
+                TMessageInstruction *MI = new TMessageInstruction();
+                ML->Add(MI);
+                MI->setId(getNonnegativeInt(C));
+                MI->Instruction = Instructions[op];
+
+                //read the arguments
+                if(nargs > 0) {
+                    TMPBinRotors& R = last.get(MI->getId());
+                    for(int k=0; k<nargs; k++) {
+                        if(header & (MPBIN_RAW << k))
+                            MI->Instruction.Args[k] = getRawDouble(C);
+                        else {
+                            long long& p = R.p[op == MPBIN_OPCODE_M2 ? 1 : k];
+                            long long d = getVarInt(C);
+                            if(d < -2*MPBIN_MAX_STEPS || 2*MPBIN_MAX_STEPS < d ||
+                                    p + d < -MPBIN_MAX_STEPS || MPBIN_MAX_STEPS < p + d)
+                                throw EImproperArgument("position out of range");
+                            p += d;
+                            MI->Instruction.Args[k] = double(p);
+                        }
+                    }
+                }
+
+                //read the non empty comments
+                string comment;
+                if(header & MPBIN_DSEC) {
+                    getString(comment, C);
+                    MI->setCommentDsec(comment);
+                }
+                if(header & MPBIN_DMIN) {
+                    getString(comment, C);
+                    MI->setCommentDmin(comment);
+                }
+                if(header & MPBIN_DEND) {
+                    getString(comment, C);
+                    MI->setCommentDend(comment);
+                }
+            }
+        }
+
+        if(C.p < C.end)
+            throw EImproperArgument("unexpected data at the end of binary");
+
+        //set the tampon variables
+        Clear();
+        if(getCapacity() < MP.getCount())
+            setCapacity(MP.getCount());
+        for(int i=0; i<MP.getCount(); i++)
+            Add(MP.GetPointer(i));
+        MP.ClearWithoutDestroy();
+        label = t_label;
+        Bid = t_Bid;
+
+    } catch(Exception& E) {
+        E.Message.Insert(1, "decoding motion program: ");
+        throw;
+    }
+}
+
+//convert a MP in the MCS format to the compact binary format
+void TMotionProgram::MCStextToBinary(string& bin, const string& str)
+{
+    TMotionProgram MP;
+    string label;
+    unsigned int Bid;
+    MP.setMCStext(label, Bid, str);
+    MP.encode(bin, label, Bid);
+}
+//convert a MP in the compact binary format to the MCS format
+void TMotionProgram::binaryToMCStext(string& str, const string& bin)
+{
+    TMotionProgram MP;
+    string label;
+    unsigned int Bid;
+    MP.decode(label, Bid, bin);
+    ostringstream os;
+    MP.writeMCStext(os, label, Bid);
+    str = os.str();
+}
+
 //Get MP-Dmins in the MCS format of the MCS.
 //Inputs:
 //  label: string labeling all the MP-Dmin.
@@ -28,6 +28,7 @@
 #include "MessageInstruction.h"
 #include "PointersList.h"
 #include "PairPositionAngles.h"
+#include "JSONWriter.h"
 
 #include <jsoncpp/json/json.h>
 
@@ -44,7 +45,7 @@ namespace Positioning {
 //---------------------------------------------------------------------------
 
 //lista de mensajes de instrucción
-class TMessageList : public TPointersList<TMessageInstruction> {
+class TMessageList : public TPointersList<TMessageInstruction>, public TArenaItem {
     //AnsiString p_Label; void SetLabel(const AnsiString&);
 
 public:
@@ -80,6 +81,12 @@ public:
 
 //class motion program
 class TMotionProgram : public TPointersList<TMessageList> {
+    //Write a motion program in the format of the MCS in a stream,
+    //actualizing the actual position list APL.
+    //If APL is NULL, all instructions shall be MM.
+    void writeMCSprogram(ostream& os, const string& label, unsigned int Bid,
+                         TPairPositionAnglesList *APL) const;
+
 public:
     //determines if there is some coment Dsec in any instruction
     //of the the motion program
@@ -113,9 +120,16 @@ public:
     //  All RPs included in the MP, must be in included in the SPL.
     void getMCStext(string& str, const string& label, unsigned int Bid,
                           const TPairPositionAnglesList& SPL) const;
+    //Write a motion progam in the format of the MCS in a stream,
+    //with the same inputs and preconditions as getMCStext.
+    void writeMCStext(ostream& os, const string& label, unsigned int Bid,
+                      const TPairPositionAnglesList& SPL) const;
 
     //get the motion program in format JSON
     Json::Value getJSON(const TPairPositionAnglesList& SPL) const;
+    //write the motion program in format JSON
+    //(like getJSON, but without build the JSON object)
+    void writeJSON(TJSONWriter& W, const TPairPositionAnglesList& SPL) const;
 
     //Values for label:
     //  "obs depos" for depositioning programs
@@ -134,6 +148,39 @@ public:
     void setMCStext(string& label, unsigned int& Bid,
                           const string& str);
 
+    //The compact binary format of the MPs is intended for archive
+    //and exchange the MPs between processes:
+    //  magic "FMPB", version, label and Bid;
+    //  number of groups, and for each group its number of MIs;
+    //  for each MI: a byte with the opcode of the instruction (3 bits),
+    //  the flags of the non empty comments (3 bits) and the flags of
+    //  the arguments written raw (2 bits); the RP identifier (varint);
+    //  the arguments and the non empty comments.
+    //The integer arguments (positions of the rotors in steps) are written
+    //as the zigzag varint of the difference with the previous position
+    //of the same rotor of the same RP, and the other arguments are written
+    //raw (8 bytes little endian), so the encoding is lossless.
+
+    //Encode the motion program in the compact binary format.
+    //Inputs:
+    //  label: string labeling the MP.
+    //  Bid: univoque identifier of the CB.
+    void encode(string& bin, const string& label, unsigned int Bid) const;
+    //Decode a motion program in the compact binary format.
+    //If the binary isn't a valid encoded MP:
+    //  throw EImproperArgument
+    void decode(string& label, unsigned int& Bid, const string& bin);
+
+    //Write a motion program in the MCS format in a stream,
+    //when all its instructions are MM (like the MPs set by setMCStext),
+    //so the SPL isn't necessary.
+    void writeMCStext(ostream& os, const string& label, unsigned int Bid) const;
+
+    //convert a MP in the MCS format to the compact binary format
+    static void MCStextToBinary(string& bin, const string& str);
+    //convert a MP in the compact binary format to the MCS format
+    static void binaryToMCStext(string& str, const string& bin);
+
     //Get MP-Dmins in the MCS format.
     //Inputs:
     //  label: string labeling all the MP-Dmin.
@@ -30,8 +30,11 @@
 #include "OutputsParkProg.h" //for function generateParkProg_online
 #include "OutputsPairPPDP.h" //for function generatePairPPDP_online
 #include "adjacentitem.h"
+#include "Arena.h"
+#include "RoboticPositionerSet.h"
 
 #include <algorithm> //std::min, std::max
+#include <vector>
 
 //---------------------------------------------------------------------------
 
@@ -79,41 +82,41 @@ void TMotionProgramGenerator::segregateRPsInDisjointSets(
     //shall be taken how obstacles, so that the sets separated only for
     //these RPs, are disjoint sets.
 
+    //get the adjacency graph of the RPs of the FMM
+    const TRoboticPositionerList& RPL = getFiberMOSModel()->RPL;
+    const TAdjacencyGraph& G = RPL.getAdjacency();
+
+    //disjoint set which contains each RP of the FMM (or NULL)
+    vector<TRoboticPositionerList*> SetOf(G.getRPsCount(), (TRoboticPositionerList*)NULL);
+    //set of RPs of the list Outsiders
+    TRoboticPositionerSet OutsidersSet(Outsiders);
+    for(int i=0; i<Outsiders.getCount(); i++)
+        if(RPL.search(Outsiders[i]) >= RPL.getCount())
+            throw EImproperArgument("all RPs in the list Outsiders shall be in the Fiber MOS Model");
+
     //for each RP of the list Outsiders
     for(int i=0; i<Outsiders.getCount(); i++) {
         //points the indicated RP to facilitate its access
         TRoboticPositioner *RP = Outsiders[i];
+        int n = RPL.search(RP);
 
-        //determines the list of adjacent RPs which are in insecurity position
-        //and are in the list Outsiders
-        TItemsList<TRoboticPositioner*> Adjacents;
-        for(int j=0; j<RP->getActuator()->AdjacentRPs.getCount(); j++) {
-            TRoboticPositioner *RPA = RP->getActuator()->AdjacentRPs[j].RP;
-            if(RPA->getActuator()->ArmIsOutSafeArea()) {
-                int k = Outsiders.Search(RPA);
-                if(k < Outsiders.getCount())
-                    Adjacents.Add(RPA);
-            }
-        }
-
-        //NOTE: list Adjacents is of type TItemsList<TRoboticPositioner*>,
-        //not TRoboticPositionerList.
-
-        //Here has been found the adjacents of a RP in the list RP->getActuator()->AdjacentRPs.
-        //The content of that list is determined when the instance of the Fiber MOS Model is assimilated.
-        //That list will contains the RPs whose points P0 are to a distance less than:
+        //Here has been found the adjacents of a RP in the adjacency graph of the FMM.
+        //The content of that graph is determined when the instance of the Fiber MOS Model is assimilated.
+        //That graph will contains the RPs whose points P0 are to a distance less than:
         //  RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
         //  RPj->getActuator()->getr_max() + RPj->getActuator()->getSPMall_a()
 
-        //search the adjacents in the disjoint sets
+        //search the disjoint sets which contains the adjacent RPs
+        //which are in insecurity position and are in the list Outsiders
         TVector<int> index;
-        for(int j=0; j<Adjacents.getCount(); j++) {
-            TRoboticPositioner *RPA = Adjacents[j];
-            for(int k=0; k<DisjointSets.getCount(); k++) {
-                TRoboticPositionerList *Set = DisjointSets.GetPointer(k);
-                int l = Set->Search(RPA);
-                int m = index.Search(k);
-                if(l<Set->getCount() && m>=index.getCount())
+        for(const TAdjacencyEdge *E=G.beginRPs(n); E!=G.endRPs(n); E++) {
+            TRoboticPositionerList *Set = SetOf[E->Target];
+            if(Set!=NULL && OutsidersSet.contains(G.getRP(E->Target)) &&
+                    G.getRP(E->Target)->getActuator()->ArmIsOutSafeArea()) {
+                int k = 0;
+                while(DisjointSets.GetPointer(k) != Set)
+                    k++;
+                if(index.Search(k) >= index.getCount())
                     index.Add(k);
             }
         }
@@ -124,6 +127,7 @@ void TMotionProgramGenerator::segregateRPsInDisjointSets(
             TRoboticPositionerList *Set = new TRoboticPositionerList();
             Set->Add(RP);
             DisjointSets.Add(Set);
+            SetOf[n] = Set;
         }
         //if has found some adjacent in the disjoint sets
         else {
@@ -135,12 +139,14 @@ void TMotionProgramGenerator::segregateRPsInDisjointSets(
                 for(int k=0; k<SetToAdd->getCount(); k++) {
                     TRoboticPositioner *RPToAdd = SetToAdd->Get(k);
                     Set->Add(RPToAdd);
+                    SetOf[RPL.search(RPToAdd)] = Set;
                 }
             }
             for(int j=index.getCount()-1; j>=1; j--)
                 DisjointSets.Delete(index[j]);
             //add the RP to the Set
             Set->Add(RP);
+            SetOf[n] = Set;
         }
     }
 }
@@ -639,8 +645,9 @@ bool TMotionProgramGenerator::searchSolutionInNegativeSense(double& p_1new, TRob
     //Therefore will be checked the proposed solution with a single adjacent every time.
     //The content of the list of adjacents shall be restablished at the end of the process.
 
-    //save the content of the list of adjacents
-    TAdjacentRPList AdjacentRPs = RP->getActuator()->AdjacentRPs;
+    //save the content of the list of adjacents (without copy it)
+    TAdjacentRPList AdjacentRPs;
+    AdjacentRPs.swap(RP->getActuator()->AdjacentRPs);
 
     //suppose that there is solution until the contrary is proved
     bool there_is_solution = true;
@@ -656,7 +663,7 @@ bool TMotionProgramGenerator::searchSolutionInNegativeSense(double& p_1new, TRob
         //point the next adjacent RP single in the list of adjacents
         TRoboticPositioner *RPA = AdjacentRPs[i].RP;
         RP->getActuator()->AdjacentRPs.Clear();
-        RP->getActuator()->AdjacentRPs.Add(new TAdjacentRP(RPA));
+        RP->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPA));
 
         //determine if the MP is valid (with the single adjacent)
         there_is_solution = motionProgramsAreValid(RP->MPturn, RP->MPretraction);
@@ -712,7 +719,7 @@ bool TMotionProgramGenerator::searchSolutionInNegativeSense(double& p_1new, TRob
     }
 
     //restablish the content of the list of adjacents
-    RP->getActuator()->AdjacentRPs = AdjacentRPs;
+    RP->getActuator()->AdjacentRPs.swap(AdjacentRPs);
 
     //indicates if there is a solution or not
     return there_is_solution;
@@ -790,8 +797,9 @@ bool TMotionProgramGenerator::searchSolutionInPositiveSense(double& p_1new, TRob
     //Therefore will be checked the proposed solution with a single adjacent every time.
     //The content of the list of adjacents shall be restablished at the end of the process.
 
-    //save the content of the list of adjacents
-    TAdjacentRPList AdjacentRPs = RP->getActuator()->AdjacentRPs;
+    //save the content of the list of adjacents (without copy it)
+    TAdjacentRPList AdjacentRPs;
+    AdjacentRPs.swap(RP->getActuator()->AdjacentRPs);
 
     //suppose that there is solution until the contrary is proved
     bool there_is_solution = true;
@@ -807,7 +815,7 @@ bool TMotionProgramGenerator::searchSolutionInPositiveSense(double& p_1new, TRob
         //point the next RP single in the list of adjacents
         TRoboticPositioner *RP_ = AdjacentRPs[i].RP;
         RP->getActuator()->AdjacentRPs.Clear();
-        RP->getActuator()->AdjacentRPs.Add(new TAdjacentRP(RP_));
+        RP->getActuator()->AdjacentRPs.Add(TAdjacentRP(RP_));
 
         //determine if the MP is valid (with the single adjacent)
         there_is_solution = motionProgramsAreValid(RP->MPturn, RP->MPretraction);
@@ -863,7 +871,7 @@ bool TMotionProgramGenerator::searchSolutionInPositiveSense(double& p_1new, TRob
     }
 
     //restablish the content of the list of adjacents
-    RP->getActuator()->AdjacentRPs = AdjacentRPs;
+    RP->getActuator()->AdjacentRPs.swap(AdjacentRPs);
 
     //indicates if there is a solution or not
     return there_is_solution;
@@ -994,6 +1002,9 @@ void TMotionProgramGenerator::segregateRecoverables(
             throw EImproperCall("all RPs of the Fiber MOS Model should be configurated for MP generation");
     }
 
+    //set of RPs of the Fiber MOS Model
+    TRoboticPositionerSet FMMRPs(getFiberMOSModel()->RPL);
+
     //All RPs of DDS:
     //  shall be in the Fiber MOS  Model;
     //  shall be in unsecurity position;
@@ -1006,8 +1017,7 @@ void TMotionProgramGenerator::segregateRecoverables(
             TRoboticPositionerList *DisperseSubset = DisjointSet->GetPointer(j);
             for(int k=0; k<DisperseSubset->getCount(); k++) {
                 TRoboticPositioner *RP = DisperseSubset->Get(k);
-                int l = getFiberMOSModel()->RPL.Search(RP);
-                if(l >= getFiberMOSModel()->RPL.getCount())
+                if(!FMMRPs.contains(RP))
                     throw EImproperArgument("all RPs of DDS should be in the Fiber MOS Model");
                 if(RP->getActuator()->ArmIsInSafeArea())
                     throw EImproperArgument("all RPs of DDS should be in unsecurity position");
@@ -1309,6 +1319,232 @@ void TMotionProgramGenerator::addMessageListToGoToTheOrigins(TMotionProgram& DP,
         delete ML;
 }
 
+//Determines if a message list only contains MIs to go to the origins.
+//Inputs:
+//  ML: message list to check.
+//Outputs:
+//  messageListGoesToTheOrigins: flag indicating if the ML is not empty
+//      and all their MIs are addressed to RPs of the FMM, with
+//      instructions whose final positions are the origins.
+bool TMotionProgramGenerator::messageListGoesToTheOrigins(const TMessageList *ML) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(ML == NULL)
+        throw EImproperArgument("pointer ML should point to built message list");
+
+    //MAKE ACTIONS:
+
+    if(ML->getCount() <= 0)
+        return false;
+
+    //for each MI of the ML
+    for(int i=0; i<ML->getCount(); i++) {
+        const TMessageInstruction *MI = ML->GetPointer(i);
+
+        //search the addressed RP
+        int j = getFiberMOSModel()->RPL.searchId(MI->getId());
+        if(j >= getFiberMOSModel()->RPL.getCount())
+            return false;
+        TRoboticPositioner *RP = getFiberMOSModel()->RPL[j];
+
+        //determine the position of the origin of each rotor
+        double p_1origin = max(0., ceil(RP->getActuator()->getp_1min()));
+        double p___3origin = max(0., ceil(RP->getActuator()->getArm()->getp___3min()));
+
+        //check if the final positions of the instruction are the origins
+        const TInstruction& I = MI->Instruction;
+        if(I.getName() == "MM") {
+            if(I.Args.getCount()!=2 || I.Args[0]!=p_1origin || I.Args[1]!=p___3origin)
+                return false;
+        } else if(I.getName() == "M1") {
+            if(I.Args.getCount()!=1 || I.Args[0]!=p_1origin)
+                return false;
+        } else if(I.getName() == "M2") {
+            if(I.Args.getCount()!=1 || I.Args[0]!=p___3origin)
+                return false;
+        } else
+            return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------
+//METHODS FOR REGENERATE MPs IN LIMITED SENSE:
+
+//Determines if a RP can replace other RP for observe their PP.
+//Inputs:
+//  RRP: the candidate to replacement RP.
+//  A: allocation of the RP to be replaced.
+//Outputs:
+//  isReplacementRP: flag indicating if the RRP:
+//      is not the RP to be replaced;
+//      contains the PP in their domain of P3;
+//      is operative and not allocated;
+//      has the unsecurity area clear, and it will stay clear.
+//Preconditions:
+//  The RRP shall be in the Fiber MOS Model.
+bool TMotionProgramGenerator::isReplacementRP(TRoboticPositioner *RRP,
+                                              const TAllocation *A) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(RRP == NULL)
+        throw EImproperArgument("pointer RRP should point to built robotic positioner");
+    if(A == NULL)
+        throw EImproperArgument("pointer A should point to built allocation");
+
+    //MAKE ACTIONS:
+
+    //the RRP shall be other RP
+    if(RRP == A->getRP())
+        return false;
+
+    //the PP allocated to the RP shall be in the scope of the RRP
+    if(!RRP->getActuator()->pointIsInDomainP3(A->PP))
+        return false;
+
+    //the RRP shall be operative and shall not be allocated
+    if(!RRP->getOperative())
+        return false;
+    if(searchAllocation(RRP) < getCount())
+        return false;
+
+    //check if the unsecurity area of the replacement RP is clear and will stay clear
+    const TRoboticPositionerList& RPL = getFiberMOSModel()->RPL;
+    const TAdjacencyGraph& G = RPL.getAdjacency();
+    int n = RPL.search(RRP);
+    if(n >= RPL.getCount())
+        throw EImproperArgument("the RRP should be in the Fiber MOS Model");
+    for(const TAdjacencyEdge *E=G.beginRPs(n); E!=G.endRPs(n); E++) {
+        TRoboticPositioner *RPA = G.getRP(E->Target);
+
+        //if the RPA is operative
+        //must be in security area, and if it has allocated PP,
+        //this must be in the security area
+        if(RPA->getOperative()) {
+            if(!RPA->getActuator()->ArmIsInSafeArea())
+                return false;
+            int l = searchAllocation(RPA);
+            if(l < getCount()) {
+                TDoublePoint PP = Items[l]->PP;
+                if(!RPA->getActuator()->pointIsInSecurityArea(PP))
+                    return false;
+            }
+        }
+
+        //if the RPA is not operative
+        //must be non invading the maneuvering domain of the RRP
+        else if(!RPA->getActuator()->notInvadeManeuveringDomain(RRP->getActuator()))
+            return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------
+//METHODS FOR COMPACT MPs:
+
+//Determines if a RP can interact with the gesture of a message list.
+//Inputs:
+//  ML: message list which contains the gesture.
+//  RP: the RP to check.
+//Outputs:
+//  messageListInteractsWith: flag indicating if some MI of the ML
+//      is addressed to the RP or to some RP adjacent to it.
+bool TMotionProgramGenerator::messageListInteractsWith(const TMessageList *ML,
+                                                       const TRoboticPositioner *RP) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(ML == NULL)
+        throw EImproperArgument("pointer ML should point to built message list");
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
+
+    //MAKE ACTIONS:
+
+    //for each MI of the ML
+    for(int i=0; i<ML->getCount(); i++) {
+        int Id = ML->GetPointer(i)->getId();
+
+        //if the MI is addressed to the RP, indicates that there is interaction
+        if(Id == RP->getActuator()->getId())
+            return true;
+
+        //if the MI is addressed to an adjacent RP, indicates that there is interaction
+        const TAdjacentRPList& AdjacentRPs = RP->getActuator()->AdjacentRPs;
+        for(int j=0; j<AdjacentRPs.getCount(); j++)
+            if(Id == AdjacentRPs[j].RP->getActuator()->getId())
+                return true;
+    }
+
+    //indicates that there isn't interaction
+    return false;
+}
+
+//Move each MI of a message list to the first previous message list
+//from which there is not interaction with the RPs addressed in the
+//intermediate message lists, and delete the message list if it is empty.
+//Inputs:
+//  MP: motion program to be compacted.
+//  j: index to the message list to be compacted.
+//Outputs:
+//  MP: motion program compacted.
+//  compactMessageList: flag indicating if some MI has been moved.
+//Preconditions:
+//  Index j shall indicate a message list of the MP.
+//  All RPs included in the MP shall be in the Fiber MOS Model.
+bool TMotionProgramGenerator::compactMessageList(TMotionProgram& MP, int j) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(j<0 || MP.getCount()<=j)
+        throw EImproperArgument("index j should indicate a message list of the MP");
+
+    //MAKE ACTIONS:
+
+    const TRoboticPositionerList& RPL = getFiberMOSModel()->RPL;
+    TMessageList *ML = MP.GetPointer(j);
+    bool moved = false;
+
+    //for each MI of the ML
+    int i = 0;
+    while(i < ML->getCount()) {
+        TMessageInstruction *MI = ML->GetPointer(i);
+
+        //search the RP addressed by the MI
+        int n = RPL.searchId(MI->getId());
+        if(n >= RPL.getCount())
+            throw EImproperArgument("all RPs included in the MP shall be in the Fiber MOS Model");
+        TRoboticPositioner *RP = RPL[n];
+
+        //search the first previous ML from which there isn't interaction
+        int k = j;
+        while(k>0 && !messageListInteractsWith(MP.GetPointer(k-1), RP))
+            k--;
+
+        //move the MI to the found ML, if any
+        if(k < j) {
+            MP.GetPointer(k)->Add(MI);
+            ML->DeleteWithoutDestroy(i);
+            moved = true;
+        }
+        else
+            i++;
+    }
+
+    //Note that the MIs moved to previous MLs are taken into account
+    //for search the ML of the following MIs of the ML.
+
+    //delete the ML if it is empty
+    if(ML->getCount() <= 0)
+        MP.Delete(j);
+
+    return moved;
+}
+
 //---------------------------------------------------------------------------
 //SETTING PARAMETERS OF THE ALGORITHMS:
 
@@ -1332,7 +1568,8 @@ TMotionProgramGenerator::TMotionProgramGenerator(TFiberMOSModel *_FiberMOSModel)
     TMotionProgramValidator(_FiberMOSModel),
     TAllocationList(&(_FiberMOSModel->RPL)),
     p_dt1Max(M_PI/2),
-    NRmin(3), NBmin(1), PrMax(0)
+    NRmin(3), NBmin(1), PrMax(0),
+    CompactMPs(false)
 {
 }
 //destroy the targetpoints and destroy the MPG
@@ -1380,10 +1617,10 @@ void TMotionProgramGenerator::generateRecoveryProgram(
             throw EImproperCall("all RPs of the Fiber MOS Model shall be configurated for MP generation");
     }
 
+    TRoboticPositionerSet FMMRPs(getFiberMOSModel()->RPL);
     for(int i=0; i<Outsiders.getCount(); i++) {
         TRoboticPositioner *RP = Outsiders[i];
-        int j = getFiberMOSModel()->RPL.Search(RP);
-        if(j >= getFiberMOSModel()->RPL.getCount())
+        if(!FMMRPs.contains(RP))
             throw EImproperArgument("all RPs of the list Outsiders shall be in the Fiber MOS Model");
         if(!RP->getOperative())
             throw EImproperArgument("all RPs in the list Outsiders shall be operative");
@@ -1409,6 +1646,9 @@ void TMotionProgramGenerator::generateRecoveryProgram(
     //segregates the RPs of the list Outsiders which are in collision status, in the list Collided
     Outsiders.segregateCollided(Collided, Outsiders_);
 
+    //build the set of RPs of the list Outsiders_ to search them in constant time
+    TRoboticPositionerSet OutsidersSet_(Outsiders_);
+
     //The following check is unnecesary, because in the preconditions is checked that
     //all RPs of the list Outsiders are in insecurity positions:
     //  //solve the trivial case when there aren't RPs of the list Outsiders in insecurity positions
@@ -1544,12 +1784,11 @@ void TMotionProgramGenerator::generateRecoveryProgram(
             //delete the retracted RPs from the list Outsiders_
             for(int i=0; i<RPsToBeRecovered.getCount(); i++) {
                 TRoboticPositioner *RP = RPsToBeRecovered[i];
-                int j = Outsiders_.Search(RP);
                 //perform a rutinary checking
-                if(j >= Outsiders_.getCount())
+                if(!OutsidersSet_.erase(RP))
                     throw EImpossibleError("previously extracted RP  fron the list Outsiders_ not found in this list");
-                Outsiders_.Delete(j);
             }
+            OutsidersSet_.retainIn(Outsiders_);
         }
 
         //-------------------------------------------------------------------
@@ -1802,6 +2041,9 @@ void TMotionProgramGenerator::generatePairPPDP(bool& PPvalid, bool& DPvalid,
                                                TMotionProgram& PP, TMotionProgram& DP,
                                                const TRoboticPositionerList& Outsiders)
 {
+    //build the MIs of the pair in the arena of the request
+    TArenaScope AS;
+
     //captures the observing positions of the RPs in a PPA list
     TPairPositionAnglesList OPL;
     getFiberMOSModel()->RPL.getPositions(OPL);
@@ -1814,6 +2056,15 @@ void TMotionProgramGenerator::generatePairPPDP(bool& PPvalid, bool& DPvalid,
 
     //if has obtained a valid DP, generates the corresponding PP
     if(DPvalid) {
+        //compact the DP from the observing positions, if it is requested
+        if(CompactMPs) {
+            TPairPositionAnglesList FPL;
+            getFiberMOSModel()->RPL.getPositions(FPL);
+            getFiberMOSModel()->RPL.setPositions(OPL);
+            compactMotionProgram(DP);
+            getFiberMOSModel()->RPL.setPositions(FPL);
+        }
+
         //captures the initial positions of the RPs in a PPA list
         TPairPositionAnglesList IPL;
         getFiberMOSModel()->RPL.getPositions(IPL);
@@ -1877,6 +2128,13 @@ bool TMotionProgramGenerator::generateParkProg(
         TRoboticPositionerList& Collided, TRoboticPositionerList& Obstructed,
         TMotionProgram& ParkProg, const TRoboticPositionerList& Outsiders)
 {
+    //build the MIs of the parking program in the arena of the request
+    TArenaScope AS;
+
+    //captures the starting positions of the RPs in a PPA list
+    TPairPositionAnglesList SPL;
+    getFiberMOSModel()->RPL.getPositions(SPL);
+
     //configure the Fiber MOS Model for generate a parking program
     getFiberMOSModel()->RPL.setPurpose(pGenParPro);
 
@@ -1913,11 +2171,382 @@ bool TMotionProgramGenerator::generateParkProg(
         Inners.moveToOrigins();
 
         //Here all RPs included in the DP, are in the origin.
+
+        //compact the parking program from the starting positions,
+        //if it is requested
+        if(CompactMPs) {
+            TPairPositionAnglesList FPL;
+            getFiberMOSModel()->RPL.getPositions(FPL);
+            getFiberMOSModel()->RPL.setPositions(SPL);
+            compactMotionProgram(ParkProg);
+            getFiberMOSModel()->RPL.setPositions(FPL);
+        }
     }
 
     return valid;
 }
 
+//---------------------------------------------------------------------------
+//METHODS FOR REGENERATE MPs INCREMENTALLY:
+
+//Regenerates a pair (PP, DP) after change the observing positions
+//of a few RPs, recomputing only the gestures of the affected RPs.
+//The affected RPs are:
+//  the RPs of the list Changed;
+//  the RPs included in the previous DP, adjacent to a RP of Changed;
+//  the RPs of the disjoint sets of Outsiders containing any of them.
+//The MIs of the affected RPs are removed from the previous DP,
+//a recovery program is generated for the affected outsiders, and it is
+//merged step by step with the previous DP. The gesture to go to
+//the origins is regenerated, and the resulting pair is validated.
+//If the merged DP is not valid, the pair is generated from scratch.
+//Inputs:
+//  (PP, DP): the previous pair, generated for the previous observing
+//      positions.
+//  Outsiders: list of operative RPs in unsecurity positions which
+//      we want move.
+//  Changed: list of RPs whose observing position has changed.
+//Outputs:
+//  regeneratePairPPDP: flag indicating if the pair has been regenerated
+//      incrementally (in other case it has been generated from scratch).
+//  PPvalid: flag indicating if the regenerated PP is valid.
+//  DPvalid: flag indicating if the regenerated DP is valid.
+//  Collided: list of RPs collided in insecurity position.
+//  Obstructed: list of RPs obstructed in insecurity position.
+//  (PP, DP): the regenerated pair.
+//Preconditions:
+//  All RPs of the Fiber MOS Model:
+//    - shall be in their new observing positions.
+//  The RPs out of the list Changed:
+//    - shall have the same observing positions than in the previous
+//      generation.
+//  The previous pair (PP, DP):
+//    - shall be valid for the previous observing positions.
+//  All RPs of the lists Outsiders and Changed:
+//    - shall be in the Fiber MOS Model.
+//  All RPs of the list Outsiders:
+//    - shall fulfill the preconditions of generatePairPPDP.
+//Postconditions:
+//  The same of generatePairPPDP.
+bool TMotionProgramGenerator::regeneratePairPPDP(bool& PPvalid, bool& DPvalid,
+        TRoboticPositionerList& Collided, TRoboticPositionerList& Obstructed,
+        TMotionProgram& PP, TMotionProgram& DP,
+        const TRoboticPositionerList& Outsiders,
+        const TRoboticPositionerList& Changed)
+{
+    //build the MIs of the pair in the arena of the request
+    TArenaScope AS;
+
+    //CHECK THE PRECONDITIONS:
+
+    TRoboticPositionerList& RPL = getFiberMOSModel()->RPL;
+
+    for(int i=0; i<Changed.getCount(); i++) {
+        int j = RPL.Search(Changed[i]);
+        if(j >= RPL.getCount())
+            throw EImproperArgument("all RPs of the list Changed shall be in the Fiber MOS Model");
+    }
+
+    //get the RPs included in the previous DP
+    TRoboticPositionerList Included;
+    getRPsIncludedInMP(Included, DP, getFiberMOSModel());
+
+    //MAKE ACTIONS:
+
+    //captures the observing positions of the RPs in a PPA list
+    TPairPositionAnglesList OPL;
+    RPL.getPositions(OPL);
+
+    //DETERMINE THE AFFECTED RPs:
+
+    TRoboticPositionerList Affected;
+    TRoboticPositionerSet AffectedSet;
+
+    //add the changed RPs
+    for(int i=0; i<Changed.getCount(); i++)
+        if(AffectedSet.insert(Changed[i]))
+            Affected.Add(Changed[i]);
+
+    //add the RPs included in the previous DP adjacent to a changed RP
+    TRoboticPositionerSet ChangedSet(Changed);
+    for(int i=0; i<Included.getCount(); i++) {
+        TRoboticPositioner *RP = Included[i];
+        const TAdjacentRPList& AdjacentRPs = RP->getActuator()->AdjacentRPs;
+        for(int j=0; j<AdjacentRPs.getCount(); j++)
+            if(ChangedSet.contains(AdjacentRPs[j].RP)) {
+                if(AffectedSet.insert(RP))
+                    Affected.Add(RP);
+                break;
+            }
+    }
+
+    //The RPs which shared disjoint set with a changed RP in the previous
+    //observing positions are included in the previous DP and are adjacent
+    //to some RP of the set.
+
+    //add the disjoint sets of outsiders containing an affected RP
+    TPointersList<TRoboticPositionerList> DisjointSets;
+    segregateRPsInDisjointSets(DisjointSets, Outsiders);
+    for(int i=0; i<DisjointSets.getCount(); i++) {
+        TRoboticPositionerList *Set = DisjointSets.GetPointer(i);
+        bool affected = false;
+        for(int j=0; j<Set->getCount() && !affected; j++)
+            if(AffectedSet.contains((*Set)[j]))
+                affected = true;
+        if(affected)
+            for(int j=0; j<Set->getCount(); j++)
+                if(AffectedSet.insert((*Set)[j]))
+                    Affected.Add((*Set)[j]);
+    }
+
+    //segregate the affected outsiders
+    TRoboticPositionerSet OutsidersSet(Outsiders);
+    TRoboticPositionerList AffectedOutsiders;
+    for(int i=0; i<Affected.getCount(); i++)
+        if(OutsidersSet.contains(Affected[i]))
+            AffectedOutsiders.Add(Affected[i]);
+
+    //segregate the not affected outsiders out of the previous DP,
+    //which are collided or obstructed in insecurity positions
+    TRoboticPositionerSet IncludedSet(Included);
+    TRoboticPositionerList Collided_, Obstructed_;
+    for(int i=0; i<Outsiders.getCount(); i++) {
+        TRoboticPositioner *RP = Outsiders[i];
+        if(!AffectedSet.contains(RP) && !IncludedSet.contains(RP)) {
+            if(RP->getActuator()->thereIsCollisionWithAdjacent())
+                Collided_.Add(RP);
+            else
+                Obstructed_.Add(RP);
+        }
+    }
+
+    //BUILD THE DP KEEPING THE GESTURES OF THE NOT AFFECTED RPs:
+
+    TMotionProgram DPkeep(DP);
+
+    //remove the MIs of the affected RPs and the empty message lists
+    for(int i=0; i<Affected.getCount(); i++)
+        DPkeep.excludeRP(Affected[i]->getActuator()->getId());
+    for(int i=DPkeep.getCount()-1; i>=0; i--)
+        if(DPkeep[i].getCount() <= 0)
+            DPkeep.Delete(i);
+
+    //remove the message list to go to the origins, which will be regenerated
+    if(DPkeep.getCount() > 0 && messageListGoesToTheOrigins(DPkeep.getLastPointer()))
+        DPkeep.Delete(DPkeep.getCount() - 1);
+
+    //generate the recovery program for the affected outsiders
+    RPL.setPurpose(pGenPairPPDP);
+    TMotionProgram RecoveryProgram;
+    generateRecoveryProgram(Collided, Obstructed, RecoveryProgram, AffectedOutsiders);
+    Collided.Add(Collided_);
+    Obstructed.Add(Obstructed_);
+    Collided.SortInc();
+    Obstructed.SortInc();
+
+    //merge the recovery program with the kept DP, step by step
+    for(int i=0; i<RecoveryProgram.getCount(); i++) {
+        TMessageList *ML = RecoveryProgram.GetPointer(i);
+        if(i < DPkeep.getCount()) {
+            TMessageList *MLkeep = DPkeep.GetPointer(i);
+            while(ML->getCount() > 0) {
+                MLkeep->Add(ML->getFirstPointer());
+                ML->DeleteWithoutDestroy(0);
+            }
+        } else
+            DPkeep.Add(new TMessageList(ML));
+    }
+
+    //Note that the affected outsiders aren't adjacent to the not affected
+    //outsiders, because belong to different disjoint sets.
+
+    //VALIDATE THE MERGED DP AND ADD THE GESTURE TO GO TO THE ORIGINS:
+
+    RPL.setPurpose(pValDP);
+    DPvalid = validateMotionProgram(DPkeep);
+
+    //if the merged DP is not valid, generate the pair from scratch
+    if(!DPvalid) {
+        RPL.restoreAndPopQuantifys();
+        RPL.setPositions(OPL);
+        generatePairPPDP(PPvalid, DPvalid, Collided, Obstructed, PP, DP, Outsiders);
+        return false;
+    }
+
+    //generate the parking gesture for the operative RPs in security position out the origin
+    TRoboticPositionerList Inners;
+    RPL.segregateOperativeInnersOutTheOrigins(Inners);
+    Inners.SortInc();
+    addMessageListToGoToTheOrigins(DPkeep, Inners);
+    Inners.moveToOrigins();
+
+    //GENERATE AND VALIDATE THE PP:
+
+    DP = DPkeep;
+
+    //captures the initial positions of the RPs in a PPA list
+    TPairPositionAnglesList IPL;
+    RPL.getPositions(IPL);
+
+    //generate the PP from the DP
+    generatePositioningProgram(PP, DP, OPL);
+
+    //validate the PP
+    RPL.setPurpose(pValPP);
+    RPL.setPositions(IPL);
+    PPvalid = validateMotionProgram(PP);
+
+    //if the generated PP is valid, move the RPs to the initial positions
+    if(PPvalid)
+        RPL.setPositions(IPL);
+
+    return true;
+}
+
+//---------------------------------------------------------------------------
+//METHODS FOR COMPACT MPs:
+
+//Calculates the time necessary to execute a MP.
+//Inputs:
+//  MP: motion program to be measured.
+//Outputs:
+//  calculateDuration: sum of the displacement times of the gestures
+//      of the MP, in seconds.
+//Preconditions:
+//  All RPs included in the MP shall be in the Fiber MOS Model.
+//  All RPs of the Fiber MOS Model shall be in the starting positions
+//  of the MP.
+//Postconditions:
+//  All RPs of the Fiber MOS Model will be in the starting positions
+//  of the MP.
+double TMotionProgramGenerator::calculateDuration(const TMotionProgram& MP) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    TRoboticPositionerList& RPL = getFiberMOSModel()->RPL;
+
+    for(int i=0; i<MP.getCount(); i++) {
+        const TMessageList *ML = MP.GetPointer(i);
+        for(int j=0; j<ML->getCount(); j++) {
+            int k = RPL.searchId(ML->GetPointer(j)->getId());
+            if(k >= RPL.getCount())
+                throw EImproperArgument("all RPs included in the MP shall be in the Fiber MOS Model");
+        }
+    }
+
+    //MAKE ACTIONS:
+
+    //stack the starting status of the RPs and disable the quantifiers
+    RPL.pushPositions();
+    RPL.pushQuantifys();
+    RPL.setQuantifys(false, false);
+
+    //accumulate the displacement time of each gesture
+    double T = 0;
+    for(int i=0; i<MP.getCount(); i++) {
+        const TMessageList *ML = MP.GetPointer(i);
+
+        //program the gesture
+        RPL.clearInstructions();
+        for(int j=0; j<ML->getCount(); j++) {
+            const TMessageInstruction *MI = ML->GetPointer(j);
+            RPL.setInstruction(MI->getId(), MI->Instruction);
+        }
+
+        //add the displacement time and go to the end of the gesture
+        T += RPL.getTdis();
+        RPL.moveFin();
+    }
+
+    //restore the starting status of the RPs
+    RPL.clearInstructions();
+    RPL.restoreAndPopQuantifys();
+    RPL.restoreAndPopPositions();
+
+    return T;
+}
+
+//Compact a valid MP, merging the gestures of the RPs which not interact.
+//Each MI is moved to the first previous message list from which
+//neither the RP nor their adjacent RPs are addressed in any message
+//list until their own message list. The compacted MP is validated
+//again, and it is only accepted when it is valid and their duration
+//is not upper than the duration of the original MP.
+//Inputs:
+//  MP: the valid motion program to be compacted.
+//Outputs:
+//  compactMotionProgram: flag indicating if the MP has been replaced
+//      by the compacted MP.
+//  MP: the compacted MP, if any.
+//Preconditions:
+//  All RPs included in the MP:
+//      shall be in the Fiber MOS Model;
+//      shall be enabled the quantifiers of their rotors.
+//  All RPs of the Fiber MOS Model:
+//      shall be in the starting positions of the MP;
+//      shall be configured for validate the MP.
+//Postconditions:
+//  All RPs of the Fiber MOS Model:
+//      will be in the starting positions of the MP;
+//      will have the quantifiers of their rotors in their initial status.
+bool TMotionProgramGenerator::compactMotionProgram(TMotionProgram& MP)
+{
+    //CHECK THE PRECONDITIONS:
+
+    TRoboticPositionerList Included;
+    getRPsIncludedInMP(Included, MP, getFiberMOSModel());
+
+    for(int i=0; i<Included.getCount(); i++) {
+        TRoboticPositioner *RP = Included[i];
+        if(RP->getActuator()->getQuantify_()!=true || RP->getActuator()->getArm()->getQuantify___()!=true)
+            throw EImproperCall("all RPs included in the MP, should be enabled the quantifiers of their rotors");
+    }
+
+    //MAKE ACTIONS:
+
+    TRoboticPositionerList& RPL = getFiberMOSModel()->RPL;
+    bool compacted = false;
+    double T = calculateDuration(MP);
+
+    //for each message list from the second
+    int j = 1;
+    while(j < MP.getCount()) {
+        int Count = MP.getCount();
+
+        //build a candidate moving the MIs of the message list j
+        TMotionProgram Candidate(MP);
+        bool accepted = false;
+        if(compactMessageList(Candidate, j)) {
+            //the candidate only is accepted if their duration is not upper
+            double Tcandidate = calculateDuration(Candidate);
+            if(Tcandidate <= T) {
+                //validate the candidate from the starting positions
+                RPL.pushPositions();
+                accepted = validateMotionProgram(Candidate);
+                if(!accepted)
+                    RPL.restoreAndPopQuantifys();
+                RPL.restoreAndPopPositions();
+
+                //When the validation fails, the quantifiers stay disabled
+                //and stacked, so they shall be restored here.
+
+                //if the candidate is valid, replace the MP
+                if(accepted) {
+                    MP = Candidate;
+                    T = Tcandidate;
+                    compacted = true;
+                }
+            }
+        }
+
+        //if the message list j has not been deleted, go to the next
+        if(MP.getCount() == Count)
+            j++;
+    }
+
+    return compacted;
+}
+
 //---------------------------------------------------------------------------
 //METHODS FOR REGENERATE MPs:
 
@@ -1988,71 +2617,63 @@ void TMotionProgramGenerator::searchReplacementRPs(TRoboticPositionerList& RRPs,
     //initialize the output
     RRPs.Clear(); //replacement RPs
 
-    //search the replacement RPs
-    for(i=0; i<RP->getActuator()->AdjacentRPs.getCount(); i++) {
-        TRoboticPositioner *RRP = RP->getActuator()->AdjacentRPs[i].RP;
+    //point the allocation of the RP
+    i = searchAllocation(RP);
+    const TAllocation *A = Items[i];
+
+    //search the replacement RPs among the adjacent RPs
+    const TAdjacencyGraph& G = getFiberMOSModel()->RPL.getAdjacency();
+    int n = getFiberMOSModel()->RPL.search(RP);
+    for(const TAdjacencyEdge *E=G.beginRPs(n); E!=G.endRPs(n); E++) {
+        TRoboticPositioner *RRP = G.getRP(E->Target);
+        if(isReplacementRP(RRP, A))
+            RRPs.Add(RRP);
+    }
+}
 
-        //Here the RRP is adjacent to the RP to be replaced.
+//search the replacement RPs of a RP using a reachability index
+//Inputs:
+//  RP: the RP to be replaced.
+//  RI: reachability index of the RPs of the Fiber MOS Model.
+//Outputs:
+//  RRPs: list of replacement RPs.
+//Preconditions:
+//  The same of searchReplacementRPs(RRPs, RP).
+//  The index RI shall be built with the RPs of the Fiber MOS Model.
+//Postconditions:
+//  The list RRPs will contains the same RPs than the obtained by
+//  searchReplacementRPs(RRPs, RP), sorted as the Fiber MOS Model.
+void TMotionProgramGenerator::searchReplacementRPs(TRoboticPositionerList& RRPs,
+                                                   const TRoboticPositioner *RP,
+                                                   const TReachabilityIndex& RI) const
+{
+    //CHECK THE PRECONDITIONS:
 
-        //determines if the PP allocated to the RP is in the scope of the RRP
-        i = searchAllocation(RP);
-        TAllocation *TP = Items[i];
-        bool is_in_domain = RRP->getActuator()->pointIsInDomainP3(TP->PP);
-
-        if(is_in_domain) {
-
-            //Here the PP allocated to the RP, is in the scope of the RRP.
-
-            if(RRP->getOperative()) {
-                int j = searchAllocation(RRP);
-                if(j >= getCount()) {
-
-                    //Here the RRP is adjacent, operative and it is not allocated.
-
-                    //check if the unsecurity area of the replacement RP is clear and will stay clear
-                    bool clear = true;
-                    int k = 0;
-                    while(clear && k<RRP->getActuator()->AdjacentRPs.getCount()) {
-                        TRoboticPositioner *RPA = RRP->getActuator()->AdjacentRPs[k].RP;
-
-                        //if the RPA is operative
-                        //must be in security area, and if it has allocated PP,
-                        //this must be in the security area
-                        if(RPA->getOperative()) {
-                            if(RPA->getActuator()->ArmIsInSafeArea()) {
-                                int l = searchAllocation(RPA);
-                                if(l < getCount()) {
-                                    TAllocation *TP = Items[l];
-                                    TDoublePoint PP = TP->PP;
-                                    if(RPA->getActuator()->pointIsInSecurityArea(PP))
-                                        k++;
-                                    else
-                                        clear = false;
-                                } else
-                                    k++;
-
-                            } else
-                                clear = false;
-                        }
-
-                        //if the RPA is not operative
-                        //must be non invading the maneuvering domain of the RRP
-                        else {
-                            if(RPA->getActuator()->notInvadeManeuveringDomain(RRP->getActuator()))
-                                k++;
-                            else
-                                clear = false;
-                        }
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
 
-                    }
+    int i = getFiberMOSModel()->RPL.search(RP);
+    if(i >= getFiberMOSModel()->RPL.getCount())
+        throw EImproperArgument("the RP should be in the Fiber MOS Model");
 
-                    //if the unsecurity area is clear and stay clear,add the RRP to the list
-                    if(clear)
-                        RRPs.Add(RRP);
-                }
-            }
-        }
-    }
+    i = searchAllocation(RP);
+    if(i >= getCount())
+        throw EImproperArgument("the RP must be included in the TPL");
+
+    //MAKE ACTIONS:
+
+    //point the allocation of the RP
+    const TAllocation *A = Items[i];
+
+    //search the RPs in whose domain of P3 is the PP
+    TRoboticPositionerList Candidates;
+    RI.searchRPs(Candidates, A->PP);
+
+    //select the replacement RPs among the candidates
+    RRPs.Clear();
+    for(int j=0; j<Candidates.getCount(); j++)
+        if(isReplacementRP(Candidates[j], A))
+            RRPs.Add(Candidates[j]);
 }
 
 //The data (NRmin, NBmin, PrMax) are the same for all points in the CB.
@@ -2118,9 +2739,20 @@ bool TMotionProgramGenerator::allocationIsMustType(int i) const
 //      must correspond to the status of the real Fiber MOS.
 //  The allocations shall contains the properties enough to
 //      make the regeneration (Type, Pr, Pid, X, Y).
+//  All RPs of the Fiber MOS Model shall be in the initial positions
+//      of the pair (PP, DP).
+//Postconditions:
+//  When there are replacement RPs, the regenerated pair is validated,
+//      and it is only accepted if it avoids collisions.
+//  All RPs of the Fiber MOS Model will be in the initial positions
+//      of the pair (PP, DP).
 bool TMotionProgramGenerator::attemptRegenerate(TVector<int>& Excluded,
+                                                TVector<int>& Replaced, TVector<int>& Replacements,
                                                 TMotionProgram& PP, TMotionProgram& DP) const
 {
+    //build the MIs of the pair in the arena of the request
+    TArenaScope AS;
+
     //determine the list of not operative RPs included in the pair (PP, DP)
     TRoboticPositionerList RPL;
     getRPsIncludedInMPs(RPL, PP, DP, getFiberMOSModel());
@@ -2146,60 +2778,129 @@ bool TMotionProgramGenerator::attemptRegenerate(TVector<int>& Excluded,
             throw EImproperArgument("all RPs included in the pair (PP,DP) should have an allocation in the MPG");
     }
 
-    //initialize the output
+    //initialize the outputs
     Excluded.Clear();
+    Replaced.Clear();
+    Replacements.Clear();
+
+    //work on copies of the pair, to keep it unchanged if can not be regenerated
+    TMotionProgram PP_(PP);
+    TMotionProgram DP_(DP);
+
+    //build the reachability index of the Fiber MOS Model
+    //only if it will be used
+    TReachabilityIndex RI;
 
-    //determines if there is some point of type must allocated to a not operative RP
+    //for each not operative RP included in the pair (PP, DP)
     for(int i=0; i<RPL.getCount(); i++) {
         TRoboticPositioner *RP = RPL[i];
+        int Id = RP->getActuator()->getId();
 
-        //if the allocation if type must
-        //indicates that the pair (PP, DP) can not be regenerated
+        //exclude the RP from the pair (PP,DP)
+        PP_.excludeRP(Id);
+        DP_.excludeRP(Id);
+
+        //add the identifier of the RP excluded to the list
+        Excluded.Add(Id);
+
+        //if the allocation is not type must, the RP only is excluded
         int j = searchAllocation(RP);
         if(j >= getCount())
             throw EImpossibleError("lateral effect");
-        bool allocation_is_must = allocationIsMustType(j);
-        if(allocation_is_must)
-            return false; //indicates that the pair (PP, DP) can not be regenerated
+        if(!allocationIsMustType(j))
+            continue;
+
+        //SEARCH A REPLACEMENT RP FOR THE ALLOCATION OF TYPE MUST:
+
+        if(RI.getSide() <= 0)
+            RI.build(getFiberMOSModel()->RPL);
+
+        TRoboticPositionerList RRPs;
+        searchReplacementRPs(RRPs, RP, RI);
+
+        //select the first replacement RP not used previously
+        TRoboticPositioner *RRP = NULL;
+        for(int k=0; k<RRPs.getCount() && RRP==NULL; k++) {
+            int RRPId = RRPs[k]->getActuator()->getId();
+            bool used = false;
+            for(int l=0; l<Replacements.getCount(); l++)
+                if(Replacements[l] == RRPId)
+                    used = true;
+            if(!used)
+                RRP = RRPs[k];
+        }
 
-        //exclude the RP from the pair (PP,DP)
-        PP.excludeRP(RP->getActuator()->getId());
-        DP.excludeRP(RP->getActuator()->getId());
+        //if there isn't replacement RP
+        //indicates that the pair (PP, DP) can not be regenerated
+        if(RRP == NULL)
+            return false;
+
+        //determine the stable positions of the rotors of the RRP,
+        //more closer to the PP
+        const TAllocation *A = Items[j];
+        double theta_1, theta___3;
+        bool isindomain = RRP->getActuator()->anglesToGoP3(theta_1, theta___3, A->PP.x, A->PP.y);
+        if(!isindomain)
+            throw EImpossibleError("lateral effect");
+        double p_1nsp, p___3nsp;
+        RRP->getActuator()->getNearestStablePosition(p_1nsp, p___3nsp, theta_1, theta___3);
 
-        //add the identifier of the RP excluded to the list
-        Excluded.Add(RP->getActuator()->getId());
+        //determine the position of the origin of each rotor of the RRP
+        double p_1origin = max(0., ceil(RRP->getActuator()->getp_1min()));
+        double p___3origin = max(0., ceil(RRP->getActuator()->getArm()->getp___3min()));
+
+        //add to the PP the gesture to go from the origin to the PP
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(RRP->getActuator()->getId());
+        MI->Instruction.setName("MM");
+        MI->Instruction.Args.setCount(2);
+        MI->Instruction.Args[0] = p_1nsp;
+        MI->Instruction.Args[1] = p___3nsp;
+        TMessageList *ML = new TMessageList();
+        ML->Add(MI);
+        PP_.Add(ML);
+
+        //insert in the DP the gesture to go from the PP to the origin
+        MI = new TMessageInstruction();
+        MI->setId(RRP->getActuator()->getId());
+        MI->Instruction.setName("MM");
+        MI->Instruction.Args.setCount(2);
+        MI->Instruction.Args[0] = p_1origin;
+        MI->Instruction.Args[1] = p___3origin;
+        ML = new TMessageList();
+        ML->Add(MI);
+        DP_.Insert(0, ML);
+
+        //add the identifiers to the lists
+        Replaced.Add(Id);
+        Replacements.Add(RRP->getActuator()->getId());
     }
 
-    return true;
+    //validate the pair amended with the gestures of the replacement RPs
+    //starting from the initial positions
+    if(Replaced.getCount() > 0) {
+        getFiberMOSModel()->RPL.pushPositions();
+        getFiberMOSModel()->RPL.setPurpose(pValPP);
+        bool valid = validateMotionProgram(PP_);
+        if(valid) {
+            getFiberMOSModel()->RPL.setPurpose(pValDP);
+            valid = validateMotionProgram(DP_);
+        }
+        if(!valid)
+            getFiberMOSModel()->RPL.restoreAndPopQuantifys();
+        getFiberMOSModel()->RPL.restoreAndPopPositions();
+
+        //if the amended pair produces a collision,
+        //the replacements are rejected
+        if(!valid)
+            return false;
+    }
 
-    //Other more efficient way of regenerate a pair (PP, PD):
-    //  //search the list of replacement RPs for each RP
-    //  TPointersList<TRoboticPositionerList> RRPss;
-    //  for(int i=0; i<RPL.getCount(); i++) {
-    //      TRoboticPositioner *RP = RPL[i];
-    //
-    //      TRoboticPositionerList *RRPs = new TRoboticPositionerList();
-    //      searchReplacementRPs(RRPs, RP);
-    //      if(RRPs.getCount() <= 0)
-    //          return false;
-    //      RRPss.Add(RRPs);
-    //  }
-    //  //attemp solve all not operative RPs included in the pair (PP, DP)
-    //  for(int i=0; i<RPL.getCount(); i++) {
-    //      TRoboticPositioner *RP = RPL[i];
-    //
-    //      //If it is a simple case:
-    //          //allocate the point to the adjacent RP (more convenient) satisfing the requirements.
-    //      //If it is not a simple case:
-    //          //if the allocated point is type must:
-    //              //indicates that the pair (PP, DP) can not be regenerated
-    //
-    //      //If the actual position is secure:
-    //          //delete the allocation of the RP.
-    //      //Ifthe actual position is unsecure:
-    //          //delete the allocation of the RP and all adjacents RPs with point allocated in unsecurity position.
-    //  }
-    //  return false;
+    //set the regenerated pair
+    PP = PP_;
+    DP = DP_;
+
+    return true;
 }
 
 /*****************************************************************************
@@ -2450,9 +3151,9 @@ bool generatePairPPDP_online(TMotionProgram& PP, TMotionProgram& DP,
 //FUNCTIONS TO BE USED ONLINE BY MCS (MARCH 2017)
 //OUTPUTS IN STRUCTURE FORMAT:
 
-//Generate a parking program online
+//Generate a parking program online on a loaded Fiber MOS Model
 //Inputs:
-//  FMMI_dir: dir of the FMM Instance
+//  FMM: the Fiber MOS Model, in their initial status.
 //  p_1s: the rotor 1 starting positions of all RPs of the FMM.
 //  p___3s: the rotor 2 starting positions of all RPs of the FMM.
 //  RPids: the identifiers of the RPs of the FMM to be disabled.
@@ -2467,31 +3168,18 @@ bool generatePairPPDP_online(TMotionProgram& PP, TMotionProgram& DP,
 //      the validation process, so it is not safe that it not produces
 //      a dynamic collission, or there are enabled-not-operative RPs
 //      with dynamic fault.
+//Notes:
+//- The FMM will be changed by the generation process, and the FMM Instance
+//  will not be written. For serve several requests from a resident FMM,
+//  each call shall be made on a clone of it.
 bool generateParkProg_online(OutputsParkProg& outputs,
-        const string& FMMI_dir,
+        TFiberMOSModel& FMM,
         const vector<double>& p_1s, const vector<double>& p___3s,
         const vector<int>& RPids, const unsigned int Bid)
 {
     //-------------------------------------------------------------------
     //CHECK PRECONDITIONS:
 
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
-    //-----------------------------------------------------------------------
-    //LOAD THE FIBER MOS MODEL INSTANCE:
-
-    //load the FMM Instance from a dir
-    TFiberMOSModel FMM;
-    try {
-        readInstanceFromDir(FMM, FMMI_dir);
-    }
-    catch(Exception& E) {
-        E.Message.Insert(1, "loading instance: ");
-        throw;
-    }
-
     //make a rutinary cheack
     if(FMM.RPL.Compare != TRoboticPositioner::compareIds)
         throw EImpossibleError("improper initialization value of TRoboticPositionerList::Compare");
@@ -2608,17 +3296,6 @@ bool generateParkProg_online(OutputsParkProg& outputs,
     //-------------------------------------------------------------------
     //RETURN THE OUTPUTS:
 
-    //save the FMM Instance in the same dir from was loaded
-    try {
-        writeInstanceToDir(FMMI_dir, FMM);
-    }
-    catch(Exception& E) {
-        E.Message.Insert(1, "writing instance: ");
-        throw;
-    }
-
-    //Only FMM Instance's changed files will be written.
-
     //make a rutinary check
     if(SPL.getCount() != FMM.RPL.getCount())
         throw EImpossibleError("lateral effect");
@@ -2652,45 +3329,91 @@ bool generateParkProg_online(OutputsParkProg& outputs,
     //for difficult their execution.
 }
 
-//Generate a pair (PP, DP) online
+//Generate a parking program online
 //Inputs:
 //  FMMI_dir: dir of the FMM Instance
-//  p_1s: the rotor 1 observing positions of all RPs of the FMM.
-//  p___3s: the rotor 2 observing positions of all RPs of the FMM.
+//  p_1s: the rotor 1 starting positions of all RPs of the FMM.
+//  p___3s: the rotor 2 starting positions of all RPs of the FMM.
 //  RPids: the identifiers of the RPs of the FMM to be disabled.
 //Outputs:
-//  outputs: structure OutputsPairPPDP (without FMOSA).
-//  generatePairPPDP_online:
-//    - true: the generated pair (PP, DP) has passed the validation
+//  outputs: structure OutputsParkProg.
+//  generateParkProg_online:
+//    - true: the generated parking program has passed the validation
 //      process, so it is safe that it not produces a dynamic collission.
 //      moreover there aren't enabled-not-operative RPs with dynamic fault,
-//      and there aren't neither collided nor obstructed RPs.
-//    - false: some of above conditions are not meet.
-bool generatePairPPDP_online(OutputsPairPPDP& outputs,
+//      but could have either collided or obstructed RPs.
+//    - false: either the generated parking program has not passed
+//      the validation process, so it is not safe that it not produces
+//      a dynamic collission, or there are enabled-not-operative RPs
+//      with dynamic fault.
+bool generateParkProg_online(OutputsParkProg& outputs,
         const string& FMMI_dir,
         const vector<double>& p_1s, const vector<double>& p___3s,
         const vector<int>& RPids, const unsigned int Bid)
 {
-    //-------------------------------------------------------------------
-    //CHECK PRECONDITIONS:
-
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
     //-----------------------------------------------------------------------
     //LOAD THE FIBER MOS MODEL INSTANCE:
 
-    //load the FMM Instance from a dir
+    //load the FMM Instance from a dir through its snapshot
+    //(the dir is parsed when the snapshot is missing or stale)
     TFiberMOSModel FMM;
     try {
-        readInstanceFromDir(FMM, FMMI_dir);
+        readInstanceFromDirUsingSnapshot(FMM, FMMI_dir);
     }
     catch(Exception& E) {
         E.Message.Insert(1, "loading instance: ");
         throw;
     }
 
+    //the flag of validity will be set only when the generated MP is valid
+    outputs.ParkProgValid = false;
+
+    //call the function online on the loaded FMM
+    bool suitable = generateParkProg_online(outputs, FMM, p_1s, p___3s, RPids, Bid);
+
+    //save the FMM Instance in the same dir from was loaded
+    //when the generated MPs are valid
+    if(outputs.ParkProgValid) {
+        try {
+            writeInstanceToDir(FMMI_dir, FMM);
+        }
+        catch(Exception& E) {
+            E.Message.Insert(1, "writing instance: ");
+            throw;
+        }
+    }
+
+    //Only FMM Instance's changed files will be written.
+
+    return suitable;
+}
+
+//Generate a pair (PP, DP) online on a loaded Fiber MOS Model
+//Inputs:
+//  FMM: the Fiber MOS Model, in their initial status.
+//  p_1s: the rotor 1 observing positions of all RPs of the FMM.
+//  p___3s: the rotor 2 observing positions of all RPs of the FMM.
+//  RPids: the identifiers of the RPs of the FMM to be disabled.
+//Outputs:
+//  outputs: structure OutputsPairPPDP (without FMOSA).
+//  generatePairPPDP_online:
+//    - true: the generated pair (PP, DP) has passed the validation
+//      process, so it is safe that it not produces a dynamic collission.
+//      moreover there aren't enabled-not-operative RPs with dynamic fault,
+//      and there aren't neither collided nor obstructed RPs.
+//    - false: some of above conditions are not meet.
+//Notes:
+//- The FMM will be changed by the generation process, and the FMM Instance
+//  will not be written. For serve several requests from a resident FMM,
+//  each call shall be made on a clone of it.
+bool generatePairPPDP_online(OutputsPairPPDP& outputs,
+        TFiberMOSModel& FMM,
+        const vector<double>& p_1s, const vector<double>& p___3s,
+        const vector<int>& RPids, const unsigned int Bid)
+{
+    //-------------------------------------------------------------------
+    //CHECK PRECONDITIONS:
+
     //make a rutinary cheack
     if(FMM.RPL.Compare != TRoboticPositioner::compareIds)
         throw EImpossibleError("improper initialization value of TRoboticPositionerList::Compare");
@@ -2812,17 +3535,6 @@ bool generatePairPPDP_online(OutputsPairPPDP& outputs,
     //-------------------------------------------------------------------
     //RETURN THE OUTPUTS:
 
-    //save the FMM Instance in the same dir from was loaded
-    try {
-        writeInstanceToDir(FMMI_dir, FMM);
-    }
-    catch(Exception& E) {
-        E.Message.Insert(1, "writing instance: ");
-        throw;
-    }
-
-    //Only FMM Instance's changed files will be written.
-
     //make a rutinary check
     if(OPL.getCount() != FMM.RPL.getCount())
         throw EImpossibleError("lateral effect");
@@ -2859,6 +3571,63 @@ bool generatePairPPDP_online(OutputsPairPPDP& outputs,
     //for difficult their execution.
 }
 
+//Generate a pair (PP, DP) online
+//Inputs:
+//  FMMI_dir: dir of the FMM Instance
+//  p_1s: the rotor 1 observing positions of all RPs of the FMM.
+//  p___3s: the rotor 2 observing positions of all RPs of the FMM.
+//  RPids: the identifiers of the RPs of the FMM to be disabled.
+//Outputs:
+//  outputs: structure OutputsPairPPDP (without FMOSA).
+//  generatePairPPDP_online:
+//    - true: the generated pair (PP, DP) has passed the validation
+//      process, so it is safe that it not produces a dynamic collission.
+//      moreover there aren't enabled-not-operative RPs with dynamic fault,
+//      and there aren't neither collided nor obstructed RPs.
+//    - false: some of above conditions are not meet.
+bool generatePairPPDP_online(OutputsPairPPDP& outputs,
+        const string& FMMI_dir,
+        const vector<double>& p_1s, const vector<double>& p___3s,
+        const vector<int>& RPids, const unsigned int Bid)
+{
+    //-----------------------------------------------------------------------
+    //LOAD THE FIBER MOS MODEL INSTANCE:
+
+    //load the FMM Instance from a dir through its snapshot
+    //(the dir is parsed when the snapshot is missing or stale)
+    TFiberMOSModel FMM;
+    try {
+        readInstanceFromDirUsingSnapshot(FMM, FMMI_dir);
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "loading instance: ");
+        throw;
+    }
+
+    //the flags of validity will be set only when the generated MPs are valid
+    outputs.PPvalid = false;
+    outputs.DPvalid = false;
+
+    //call the function online on the loaded FMM
+    bool suitable = generatePairPPDP_online(outputs, FMM, p_1s, p___3s, RPids, Bid);
+
+    //save the FMM Instance in the same dir from was loaded
+    //when the generated MPs are valid
+    if(outputs.PPvalid && outputs.DPvalid) {
+        try {
+            writeInstanceToDir(FMMI_dir, FMM);
+        }
+        catch(Exception& E) {
+            E.Message.Insert(1, "writing instance: ");
+            throw;
+        }
+    }
+
+    //Only FMM Instance's changed files will be written.
+
+    return suitable;
+}
+
 //############################################################################
 //FUNCTIONS TO BE USED ONLINE BY MCS (MARCH 2017)
 //OUTPUTS IN STRING FORMAT:
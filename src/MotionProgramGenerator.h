@@ -30,6 +30,7 @@
 #include "FMOSA.h"
 #include "FiberMOSModel.h"
 #include "MotionProgram.h"
+#include "ReachabilityIndex.h"
 
 using namespace Models;
 
@@ -310,6 +311,59 @@ protected:
     void addMessageListToGoToTheOrigins(TMotionProgram& DP,
         const TRoboticPositionerList& Inners);
 
+    //Determines if a message list only contains MIs to go to the origins.
+    //Inputs:
+    //  ML: message list to check.
+    //Outputs:
+    //  messageListGoesToTheOrigins: flag indicating if the ML is not empty
+    //      and all their MIs are addressed to RPs of the FMM, with
+    //      instructions whose final positions are the origins.
+    bool messageListGoesToTheOrigins(const TMessageList *ML) const;
+
+    //-----------------------------------------------------------------------
+    //METHODS FOR REGENERATE MPs IN LIMITED SENSE:
+
+    //Determines if a RP can replace other RP for observe their PP.
+    //Inputs:
+    //  RRP: the candidate to replacement RP.
+    //  A: allocation of the RP to be replaced.
+    //Outputs:
+    //  isReplacementRP: flag indicating if the RRP:
+    //      is not the RP to be replaced;
+    //      contains the PP in their domain of P3;
+    //      is operative and not allocated;
+    //      has the unsecurity area clear, and it will stay clear.
+    //Preconditions:
+    //  The RRP shall be in the Fiber MOS Model.
+    bool isReplacementRP(TRoboticPositioner *RRP, const TAllocation *A) const;
+
+    //-----------------------------------------------------------------------
+    //METHODS FOR COMPACT MPs:
+
+    //Determines if a RP can interact with the gesture of a message list.
+    //Inputs:
+    //  ML: message list which contains the gesture.
+    //  RP: the RP to check.
+    //Outputs:
+    //  messageListInteractsWith: flag indicating if some MI of the ML
+    //      is addressed to the RP or to some RP adjacent to it.
+    bool messageListInteractsWith(const TMessageList *ML,
+                                  const TRoboticPositioner *RP) const;
+
+    //Move each MI of a message list to the first previous message list
+    //from which there is not interaction with the RPs addressed in the
+    //intermediate message lists, and delete the message list if it is empty.
+    //Inputs:
+    //  MP: motion program to be compacted.
+    //  j: index to the message list to be compacted.
+    //Outputs:
+    //  MP: motion program compacted.
+    //  compactMessageList: flag indicating if some MI has been moved.
+    //Preconditions:
+    //  Index j shall indicate a message list of the MP.
+    //  All RPs included in the MP shall be in the Fiber MOS Model.
+    bool compactMessageList(TMotionProgram& MP, int j) const;
+
 public:
     //-----------------------------------------------------------------------
     //SETTING PARAMETERS OF THE ALGORITHMS:
@@ -337,6 +391,13 @@ public:
     //default value: 0
     unsigned int PrMax;
 
+    //PARAMETERS TO COMPACT MPs:
+
+    //indicates if the generated MPs shall be compacted
+    //merging the gestures of the RPs which not interact
+    //default value: false
+    bool CompactMPs;
+
     //-----------------------------------------------------------------------
     //BUILDING AND DESTROYING METHODS:
 
@@ -533,6 +594,105 @@ public:
         TRoboticPositionerList& Collided, TRoboticPositionerList& Obstructed,
         TMotionProgram& ParkProg, const TRoboticPositionerList& Outsiders);
 
+    //-----------------------------------------------------------------------
+    //METHODS FOR REGENERATE MPs INCREMENTALLY:
+
+    //Regenerates a pair (PP, DP) after change the observing positions
+    //of a few RPs, recomputing only the gestures of the affected RPs.
+    //The affected RPs are:
+    //  the RPs of the list Changed;
+    //  the RPs included in the previous DP, adjacent to a RP of Changed;
+    //  the RPs of the disjoint sets of Outsiders containing any of them.
+    //The MIs of the affected RPs are removed from the previous DP,
+    //a recovery program is generated for the affected outsiders, and it is
+    //merged step by step with the previous DP. The gesture to go to
+    //the origins is regenerated, and the resulting pair is validated.
+    //If the merged DP is not valid, the pair is generated from scratch.
+    //Inputs:
+    //  (PP, DP): the previous pair, generated for the previous observing
+    //      positions.
+    //  Outsiders: list of operative RPs in unsecurity positions which
+    //      we want move.
+    //  Changed: list of RPs whose observing position has changed.
+    //Outputs:
+    //  regeneratePairPPDP: flag indicating if the pair has been regenerated
+    //      incrementally (in other case it has been generated from scratch).
+    //  PPvalid: flag indicating if the regenerated PP is valid.
+    //  DPvalid: flag indicating if the regenerated DP is valid.
+    //  Collided: list of RPs collided in insecurity position.
+    //  Obstructed: list of RPs obstructed in insecurity position.
+    //  (PP, DP): the regenerated pair.
+    //Preconditions:
+    //  All RPs of the Fiber MOS Model:
+    //    - shall be in their new observing positions.
+    //  The RPs out of the list Changed:
+    //    - shall have the same observing positions than in the previous
+    //      generation.
+    //  The previous pair (PP, DP):
+    //    - shall be valid for the previous observing positions.
+    //  All RPs of the lists Outsiders and Changed:
+    //    - shall be in the Fiber MOS Model.
+    //  All RPs of the list Outsiders:
+    //    - shall fulfill the preconditions of generatePairPPDP.
+    //Postconditions:
+    //  The same of generatePairPPDP.
+    bool regeneratePairPPDP(bool& PPvalid, bool& DPvalid,
+        TRoboticPositionerList& Collided, TRoboticPositionerList& Obstructed,
+        TMotionProgram& PP, TMotionProgram& DP,
+        const TRoboticPositionerList& Outsiders,
+        const TRoboticPositionerList& Changed);
+
+    //Note that when the observing position of a RP is disabled, the RP
+    //shall be in the list Changed, and shall be in their origin or
+    //in other secure position.
+
+    //-----------------------------------------------------------------------
+    //METHODS FOR COMPACT MPs:
+
+    //Calculates the time necessary to execute a MP.
+    //Inputs:
+    //  MP: motion program to be measured.
+    //Outputs:
+    //  calculateDuration: sum of the displacement times of the gestures
+    //      of the MP, in seconds.
+    //Preconditions:
+    //  All RPs included in the MP shall be in the Fiber MOS Model.
+    //  All RPs of the Fiber MOS Model shall be in the starting positions
+    //  of the MP.
+    //Postconditions:
+    //  All RPs of the Fiber MOS Model will be in the starting positions
+    //  of the MP.
+    double calculateDuration(const TMotionProgram& MP) const;
+
+    //Compact a valid MP, merging the gestures of the RPs which not interact.
+    //Each MI is moved to the first previous message list from which
+    //neither the RP nor their adjacent RPs are addressed in any message
+    //list until their own message list. The compacted MP is validated
+    //again, and it is only accepted when it is valid and their duration
+    //is not upper than the duration of the original MP.
+    //Inputs:
+    //  MP: the valid motion program to be compacted.
+    //Outputs:
+    //  compactMotionProgram: flag indicating if the MP has been replaced
+    //      by the compacted MP.
+    //  MP: the compacted MP, if any.
+    //Preconditions:
+    //  All RPs included in the MP:
+    //      shall be in the Fiber MOS Model;
+    //      shall be enabled the quantifiers of their rotors.
+    //  All RPs of the Fiber MOS Model:
+    //      shall be in the starting positions of the MP;
+    //      shall be configured for validate the MP.
+    //Postconditions:
+    //  All RPs of the Fiber MOS Model:
+    //      will be in the starting positions of the MP;
+    //      will have the quantifiers of their rotors in their initial status.
+    bool compactMotionProgram(TMotionProgram& MP);
+
+    //Note that the compaction not change the instructions of the MP,
+    //so the rotors keep moving with the velocity profile of their
+    //ramp functions, and only the time between gestures is reduced.
+
     //-----------------------------------------------------------------------
     //METHODS FOR REGENERATE MPs IN LIMITED SENSE:
 
@@ -581,6 +741,25 @@ public:
     void searchReplacementRPs(TRoboticPositionerList& RRPs,
                               const TRoboticPositioner *RP) const;
 
+    //search the replacement RPs of a RP using a reachability index
+    //Inputs:
+    //  RP: the RP to be replaced.
+    //  RI: reachability index of the RPs of the Fiber MOS Model.
+    //Outputs:
+    //  RRPs: list of replacement RPs.
+    //Preconditions:
+    //  The same of searchReplacementRPs(RRPs, RP).
+    //  The index RI shall be built with the RPs of the Fiber MOS Model.
+    //Postconditions:
+    //  The list RRPs will contains the same RPs than the obtained by
+    //  searchReplacementRPs(RRPs, RP), sorted as the Fiber MOS Model.
+    void searchReplacementRPs(TRoboticPositionerList& RRPs,
+                              const TRoboticPositioner *RP,
+                              const TReachabilityIndex& RI) const;
+
+    //The replacement RPs searched with the reachability index only
+    //are checked among the RPs in whose domain of P3 is the PP.
+
     //A PP is the type must when occur some of the following circunstances:
     //  1. Corresponds to a reference source, and the CB contains the minimun
     //     number of reference sources NRmin or less.
@@ -652,6 +831,11 @@ public:
     bool allocationIsMustType(int i) const;
 
     //Attempt regenerate a pair (PP, DP).
+    //The not operative RPs included in the pair (PP, DP) are excluded.
+    //When a not operative RP has an allocation of type must, the PP is
+    //reallocated to a replacement RP, which is added to the pair with
+    //a gesture to go from the origin to the PP at the end of the PP,
+    //and a gesture to go from the PP to the origin at the begin of the DP.
     //Inputs:
     //  (PP, DP): the pair to regenerate.
     //Outputs:
@@ -659,6 +843,10 @@ public:
     //      has been regenerated.
     //  (PP, DP): the regenerated pair, if any.
     //  Excluded: list of identifiers of the excluded RPs, if Any.
+    //  Replaced: list of identifiers of the excluded RPs
+    //      whose allocation has been reallocated, if any.
+    //  Replacements: list of identifiers of the replacement RPs,
+    //      in the same order than the list Replaced.
     //Preconditions:
     //  All RPs included in the pair (PP, DP):
     //      must be in the FMM;
@@ -667,8 +855,24 @@ public:
     //      must correspond to the status of the real Fiber MOS.
     //  The allocations shall contains the properties enough to
     //      make the regeneration (Type, Pr, Pid, X, Y).
+    //  All RPs of the Fiber MOS Model shall be in the initial positions
+    //      of the pair (PP, DP).
+    //Postconditions:
+    //  When there are replacement RPs, the regenerated pair is validated,
+    //      and it is only accepted if it avoids collisions.
+    //  All RPs of the Fiber MOS Model will be in the initial positions
+    //      of the pair (PP, DP).
     bool attemptRegenerate(TVector<int>& Excluded,
+                           TVector<int>& Replaced, TVector<int>& Replacements,
                            TMotionProgram& PP, TMotionProgram& DP) const;
+
+    //The unsecurity area of each replacement RP is clear and will stay
+    //clear, but the gestures of the replacement RPs are validated
+    //with the rest of the pair, because they could interfere with
+    //other gestures of the pair.
+    //The allocations of the MPG are not modified, so the allocations of
+    //the replaced RPs shall be transferred to the replacement RPs
+    //by the caller (see TFMOSA::transferAllocations).
 };
 
 /*****************************************************************************
@@ -794,6 +998,32 @@ bool generatePairPPDP_online(TMotionProgram& PP, TMotionProgram& DP,
 
 class OutputsParkProg;
 
+//Generate a parking program online on a loaded Fiber MOS Model
+//Inputs:
+//  FMM: the Fiber MOS Model, in their initial status.
+//  p_1s: the rotor 1 starting positions of all RPs of the FMM.
+//  p___3s: the rotor 2 starting positions of all RPs of the FMM.
+//  RPids: the identifiers of the RPs of the FMM to be disabled.
+//Outputs:
+//  outputs: structure OutputsParkProg.
+//  generateParkProg_online:
+//    - true: the generated parking program has passed the validation
+//      process, so it is safe that it not produces a dynamic collission.
+//      moreover there aren't enabled-not-operative RPs with dynamic fault,
+//      but could have either collided or obstructed RPs.
+//    - false: either the generated parking program has not passed
+//      the validation process, so it is not safe that it not produces
+//      a dynamic collission, or there are enabled-not-operative RPs
+//      with dynamic fault.
+//Notes:
+//- The FMM will be changed by the generation process, and the FMM Instance
+//  will not be written. For serve several requests from a resident FMM,
+//  each call shall be made on a clone of it.
+bool generateParkProg_online(OutputsParkProg& outputs,
+        TFiberMOSModel& FMM,
+        const vector<double>& p_1s, const vector<double>& p___3s,
+        const vector<int>& RPids, const unsigned int Bid);
+
 //Generate a parking program online
 //Inputs:
 //  FMMI_dir: dir of the FMM Instance
@@ -811,6 +1041,8 @@ class OutputsParkProg;
 //      the validation process, so it is not safe that it not produces
 //      a dynamic collission, or there are enabled-not-operative RPs
 //      with dynamic fault.
+//Notes:
+//- The FMM Instance is read through their snapshot, when it is up to date.
 bool generateParkProg_online(OutputsParkProg& outputs,
         const string& FMMI_dir,
         const vector<double>& p_1s, const vector<double>& p___3s,
@@ -818,6 +1050,29 @@ bool generateParkProg_online(OutputsParkProg& outputs,
 
 class OutputsPairPPDP;
 
+//Generate a pair (PP, DP) online on a loaded Fiber MOS Model
+//Inputs:
+//  FMM: the Fiber MOS Model, in their initial status.
+//  p_1s: the rotor 1 observing positions of all RPs of the FMM.
+//  p___3s: the rotor 2 observing positions of all RPs of the FMM.
+//  RPids: the identifiers of the RPs of the FMM to be disabled.
+//Outputs:
+//  outputs: structure OutputsPairPPDP (without FMOSA).
+//  generatePairPPDP_online:
+//    - true: the generated pair (PP, DP) has passed the validation
+//      process, so it is safe that it not produces a dynamic collission.
+//      moreover there aren't enabled-not-operative RPs with dynamic fault,
+//      and there aren't neither collided nor obstructed RPs.
+//    - false: some of above conditions are not meet.
+//Notes:
+//- The FMM will be changed by the generation process, and the FMM Instance
+//  will not be written. For serve several requests from a resident FMM,
+//  each call shall be made on a clone of it.
+bool generatePairPPDP_online(OutputsPairPPDP& outputs,
+        TFiberMOSModel& FMM,
+        const vector<double>& p_1s, const vector<double>& p___3s,
+        const vector<int>& RPids, const unsigned int Bid);
+
 //Generate a pair (PP, DP) online
 //Inputs:
 //  FMMI_dir: dir of the FMM Instance
@@ -832,6 +1087,8 @@ class OutputsPairPPDP;
 //      moreover there aren't enabled-not-operative RPs with dynamic fault,
 //      and there aren't neither collided nor obstructed RPs.
 //    - false: some of above conditions are not meet.
+//Notes:
+//- The FMM Instance is read through their snapshot, when it is up to date.
 bool generatePairPPDP_online(OutputsPairPPDP& outputs,
         const string& FMMI_dir,
         const vector<double>& p_1s, const vector<double>& p___3s,
@@ -886,8 +1143,6 @@ bool generatePairPPDP_online(string& outputs_str,
 
 //############################################################################
 //Precondition and their exceptions:
-//  EImproperCall       locale information shall be set to minimal C locale
-//      (you can make this calling "setlocale(LC_ALL, "C");")
 //  EImproperFileLoadedValue: directory FMMI_dir shall contains
 //      a valid FMM Instance.
 //  EImproperArgument   vector p_1s should has one position
@@ -183,10 +183,46 @@ double TMotionProgramValidator::calculateTf(TRoboticPositioner *RP,
     if(EAA == NULL)
         throw EImproperArgument("pointer EAA should point to built exclusion area");
 
+    //search the EA in the list of adjacents of the RP
+    const TAdjacentEAList& AdjacentEAs = RP->getActuator()->AdjacentEAs;
+    int i = 0;
+    while(i<AdjacentEAs.getCount() && EAA!=AdjacentEAs[i].EA)
+        i++;
+    if(i >= AdjacentEAs.getCount())
+        throw EImproperArgument("pointer EAA should be an adjacent exclusion area");
+
+    return calculateTfAdjacentEA(RP, i);
+}
+//calculates the time free of collission of two RPs
+double TMotionProgramValidator::calculateTf(TRoboticPositioner *RP,
+                                            const TRoboticPositioner *RPA) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
+    if(RPA == NULL)
+        throw EImproperArgument("pointer RPA should point to built robotic positioner");
+
+    //search the RPA in the list of adjacents of the RP
+    const TAdjacentRPList& AdjacentRPs = RP->getActuator()->AdjacentRPs;
+    int i = 0;
+    while(i<AdjacentRPs.getCount() && RPA->getActuator()!=AdjacentRPs[i].RP->getActuator())
+        i++;
+    if(i >= AdjacentRPs.getCount())
+        throw EImproperArgument("pointer RPA should be an adjacent robotic positioner");
+
+    return calculateTfAdjacentRP(RP, i);
+}
+//calculates the time free of collission of a RP and
+//the EA in the position i of its list of adjacent EAs
+double TMotionProgramValidator::calculateTfAdjacentEA(TRoboticPositioner *RP, int i) const
+{
     //MAKE ACTIONS:
 
     //calcula la distancia entre los contornos
-    double D = RP->getActuator()->distanceMin(EAA);
+    const TExclusionArea *EAA = RP->getActuator()->AdjacentEAs[i].EA;
+    double D = RP->getActuator()->distanceMinAdjacentEA(i);
     //calcula la distancia libre
     double Df = D - RP->getActuator()->getArm()->getSPM() - EAA->Barrier.getSPM();
 
@@ -220,21 +256,15 @@ double TMotionProgramValidator::calculateTf(TRoboticPositioner *RP,
 
     return Tf; //return Tf
 }
-//calculates the time free of collission of two RPs
-double TMotionProgramValidator::calculateTf(TRoboticPositioner *RP,
-                                            const TRoboticPositioner *RPA) const
+//calculates the time free of collission of a RP and
+//the RP in the position i of its list of adjacent RPs
+double TMotionProgramValidator::calculateTfAdjacentRP(TRoboticPositioner *RP, int i) const
 {
-    //CHECK THE PRECONDITIONS:
-
-    if(RP == NULL)
-        throw EImproperArgument("pointer RP should point to built robotic positioner");
-    if(RPA == NULL)
-        throw EImproperArgument("pointer RPA should point to built robotic positioner");
-
     //MAKE ACTIONS:
 
     //calcula la distancia entre los contornos
-    double D = RP->getActuator()->distanceMin(RPA->getActuator());
+    const TRoboticPositioner *RPA = RP->getActuator()->AdjacentRPs[i].RP;
+    double D = RP->getActuator()->distanceMinAdjacentRP(i);
     //calcula la distancia libre de los brazos
     double Df = D - RP->getActuator()->getArm()->getSPM() - RPA->getActuator()->getArm()->getSPM();
 
@@ -334,14 +364,12 @@ double TMotionProgramValidator::calculateTfmin(TRoboticPositioner *RP) const
     //determines the Tf between each adjacent RP and select the minimun
     double Tfmin = DBL_MAX;
     for(int i=0; i<RP->getActuator()->AdjacentEAs.getCount(); i++) {
-        TExclusionArea *EAA = RP->getActuator()->AdjacentEAs[i].EA;
-        double Tf = calculateTf(RP, EAA);
+        double Tf = calculateTfAdjacentEA(RP, i);
         if(Tf < Tfmin)
             Tfmin = Tf;
     }
     for(int i=0; i<RP->getActuator()->AdjacentRPs.getCount(); i++) {
-        TRoboticPositioner *RPA = RP->getActuator()->AdjacentRPs[i].RP;
-        double Tf = calculateTf(RP, RPA);
+        double Tf = calculateTfAdjacentRP(RP, i);
         if(Tf < Tfmin)
             Tfmin = Tf;
     }
@@ -380,6 +408,11 @@ double TMotionProgramValidator::calculateTfmin(const TRoboticPositionerList& RPL
 {
     //minimun time free of the RPs of the RPL
     double Tfmin = DBL_MAX; //initialize Tfmin with its maximun possible value
+
+    //The lists of adjacents are read instead of the adjacency graph
+    //of the FMM, because the search of the recovery programs restricts
+    //them temporarily to a single adjacent. The Dmin and Dend of each
+    //adjacent are accessed through its position in the list.
     bool notcollision = true; //initialize the collision indicator flag
 
     //calculates the Tf for the RPs of the RPL and select the minimun
@@ -391,11 +424,8 @@ double TMotionProgramValidator::calculateTfmin(const TRoboticPositionerList& RPL
         //calculates the Tf for the RP with their adjacents and select the minimun
         int k = 0;
         while(k<RP->getActuator()->AdjacentEAs.getCount() && notcollision) {
-            //point the indicated adjacent RP to facilitateits access
-            TExclusionArea *EAA = RP->getActuator()->AdjacentEAs[k].EA;
-
             //calculates the free time between the RP and its adjacent
-            double Tf = calculateTf(RP, EAA);
+            double Tf = calculateTfAdjacentEA(RP, k);
 
             //if there is collision
             if(Tf < 0) {
@@ -416,11 +446,8 @@ double TMotionProgramValidator::calculateTfmin(const TRoboticPositionerList& RPL
         //calculates the Tf for the RP with their adjacents and select the minimun
         k = 0;
         while(k<RP->getActuator()->AdjacentRPs.getCount() && notcollision) {
-            //point the indicated adjacent RP to facilitateits access
-            TRoboticPositioner *RPA = RP->getActuator()->AdjacentRPs[k].RP;
-
             //calculates the free time between the RP and its adjacent
-            double Tf = calculateTf(RP, RPA);
+            double Tf = calculateTfAdjacentRP(RP, k);
 
             //if there is collision
             if(Tf < 0) {
@@ -80,6 +80,12 @@ protected:
     //calculates the time free of collission of a RP and an EA
     double calculateTf(TRoboticPositioner *RP,
                        const TExclusionArea *EAA) const;
+    //calculates the time free of collission of a RP and
+    //the EA in the position i of its list of adjacent EAs
+    double calculateTfAdjacentEA(TRoboticPositioner *RP, int i) const;
+    //calculates the time free of collission of a RP and
+    //the RP in the position i of its list of adjacent RPs
+    double calculateTfAdjacentRP(TRoboticPositioner *RP, int i) const;
     //calculates the time free of collission of two RPs
     double calculateTf(TRoboticPositioner *RP,
                        const TRoboticPositioner *RPA) const;
@@ -0,0 +1,230 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: OutputWriter.cpp
+//Content: concurrent writing of output files
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "OutputWriter.h"
+#include "TextFile.h" //TTextOutputStream
+#include "Strings.h" //inttostr
+#include "Exceptions.h"
+
+#include <stdio.h> //remove
+
+//---------------------------------------------------------------------------
+
+//namespace for strings
+namespace Strings {
+
+//---------------------------------------------------------------------------
+//TOutputWriter:
+//---------------------------------------------------------------------------
+
+//PRIVATE:
+
+//write a task in its file
+void TOutputWriter::writeFile(TTask *T)
+{
+    string path;
+    try {
+        //the entries which are only messages haven't file
+        path = T->Files->getPath(T->i);
+        if(path.length() <= 0)
+            return;
+
+        //format the file directly in the file
+        TTextOutputStream os(path);
+        T->Files->write(os, T->i);
+        os.close();
+    }
+    catch(Exception& E) {
+        T->error = "writing file '"+path+"': "+E.Message.str;
+    }
+    catch(...) {
+        T->error = "writing file '"+path+"': unknown exception";
+    }
+
+    //a file partially written shall not be confused with a file written
+    if(T->error.length() > 0 && path.length() > 0)
+        remove(path.c_str());
+}
+
+//process a pending task, with the mutex locked,
+//unlocking the mutex while the task is processed
+bool TOutputWriter::processTask(void)
+{
+    if(p_next >= p_Tasks.size())
+        return false;
+
+    TTask *T = p_Tasks[p_next++];
+    pthread_mutex_unlock(&p_mutex);
+    writeFile(T);
+    pthread_mutex_lock(&p_mutex);
+    p_written++;
+    pthread_cond_broadcast(&p_cond);
+    return true;
+}
+
+//process the tasks until the writer stops
+void *TOutputWriter::worker(void *arg)
+{
+    TOutputWriter *W = (TOutputWriter*)arg;
+
+    pthread_mutex_lock(&W->p_mutex);
+    while(true) {
+        if(W->processTask())
+            continue;
+        if(W->p_Stopping)
+            break;
+        pthread_cond_wait(&W->p_cond, &W->p_mutex);
+    }
+    pthread_mutex_unlock(&W->p_mutex);
+
+    return NULL;
+}
+
+//PUBLIC:
+
+//build an output writer without workers
+TOutputWriter::TOutputWriter(void) :
+    p_Tasks(), p_Owned(), p_next(0), p_written(0),
+    p_Workers(), p_Stopping(false)
+{
+    pthread_mutex_init(&p_mutex, NULL);
+    pthread_cond_init(&p_cond, NULL);
+}
+//wait the pending files and stop the workers
+TOutputWriter::~TOutputWriter()
+{
+    try {
+        vector<string> messages;
+        vector<TLogLevel> levels;
+        wait(messages, levels);
+    }
+    catch(...) {
+    }
+    stop();
+
+    pthread_cond_destroy(&p_cond);
+    pthread_mutex_destroy(&p_mutex);
+}
+
+//start a number of workers
+void TOutputWriter::start(unsigned int workers)
+{
+    //check the preconditions
+    if(p_Workers.size() > 0)
+        throw EImproperCall("workers should not be started");
+
+    //start the workers
+    p_Stopping = false;
+    for(unsigned int i=0; i<workers; i++) {
+        pthread_t thread;
+        if(pthread_create(&thread, NULL, worker, this) != 0) {
+            stop();
+            throw ECantComplete("can't start the worker "+inttostr(i));
+        }
+        p_Workers.push_back(thread);
+    }
+}
+//stop the workers, waiting they write the pending files
+void TOutputWriter::stop(void)
+{
+    pthread_mutex_lock(&p_mutex);
+    p_Stopping = true;
+    pthread_cond_broadcast(&p_cond);
+    pthread_mutex_unlock(&p_mutex);
+
+    for(unsigned int i=0; i<p_Workers.size(); i++)
+        pthread_join(p_Workers[i], NULL);
+    p_Workers.clear();
+}
+
+//add a set of files to be written
+void TOutputWriter::add(const TOutputFiles& Files)
+{
+    pthread_mutex_lock(&p_mutex);
+    for(unsigned int i=0; i<Files.getCount(); i++)
+        p_Tasks.push_back(new TTask(&Files, i));
+    pthread_cond_broadcast(&p_cond);
+    pthread_mutex_unlock(&p_mutex);
+}
+//add a set of files to be written, which will be destroyed
+//by the writer once the files have been written
+void TOutputWriter::add(TOutputFiles *Files)
+{
+    //check the precondition
+    if(Files == NULL)
+        throw EImproperArgument("pointer Files should point to built set of files");
+
+    pthread_mutex_lock(&p_mutex);
+    p_Owned.push_back(Files);
+    pthread_mutex_unlock(&p_mutex);
+
+    add(*Files);
+}
+
+//wait until all files added have been written
+void TOutputWriter::wait(vector<string>& messages, vector<TLogLevel>& levels)
+{
+    pthread_mutex_lock(&p_mutex);
+    //help the workers writing the files
+    while(p_written < p_Tasks.size())
+        if(!processTask())
+            pthread_cond_wait(&p_cond, &p_mutex);
+
+    //collect the results and reset the writer
+    vector<TTask*> Tasks;
+    Tasks.swap(p_Tasks);
+    vector<TOutputFiles*> Owned;
+    Owned.swap(p_Owned);
+    p_next = 0;
+    p_written = 0;
+    pthread_mutex_unlock(&p_mutex);
+
+    string errors;
+    for(unsigned int i=0; i<Tasks.size(); i++) {
+        TTask *T = Tasks[i];
+        if(T->error.length() > 0) {
+            if(errors.length() > 0)
+                errors += "; ";
+            errors += T->error;
+        } else {
+            string message = T->Files->getMessage(T->i);
+            if(message.length() > 0) {
+                messages.push_back(message);
+                levels.push_back(T->Files->getLevel(T->i));
+            }
+        }
+        delete T;
+    }
+    for(unsigned int i=0; i<Owned.size(); i++)
+        delete Owned[i];
+
+    if(errors.length() > 0)
+        throw ECantComplete(errors);
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Strings
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,165 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: OutputWriter.h
+//Content: concurrent writing of output files
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef OUTPUTWRITER_H
+#define OUTPUTWRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <pthread.h> //pthread_t, pthread_mutex_t, pthread_cond_t
+
+#include "Log.h" //TLogLevel
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+//namespace for strings
+namespace Strings {
+
+//---------------------------------------------------------------------------
+//TOutputFiles:
+//---------------------------------------------------------------------------
+
+//set of files to be written by an output writer
+class TOutputFiles {
+public:
+    //destroy the set of files
+    virtual ~TOutputFiles() {;}
+
+    //number of entries of the set
+    virtual unsigned int getCount(void) const = 0;
+    //path of the file i,
+    //or empty string when the entry i is only a message to be annotated
+    virtual string getPath(unsigned int i) const = 0;
+    //message to be annotated in the log when the file i has been written
+    virtual string getMessage(unsigned int i) const = 0;
+    //level of the message of the entry i
+    virtual TLogLevel getLevel(unsigned int i) const {return llINFO;}
+    //write the content of the file i in a stream
+    //(can be called concurrently for different files)
+    virtual void write(ostream& os, unsigned int i) const = 0;
+};
+
+//---------------------------------------------------------------------------
+//TOutputWriter:
+//---------------------------------------------------------------------------
+
+//The output writer writes the files concurrently in the background,
+//so the writing can be overlapped with other work.
+//
+//Each file is formatted directly in its file, so the data of the sets
+//of files is accessed until the files have been written (wait),
+//and the files aren't kept in memory.
+//
+//The messages of the entries are returned in order of addition,
+//so the entries which are only messages keep their place in the log.
+//
+//The chars '\r' are discarded from the files (like strWriteToFile).
+//
+//When there aren't workers, the files are written
+//by the thread which waits them.
+
+//class output writer
+class TOutputWriter {
+    //file to be written
+    class TTask {
+    public:
+        const TOutputFiles *Files;
+        unsigned int i;
+        string error;
+
+        TTask(const TOutputFiles *t_Files, unsigned int t_i) :
+            Files(t_Files), i(t_i), error() {;}
+    };
+
+    //tasks added since the last wait, in order of addition
+    vector<TTask*> p_Tasks;
+    //sets of files owned by the writer, to be destroyed in the next wait
+    vector<TOutputFiles*> p_Owned;
+    //index of the next task to be written
+    unsigned int p_next;
+    //number of tasks written (successfully or not)
+    unsigned int p_written;
+
+    //workers writting the files
+    vector<pthread_t> p_Workers;
+    //indicates that the workers shall finish
+    bool p_Stopping;
+    //mutex and condition for access to the tasks
+    pthread_mutex_t p_mutex;
+    pthread_cond_t p_cond;
+
+    //write a task in its file
+    static void writeFile(TTask *T);
+    //process a pending task, with the mutex locked,
+    //unlocking the mutex while the task is processed
+    //return false if there isn't a pending task
+    bool processTask(void);
+
+    //process the tasks until the writer stops
+    static void *worker(void *arg);
+
+public:
+    //number of workers
+    unsigned int getWorkersCount(void) const {return p_Workers.size();}
+
+    //build an output writer without workers
+    TOutputWriter(void);
+    //wait the pending files and stop the workers
+    ~TOutputWriter();
+
+    //start a number of workers
+    //if the workers are already started:
+    //  throw an exception EImproperCall
+    void start(unsigned int workers);
+    //stop the workers, waiting they write the pending files
+    void stop(void);
+
+    //add a set of files to be written
+    //Preconditions:
+    //  The set of files shall exist until wait returns.
+    void add(const TOutputFiles& Files);
+    //add a set of files to be written, which will be destroyed
+    //by the writer once the files have been written
+    //if Files is NULL:
+    //  throw an exception EImproperArgument
+    void add(TOutputFiles *Files);
+
+    //wait until all files added have been written
+    //Outputs:
+    //  messages: messages of the entries written, in order of addition
+    //  levels: levels of the messages
+    //if some file can't be written:
+    //  throw an exception ECantComplete
+    void wait(vector<string>& messages, vector<TLogLevel>& levels);
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Strings
+
+//---------------------------------------------------------------------------
+#endif // OUTPUTWRITER_H
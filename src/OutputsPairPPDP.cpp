@@ -26,6 +26,7 @@
 #include "Strings.h"
 
 #include <uuid/uuid.h>
+#include <sstream> //ostringstream
 
 //For install:
 //  sudo apt-get install uuid-dev
@@ -43,8 +44,8 @@ namespace Positioning {
 
 //PRIVATE:
 
-//functions for add data to a JSON object
-void OutputsPairPPDP::addUUID(Json::Value &object) const
+//functions for write data in format JSON
+void OutputsPairPPDP::writeUUID(TJSONWriter& W) const
 {
     //get the uuid
     uuid_t uuid;
@@ -52,168 +53,83 @@ void OutputsPairPPDP::addUUID(Json::Value &object) const
     //unparse the uuid to string
     char uuid_c_str[37];
     uuid_unparse(uuid, uuid_c_str);
-    object["uuid"] = string(uuid_c_str);
+    W.name("uuid");
+    W.value(uuid_c_str);
 }
-Json::Value OutputsPairPPDP::getComments(void) const
+void OutputsPairPPDP::writeComments(TJSONWriter& W) const
 {
-    //build a json array
-    Json::Value object;
-
-    string str = "# Pair (PP, DP) outputs generated ";
-    if(FMOSA_filename.length() > 0)
-        str += "from FMOSA " + FMOSA_filename;
-    else
-        str += "online (not from FMOSA)";
-    object.append(str);
-
-    str = "# Generated with FMPT version "+FMPT_version;
-    object.append(str);
-    str = "# Date of generation: "+datetime;
-    object.append(str);
-
-    if(EnabledNotOperative.getCount() > 0) {
-        str = "# WARNING! This pair (PP, DP) has been generated with enabled-not-operative RPs:";
-        object.append(str);
-        str = "# Enabled-not-operative RP ids: " + EnabledNotOperative.getText().str;
-        object.append(str);
-
-        //get the list of dangerous RPs
-        TRoboticPositionerList Dangerous;
-        EnabledNotOperative.getDangerous(Dangerous);
-
-        str = "# Dangerous RPs are enabled-not-operative RPs with fault type dyynamic or unknowledge";
-        object.append(str);
-        if(Dangerous.getCount() > 0) {
-            str = "# ERROR! This pair (PP, DP) has been generated with dangerous RPs:";
-            object.append(str);
-            str = "# Dangerous RP ids: " + Dangerous.getText().str;
-            object.append(str);
-        }
-        else {
-            str = "# This pair (PP, DP) has been generated without dangerous RPs.";
-            object.append(str);
-        }
-    }
-    else {
-        str = "# This pair (PP, DP) has been generated without enabled-not-operative RPs.";
-        object.append(str);
-    }
-
-    if(Collided.getCount() > 0 || Obstructed.getCount() > 0) {
-        if(Collided.getCount() > 0) {
-            str = "# WARNING! the FMOSA contains collided items (either EAs or RPs):";
-            object.append(str);
-            str = "# Collided items: " + collided_str;
-            object.append(str);
-            str = "# Collided RP ids: " + Collided.getText().str;
-            object.append(str);
-        }
-        if(Obstructed.getCount() > 0) {
-            str = "# WARNING! the FMOSA contains obstructed RPs:";
-            object.append(str);
-            str = "# Obstructed RP ids: " + Obstructed.getText().str;
-            object.append(str);
-        }
-        str = "# The initial positions of the collided or obstructed RPs match with their observing positions.";
-        object.append(str);
-    }
-    else {
-        str = "# The pair (PP, DP) has been generated without neither collided nor obstructed RPs.";
-        object.append(str);
-    }
-
-    str = "# A pair (PP, DP) is suitable to be executed when it is valid (avoid collisions) and there aren't";
-    object.append(str);
-    str = "# dangerous RPs in the Fiber MOS (enabled-not-operative RPs with fault type dynamic or unknowledge),";
-    object.append(str);
-    str = "# and there aren't neither collided nor obstructed RPs.";
-    object.append(str);
-    if(suitable()) {
-        str = "# According the actual status of the FMPT, this pair (PP, DP) is suitable to be executed.";
-        object.append(str);
-    }
-    else {
-        str = "# According the actual status of the FMPT, this pair (PP, DP) is not suitable to be executed.";
-        object.append(str);
-    }
-
-    return object;
+    //write each line of the comments as a string
+    W.beginArray();
+    W.valueLines(getCommentsText());
+    W.endArray();
 }
-Json::Value OutputsPairPPDP::getPos(void) const
+void OutputsPairPPDP::writePos(TJSONWriter& W) const
 {
-    //build a json object
-    Json::Value object;
+    W.beginObject();
+
+    //add the Bid
+    W.name("Bid");
+    W.value(Bid);
+    //add the PP
+    W.name("PP");
+    PP.writeJSON(W, IPL);
 
     //add comment about name
-    Json::Value comments;
-    comments.append("# PP (Positioning Program)");
+    W.name("comments");
+    W.beginArray();
+    W.value("# PP (Positioning Program)");
 
     //add comment about validity
-    string str;
     if(PPvalid) {
-        str = "# This PP avoids collisions when it is executed starting from the initial positions (check out IPL).";
+        W.value("# This PP avoids collisions when it is executed starting from the initial positions (check out IPL).");
     } else {
-        str = "# ERROR! This PP produces a collision when it is executed starting from the initial positions (check out IPL).";
+        W.value("# ERROR! This PP produces a collision when it is executed starting from the initial positions (check out IPL).");
     }
-    comments.append(str);
 
     //add comment about approximations
     if(PP.thereIsSomeCommentDsec()) {
-        str = "# WARNING! This PP contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:";
-        comments.append(str);
-        str = PP.getCommentsDsecMCStext();
-        comments.append(str);
+        W.value("# WARNING! This PP contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:");
+        W.value(PP.getCommentsDsecMCStext());
     } else {
-        str = "# All radial movements of this PP keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.";
-        comments.append(str);
+        W.value("# All radial movements of this PP keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.");
     }
+    W.endArray();
 
-    //add the coments
-    object["comments"] = comments;
-    //add the Bid
-    object["Bid"] = Bid;
-    //add the PP
-    object["PP"] = PP.getJSON(IPL);
-
-    return object;
+    W.endObject();
 }
-Json::Value OutputsPairPPDP::getDepos(void) const
+void OutputsPairPPDP::writeDepos(TJSONWriter& W) const
 {
-    //build a json object
-    Json::Value object;
+    W.beginObject();
+
+    //add the Bid
+    W.name("Bid");
+    W.value(Bid);
+    //add the DP
+    W.name("DP");
+    DP.writeJSON(W, OPL);
 
     //add comment about name
-    Json::Value comments;
-    comments.append("# DP (Depositioning Program)");
+    W.name("comments");
+    W.beginArray();
+    W.value("# DP (Depositioning Program)");
 
     //add comment about validity
-    string str;
     if(DPvalid) {
-        str = "# This DP avoids collisions when it is executed starting from the observing positions (check out OPL).";
+        W.value("# This DP avoids collisions when it is executed starting from the observing positions (check out OPL).");
     } else {
-        str = "# ERROR! This DP produces a collision when it is executed starting from the observing positions (check out OPL).";
+        W.value("# ERROR! This DP produces a collision when it is executed starting from the observing positions (check out OPL).");
     }
-    comments.append(str);
 
     //add comment about approximations
     if(DP.thereIsSomeCommentDsec()) {
-        str = "# WARNING! This DP contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:";
-        comments.append(str);
-        str = DP.getCommentsDsecMCStext();
-        comments.append(str);
+        W.value("# WARNING! This DP contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:");
+        W.value(DP.getCommentsDsecMCStext());
     } else {
-        str = "# All radial movements of this DP keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.";
-        comments.append(str);
+        W.value("# All radial movements of this DP keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.");
     }
+    W.endArray();
 
-    //add the coments
-    object["comments"] = comments;
-    //add the Bid
-    object["Bid"] = Bid;
-    //add the DP
-    object["DP"] = DP.getJSON(OPL);
-
-    return object;
+    W.endObject();
 }
 
 //PUBLIC:
@@ -251,10 +167,6 @@ string OutputsPairPPDP::getWarningNotSuitable(void) const
 //get the comments about outputs
 string OutputsPairPPDP::getCommentsText(void) const
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
     string str = "# Pair (PP, DP) outputs generated ";
     if(FMOSA_filename.length() > 0)
         str += "from FMOSA " + FMOSA_filename;
@@ -319,63 +231,60 @@ string OutputsPairPPDP::getCommentsText(void) const
 //  the pair (PP, DP)
 //  the FMOSA
 void OutputsPairPPDP::getText(string& str, bool includeFMOSA) const
-
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
-    if(suitable())
-        str = "";
-    else {
-        str = getWarningNotSuitable();
-        str += "\r\n\r\n";
-    }
+    ostringstream os;
+    writeText(os, includeFMOSA);
+    str = os.str();
+}
+//write outputs in format MCS in a stream
+void OutputsPairPPDP::writeText(ostream& os, bool includeFMOSA) const
+{
+    if(!suitable())
+        os << getWarningNotSuitable() << "\r\n\r\n";
 
     //print the coments about outputs
-    str += getCommentsText();
+    os << getCommentsText();
 
-    str += "\r\n";
-    str += "\r\n# Positioning program";
+    os << "\r\n";
+    os << "\r\n# Positioning program";
     if(PPvalid) {
-        str += "\r\n# This PP avoids collisions when it is executed starting from the initial positions (check out IPL).";
+        os << "\r\n# This PP avoids collisions when it is executed starting from the initial positions (check out IPL).";
     } else {
-        str += "\r\n# ERROR! This PP produces a collision when it is executed starting from the initial positions (check out IPL).";
+        os << "\r\n# ERROR! This PP produces a collision when it is executed starting from the initial positions (check out IPL).";
     }
     if(PP.thereIsSomeCommentDsec()) {
-        str += "\r\n# WARNING! This PP contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:";
-        str += "\r\n"+PP.getCommentsDsecMCStext();
+        os << "\r\n# WARNING! This PP contains instructions that produce radial movements which produce approximations closer than " << floattostr(DsecMax) << " mm:";
+        os << "\r\n" << PP.getCommentsDsecMCStext();
     } else {
-        str += "\r\n# All radial movements of this PP keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.";
+        os << "\r\n# All radial movements of this PP keep a security distance upper or equal to " << floattostr(DsecMax) << " mm.";
     }
-    str += "\r\n@@SPP@@";
-    string aux;
-    PP.getMCStext(aux, "pos", Bid, IPL);
-    str += "\r\n"+aux;
-    str += "\r\n@@EPP@@";
+    os << "\r\n@@SPP@@";
+    os << "\r\n";
+    PP.writeMCStext(os, "pos", Bid, IPL);
+    os << "\r\n@@EPP@@";
 
-    str += "\r\n";
-    str += "\r\n# Depositioning program";
+    os << "\r\n";
+    os << "\r\n# Depositioning program";
     if(DPvalid) {
-        str += "\r\n# This DP avoids collisions when it is executed starting from the observing positions (check out OPL).";
+        os << "\r\n# This DP avoids collisions when it is executed starting from the observing positions (check out OPL).";
     } else {
-        str += "\r\n# ERROR! This DP produces a collision when it is executed starting from the observing positions (check out OPL).";
+        os << "\r\n# ERROR! This DP produces a collision when it is executed starting from the observing positions (check out OPL).";
     }
     if(DP.thereIsSomeCommentDsec()) {
-        str += "\r\n# WARNING! This DP contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:";
-        str += "\r\n"+DP.getCommentsDsecMCStext();
+        os << "\r\n# WARNING! This DP contains instructions that produce radial movements which produce approximations closer than " << floattostr(DsecMax) << " mm:";
+        os << "\r\n" << DP.getCommentsDsecMCStext();
     } else {
-        str += "\r\n# All radial movements of this DP keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.";
+        os << "\r\n# All radial movements of this DP keep a security distance upper or equal to " << floattostr(DsecMax) << " mm.";
     }
-    str += "\r\n@@SDP@@";
-    DP.getMCStext(aux, "depos", Bid, OPL);
-    str += "\r\n"+aux;
-    str += "\r\n@@EDP@@";
+    os << "\r\n@@SDP@@";
+    os << "\r\n";
+    DP.writeMCStext(os, "depos", Bid, OPL);
+    os << "\r\n@@EDP@@";
 
     if(includeFMOSA) {
-        str += "\r\n";
-        FMOSA.getTableText(aux);
-        str += "\r\n"+aux;
+        os << "\r\n";
+        os << "\r\n";
+        FMOSA.writeTableText(os);
     }
 }
 
@@ -385,54 +294,43 @@ void OutputsPairPPDP::getText(string& str, bool includeFMOSA) const
 //  the FMOSA
 string OutputsPairPPDP::getJSONtext(bool includeFMOSA) const
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
-    //build the JSON object and parse the schema
-    //  json_object *root;
-    //  root = json_tokener_parse(schema.c_str());
-
-    //check the result of the parsing
-    //  if(root == NULL)
-    //      throw EImproperFileLoadedValue("failed so parse JSON");
-
-    //set value for token "instrument"
-    //  json_object *val;
-    //  //val = json_object_object_get(root, "instrument");
-    //  val = json_object_array_get_idx(root, 0);
-    //  if(val == NULL || json_object_get_type(val) != json_type_string)
-    //      throw EImpossibleError("lateral effect");
-    //  json_object_object_add(val, "instrument", json_object_new_string("MEGARA"));
-    //  json_object_array_put_idx(root, 0, val);
-
-    //build a json object
-    Json::Value root;
-
-    //add (instrument, uuid, tittle)
-    root["instrument"] = "MEGARA";
-    addUUID(root);
-    root["tittle"] = "Tittle from FMAT";
-
-    //add the coments
-    root["comments"] = getComments();
+    ostringstream os;
+    writeJSONtext(os, includeFMOSA);
+    return os.str();
+}
+//write outputs in format JSON in a stream
+//(the members are written in the order of the JSON objects)
+void OutputsPairPPDP::writeJSONtext(ostream& os, bool includeFMOSA) const
+{
+    if(!suitable())
+        os << getWarningNotSuitable() << "\r\n\r\n";
 
-    //add (pos, depos, FMOSA)
-    root["pos"] = getPos();
-    root["depos"] = getDepos();
-    if(includeFMOSA)
-        root["FMOSA"] = FMOSA.getJSON();
+    TJSONWriter W(os);
+    W.beginObject();
 
-    string str;
-    if(suitable())
-        str = "";
-    else {
-        str = getWarningNotSuitable();
-        str += "\r\n\r\n";
+    //add the FMOSA
+    if(includeFMOSA) {
+        W.name("FMOSA");
+        FMOSA.writeJSON(W);
     }
-    Json::StyledWriter writer;
-    str += writer.write(root);
-    return str;
+
+    //add the coments
+    W.name("comments");
+    writeComments(W);
+
+    //add (depos, instrument, pos, tittle, uuid)
+    W.name("depos");
+    writeDepos(W);
+    W.name("instrument");
+    W.value("MEGARA");
+    W.name("pos");
+    writePos(W);
+    W.name("tittle");
+    W.value("Tittle from FMAT");
+    writeUUID(W);
+
+    W.endObject();
+    W.end();
 }
 
 //get other outputs in text format with:
@@ -440,10 +338,6 @@ string OutputsPairPPDP::getJSONtext(bool includeFMOSA) const
 //  other properties in format assigns
 void OutputsPairPPDP::getOtherText(string& str) const
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
     //print the coments about outputs
     str = getCommentsText();
 
@@ -488,10 +382,6 @@ void OutputsPairPPDP::getOtherText(string& str) const
 void OutputsPairPPDP::setText(const string& str, bool includeFMOSA)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //divide the string str in lines
         TStrings Strings;
         StrDivideInLines(Strings, str);
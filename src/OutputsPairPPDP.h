@@ -49,11 +49,11 @@ namespace Positioning {
 class OutputsPairPPDP
 {
 private:
-    //functions for add data to a JSON object
-    void addUUID(Json::Value &object) const;
-    Json::Value getComments(void) const;
-    Json::Value getPos(void) const;
-    Json::Value getDepos(void) const;
+    //functions for write data in format JSON
+    void writeUUID(TJSONWriter& W) const;
+    void writeComments(TJSONWriter& W) const;
+    void writePos(TJSONWriter& W) const;
+    void writeDepos(TJSONWriter& W) const;
 
 public:
     //properties for built comments about file outputs
@@ -88,12 +88,18 @@ public:
     //  the pair (PP, DP)
     //  the FMOSA
     void getText(string& str, bool includeFMOSA=true) const;
+    //write outputs in format MCS in a stream
+    //(without build the text in memory)
+    void writeText(ostream& os, bool includeFMOSA=true) const;
 
     //get outputs in format JSON with:
     //  comments
     //  the pair (PP, DP)
     //  the FMOSA
     string getJSONtext(bool includeFMOSA=true) const;
+    //write outputs in format JSON in a stream
+    //(without build the JSON object in memory)
+    void writeJSONtext(ostream& os, bool includeFMOSA=true) const;
 
     //get other outputs in text format with:
     //  comments
@@ -26,6 +26,7 @@
 #include "Strings.h"
 
 #include <uuid/uuid.h>
+#include <sstream> //ostringstream
 //#include <json/json_object.h>
 //#include <json/json_tokener.h>
 
@@ -46,8 +47,8 @@ namespace Positioning {
 
 //PRIVATE:
 
-//functions for add data to a JSON object
-void OutputsParkProg::addUUID(Json::Value &object) const
+//functions for write data in format JSON
+void OutputsParkProg::writeUUID(TJSONWriter& W) const
 {
     //get the uuid
     uuid_t uuid;
@@ -55,128 +56,49 @@ void OutputsParkProg::addUUID(Json::Value &object) const
     //unparse the uuid to string
     char uuid_c_str[37];
     uuid_unparse(uuid, uuid_c_str);
-    object["uuid"] = string(uuid_c_str);
+    W.name("uuid");
+    W.value(uuid_c_str);
 }
-Json::Value OutputsParkProg::getComments(void) const
+void OutputsParkProg::writeComments(TJSONWriter& W) const
 {
-    //build a json array
-    Json::Value object;
-
-    string str = "# Parkig program outputs generated ";
-    if(FMOSA_filename.length() > 0)
-        str += "from FMOSA " + FMOSA_filename;
-    else
-        str += "online (not from FMOSA)";
-    object.append(str);
-
-    str = "# Generated with FMPT version "+FMPT_version;
-    object.append(str);
-    str = "# Date of generation: "+datetime;
-    object.append(str);
-
-    if(EnabledNotOperative.getCount() > 0) {
-        str = "# WARNING! This parking program has been generated with enabled-not-operative RPs:";
-        object.append(str);
-        str = "# Enabled-not-operative RP ids: " + EnabledNotOperative.getText().str;
-        object.append(str);
-
-        //get the list of dangerous RPs
-        TRoboticPositionerList Dangerous;
-        EnabledNotOperative.getDangerous(Dangerous);
-
-        str = "# Dangerous RPs are enabled-not-operative RPs with fault type dyynamic or unknowledge";
-        object.append(str);
-        if(Dangerous.getCount() > 0) {
-            str = "# ERROR! This parking program has been generated with dangerous RPs:";
-            object.append(str);
-            str = "# Dangerous RP ids: " + Dangerous.getText().str;
-            object.append(str);
-        }
-        else {
-            str = "# This parking program has been generated without dangerous RPs.";
-            object.append(str);
-        }
-    }
-    else {
-        str = "# This parking program has been generated without enabled-not-operative RPs.";
-        object.append(str);
-    }
-
-    if(Collided.getCount() > 0 || Obstructed.getCount() > 0) {
-        if(Collided.getCount() > 0) {
-            str = "# WARNING! the FMOSA contains collided items (either EAs or RPs):";
-            object.append(str);
-            str = "# Collided items: " + collided_str;
-            object.append(str);
-            str = "# Collided RP ids: " + Collided.getText().str;
-            object.append(str);
-        }
-        if(Obstructed.getCount() > 0) {
-            str = "# WARNING! the FMOSA contains obstructed RPs:";
-            object.append(str);
-            str = "# Obstructed RP ids: " + Obstructed.getText().str;
-            object.append(str);
-        }
-        str = "# The final positions of the collided or obstructed RPs match with their starting positions.";
-        object.append(str);
-    }
-    else {
-        str = "# The parking program has been generated without neither collided nor obstructed RPs.";
-        object.append(str);
-    }
-
-    str = "# A parking program is suitable to be executed when it is valid (avoid collisions) and there aren't";
-    object.append(str);
-    str = "# dangerous RPs in the Fiber MOS (enabled-not-operative RPs with fault type dynamic or unknowledge).";
-    object.append(str);
-    if(suitable()) {
-        str = "# According the actual status of the FMPT, this parking program is suitable to be executed.";
-        object.append(str);
-    }
-    else {
-        str = "# According the actual status of the FMPT, this parking program is not suitable to be executed.";
-        object.append(str);
-    }
-
-    return object;
+    //write each line of the comments as a string
+    W.beginArray();
+    W.valueLines(getCommentsText());
+    W.endArray();
 }
-Json::Value OutputsParkProg::getParking(void) const
+void OutputsParkProg::writeParking(TJSONWriter& W) const
 {
-    //build a json object
-    Json::Value object;
+    W.beginObject();
+
+    //add the Bid
+    W.name("Bid");
+    W.value(Bid);
+    //add the parking program
+    W.name("ParkProg");
+    ParkProg.writeJSON(W, SPL);
 
     //add comment about name
-    Json::Value comments;
-    comments.append("# ParkProg (Parking Program)");
+    W.name("comments");
+    W.beginArray();
+    W.value("# ParkProg (Parking Program)");
 
     //add comment about validity
-    string str;
     if(ParkProgValid) {
-        str = "# This parking program avoids collisions when it is executed starting from the starting positions (check out SPL).";
+        W.value("# This parking program avoids collisions when it is executed starting from the starting positions (check out SPL).");
     } else {
-        str = "# ERROR! This parking program produces a collision when it is executed starting from the starting positions (check out SPL).";
+        W.value("# ERROR! This parking program produces a collision when it is executed starting from the starting positions (check out SPL).");
     }
-    comments.append(str);
 
     //add comment about approximations
     if(ParkProg.thereIsSomeCommentDsec()) {
-        str = "# WARNING! This parking program contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:";
-        comments.append(str);
-        str = ParkProg.getCommentsDsecMCStext();
-        comments.append(str);
+        W.value("# WARNING! This parking program contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:");
+        W.value(ParkProg.getCommentsDsecMCStext());
     } else {
-        str = "# All radial movements of this parking program keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.";
-        comments.append(str);
+        W.value("# All radial movements of this parking program keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.");
     }
+    W.endArray();
 
-    //add the coments
-    object["comments"] = comments;
-    //add the Bid
-    object["Bid"] = Bid;
-    //add the parking program
-    object["ParkProg"] = ParkProg.getJSON(SPL);
-
-    return object;
+    W.endObject();
 }
 
 //PUBLIC:
@@ -212,10 +134,6 @@ string OutputsParkProg::getWarningNotSuitable(void) const
 //get the comments about ParkProg in text format
 string OutputsParkProg::getCommentsText(void) const
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
     string str = "# Parkig program outputs generated ";
     if(FMOSA_filename.length() > 0)
         str += "from FMOSA " + FMOSA_filename;
@@ -278,38 +196,36 @@ string OutputsParkProg::getCommentsText(void) const
 //  the parking program
 void OutputsParkProg::getText(string& str) const
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
-    if(suitable())
-        str = "";
-    else {
-        str = getWarningNotSuitable();
-        str += "\r\n\r\n";
-    }
+    ostringstream os;
+    writeText(os);
+    str = os.str();
+}
+//write outputs in format MCS in a stream
+void OutputsParkProg::writeText(ostream& os) const
+{
+    if(!suitable())
+        os << getWarningNotSuitable() << "\r\n\r\n";
 
     //print the coments about ParkProg
-    str += getCommentsText();
+    os << getCommentsText();
 
-    str += "\r\n";
-    str += "\r\n# Parking program";
+    os << "\r\n";
+    os << "\r\n# Parking program";
     if(ParkProgValid) {
-        str += "\r\n# This parking program avoids collisions when it is executed starting from the starting positions (check out SPL).";
+        os << "\r\n# This parking program avoids collisions when it is executed starting from the starting positions (check out SPL).";
     } else {
-        str += "\r\n# ERROR! This parking program produces a collision when it is executed starting from the starting positions (check out SPL).";
+        os << "\r\n# ERROR! This parking program produces a collision when it is executed starting from the starting positions (check out SPL).";
     }
     if(ParkProg.thereIsSomeCommentDsec()) {
-        str += "\r\n# WARNING! This parking program contains instructions that produce radial movements which produce approximations closer than "+floattostr(DsecMax)+" mm:";
-        str += "\r\n"+ParkProg.getCommentsDsecMCStext();
+        os << "\r\n# WARNING! This parking program contains instructions that produce radial movements which produce approximations closer than " << floattostr(DsecMax) << " mm:";
+        os << "\r\n" << ParkProg.getCommentsDsecMCStext();
     } else {
-        str += "\r\n# All radial movements of this parking program keep a security distance upper or equal to "+floattostr(DsecMax)+" mm.";
+        os << "\r\n# All radial movements of this parking program keep a security distance upper or equal to " << floattostr(DsecMax) << " mm.";
     }
-    str += "\r\n@@SParkProg@@";
-    string aux;
-    ParkProg.getMCStext(aux, "depos", Bid, SPL);
-    str += "\r\n"+aux;
-    str += "\r\n@@EParkProg@@";
+    os << "\r\n@@SParkProg@@";
+    os << "\r\n";
+    ParkProg.writeMCStext(os, "depos", Bid, SPL);
+    os << "\r\n@@EParkProg@@";
 }
 
 //get outputs in format JSON with:
@@ -317,51 +233,37 @@ void OutputsParkProg::getText(string& str) const
 //  the parking program
 string OutputsParkProg::getJSONtext(void) const
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
-    //build the JSON object and parse the schema
-    //  json_object *root;
-    //  root = json_tokener_parse(schema.c_str());
-
-    //check the result of the parsing
-    //  if(root == NULL)
-    //      throw EImproperFileLoadedValue("failed so parse JSON");
-
-    //set value for token "instrument"
-    //  json_object *val;
-    //  //val = json_object_object_get(root, "instrument");
-    //  val = json_object_array_get_idx(root, 0);
-    //  if(val == NULL || json_object_get_type(val) != json_type_string)
-    //      throw EImpossibleError("lateral effect");
-    //  json_object_object_add(val, "instrument", json_object_new_string("MEGARA"));
-    //  json_object_array_put_idx(root, 0, val);
-
-    //build a json object
-    Json::Value root;
-
-    //add (instrument, uuid, tittle)
-    root["instrument"] = "MEGARA";
-    addUUID(root);
-    root["tittle"] = "Tittle from FMAT";
+    ostringstream os;
+    writeJSONtext(os);
+    return os.str();
+}
+//write outputs in format JSON in a stream
+//(the members are written in the order of the JSON objects)
+void OutputsParkProg::writeJSONtext(ostream& os) const
+{
+    if(!suitable())
+        os << getWarningNotSuitable() << "\r\n\r\n";
+
+    TJSONWriter W(os);
+    W.beginObject();
 
     //add the coments
-    root["comments"] = getComments();
+    W.name("comments");
+    writeComments(W);
 
     //add the parking program with comments
-    root["depos"] = getParking();
-
-    string str;
-    if(suitable())
-        str = "";
-    else {
-        str = getWarningNotSuitable();
-        str += "\r\n\r\n";
-    }
-    Json::StyledWriter writer;
-    str += writer.write(root);
-    return str;
+    W.name("depos");
+    writeParking(W);
+
+    //add (instrument, tittle, uuid)
+    W.name("instrument");
+    W.value("MEGARA");
+    W.name("tittle");
+    W.value("Tittle from FMAT");
+    writeUUID(W);
+
+    W.endObject();
+    W.end();
 }
 
 //get other outputs in text format with:
@@ -369,10 +271,6 @@ string OutputsParkProg::getJSONtext(void) const
 //  other properties in format assigns
 void OutputsParkProg::getOtherText(string& str) const
 {
-    locale l;
-    if(l.name() != "C")
-        throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
     //print the coments about ParkProg
     str = getCommentsText();
 
@@ -402,10 +300,6 @@ void OutputsParkProg::getOtherText(string& str) const
 void OutputsParkProg::setText(const string& str)
 {
     try {
-        locale l;
-        if(l.name() != "C")
-            throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
-
         //divide the string str in lines
         TStrings Strings;
         StrDivideInLines(Strings, str);
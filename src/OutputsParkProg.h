@@ -43,10 +43,10 @@ namespace Positioning {
 class OutputsParkProg
 {
 private:
-    //functions for add data to a JSON object
-    void addUUID(Json::Value &object) const;
-    Json::Value getComments(void) const;
-    Json::Value getParking(void) const;
+    //functions for write data in format JSON
+    void writeUUID(TJSONWriter& W) const;
+    void writeComments(TJSONWriter& W) const;
+    void writeParking(TJSONWriter& W) const;
 
 public:
     //properties for built comments about file ParkProg
@@ -77,11 +77,17 @@ public:
     //  comments
     //  the parking program
     void getText(string& str) const;
+    //write outputs in format MCS in a stream
+    //(without build the text in memory)
+    void writeText(ostream& os) const;
 
     //get outputs in format JSON with:
     //  comments
     //  the parking program
     string getJSONtext(void) const;
+    //write outputs in format JSON in a stream
+    //(without build the JSON object in memory)
+    void writeJSONtext(ostream& os) const;
 
     //get other outputs in text format with:
     //  comments
@@ -256,6 +256,30 @@ public:
     //clona una lista de elementos basada en punteros
     void Clone(const TPointersList&);
 
+#ifdef FMPT_MOVE_SEMANTICS
+    //construye una lista tomando los elementos de otra,
+    //sin clonarlos, dejando la otra lista vacía
+    TPointersList(TPointersList&&);
+    //toma los elementos de una lista sin clonarlos,
+    //los elementos previos serán destruidos con la otra lista
+    TPointersList& operator=(TPointersList&& L) {Items.swap(L.Items); return *this;}
+
+    //construye un elemento al final de la lista con los argumentos indicados
+    template <class... Args> T& Emplace(Args&&... args) {
+        T *item = new T(std::forward<Args>(args)...);
+        try {
+            Items.AddLast(item);
+        } catch(...) {
+            delete item;
+            throw;
+        }
+        return *item;
+    }
+#endif
+
+    //intercambia los elementos con otra lista sin clonarlos
+    void swap(TPointersList& L) {Items.swap(L.Items);}
+
     //libera la memoria ocupada por la lista de elementos
     ~TPointersList();
 
@@ -1416,6 +1440,21 @@ template <class T> TPointersList<T>::TPointersList(const TPointersList& L)
     Read = L.Read;
 }
 
+#ifdef FMPT_MOVE_SEMANTICS
+//construye una lista tomando los elementos de otra,
+//sin clonarlos, dejando la otra lista vacía
+template <class T> TPointersList<T>::TPointersList(TPointersList&& L) :
+    Items(std::move(L.Items))
+{
+    //apunta a las mismas funciones externas
+    Compare = L.Compare;
+    Evaluate = L.Evaluate;
+    Assign = L.Assign;
+    Print = L.Print;
+    Read = L.Read;
+}
+#endif
+
 //clona una lista deelementos basada en punteros
 template <class T> void TPointersList<T>::Clone(const TPointersList<T>& L)
 {
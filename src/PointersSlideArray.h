@@ -25,7 +25,7 @@
 #ifndef POINTERSSLIDEARRAY_H
 #define POINTERSSLIDEARRAY_H
 
-#include "Exceptions.h"
+#include "SlideArray.h" //FMPT_MOVE_SEMANTICS
 
 //---------------------------------------------------------------------------
 
@@ -79,6 +79,23 @@ public:
     //libera la memoria ocupada por el array deslizante
     ~TPointersSlideArray();
 
+    //clona un array deslizante
+    TPointersSlideArray& operator=(const TPointersSlideArray& SA) {
+        Clone(SA); return *this;}
+
+#ifdef FMPT_MOVE_SEMANTICS
+    //construye un array deslizante tomando los punteros de otro,
+    //que queda vacío y sin capacidad
+    TPointersSlideArray(TPointersSlideArray&& SA);
+    //intercambia los punteros con otro array deslizante
+    TPointersSlideArray& operator=(TPointersSlideArray&& SA) {
+        swap(SA); return *this;}
+#endif
+
+    //intercambia todas las propiedades con otro array deslizante,
+    //sin clonar los elementos apuntados
+    void swap(TPointersSlideArray& SA);
+
     //determina si una posición indicada del array está reservada
     bool PositionIsReserved(int i);
 
@@ -194,7 +211,7 @@ template <class T> void TPointersSlideArray<T>::setCapacity(int Capacity)
     }
 
     //apunta el nuevo array
-    delete Items;
+    delete[] Items;
     Items = NewItems;
     p_Capacity = Capacity;
 
@@ -300,6 +317,33 @@ template <class T> TPointersSlideArray<T>::TPointersSlideArray(TPointersSlideArr
     }
 }
 
+#ifdef FMPT_MOVE_SEMANTICS
+//construye un array deslizante tomando los punteros de otro,
+//que queda vacío y sin capacidad
+template <class T> TPointersSlideArray<T>::TPointersSlideArray(TPointersSlideArray&& SA) :
+    p_Capacity(SA.p_Capacity), p_Count(SA.p_Count),
+    p_ifirst(SA.p_ifirst), p_ilast(SA.p_ilast),
+    Items(SA.Items)
+{
+    SA.p_Capacity = 0;
+    SA.p_Count = 0;
+    SA.p_ifirst = 0;
+    SA.p_ilast = -1;
+    SA.Items = NULL;
+}
+#endif
+
+//intercambia todas las propiedades con otro array deslizante,
+//sin clonar los elementos apuntados
+template <class T> void TPointersSlideArray<T>::swap(TPointersSlideArray& SA)
+{
+    std::swap(p_Capacity, SA.p_Capacity);
+    std::swap(p_Count, SA.p_Count);
+    std::swap(p_ifirst, SA.p_ifirst);
+    std::swap(p_ilast, SA.p_ilast);
+    std::swap(Items, SA.Items);
+}
+
 //libera la memoria ocupada por el array deslizante
 template <class T> TPointersSlideArray<T>::~TPointersSlideArray()
 {
@@ -314,7 +358,7 @@ template <class T> TPointersSlideArray<T>::~TPointersSlideArray()
     }
 
     //destruye el array de punteros
-    delete Items;
+    delete[] Items;
 }
 
 //determina si una posición indicada del array está reservada
@@ -655,6 +699,10 @@ template <class T> void TPointersSlideArray<T>::Insert(int i, const T *item)
 //clona todas las propiedades del array incluidos sus elementos
 template <class T> void TPointersSlideArray<T>::Clone(const TPointersSlideArray &SA)
 {
+    //un array deslizante es clon de sí mismo
+    if(&SA == this)
+        return;
+
     //destruye los elementos del array
     T *item;
     for(int i=0; i<getCount(); i++)
@@ -662,7 +710,7 @@ template <class T> void TPointersSlideArray<T>::Clone(const TPointersSlideArray
 
     //redimensiona el array en caso necesario
     if(getCapacity() != SA.getCapacity()) {
-        delete Items;
+        delete[] Items;
         Items = new T*[SA.getCapacity()];
     }
 
@@ -24,6 +24,8 @@
 
 #include "Quantificator.h"
 
+#include <math.h> //ceil, frexp
+
 //---------------------------------------------------------------------------
 
 //espacio de nombres de operadores matemáticos
@@ -612,6 +614,63 @@ double TQuantificator::operator[](int n) const
     return n*p_q;
 }
 
+//cuantifica un vector de valores:
+//      n[i] = Quantifice(x[i]), para i en [0, N)
+void TQuantificator::Quantifice(int *n, const double *x, int N) const
+{
+    //comprueba las precondiciones
+    if(N < 0)
+        throw EImproperArgument("number of values N should be nonnegative");
+    if(N > 0 && (n==NULL || x==NULL))
+        throw EImproperArgument("pointers n and x should point to built arrays");
+
+    //Los valores se cuantifican sin bifurcaciones, para que el compilador
+    //pueda vectorizar el bucle, y con el mismo resultado que Quantifice(x):
+    //  Round(v) == ceil(v - 0.5), para |v| < 2^52;
+    //  el límite inferior se aplica también a los valores no numéricos.
+    //Si q es una potencia de dos, su inversa es exacta y el producto
+    //por ella da el mismo resultado que la división.
+
+    double Qmin = p_Qmin;
+    double Qmax = p_Qmax;
+    int e;
+    double m = frexp(p_q, &e);
+    if(m==0.5 || m==-0.5) {
+        double r = 1/p_q;
+        for(int i=0; i<N; i++) {
+            double c = ceil(x[i]*r - 0.5);
+            c = (c >= Qmin) ? c : Qmin;
+            c = (c <= Qmax) ? c : Qmax;
+            n[i] = int(c);
+        }
+    } else {
+        for(int i=0; i<N; i++) {
+            double c = ceil(x[i]/p_q - 0.5);
+            c = (c >= Qmin) ? c : Qmin;
+            c = (c <= Qmax) ? c : Qmax;
+            n[i] = int(c);
+        }
+    }
+}
+//reconstruye un vector de valores:
+//      x[i] = Reconstruct(n[i]), para i en [0, N)
+void TQuantificator::Reconstruct(double *x, const int *n, int N) const
+{
+    //comprueba las precondiciones
+    if(N < 0)
+        throw EImproperArgument("number of values N should be nonnegative");
+    if(N > 0 && (n==NULL || x==NULL))
+        throw EImproperArgument("pointers n and x should point to built arrays");
+    for(int i=0; i<N; i++)
+        //el centroide n debe estar en el dominio imagen [Qmin, Qmax]
+        if(n[i]<p_Qmin || p_Qmax<n[i])
+            throw EImproperArgument("centroid n should be in image domain [Qmin, Qmax]");
+
+    //traduce los centroides a unidades de x
+    for(int i=0; i<N; i++)
+        x[i] = n[i]*p_q;
+}
+
 //---------------------------------------------------------------------------
 
 } //namespace Operators
@@ -160,6 +160,13 @@ public:
         //reconstruye un valor
         double Reconstruct(int n) const;
         double operator[](int n) const;
+
+        //cuantifica un vector de valores:
+        //      n[i] = Quantifice(x[i]), para i en [0, N)
+        void Quantifice(int *n, const double *x, int N) const;
+        //reconstruye un vector de valores:
+        //      x[i] = Reconstruct(n[i]), para i en [0, N)
+        void Reconstruct(double *x, const int *n, int N) const;
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,153 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//---------------------------------------------------------------------------
+//File: ReachabilityIndex.cpp
+//Content: spatial index of the domains of P3 of a RP list
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "ReachabilityIndex.h"
+
+#include <math.h> //floor
+
+//---------------------------------------------------------------------------
+
+//namespace for models
+namespace Models {
+
+//---------------------------------------------------------------------------
+//TReachabilityIndex:
+//---------------------------------------------------------------------------
+
+//build an empty reachability index
+TReachabilityIndex::TReachabilityIndex(void) :
+    p_x0(0), p_y0(0), p_Side(0), p_Nx(0), p_Ny(0), p_Cells()
+{
+}
+
+//build the index for the RPs of a list
+//the side of the cells will be the maximun diameter
+//of the domains of P3 of the RPs
+//Preconditions:
+//  All pointers of the list RPL shall point to built RPs.
+void TReachabilityIndex::build(const TItemsList<TRoboticPositioner*>& RPL)
+{
+    //CHECK THE PRECONDITIONS:
+
+    for(int i=0; i<RPL.getCount(); i++)
+        if(RPL[i] == NULL)
+            throw EImproperArgument("all pointers of the list RPL shall point to built RPs");
+
+    //MAKE ACTIONS:
+
+    clear();
+
+    //solve the trivial case
+    if(RPL.getCount() <= 0)
+        return;
+
+    //determine the square containing all domains of P3
+    //and the maximun diameter of the domains
+    TActuator *A = RPL[0]->getActuator();
+    double x3min = A->getx3min();
+    double x3max = A->getx3max();
+    double y3min = A->gety3min();
+    double y3max = A->gety3max();
+    double Side = 0;
+    for(int i=0; i<RPL.getCount(); i++) {
+        A = RPL[i]->getActuator();
+        x3min = min(x3min, A->getx3min());
+        x3max = max(x3max, A->getx3max());
+        y3min = min(y3min, A->gety3min());
+        y3max = max(y3max, A->gety3max());
+        Side = max(Side, A->getx3max() - A->getx3min());
+    }
+    if(Side <= 0)
+        Side = 1;
+
+    //With this side, each domain of P3 intersects four cells at most.
+
+    //build the grid
+    p_x0 = x3min;
+    p_y0 = y3min;
+    p_Side = Side;
+    p_Nx = int(floor((x3max - x3min)/Side)) + 1;
+    p_Ny = int(floor((y3max - y3min)/Side)) + 1;
+    p_Cells.resize(p_Nx*p_Ny);
+
+    //add each RP to the cells intersected by their domain of P3
+    for(int i=0; i<RPL.getCount(); i++) {
+        TRoboticPositioner *RP = RPL[i];
+        A = RP->getActuator();
+        int ixmin = int(floor((A->getx3min() - p_x0)/p_Side));
+        int ixmax = min(p_Nx - 1, int(floor((A->getx3max() - p_x0)/p_Side)));
+        int iymin = int(floor((A->gety3min() - p_y0)/p_Side));
+        int iymax = min(p_Ny - 1, int(floor((A->gety3max() - p_y0)/p_Side)));
+        for(int iy=max(0, iymin); iy<=iymax; iy++)
+            for(int ix=max(0, ixmin); ix<=ixmax; ix++)
+                p_Cells[iy*p_Nx + ix].push_back(RP);
+    }
+}
+
+//empty the index
+void TReachabilityIndex::clear(void)
+{
+    p_x0 = 0;
+    p_y0 = 0;
+    p_Side = 0;
+    p_Nx = 0;
+    p_Ny = 0;
+    p_Cells.clear();
+}
+
+//search the RPs of the index in whose domain of P3 is a point
+//Inputs:
+//  P: the point to search.
+//Outputs:
+//  RPs: list of RPs whose domain of P3 contains the point P,
+//      in the same order than in the indexed list.
+void TReachabilityIndex::searchRPs(TItemsList<TRoboticPositioner*>& RPs,
+                                   const TDoublePoint& P) const
+{
+    //initialize the output
+    RPs.Clear();
+
+    //solve the trivial case
+    if(p_Side <= 0)
+        return;
+
+    //search the cell containing the point
+    double fx = floor((P.x - p_x0)/p_Side);
+    double fy = floor((P.y - p_y0)/p_Side);
+    if(fx<0 || p_Nx<=fx || fy<0 || p_Ny<=fy)
+        return;
+
+    //check the RPs of the cell
+    const std::vector<TRoboticPositioner*>& Cell = p_Cells[int(fy)*p_Nx + int(fx)];
+    for(unsigned int i=0; i<Cell.size(); i++)
+        if(Cell[i]->getActuator()->pointIsInDomainP3(P))
+            RPs.Add(Cell[i]);
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//---------------------------------------------------------------------------
+//File: ReachabilityIndex.h
+//Content: spatial index of the domains of P3 of a RP list
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef REACHABILITYINDEX_H
+#define REACHABILITYINDEX_H
+
+#include "RoboticPositioner.h"
+#include "ItemsList.h"
+
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+using namespace Lists;
+
+//namespace for models
+namespace Models {
+
+//---------------------------------------------------------------------------
+//TReachabilityIndex:
+//---------------------------------------------------------------------------
+
+//The reachability index is a uniform grid of square cells covering
+//the domains of P3 of a RP list. Each cell contains the pointers to
+//the RPs whose domain of P3 (bounding square) intersects the cell,
+//so the RPs which can reach a point can be found checking only
+//the RPs of a single cell.
+
+//class reachability index
+class TReachabilityIndex {
+protected:
+    double p_x0;
+    double p_y0;
+    double p_Side;
+    int p_Nx;
+    int p_Ny;
+
+    //list of RPs of each cell, in row-major order
+    std::vector<std::vector<TRoboticPositioner*> > p_Cells;
+
+public:
+    //PROPERTIES:
+
+    //side of the cells
+    //default value: 0 mm (empty index)
+    double getSide(void) const {return p_Side;}
+    //number of columns of the grid
+    int getNx(void) const {return p_Nx;}
+    //number of rows of the grid
+    int getNy(void) const {return p_Ny;}
+
+    //BUILDING METHODS:
+
+    //build an empty reachability index
+    TReachabilityIndex(void);
+
+    //build the index for the RPs of a list
+    //the side of the cells will be the maximun diameter
+    //of the domains of P3 of the RPs
+    //Preconditions:
+    //  All pointers of the list RPL shall point to built RPs.
+    void build(const TItemsList<TRoboticPositioner*>& RPL);
+
+    //empty the index
+    void clear(void);
+
+    //SEARCHING METHODS:
+
+    //search the RPs of the index in whose domain of P3 is a point
+    //Inputs:
+    //  P: the point to search.
+    //Outputs:
+    //  RPs: list of RPs whose domain of P3 contains the point P,
+    //      in the same order than in the indexed list.
+    void searchRPs(TItemsList<TRoboticPositioner*>& RPs,
+                   const TDoublePoint& P) const;
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
+#endif // REACHABILITYINDEX_H
@@ -0,0 +1,849 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: RequestServer.cpp
+//Content: server of requests of generation and validation of MPs
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "RequestServer.h"
+#include "MotionProgramGenerator.h" //generateParkProg_online, generatePairPPDP_online
+#include "MotionProgramValidator.h"
+#include "OutputsParkProg.h"
+#include "OutputsPairPPDP.h"
+
+#include <sys/socket.h> //socket, bind, listen, accept, connect, send
+#include <sys/un.h> //sockaddr_un
+#include <poll.h> //poll
+#include <unistd.h> //read, write, close, unlink
+#include <errno.h> //errno
+#include <string.h> //strncpy
+#include <time.h> //clock_gettime
+#include <sstream> //std::istringstream
+#include <list> //std::list
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+//namespace for positioning
+namespace Positioning {
+
+//---------------------------------------------------------------------------
+//AUXILIARY FUNCTIONS:
+
+//get the current value of a monotonic clock in seconds
+static double monotonicTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) + double(ts.tv_nsec)/1e9;
+}
+
+//write all chars of a string in a file descriptor
+//return false if the file descriptor has been closed
+static bool writeAll(int fd, const string& str)
+{
+    size_t n = 0;
+    while(n < str.length()) {
+        ssize_t r = ::send(fd, str.data() + n, str.length() - n, MSG_NOSIGNAL);
+        if(r < 0 && errno == ENOTSOCK)
+            r = ::write(fd, str.data() + n, str.length() - n);
+        if(r < 0) {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        n += size_t(r);
+    }
+    return true;
+}
+
+//print a JSON value in a line
+static string toNDJSON(const Json::Value& value)
+{
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, value) + "\n";
+}
+
+//read a JSON value from a text
+//return false if the text is not a valid JSON
+static bool fromJSON(Json::Value& value, const string& str, string& errors)
+{
+    Json::CharReaderBuilder builder;
+    istringstream is(str);
+    return Json::parseFromStream(builder, is, &value, &errors);
+}
+
+//get a vector of numbers from a member of a request
+//if the member is not an array of numbers:
+//  throw an exception EImproperArgument
+static void getDoubles(vector<double>& v, const Json::Value& request, const char *name)
+{
+    const Json::Value& a = request[name];
+    if(!a.isArray())
+        throw EImproperArgument(string("member ")+name+" should be an array of numbers");
+
+    v.resize(a.size());
+    for(Json::ArrayIndex i=0; i<a.size(); i++) {
+        if(!a[i].isNumeric())
+            throw EImproperArgument(string("member ")+name+" should be an array of numbers");
+        v[i] = a[i].asDouble();
+    }
+}
+
+//get a vector of integers from a member of a request
+//if the member is not null nor an array of integers:
+//  throw an exception EImproperArgument
+static void getInts(vector<int>& v, const Json::Value& request, const char *name)
+{
+    v.clear();
+    const Json::Value& a = request[name];
+    if(a.isNull())
+        return;
+    if(!a.isArray())
+        throw EImproperArgument(string("member ")+name+" should be an array of integers");
+
+    v.resize(a.size());
+    for(Json::ArrayIndex i=0; i<a.size(); i++) {
+        if(!a[i].isInt())
+            throw EImproperArgument(string("member ")+name+" should be an array of integers");
+        v[i] = a[i].asInt();
+    }
+}
+
+//---------------------------------------------------------------------------
+//TRequestConnection:
+//---------------------------------------------------------------------------
+
+//connection of the request server
+class TRequestConnection {
+public:
+    //file descriptor where write the responses
+    int fd_out;
+    //jobs of the connection not finished yet
+    list<TRequestJob*> Jobs;
+    //mutex for access to (Jobs, answered) and for write in fd_out
+    pthread_mutex_t mutex;
+    //condition signaled when a job is finished
+    pthread_cond_t cond;
+
+    TRequestConnection(int t_fd_out) : fd_out(t_fd_out), Jobs() {
+        pthread_mutex_init(&mutex, NULL);
+        pthread_cond_init(&cond, NULL);
+    }
+    ~TRequestConnection() {
+        pthread_cond_destroy(&cond);
+        pthread_mutex_destroy(&mutex);
+    }
+};
+
+//---------------------------------------------------------------------------
+//TRequestJob:
+//---------------------------------------------------------------------------
+
+//job of the request server
+class TRequestJob {
+public:
+    //request in format JSON
+    //(read concurrently by the worker and the serve thread,
+    //so it shall not be modified)
+    const Json::Value request;
+    //identifier of the request, or null
+    const Json::Value id;
+    //connection where write the response
+    TRequestConnection *Connection;
+    //instant (monotonic time) where the job expires, or zero
+    double deadline;
+    //indicates if the response has been written
+    bool answered;
+
+    TRequestJob(const Json::Value& t_request, TRequestConnection *t_Connection,
+                double t_deadline) :
+        request(t_request), id(t_request.get("id", Json::Value())),
+        Connection(t_Connection), deadline(t_deadline), answered(false) {;}
+};
+
+//---------------------------------------------------------------------------
+//TRequestServer:
+//---------------------------------------------------------------------------
+
+//PROPERTIES:
+
+void TRequestServer::setTimeout(double Timeout)
+{
+    //check the precondition
+    if(Timeout < 0)
+        throw EImproperArgument("timeout Timeout should be nonnegative");
+
+    //set the value
+    p_Timeout = Timeout;
+}
+
+//indicates if a request shutdown has been received
+bool TRequestServer::getShutdown(void) const
+{
+    pthread_mutex_lock(const_cast<pthread_mutex_t*>(&p_mutex));
+    bool shutdown = p_Shutdown;
+    pthread_mutex_unlock(const_cast<pthread_mutex_t*>(&p_mutex));
+    return shutdown;
+}
+
+//PROTECTED METHODS:
+
+//process the jobs of the queue until the server stops
+void *TRequestServer::worker(void *arg)
+{
+    TRequestServer *S = (TRequestServer*)arg;
+
+    //workspace where the resident FMM Instances will be cloned
+    TFiberMOSModel FMM;
+
+    while(true) {
+        //get the next job
+        pthread_mutex_lock(&S->p_mutex);
+        while(S->p_Queue.empty() && !S->p_Stopping)
+            pthread_cond_wait(&S->p_cond, &S->p_mutex);
+        if(S->p_Queue.empty()) {
+            pthread_mutex_unlock(&S->p_mutex);
+            break;
+        }
+        TRequestJob *J = S->p_Queue.front();
+        S->p_Queue.pop_front();
+        pthread_mutex_unlock(&S->p_mutex);
+
+        //the job could have expired while waiting in the queue
+        TRequestConnection *C = J->Connection;
+        pthread_mutex_lock(&C->mutex);
+        bool answered = J->answered;
+        pthread_mutex_unlock(&C->mutex);
+
+        //process the request
+        string str;
+        if(!answered) {
+            Json::Value response;
+            double t0 = monotonicTime();
+            try {
+                S->processRequest(response, J->request, FMM);
+            }
+            catch(Exception& E) {
+                response = Json::Value(Json::objectValue);
+                response["ok"] = false;
+                response["error"] = E.Message.str;
+            }
+            catch(std::exception& E) {
+                response = Json::Value(Json::objectValue);
+                response["ok"] = false;
+                response["error"] = string(E.what());
+            }
+            catch(...) {
+                response = Json::Value(Json::objectValue);
+                response["ok"] = false;
+                response["error"] = "unknown exception";
+            }
+            response["id"] = J->id;
+            response["elapsed"] = monotonicTime() - t0;
+            str = toNDJSON(response);
+        }
+
+        //write the response and finish the job
+        pthread_mutex_lock(&C->mutex);
+        if(!J->answered) {
+            writeAll(C->fd_out, str);
+            J->answered = true;
+        }
+        C->Jobs.remove(J);
+        delete J;
+        pthread_cond_broadcast(&C->cond);
+        pthread_mutex_unlock(&C->mutex);
+    }
+
+    return NULL;
+}
+
+//search a resident FMM Instance by name
+const TFiberMOSModel *TRequestServer::searchFMM(const string& name) const
+{
+    if(p_FMMs.size() <= 0)
+        return NULL;
+    if(name.length() <= 0)
+        return p_FMMs[0];
+    for(unsigned int i=0; i<p_Names.size(); i++)
+        if(p_Names[i] == name)
+            return p_FMMs[i];
+    return NULL;
+}
+
+//answer a job if it has not been answered
+//Preconditions:
+//  The mutex of the connection shall be locked.
+void TRequestServer::answer(TRequestJob *J, const string& response) const
+{
+    if(!J->answered) {
+        writeAll(J->Connection->fd_out, response);
+        J->answered = true;
+    }
+}
+
+//answer the jobs of a connection whose deadline has expired
+//Preconditions:
+//  The mutex of the connection shall be locked.
+void TRequestServer::answerExpiredJobs(TRequestConnection *C) const
+{
+    double t = monotonicTime();
+    for(list<TRequestJob*>::iterator it=C->Jobs.begin(); it!=C->Jobs.end(); it++) {
+        TRequestJob *J = *it;
+        if(!J->answered && J->deadline > 0 && t >= J->deadline) {
+            Json::Value response(Json::objectValue);
+            response["id"] = J->id;
+            response["ok"] = false;
+            response["error"] = "timeout";
+            answer(J, toNDJSON(response));
+        }
+    }
+}
+
+//BUILDING AND DESTROYING METHODS:
+
+//build a request server without FMM Instances nor workers
+TRequestServer::TRequestServer(void) :
+    p_FMMs(), p_Names(), p_Timeout(0),
+    p_Queue(), p_Workers(), p_Stopping(false), p_Shutdown(false)
+{
+    pthread_mutex_init(&p_mutex, NULL);
+    pthread_cond_init(&p_cond, NULL);
+}
+
+//stop the workers and destroy the resident FMM Instances
+TRequestServer::~TRequestServer()
+{
+    stop();
+
+    for(unsigned int i=0; i<p_FMMs.size(); i++)
+        delete p_FMMs[i];
+
+    pthread_cond_destroy(&p_cond);
+    pthread_mutex_destroy(&p_mutex);
+}
+
+//add a clone of a FMM Instance to the resident FMM Instances
+void TRequestServer::addInstance(const string& name, const TFiberMOSModel& FMM)
+{
+    //check the preconditions
+    for(unsigned int i=0; i<p_Names.size(); i++)
+        if(p_Names[i] == name)
+            throw EImproperArgument("name '"+name+"' should not be used by other FMM Instance");
+    if(p_Workers.size() > 0)
+        throw EImproperCall("FMM Instances should be added before start the workers");
+
+    //build a clone of the FMM Instance sorted by identifier
+    TFiberMOSModel *FMM_ = new TFiberMOSModel(&FMM);
+    FMM_->RPL.SortInc();
+    FMM_->assimilate();
+
+    //add the FMM Instance
+    p_FMMs.push_back(FMM_);
+    p_Names.push_back(name);
+}
+
+//start a number of workers
+void TRequestServer::start(unsigned int workers)
+{
+    //check the preconditions
+    if(workers < 1)
+        throw EImproperArgument("number of workers should be upper zero");
+    if(p_Workers.size() > 0)
+        throw EImproperCall("workers should not be started");
+
+    //start the workers
+    p_Stopping = false;
+    for(unsigned int i=0; i<workers; i++) {
+        pthread_t thread;
+        if(pthread_create(&thread, NULL, worker, this) != 0) {
+            stop();
+            throw ECantComplete("can't start the worker "+inttostr(i));
+        }
+        p_Workers.push_back(thread);
+    }
+}
+
+//stop the workers, waiting they finish the current jobs
+void TRequestServer::stop(void)
+{
+    pthread_mutex_lock(&p_mutex);
+    p_Stopping = true;
+    pthread_cond_broadcast(&p_cond);
+    pthread_mutex_unlock(&p_mutex);
+
+    for(unsigned int i=0; i<p_Workers.size(); i++)
+        pthread_join(p_Workers[i], NULL);
+    p_Workers.clear();
+}
+
+//METHODS FOR PROCESS REQUESTS:
+
+//process a request synchronously in a FMM
+void TRequestServer::processRequest(Json::Value& response, const Json::Value& request,
+                                    TFiberMOSModel& FMM)
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(!request.isObject())
+        throw EImproperArgument("request should be a JSON object");
+    if(!request["type"].isString())
+        throw EImproperArgument("request should contains a member type");
+
+    //MAKE ACTIONS:
+
+    response = Json::Value(Json::objectValue);
+    string type = request["type"].asString();
+
+    //requests which not need a FMM
+    if(type == "ping") {
+        response["ok"] = true;
+        return;
+    }
+    if(type == "shutdown") {
+        pthread_mutex_lock(&p_mutex);
+        p_Shutdown = true;
+        pthread_mutex_unlock(&p_mutex);
+        response["ok"] = true;
+        return;
+    }
+    if(type!="park" && type!="pair" && type!="validate")
+        throw EImproperArgument("unknown type of request: "+type);
+
+    //clone the resident FMM Instance in the workspace
+    string name;
+    if(request["instance"].isString())
+        name = request["instance"].asString();
+    const TFiberMOSModel *FMM_ = searchFMM(name);
+    if(FMM_ == NULL)
+        throw EImproperArgument("unknown FMM Instance: "+name);
+    FMM.Clone(FMM_);
+    FMM.assimilate();
+
+    //get the format of the outputs
+    bool JSON = (request["format"].isString() && request["format"].asString() == "JSON");
+
+    if(type == "park") {
+        vector<double> p_1s, p___3s;
+        getDoubles(p_1s, request, "p_1s");
+        getDoubles(p___3s, request, "p___3s");
+        vector<int> RPids;
+        getInts(RPids, request, "RPids");
+        unsigned int Bid = request["Bid"].isUInt() ? request["Bid"].asUInt() : 0;
+
+        OutputsParkProg outputs;
+        bool suitable = generateParkProg_online(outputs, FMM, p_1s, p___3s, RPids, Bid);
+
+        response["suitable"] = suitable;
+        response["ParkProgValid"] = outputs.ParkProgValid;
+        if(outputs.ParkProgValid) {
+            if(JSON) {
+                string errors;
+                if(!fromJSON(response["outputs"], outputs.getJSONtext(), errors))
+                    throw EImpossibleError("lateral effect");
+            }
+            else {
+                string str;
+                outputs.getText(str);
+                response["outputs"] = str;
+            }
+        }
+    }
+    else if(type == "pair") {
+        vector<double> p_1s, p___3s;
+        getDoubles(p_1s, request, "p_1s");
+        getDoubles(p___3s, request, "p___3s");
+        vector<int> RPids;
+        getInts(RPids, request, "RPids");
+        unsigned int Bid = request["Bid"].isUInt() ? request["Bid"].asUInt() : 0;
+
+        OutputsPairPPDP outputs;
+        bool suitable = generatePairPPDP_online(outputs, FMM, p_1s, p___3s, RPids, Bid);
+
+        response["suitable"] = suitable;
+        response["PPvalid"] = outputs.PPvalid;
+        response["DPvalid"] = outputs.DPvalid;
+        if(outputs.PPvalid && outputs.DPvalid) {
+            if(JSON) {
+                string errors;
+                if(!fromJSON(response["outputs"], outputs.getJSONtext(false), errors))
+                    throw EImpossibleError("lateral effect");
+            }
+            else {
+                string str;
+                outputs.getText(str, false);
+                response["outputs"] = str;
+            }
+        }
+    }
+    else { //type == "validate"
+        if(!request["outputs"].isString())
+            throw EImproperArgument("request validate should contains a member outputs");
+        bool includeFMOSA = request["includeFMOSA"].isBool() && request["includeFMOSA"].asBool();
+        OutputsPairPPDP outputs;
+        outputs.setText(request["outputs"].asString(), includeFMOSA);
+
+        //set the initial positions, if any
+        if(!request["p_1s"].isNull() || !request["p___3s"].isNull()) {
+            vector<double> p_1s, p___3s;
+            getDoubles(p_1s, request, "p_1s");
+            getDoubles(p___3s, request, "p___3s");
+            if(p_1s.size() != (unsigned int)FMM.RPL.getCount() || p___3s.size() != (unsigned int)FMM.RPL.getCount())
+                throw EImproperArgument("members p_1s and p___3s should has one position for each RP of the FMM");
+            for(int i=0; i<FMM.RPL.getCount(); i++)
+                FMM.RPL[i]->getActuator()->setAnglesSteps(p_1s[i], p___3s[i]);
+        }
+
+        //validate the PP and then the DP
+        TMotionProgramValidator MPV(&FMM);
+        FMM.RPL.setPurpose(pValPP);
+        bool PPvalid = MPV.validateMotionProgram(outputs.PP);
+        bool DPvalid = false;
+        if(PPvalid) {
+            FMM.RPL.setPurpose(pValDP);
+            DPvalid = MPV.validateMotionProgram(outputs.DP);
+        }
+
+        response["PPvalid"] = PPvalid;
+        response["DPvalid"] = DPvalid;
+    }
+
+    response["ok"] = true;
+}
+
+//process a request in format NDJSON synchronously
+string TRequestServer::processRequest(const string& request)
+{
+    Json::Value R;
+    Json::Value response(Json::objectValue);
+    string errors;
+    try {
+        if(!fromJSON(R, request, errors))
+            throw EImproperArgument("request should be a valid JSON: "+errors);
+        TFiberMOSModel FMM;
+        processRequest(response, R, FMM);
+    }
+    catch(Exception& E) {
+        response = Json::Value(Json::objectValue);
+        response["ok"] = false;
+        response["error"] = E.Message.str;
+    }
+    catch(std::exception& E) {
+        response = Json::Value(Json::objectValue);
+        response["ok"] = false;
+        response["error"] = string(E.what());
+    }
+    if(R.isObject())
+        response["id"] = R["id"];
+    return toNDJSON(response);
+}
+
+//serve the requests read from a file descriptor
+void TRequestServer::serve(int fd_in, int fd_out)
+{
+    //check the precondition
+    if(p_Workers.size() <= 0)
+        throw EImproperCall("workers should be started");
+
+    TRequestConnection C(fd_out);
+    string buffer;
+    char chunk[4096];
+    bool eof = false;
+
+    //read the requests until the end of the input
+    while(!eof && !getShutdown()) {
+        //wait for input a short time, for check the deadlines
+        struct pollfd pfd;
+        pfd.fd = fd_in;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int r = poll(&pfd, 1, 10);
+
+        if(r > 0) {
+            ssize_t n = read(fd_in, chunk, sizeof(chunk));
+            if(n < 0 && errno == EINTR)
+                continue;
+            if(n <= 0) {
+                eof = true;
+                buffer += "\n"; //the last line could not end with '\n'
+            }
+            else
+                buffer.append(chunk, size_t(n));
+
+            //enqueue each complete line
+            size_t pos;
+            while((pos = buffer.find('\n')) != string::npos) {
+                string line = buffer.substr(0, pos);
+                buffer.erase(0, pos + 1);
+                if(line.length() > 0 && line[line.length() - 1] == '\r')
+                    line.erase(line.length() - 1);
+                if(line.find_first_not_of(" \t") == string::npos)
+                    continue;
+
+                //answer the malformed requests inmediately
+                Json::Value request;
+                string errors;
+                if(!fromJSON(request, line, errors) || !request.isObject()) {
+                    Json::Value response(Json::objectValue);
+                    response["id"] = Json::Value();
+                    response["ok"] = false;
+                    response["error"] = "request should be a JSON object";
+                    pthread_mutex_lock(&C.mutex);
+                    writeAll(fd_out, toNDJSON(response));
+                    pthread_mutex_unlock(&C.mutex);
+                    continue;
+                }
+
+                //build the job with their deadline
+                double timeout = p_Timeout;
+                if(request["timeout"].isNumeric())
+                    timeout = request["timeout"].asDouble();
+                double deadline = 0;
+                if(timeout > 0)
+                    deadline = monotonicTime() + timeout;
+                TRequestJob *J = new TRequestJob(request, &C, deadline);
+
+                //enqueue the job
+                pthread_mutex_lock(&C.mutex);
+                C.Jobs.push_back(J);
+                pthread_mutex_unlock(&C.mutex);
+                pthread_mutex_lock(&p_mutex);
+                p_Queue.push_back(J);
+                pthread_cond_signal(&p_cond);
+                pthread_mutex_unlock(&p_mutex);
+            }
+        }
+        else if(r < 0 && errno != EINTR)
+            eof = true;
+
+        //answer the expired jobs
+        pthread_mutex_lock(&C.mutex);
+        answerExpiredJobs(&C);
+        pthread_mutex_unlock(&C.mutex);
+    }
+
+    //wait until all jobs of the connection have been finished
+    pthread_mutex_lock(&C.mutex);
+    while(!C.Jobs.empty()) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += 10000000;
+        if(ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&C.cond, &C.mutex, &ts);
+        answerExpiredJobs(&C);
+    }
+    pthread_mutex_unlock(&C.mutex);
+}
+
+//context of a connection to the Unix domain socket
+struct TRequestSocketConnection {
+    TRequestServer *Server;
+    int fd;
+    //number of active connections and their mutex
+    unsigned int *active;
+    pthread_mutex_t *mutex;
+};
+
+//serve a connection to the Unix domain socket
+static void *serveConnection(void *arg)
+{
+    TRequestSocketConnection *SC = (TRequestSocketConnection*)arg;
+    try {
+        SC->Server->serve(SC->fd, SC->fd);
+    }
+    catch(...) {
+        //the connection is closed
+    }
+    close(SC->fd);
+
+    pthread_mutex_lock(SC->mutex);
+    (*SC->active)--;
+    pthread_mutex_unlock(SC->mutex);
+
+    delete SC;
+    return NULL;
+}
+
+//serve the requests of the connections to a Unix domain socket
+void TRequestServer::serveUnixSocket(const string& path)
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(p_Workers.size() <= 0)
+        throw EImproperCall("workers should be started");
+
+    struct sockaddr_un addr;
+    if(path.length() <= 0 || path.length() >= sizeof(addr.sun_path))
+        throw EImproperArgument("path '"+path+"' should be a valid path of Unix domain socket");
+
+    //MAKE ACTIONS:
+
+    //build the socket listening in the path
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0)
+        throw ECantComplete("can't build the Unix domain socket");
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+    if(bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        throw ECantComplete("can't listen in the Unix domain socket '"+path+"'");
+    }
+
+    //accept connections until a request shutdown is received
+    unsigned int active = 0;
+    pthread_mutex_t mutex;
+    pthread_mutex_init(&mutex, NULL);
+    while(!getShutdown()) {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if(poll(&pfd, 1, 100) <= 0)
+            continue;
+
+        int fd_ = accept(fd, NULL, NULL);
+        if(fd_ < 0)
+            continue;
+
+        TRequestSocketConnection *SC = new TRequestSocketConnection;
+        SC->Server = this;
+        SC->fd = fd_;
+        SC->active = &active;
+        SC->mutex = &mutex;
+
+        pthread_mutex_lock(&mutex);
+        active++;
+        pthread_mutex_unlock(&mutex);
+
+        pthread_t thread;
+        if(pthread_create(&thread, NULL, serveConnection, SC) != 0) {
+            close(fd_);
+            pthread_mutex_lock(&mutex);
+            active--;
+            pthread_mutex_unlock(&mutex);
+            delete SC;
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+    //stop listening and wait the active connections
+    close(fd);
+    unlink(path.c_str());
+    while(true) {
+        pthread_mutex_lock(&mutex);
+        unsigned int n = active;
+        pthread_mutex_unlock(&mutex);
+        if(n <= 0)
+            break;
+        poll(NULL, 0, 10);
+    }
+    pthread_mutex_destroy(&mutex);
+}
+
+//---------------------------------------------------------------------------
+//TRequestClient:
+//---------------------------------------------------------------------------
+
+//close the connection, if any
+TRequestClient::~TRequestClient()
+{
+    disconnect();
+}
+
+//connect to a Unix domain socket
+void TRequestClient::connectTo(const string& path)
+{
+    //check the preconditions
+    struct sockaddr_un addr;
+    if(path.length() <= 0 || path.length() >= sizeof(addr.sun_path))
+        throw EImproperArgument("path '"+path+"' should be a valid path of Unix domain socket");
+
+    //close the previous connection, if any
+    disconnect();
+
+    //connect to the socket
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0)
+        throw ECantComplete("can't build the Unix domain socket");
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        throw ECantComplete("can't connect to the Unix domain socket '"+path+"'");
+    }
+    p_fd = fd;
+    p_Buffer.clear();
+}
+
+//close the connection
+void TRequestClient::disconnect(void)
+{
+    if(p_fd >= 0) {
+        close(p_fd);
+        p_fd = -1;
+    }
+}
+
+//send a request in format NDJSON
+void TRequestClient::send(const string& request)
+{
+    if(p_fd < 0)
+        throw EImproperCall("client should be connected");
+    if(!writeAll(p_fd, request + "\n"))
+        throw ECantComplete("can't send the request");
+}
+
+//receive a response in format NDJSON
+string TRequestClient::receive(void)
+{
+    if(p_fd < 0)
+        throw EImproperCall("client should be connected");
+
+    char chunk[4096];
+    size_t pos;
+    while((pos = p_Buffer.find('\n')) == string::npos) {
+        ssize_t n = read(p_fd, chunk, sizeof(chunk));
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            throw ECantComplete("connection closed before receive the response");
+        p_Buffer.append(chunk, size_t(n));
+    }
+
+    string response = p_Buffer.substr(0, pos);
+    p_Buffer.erase(0, pos + 1);
+    return response;
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Positioning
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,212 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: RequestServer.h
+//Content: server of requests of generation and validation of MPs
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef REQUESTSERVER_H
+#define REQUESTSERVER_H
+
+#include "FiberMOSModel.h"
+
+#include <jsoncpp/json/json.h>
+#include <pthread.h>
+#include <deque>
+#include <vector>
+#include <string>
+
+//---------------------------------------------------------------------------
+
+using namespace Models;
+
+//namespace for positioning
+namespace Positioning {
+
+//---------------------------------------------------------------------------
+//TRequestServer:
+//---------------------------------------------------------------------------
+
+//The request server keeps one or more FMM Instances resident in memory,
+//and serves requests in format NDJSON (a JSON object per line).
+//Each request shall contain the following members:
+//  "id": identifier of the request, echoed in the response (optional);
+//  "type": "ping", "park", "pair", "validate" or "shutdown";
+//  "instance": name of the FMM Instance (optional, by default the first);
+//  "timeout": maximun time to wait the response in seconds (optional).
+//Requests "park" and "pair" shall contain:
+//  "p_1s", "p___3s": the rotor positions of all RPs of the FMM in steps;
+//  "RPids": the identifiers of the RPs to be disabled (optional);
+//  "Bid": the identifier of the block (optional);
+//  "format": "MCS" or "JSON", format of the outputs (optional).
+//Requests "validate" shall contain:
+//  "outputs": a structure OutputsPairPPDP in format MCS;
+//  "includeFMOSA": indicates if "outputs" includes the FMOSA (optional);
+//  "p_1s", "p___3s": the initial positions (optional).
+//Each response is a JSON object in a line, containing "id", "ok"
+//and either the results or "error". Responses can be written
+//in an order different of the requests.
+//
+//Each request is processed on a fresh clone of the resident FMM Instance,
+//so the FMM Instance is never changed, and never written.
+
+//job of the request server
+class TRequestJob;
+//connection of the request server
+class TRequestConnection;
+
+//class request server
+class TRequestServer {
+protected:
+    //resident FMM Instances and their names
+    std::vector<TFiberMOSModel*> p_FMMs;
+    std::vector<std::string> p_Names;
+
+    double p_Timeout;
+
+    //queue of jobs pending to be processed
+    std::deque<TRequestJob*> p_Queue;
+    //workers processing the jobs
+    std::vector<pthread_t> p_Workers;
+    //indicates that the workers shall finish
+    bool p_Stopping;
+    //indicates that a request shutdown has been received
+    bool p_Shutdown;
+    //mutex and condition for access to (p_Queue, p_Stopping, p_Shutdown)
+    pthread_mutex_t p_mutex;
+    pthread_cond_t p_cond;
+
+    //process the jobs of the queue until the server stops
+    static void *worker(void *arg);
+
+    //search a resident FMM Instance by name
+    //if the name is empty, return the first one
+    //if the name is not found, return NULL
+    const TFiberMOSModel *searchFMM(const std::string& name) const;
+
+    //answer a job if it has not been answered
+    void answer(TRequestJob *J, const std::string& response) const;
+    //answer the jobs of a connection whose deadline has expired
+    void answerExpiredJobs(TRequestConnection *C) const;
+
+public:
+    //PROPERTIES:
+
+    //default maximun time to wait the response of a request in seconds
+    //zero means without timeout
+    //default value: 0
+    double getTimeout(void) const {return p_Timeout;}
+    void setTimeout(double);
+
+    //number of workers
+    unsigned int getWorkersCount(void) const {return p_Workers.size();}
+    //number of resident FMM Instances
+    unsigned int getInstancesCount(void) const {return p_FMMs.size();}
+
+    //indicates if a request shutdown has been received
+    bool getShutdown(void) const;
+
+    //BUILDING AND DESTROYING METHODS:
+
+    //build a request server without FMM Instances nor workers
+    TRequestServer(void);
+    //stop the workers and destroy the resident FMM Instances
+    ~TRequestServer();
+
+    //add a clone of a FMM Instance to the resident FMM Instances
+    //the RPs of the clone will be sorted by identifier
+    //if the name is already used:
+    //  throw an exception EImproperArgument
+    void addInstance(const std::string& name, const TFiberMOSModel& FMM);
+
+    //start a number of workers
+    //if the workers are already started:
+    //  throw an exception EImproperCall
+    void start(unsigned int workers);
+    //stop the workers, waiting they finish the current jobs
+    void stop(void);
+
+    //METHODS FOR PROCESS REQUESTS:
+
+    //process a request synchronously
+    //Inputs:
+    //  request: the request in format JSON
+    //  FMM: workspace where the resident FMM Instance will be cloned
+    //Outputs:
+    //  response: the response in format JSON (without "id")
+    //Exceptions are propagated to the caller.
+    void processRequest(Json::Value& response, const Json::Value& request,
+                        TFiberMOSModel& FMM);
+
+    //process a request in format NDJSON synchronously
+    //and return the response in format NDJSON (ended by '\n')
+    std::string processRequest(const std::string& request);
+
+    //serve the requests read from a file descriptor,
+    //writing the responses in other file descriptor,
+    //until the end of the input and all responses have been written
+    //Preconditions:
+    //  The workers shall be started.
+    void serve(int fd_in, int fd_out);
+
+    //serve the requests of the connections to a Unix domain socket,
+    //until a request shutdown is received
+    //Preconditions:
+    //  The workers shall be started.
+    void serveUnixSocket(const std::string& path);
+};
+
+//---------------------------------------------------------------------------
+//TRequestClient:
+//---------------------------------------------------------------------------
+
+//class client of a request server listening in a Unix domain socket
+class TRequestClient {
+protected:
+    int p_fd;
+    std::string p_Buffer;
+
+public:
+    //build a client not connected
+    TRequestClient(void) : p_fd(-1), p_Buffer() {;}
+    //close the connection, if any
+    ~TRequestClient();
+
+    //connect to a Unix domain socket
+    //if the connection fail:
+    //  throw an exception ECantComplete
+    void connectTo(const std::string& path);
+    //close the connection
+    void disconnect(void);
+
+    //send a request in format NDJSON (without the ending '\n')
+    void send(const std::string& request);
+    //receive a response in format NDJSON (without the ending '\n')
+    //if the connection is closed before receive a response:
+    //  throw an exception ECantComplete
+    std::string receive(void);
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Positioning
+
+//---------------------------------------------------------------------------
+#endif // REQUESTSERVER_H
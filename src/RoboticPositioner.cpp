@@ -27,6 +27,7 @@
 #include "TextFile.h"
 
 #include <algorithm> //std::min, std::max
+#include <pthread.h> //pthread_mutex_t, pthread_mutex_lock, pthread_mutex_unlock
 
 //---------------------------------------------------------------------------
 
@@ -287,6 +288,10 @@ TFaultType StrToFaultType(const AnsiString& S)
 //lista de objetos construidos
 TItemsList<TRoboticPositioner*> TRoboticPositioner::Builts;
 
+//mutex for access to the list of built objects,
+//so objects can be built and destroyed from several threads
+static pthread_mutex_t BuiltsMutex = PTHREAD_MUTEX_INITIALIZER;
+
 //---------------------------------------------------------------------------
 //PROPIEDADES DE SEGURIDAD:
 
@@ -926,7 +931,9 @@ TRoboticPositioner::TRoboticPositioner(void) :
     CMF.setLabel("CMF");
 
     //añade el posicionador a la lista de contruidos
+    pthread_mutex_lock(&BuiltsMutex);
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 //build a RP with the indicated values
 //if Id is less 1 throw an exception EImproperArgument
@@ -958,7 +965,9 @@ TRoboticPositioner::TRoboticPositioner(int Id, TDoublePoint P0,
     CMF.setLabel("CMF");
 
     //añade el posicionador a la lista de contruidos
+    pthread_mutex_lock(&BuiltsMutex);
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 
 //copy all tolerance properties of a RP
@@ -1030,7 +1039,9 @@ TRoboticPositioner::TRoboticPositioner(const TRoboticPositioner *RP)
     clone(RP);
 
     //añade el posicionador a la lista de contruidos
+    pthread_mutex_lock(&BuiltsMutex);
     Builts.Add(this);
+    pthread_mutex_unlock(&BuiltsMutex);
 }
 
 //copy all properties of a RP
@@ -1058,9 +1069,13 @@ void TRoboticPositioner::apply(const TRoboticPositioner *RP)
 //if the RP isn't in Built throw EImproperCall
 TRoboticPositioner::~TRoboticPositioner()
 {
+    pthread_mutex_lock(&BuiltsMutex);
+
     //debe haber algún objeto para destruir
-    if(Builts.getCount() < 1)
+    if(Builts.getCount() < 1) {
+        pthread_mutex_unlock(&BuiltsMutex);
         throw EImproperCall("there isn't an object to destroy");
+    }
 
     //busca el objeto a destruir en la lista
     int i = 0;
@@ -1068,16 +1083,20 @@ TRoboticPositioner::~TRoboticPositioner()
         i++;
 
     //si no ha encontrado el objeto
-    if(i >= Builts.getCount())
+    if(i >= Builts.getCount()) {
+        pthread_mutex_unlock(&BuiltsMutex);
         //indica que está intentando destruir un objeto no contruido
         throw EImproperCall("destruction attempt of non built object: "+
                             IntToHex(intptr_t(this)).str);
-
-    //destruye el actuador
-    delete p_Actuator;
+    }
 
     //borra el puntero de la lista de construídos
     Builts.Delete(i);
+
+    pthread_mutex_unlock(&BuiltsMutex);
+
+    //destruye el actuador
+    delete p_Actuator;
 }
 
 //---------------------------------------------------------------------------
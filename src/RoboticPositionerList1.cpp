@@ -28,6 +28,11 @@
 #include "VCLemu.h"
 #include "TextFile.h"
 
+#include <algorithm> //std::sort, std::min, std::max
+#include <float.h> //DBL_MAX
+#include <pthread.h> //pthread_create, pthread_join
+#include <unistd.h> //sysconf
+
 //---------------------------------------------------------------------------
 
 using namespace Strings;
@@ -460,7 +465,15 @@ void  TRoboticPositionerList1::readInstance(TRoboticPositionerList1* &RPL,
 TRoboticPositionerList1::TRoboticPositionerList1(void) :
     TItemsList<TRoboticPositioner*>(100),
     //propiedades de seguridad
-    p_PAem(MEGARA_PAem), p_Pem(MEGARA_Pem)
+    p_PAem(MEGARA_PAem), p_Pem(MEGARA_Pem),
+    //propiedades de dimensionamiento
+    p_LO3max(0), p_x3min(0), p_x3max(0), p_y3min(0), p_y3max(0),
+    //índice de los posicionadores
+    p_IdIndex(), p_IdsOutOfIndex(false), p_RPIndex(), p_IndexedCount(0),
+    //grafo de adyacencia
+    p_Adjacency(),
+    //buffers de la asignación en lote
+    p_Batch()
 {
     //point the default functions
     Compare = TRoboticPositioner::compareIds;
@@ -551,7 +564,9 @@ void TRoboticPositionerList1::Clone(const TRoboticPositionerList1 *RPL)
 }
 
 //construye un clon de una lista de posicionadores
-TRoboticPositionerList1::TRoboticPositionerList1(const TRoboticPositionerList1 *RPL)
+TRoboticPositionerList1::TRoboticPositionerList1(const TRoboticPositionerList1 *RPL) :
+    p_IdIndex(), p_IdsOutOfIndex(false), p_RPIndex(), p_IndexedCount(0),
+    p_Adjacency(), p_Batch()
 {
     //comprueba las precondiciones
     if(RPL == NULL)
@@ -561,9 +576,144 @@ TRoboticPositionerList1::TRoboticPositionerList1(const TRoboticPositionerList1 *
     Clone(RPL);
 }
 
+//--------------------------------------------------------------------------
+//INDEX OF THE RPs:
+
+//rebuild the index of the RPs
+void TRoboticPositionerList1::buildIndex(void) const
+{
+    //determine the maximum identifier
+    int Idmax = 0;
+    for(int i=0; i<getCount(); i++) {
+        int Id = Items[i]->getActuator()->getId();
+        if(Id > Idmax)
+            Idmax = Id;
+    }
+
+    //the identifiers are usually consecutive, but the index
+    //shall not grow without limit with an anomalous identifier
+    int size = min(Idmax, 4*getCount() + 256) + 1;
+
+    //initialize the index
+    p_IdIndex.assign(size, -1);
+    p_IdsOutOfIndex = false;
+    p_RPIndex.clear();
+    p_IndexedCount = 0;
+
+    //index the RPs
+    for(int i=0; i<getCount(); i++)
+        addToIndex(i);
+}
+//add the RP in the position i to the index
+void TRoboticPositionerList1::addToIndex(int i) const
+{
+    const TRoboticPositioner *RP = Items[i];
+    int Id = RP->getActuator()->getId();
+
+    //only the first RP with each identifier is indexed
+    if(Id < 0)
+        ;
+    else if(Id < int(p_IdIndex.size())) {
+        if(p_IdIndex[Id] < 0)
+            p_IdIndex[Id] = i;
+    } else if(Id < 4*(i + 1) + 256) {
+        p_IdIndex.resize(Id + 1, -1);
+        p_IdIndex[Id] = i;
+    } else
+        p_IdsOutOfIndex = true;
+
+    //only the first position of each RP is indexed
+    p_RPIndex.insert(pair<const TRoboticPositioner*, int>(RP, i));
+
+    p_IndexedCount++;
+}
+//search the first RP with an identifier in the index
+//return -1 if the index doesn't correspond to the list
+int TRoboticPositionerList1::searchIdInIndex(int Id) const
+{
+    if(p_IndexedCount != getCount())
+        return -1;
+
+    //if the identifier is out of the index
+    if(Id >= int(p_IdIndex.size())) {
+        if(!p_IdsOutOfIndex)
+            return getCount();
+        int i = 0;
+        while(i<getCount() && Items[i]->getActuator()->getId()!=Id)
+            i++;
+        return i;
+    }
+
+    //check that the indexed RP has the identifier
+    int i = p_IdIndex[Id];
+    if(i < 0)
+        return getCount();
+    if(Items[i]->getActuator()->getId() != Id)
+        return -1;
+    return i;
+}
+
 //--------------------------------------------------------------------------
 //ADD OR DELETE RPs:
 
+//add a RP to the list
+void TRoboticPositionerList1::Add(TRoboticPositioner *RP)
+{
+    //comprueba las precondiciones
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
+
+    bool indexed = (p_IndexedCount == getCount());
+    TItemsList<TRoboticPositioner*>::Add(RP);
+
+    //actualiza el índice si correspondía a la lista
+    if(indexed)
+        addToIndex(getCount() - 1);
+    else
+        invalidateIndex();
+    invalidateAdjacency();
+}
+//add the RPs of other list to the list
+void TRoboticPositionerList1::Add(const TItemsList<TRoboticPositioner*>& RPL)
+{
+    //la lista podría ser esta misma
+    int count = RPL.getCount();
+    for(int i=0; i<count; i++)
+        Add(RPL[i]);
+}
+//insert a RP in the position i of the list
+void TRoboticPositionerList1::Insert(int i, TRoboticPositioner *RP)
+{
+    //comprueba las precondiciones
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
+
+    TItemsList<TRoboticPositioner*>::Insert(i, RP);
+    invalidateIndex();
+    invalidateAdjacency();
+}
+//delete a RP of the list without destroy it
+void TRoboticPositionerList1::Delete(int i)
+{
+    TItemsList<TRoboticPositioner*>::Delete(i);
+
+    //the positions of the next RPs have changed, so the index
+    //will be rebuilt when the next RP is searched
+    invalidateIndex();
+    invalidateAdjacency();
+}
+//delete all RPs of the list without destroy them
+void TRoboticPositionerList1::Clear(void)
+{
+    TItemsList<TRoboticPositioner*>::Clear();
+
+    p_IdIndex.clear();
+    p_IdsOutOfIndex = false;
+    p_RPIndex.clear();
+    p_IndexedCount = 0;
+    invalidateAdjacency();
+}
+
 //search and delete a RP of the list
 //return the position where the RP was found
 int TRoboticPositionerList1::deleteIfFind(const TRoboticPositioner* RP)
@@ -762,13 +912,23 @@ int TRoboticPositionerList1::search(const TRoboticPositioner *RP) const
     if(RP == NULL)
         throw EImproperArgument("pointer RP should point to built robotic positioner");
 
-    //mientras queden posiciones en la lista y
-    //el puntero no apunte al mismo posicionador
-    int i = 0;
-    while(i<getCount() && RP!=Items[i])
-        i++; //incrementa el índice
+    //si el índice no corresponde a la lista, lo reconstruye
+    if(p_IndexedCount != getCount())
+        buildIndex();
 
-    return i; //devuelve el índice
+    //busca el posicionador en el índice
+    map<const TRoboticPositioner*, int>::const_iterator it = p_RPIndex.find(RP);
+    //si el índice no corresponde a la lista, lo reconstruye
+    if(it!=p_RPIndex.end() && Items[it->second]!=RP) {
+        buildIndex();
+        it = p_RPIndex.find(RP);
+    }
+
+    //si no ha encontrado el posicionador
+    if(it == p_RPIndex.end())
+        return getCount(); //indica que no está en la lista
+
+    return it->second; //devuelve el índice
 }
 int TRoboticPositionerList1::search(const TActuator *A) const
 {
@@ -776,8 +936,15 @@ int TRoboticPositionerList1::search(const TActuator *A) const
     if(A == NULL)
         throw EImproperArgument("pointer A should point to built actuator");
 
-    //mientras queden posiciones en la lista y
-    //el puntero no apunte al mismo actuador
+    //busca el actuador por su identificador
+    if(A->getId() > 0) {
+        int i = searchId(A->getId());
+        if(i<getCount() && A==Items[i]->getActuator())
+            return i; //devuelve el índice
+    }
+
+    //si no lo ha encontrado (por ejemplo, porque el identificador
+    //está repetido), recorre la lista
     int i = 0;
     while(i<getCount() && A!=Items[i]->getActuator())
         i++; //incrementa el índice
@@ -791,9 +958,13 @@ int TRoboticPositionerList1::searchId(int Id) const
     if(Id < 1)
         throw EImproperArgument("RP identifier number Id should be upper zero");
 
-    int i = 0;
-    while(i<getCount() && Items[i]->getActuator()->getId()!=Id)
-        i++;
+    //busca el identificador en el índice
+    int i = searchIdInIndex(Id);
+    //si el índice no corresponde a la lista, lo reconstruye
+    if(i < 0) {
+        buildIndex();
+        i = searchIdInIndex(Id);
+    }
 
     return i;
 }
@@ -932,56 +1103,160 @@ void TRoboticPositionerList1::calculateSPMcomponents(void)
     }
 }
 
+//rejilla uniforme de celdas cuadradas, que permite obtener los RPs
+//próximos a un punto recorriendo solo las celdas vecinas
+class TCellGrid {
+    //origen de la rejilla
+    double p_xmin, p_ymin;
+    //lado de las celdas
+    double p_D;
+    //número de columnas y de filas
+    int p_nx, p_ny;
+    //posición en Indices del primer RP de cada celda, más el total
+    vector<int> p_First;
+    //índices de los RPs ordenados por celda
+    vector<int> p_Indices;
+
+public:
+    //determina la columna o la fila de una coordenada
+    int cellx(double x) const {
+        int i = int(floor((x - p_xmin)/p_D));
+        return max(0, min(i, p_nx - 1));
+    }
+    int celly(double y) const {
+        int j = int(floor((y - p_ymin)/p_D));
+        return max(0, min(j, p_ny - 1));
+    }
+
+    //número de columnas y de filas
+    int getnx(void) const {return p_nx;}
+    int getny(void) const {return p_ny;}
+    //RPs de la celda (i, j) en el intervalo [begin, end)
+    const int *begin(int i, int j) const {return &p_Indices[0] + p_First[j*p_nx + i];}
+    const int *end(int i, int j) const {return &p_Indices[0] + p_First[j*p_nx + i + 1];}
+
+    //construye la rejilla con celdas de lado D almenos,
+    //sin exceder del orden de celdas que de puntos
+    TCellGrid(const vector<TDoublePoint>& P, double D) {
+        int N = int(P.size());
+        p_xmin = p_ymin = DBL_MAX;
+        double xmax = -DBL_MAX, ymax = -DBL_MAX;
+        for(int k=0; k<N; k++) {
+            p_xmin = min(p_xmin, P[k].x);
+            p_ymin = min(p_ymin, P[k].y);
+            xmax = max(xmax, P[k].x);
+            ymax = max(ymax, P[k].y);
+        }
+        p_D = (D > 0) ? D : 1;
+        while((floor((xmax - p_xmin)/p_D) + 1)*(floor((ymax - p_ymin)/p_D) + 1) > 4.0*N + 16)
+            p_D *= 2;
+        p_nx = int(floor((xmax - p_xmin)/p_D)) + 1;
+        p_ny = int(floor((ymax - p_ymin)/p_D)) + 1;
+
+        //distribuye los índices de los RPs en las celdas
+        //conservando el orden de la lista en cada celda
+        vector<int> Cells(N);
+        p_First.assign(p_nx*p_ny + 1, 0);
+        for(int k=0; k<N; k++) {
+            Cells[k] = celly(P[k].y)*p_nx + cellx(P[k].x);
+            p_First[Cells[k] + 1]++;
+        }
+        for(int c=0; c<p_nx*p_ny; c++)
+            p_First[c + 1] += p_First[c];
+        vector<int> Next(p_First.begin(), p_First.end() - 1);
+        p_Indices.resize(N);
+        for(int k=0; k<N; k++)
+            p_Indices[Next[Cells[k]]++] = k;
+    }
+};
+
 //determina las EAs y los RPs que están lo bastante cerca
 //de cada posicionador como para invadir su dominio de maniobra
 void TRoboticPositionerList1::determineAdjacents(const TExclusionAreaList& EAL)
 {
+    //el grafo de adyacencia será reconstruido cuando se solicite
+    invalidateAdjacency();
+
+    //Los RPs se distribuyen en una rejilla de celdas cuyo lado es
+    //la distancia máxima a la que pueden estar dos RPs adyacentes,
+    //de modo que los adyacentes de cada RP están en su celda o en
+    //las celdas vecinas, y la determinación es de orden lineal.
+    //Los adyacentes se añaden en el mismo orden que en la lista,
+    //y se comparan con la misma expresión que comparando todos
+    //los pares, de modo que el resultado es idéntico.
+
+    int N = getCount();
+    if(N <= 0)
+        return;
+
+    //captura las propiedades de los RPs para facilitar su acceso
+    vector<TDoublePoint> P0(N);
+    vector<double> r_max(N), SPMall_a(N);
+    double Rmax = 0;
+    for(int i=0; i<N; i++) {
+        TActuator *A = Items[i]->getActuator();
+        P0[i] = A->getP0();
+        r_max[i] = A->getr_max();
+        SPMall_a[i] = A->getSPMall_a();
+        Rmax = max(Rmax, r_max[i] + SPMall_a[i]);
+
+        //inicializa las listas de EAs adyacentes y de RPs adyacentes
+        A->AdjacentEAs.Clear();
+        A->AdjacentRPs.Clear();
+    }
+
+    //construye la rejilla de celdas
+    TCellGrid G(P0, 2*Rmax + 2*ERR_NUM);
+
+    //para cada una de las EAs
+    for(int j=0; j<EAL.getCount(); j++) {
+        //apunta el EA indicada para facilitar su acceso
+        TExclusionArea *EAj = EAL[j];
+        TDoublePoint P = EAj->Barrier.getP0();
+        double R = EAj->Barrier.getr_max() + EAj->Barrier.getSPM() + Rmax + 2*ERR_NUM;
+
+        //por cada RP de las celdas cercanas al EA
+        for(int y=G.celly(P.y - R); y<=G.celly(P.y + R); y++)
+            for(int x=G.cellx(P.x - R); x<=G.cellx(P.x + R); x++)
+                for(const int *k=G.begin(x, y); k!=G.end(x, y); k++) {
+                    int i = *k;
+                    //si están lo bastante cerca como para colisionar
+                    if(Mod(P0[i] - P) < (r_max[i] + SPMall_a[i] +
+                                         EAj->Barrier.getr_max() + EAj->Barrier.getSPM()) + ERR_NUM) {
+                        //añade el EA a la lista de EAs adyacentes
+                        Items[i]->getActuator()->AdjacentEAs.Add(TAdjacentEA(EAj));
+                    }
+                }
+    }
+
     //por cada posicionador de la lista
-    for(int i=0; i<getCount(); i++) {
+    vector<int> Candidates;
+    for(int i=0; i<N; i++) {
         //apunta el posicionador indicado para facilitar su acceso
         TRoboticPositioner *RPi = Items[i];
 
-        //inicializa la lista de EAs adyacentes
-        RPi->getActuator()->AdjacentEAs.Clear();
-        //inicializa la lista de RPs adyacentes
-        RPi->getActuator()->AdjacentRPs.Clear();
+        //determina los RPs de las celdas vecinas en el orden de la lista
+        Candidates.clear();
+        int xi = G.cellx(P0[i].x), yi = G.celly(P0[i].y);
+        for(int y=max(0, yi-1); y<=min(G.getny()-1, yi+1); y++)
+            for(int x=max(0, xi-1); x<=min(G.getnx()-1, xi+1); x++)
+                Candidates.insert(Candidates.end(), G.begin(x, y), G.end(x, y));
+        sort(Candidates.begin(), Candidates.end());
+
+        //para cada uno de los RPs cercanos
+        for(unsigned int k=0; k<Candidates.size(); k++) {
+            int j = Candidates[k];
+            if(j == i)
+                continue;
 
-        //para cada una de las EAs
-        for(int j=0; j<EAL.getCount(); j++) {
-            //apunta el EA indicada para facilitar su acceso
-            TExclusionArea *EAj = EAL[j];
-            //si están lo bastante cerca como para colisionar
-            if(Mod(RPi->getActuator()->getP0() - EAj->Barrier.getP0()) <
-                    (RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
-                     EAj->Barrier.getr_max() + EAj->Barrier.getSPM()) + ERR_NUM) {
-                //añade el EA a la lista de EAs adyacentes
-                RPi->getActuator()->AdjacentEAs.Add(new TAdjacentEA(EAj));
-            }
-        }
-        //para cada uno de los RPs previos al indicado
-        for(int j=0; j<i; j++) {
-            //apunta el RP indicado para facilitar su acceso
-            TRoboticPositioner *RPj = Items[j];
-            //si están lo bastante cerca como para colisionar
-            if(Mod(RPi->getActuator()->getP0() - RPj->getActuator()->getP0()) <
-                    (RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
-                     RPj->getActuator()->getr_max() + RPj->getActuator()->getSPMall_a()) + ERR_NUM) {
-                //añade el RP a la lista de RPs adyacentes
-                //añade una distancia mínima para el RP adyacente
-                RPi->getActuator()->AdjacentRPs.Add(new TAdjacentRP(RPj));
-            }
-        }
-        //para cada uno de los RPs posteriores al indicado
-        for(int j=i+1; j<getCount(); j++) {
-            //apunta el RP indicado para facilitar su acceso
-            TRoboticPositioner *RPj = Items[j];
             //si están lo bastante cerca como para colisionar
-            if(Mod(RPi->getActuator()->getP0() - RPj->getActuator()->getP0()) <
-                    (RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
-                     RPj->getActuator()->getr_max() + RPj->getActuator()->getSPMall_a())) {
+            //(con los RPs previos con un margen adicional)
+            double d = Mod(P0[i] - P0[j]);
+            double dmax = r_max[i] + SPMall_a[i] + r_max[j] + SPMall_a[j];
+            if(j < i ? d < dmax + ERR_NUM : d < dmax) {
                 //añade el RP a la lista de RPs adyacentes
                 //añade una distancia mínima para el RP adyacente
-                RPi->getActuator()->AdjacentRPs.Add(new TAdjacentRP(RPj));
+                RPi->getActuator()->AdjacentRPs.Add(TAdjacentRP(Items[j]));
             }
         }
     }
@@ -992,6 +1267,9 @@ void TRoboticPositionerList1::sortAdjacents(void)
 {
     TRoboticPositioner *RP, *RPA;
 
+    //el grafo de adyacencia será reconstruido cuando se solicite
+    invalidateAdjacency();
+
     //ninguno de los adyacentes debe ser el posicionador de referencia
     for(int i=0; i<getCount(); i++) {
         //apunta el posicionador indicado para facilitar su acceso
@@ -1095,10 +1373,28 @@ void TRoboticPositionerList1::sortAdjacents(void)
         //transcribe la lista
         RP->getActuator()->AdjacentRPs.Clear();
         for(int j=0; j<LP.getCount(); j++)
-            RP->getActuator()->AdjacentRPs.Add(new TAdjacentRP(LP[j].P));
+            RP->getActuator()->AdjacentRPs.Add(TAdjacentRP(LP[j].P));
     }
 }
 
+//get the adjacency graph of the RPs of the list,
+//building it if it has been invalidated
+const TAdjacencyGraph& TRoboticPositionerList1::getAdjacency(void) const
+{
+    //the nodes of the graph are the positions of the RPs in the list,
+    //so the graph shall be rebuilt when the list has been reordered
+    //through the methods of the base class (SortInc, SortDec, etc)
+    bool built = p_Adjacency.getBuilt() &&
+            p_Adjacency.getRPsCount() == getCount();
+    for(int i=0; built && i<getCount(); i++)
+        if(p_Adjacency.getRP(i) != Items[i])
+            built = false;
+
+    if(!built)
+        p_Adjacency.build(*this);
+    return p_Adjacency;
+}
+
 //para cada posicionador de la lista calcula:
 //      su radio de seguridad Rbsaf;
 //      sus propiedades de la zona segura.
@@ -1121,6 +1417,19 @@ void TRoboticPositionerList1::calculateSizingParameters(void)
     double LO3;
     p_LO3max = 0; //inicializa la distancia máxima
 
+    //inicializa los límites del dominio de P3
+    if(getCount() > 0) {
+        p_x3min = DBL_MAX;
+        p_x3max = -DBL_MAX;
+        p_y3min = DBL_MAX;
+        p_y3max = -DBL_MAX;
+    } else {
+        p_x3min = 0;
+        p_x3max = 0;
+        p_y3min = 0;
+        p_y3max = 0;
+    }
+
     //por cada posicionador de la lista
     for(int i=0; i<getCount(); i++) {
         //apunta el posicionador indicado para facilitar su acceso
@@ -1270,30 +1579,103 @@ void TRoboticPositionerList1::setPositions(const TPairPositionAnglesList& Positi
     if(PositionList.getCount() != getCount())
         throw EImproperArgument("list PositionList should contain a pair by each robotic positioner");
 
-    //por cada posicionador de la lista
+    //añade cada posicionador de la lista y su posición al lote
+    p_Batch.RPs.resize(getCount());
+    p_Batch.p_1.resize(getCount());
+    p_Batch.p___3.resize(getCount());
     for(int i=0; i<getCount(); i++) {
-        //apunta el posicionador indicado para facilitar su acceso
-        TRoboticPositioner *RP = Items[i];
-        //apunta el par indicado para facilitar su acceso
         const TPairPositionAngles *PPA = PositionList.GetPointer(i);
-        //las posiciones angulares del eje 1 debe estar en el dominio del eje 1
-        if(RP->getActuator()->isntInDomainp_1(PPA->p_1))
-            throw EImproperArgument("the axis 1 angular position should be in the domain of axis 1");
-        //las posiciones angulares del eje 2 debe estar en el dominio del eje 2
-        if(RP->getActuator()->getArm()->isntInDomainp___3(PPA->p___3))
-            throw EImproperArgument("the axis 2 angular position should be in the domain of axis 2");
+        p_Batch.RPs[i] = Items[i];
+        p_Batch.p_1[i] = PPA->p_1;
+        p_Batch.p___3[i] = PPA->p___3;
     }
 
-    //por cada posicionador de la lista
-    for(int i=0; i<getCount(); i++) {
-        //apunta el posicionador indicado para facilitar su acceso
-        TRoboticPositioner *RP = Items[i];
-        //apunta el par indicado para facilitar su acceso
-        const TPairPositionAngles *PPA = PositionList.GetPointer(i);
-        //asigna las posiciones angulares
-        RP->getActuator()->setAnglesSteps(PPA->p_1, PPA->p___3);
+    //asigna las posiciones angulares cuantificándolas en lote
+    //las posiciones se comprueban todas antes de asignar ninguna,
+    //de modo que si alguna está fuera de su dominio no se asigna ninguna
+    setAnglesStepsInBatch();
+}
+//quantify in batch the values x, in runs of consecutive values
+//with the same quantifier
+static void quantificeInRuns(vector<int>& n, const vector<double>& x,
+                             const vector<const TQuantificator*>& Q)
+{
+    int N = int(x.size());
+    n.resize(N);
+    int k = 0;
+    while(k < N) {
+        int j = k + 1;
+        while(j<N && (Q[j]==Q[k] || *Q[j]==*Q[k]))
+            j++;
+        Q[k]->Quantifice(&n[k], &x[k], j - k);
+        k = j;
+    }
+}
+
+//assign the positions in steps (p_Batch.p_1[k], p_Batch.p___3[k])
+//to the RPs p_Batch.RPs[k], quantifying the angles of the rotors
+//in batch, with the same result as:
+//  p_Batch.RPs[k]->getActuator()->setAnglesSteps(p_Batch.p_1[k], p_Batch.p___3[k])
+void TRoboticPositionerList1::setAnglesStepsInBatch(void)
+{
+    TBatchBuffers& B = p_Batch;
+
+    //check the preconditions
+    if(B.p_1.size()!=B.RPs.size() || B.p___3.size()!=B.RPs.size())
+        throw EImproperArgument("should be a pair of positions for each RP");
+
+    int N = int(B.RPs.size());
+
+    //translate the positions to radians, and the angles
+    //of the quantified rotors to steps again for quantify them
+    B.theta_1.resize(N);
+    B.theta___3.resize(N);
+    B.x_1.clear();
+    B.x___3.clear();
+    B.Q_1.clear();
+    B.Q___3.clear();
+    for(int k=0; k<N; k++) {
+        TActuator *A = B.RPs[k]->getActuator();
+        TArm *Arm = A->getArm();
+
+        //translate the positions to radians only once,
+        //checking that they are in their domains
+        if(!A->getG().BelongToDomain(B.p_1[k]))
+            throw EImproperArgument("angle p_1 should be in domain G(p_1)");
+        B.theta_1[k] = A->getG().Image(B.p_1[k]);
+        if(A->isntInDomaintheta_1(B.theta_1[k]))
+            throw EImproperArgument("angle p_1 should be in [p_1min, p_1max]");
+        B.theta___3[k] = Arm->getG().Image(B.p___3[k]);
+        if(Arm->isntInDomaintheta___3(B.theta___3[k]))
+            throw EImproperArgument("angle p___3 should be in [p___3min, p___3max]");
+
+        if(A->getQuantify_()) {
+            B.x_1.push_back(A->getF().Image(B.theta_1[k]));
+            B.Q_1.push_back(&A->getQ());
+        }
+        if(Arm->getQuantify___()) {
+            B.x___3.push_back(Arm->getF().Image(B.theta___3[k]));
+            B.Q___3.push_back(&Arm->getQ());
+        }
+    }
+
+    //quantify the steps in batch
+    quantificeInRuns(B.n_1, B.x_1, B.Q_1);
+    quantificeInRuns(B.n___3, B.x___3, B.Q___3);
+
+    //translate the quantified steps to radians and assign the angles
+    int k_1 = 0, k___3 = 0;
+    for(int k=0; k<N; k++) {
+        TActuator *A = B.RPs[k]->getActuator();
+        TArm *Arm = A->getArm();
+        if(A->getQuantify_())
+            B.theta_1[k] = A->getG().Image(B.n_1[k_1++]);
+        if(Arm->getQuantify___())
+            B.theta___3[k] = Arm->getG().Image(B.n___3[k___3++]);
+        A->setAnglesQuantified(B.theta_1[k], B.theta___3[k]);
     }
 }
+
 //asigna conjuntamente los márgenes de segudidad
 //      (PAem, Pem)
 void TRoboticPositionerList1::setTolerance(double PAem,double Pem)
@@ -1549,11 +1931,15 @@ void TRoboticPositionerList1::segregateOperativeInnersOutTheOrigins(
 void TRoboticPositionerList1::segregateCollided(TRoboticPositionerList1& Collided,
                                                 TRoboticPositionerList1& notCollided) const
 {
+    //determine the collision of each pair of adjacent items only once
+    vector<bool> isCollided;
+    searchCollided(isCollided);
+
     Collided.Clear();
     notCollided.Clear();
     for(int i=0; i<getCount(); i++) {
         TRoboticPositioner *RP = Items[i];
-        if(RP->getActuator()->thereIsCollisionWithAdjacent())
+        if(isCollided[i])
             Collided.Add(RP);
         else
             notCollided.Add(RP);
@@ -1840,31 +2226,184 @@ void TRoboticPositionerList1::setAllCollision(bool Collision)
         Items[i]->getActuator()->Collision = Collision;
 }*/
 
-//determina si algún actuador de algún RP colisiona con
-//algún actuador o barrera de algún RP o EA adyacente
-bool TRoboticPositionerList1::thereIsCollision(void)
+//get the unique pairs of adjacent items of the RPs of the list
+void TRoboticPositionerList1::getCollisionPairs(vector<TCollisionPair>& Pairs) const
 {
-    //inicializa las banderas de determinación de colisión pendiente
-    enableAllPending();
+    Pairs.clear();
 
-    //busca colisión del actuador de cada RP con algún actuador o barrera de RP o EA adyacente,
-    //exceptuando aquellos con los que se ha comprobado ya
-    for(int i= 0; i<getCount(); i++) {
-        //apunta el RP indicado para facilitar su acceso
-        TRoboticPositioner *RP = Items[i];
-        //si el actuador del posicionador indicado colisiona con
-        //el actuador o barrera de algún RP o EA adyacente con
-        //determinación de colisión pendiente
-        if(RP->getActuator()->thereIsCollisionWithPendingAdjacent())
-            //indica que hay colisión
-            return true;
+    for(int i=0; i<getCount(); i++) {
+        TActuator *A = Items[i]->getActuator();
+
+        //each adjacent EA makes a pair
+        for(int k=0; k<A->AdjacentEAs.getCount(); k++) {
+            TCollisionPair P = {i, A, NULL, A->AdjacentEAs[k].EA, -1};
+            Pairs.push_back(P);
+        }
+
+        //each adjacent RP makes a pair, unless the pair has been
+        //already made from the adjacent RP, which happens when it is
+        //previous in the list and it has this RP as adjacent
+        for(int k=0; k<A->AdjacentRPs.getCount(); k++) {
+            TRoboticPositioner *RPA = A->AdjacentRPs[k].RP;
+            int j = search(RPA);
+
+            //determine if the RP is adjacent to its adjacent
+            bool reciprocal = false;
+            if(j < getCount()) {
+                const TAdjacentRPList& AdjacentRPs = RPA->getActuator()->AdjacentRPs;
+                for(int l=0; l<AdjacentRPs.getCount() && !reciprocal; l++)
+                    reciprocal = (AdjacentRPs[l].RP == Items[i]);
+            }
+
+            if(j<i && reciprocal)
+                continue;
+            TCollisionPair P = {i, A, RPA->getActuator(), NULL, (j>i && reciprocal) ? j : -1};
+            Pairs.push_back(P);
+        }
+    }
+}
+
+//part of a sweep assigned to a thread
+class TSweepPart {
+public:
+    //pairs of the sweep
+    const TRoboticPositionerList1::TCollisionPair *Pairs;
+    //interval of pairs of the part [begin, end)
+    unsigned int begin, end;
+    //buffer of results of the part
+    vector<char> Collisions;
+    //indicates if the sweep can finish at the first collision
+    bool first;
+    //indicates that some part has found a collision
+    volatile int *found;
+    //indicates that an exception has been thrown
+    bool error;
+};
+
+//determine the collision of the pairs of a part of a sweep
+static void *sweepPart(void *arg)
+{
+    TSweepPart *S = (TSweepPart*)arg;
+    S->Collisions.assign(S->end - S->begin, 0);
+    try {
+        for(unsigned int k=S->begin; k<S->end; k++) {
+            if(S->first && *S->found)
+                break;
+            const TRoboticPositionerList1::TCollisionPair& P = S->Pairs[k];
+            //the collision between actuators is not symmetric
+            //(an actuator with unknown position is represented by its barrier),
+            //so a reciprocal pair is determined in both senses
+            bool collision;
+            if(P.A == NULL)
+                collision = P.Actuator->thereIsCollision(P.EA);
+            else
+                collision = P.Actuator->thereIsCollision(P.A) ||
+                        (P.j >= 0 && P.A->thereIsCollision(P.Actuator));
+            if(collision) {
+                S->Collisions[k - S->begin] = 1;
+                __sync_lock_test_and_set(S->found, 1);
+            }
+        }
+    } catch(...) {
+        S->error = true;
+    }
+    return NULL;
+}
+
+//determine the collision of each pair, concurrently when they are many
+//  first: indicates if the sweep can finish at the first collision
+//return true if some pair collides
+bool TRoboticPositionerList1::sweepCollisions(vector<char>& Collisions,
+        const vector<TCollisionPair>& Pairs, bool first)
+{
+    //The pairs are distributed in consecutive parts, and each part
+    //is swept by a thread in its own buffer of results. The results
+    //are joined in the order of the parts, so they are independent
+    //of the number of threads. When there are few pairs, the cost
+    //of start the threads exceeds the gain, and they are swept
+    //by the calling thread.
+
+    //minimum number of pairs swept by each thread
+    static const unsigned int MinPart = 512;
+
+    //determine the number of parts
+    unsigned int N = Pairs.size();
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int parts = (processors > 1) ? (unsigned int)processors : 1;
+    parts = max(1u, min(parts, N/MinPart));
+
+    //distribute the pairs
+    volatile int found = 0;
+    vector<TSweepPart> Parts(parts);
+    for(unsigned int p=0; p<parts; p++) {
+        Parts[p].Pairs = N > 0 ? &Pairs[0] : NULL;
+        Parts[p].begin = (unsigned int)((unsigned long long)N*p/parts);
+        Parts[p].end = (unsigned int)((unsigned long long)N*(p + 1)/parts);
+        Parts[p].first = first;
+        Parts[p].found = &found;
+        Parts[p].error = false;
+    }
+
+    //sweep the parts, the first one in the calling thread
+    vector<pthread_t> Threads;
+    for(unsigned int p=1; p<parts; p++) {
+        pthread_t thread;
+        if(pthread_create(&thread, NULL, sweepPart, &Parts[p]) == 0)
+            Threads.push_back(thread);
         else
-            //desactiva la bandera para evitar que
-            //se vuelva a determinar la colisión
-            RP->getActuator()->Pending = false;
+            sweepPart(&Parts[p]);
+    }
+    sweepPart(&Parts[0]);
+    for(unsigned int t=0; t<Threads.size(); t++)
+        pthread_join(Threads[t], NULL);
+
+    //join the results in order
+    Collisions.clear();
+    Collisions.reserve(N);
+    for(unsigned int p=0; p<parts; p++) {
+        if(Parts[p].error)
+            throw EImpossibleError("error determining the collision of a pair of adjacent items");
+        Collisions.insert(Collisions.end(), Parts[p].Collisions.begin(), Parts[p].Collisions.end());
     }
+    Collisions.resize(N, 0);
+
+    return found != 0;
+}
+
+//determine the RPs of the list which collide with some adjacent
+//return the number of collided RPs
+int TRoboticPositionerList1::searchCollided(vector<bool>& Collided) const
+{
+    vector<TCollisionPair> Pairs;
+    getCollisionPairs(Pairs);
+    vector<char> Collisions;
+    sweepCollisions(Collisions, Pairs, false);
+
+    Collided.assign(getCount(), false);
+    for(unsigned int k=0; k<Pairs.size(); k++)
+        if(Collisions[k]) {
+            Collided[Pairs[k].i] = true;
+            if(Pairs[k].j >= 0)
+                Collided[Pairs[k].j] = true;
+        }
 
-    return false; //indica que no se ha encontrado invasión
+    int count = 0;
+    for(int i=0; i<getCount(); i++)
+        if(Collided[i])
+            count++;
+    return count;
+}
+
+//determina si algún actuador de algún RP colisiona con
+//algún actuador o barrera de algún RP o EA adyacente
+bool TRoboticPositionerList1::thereIsCollision(void)
+{
+    //determina la colisión de cada par de elementos adyacentes
+    //una sola vez, hasta encontrar una colisión
+    vector<TCollisionPair> Pairs;
+    getCollisionPairs(Pairs);
+    vector<char> Collisions;
+    return sweepCollisions(Collisions, Pairs, true);
 }
 //busca los RPs de la lista cuyo actuador colisiona con
 //algún actuador o barrera de algún RP o EA adyacente
@@ -1873,34 +2412,15 @@ void TRoboticPositionerList1::searchCollinding(TVector<int> &indices)
     //inicializa la salida
     indices.Clear();
 
-    //inicializa las banderas de determinación de colisión pendiente
-    enableAllPending();
-
-    //busca colisión del actuador de cada RP con algún actuador o barrera de RP o EA adyacente,
-    //exceptuando aquellos con los que se ha comprobado ya
-    for(int i= 0; i<getCount(); i++) {
-        //apunta el RP indicado para facilitar su acceso
-        TRoboticPositioner *RP = Items[i];
-        //si el actuador del posicionador indicado colisiona con
-        //el actuador o barrera de algún RP o EA adyacente con
-        //determinación de colisión pendiente
-        if(RP->getActuator()->thereIsCollisionWithPendingAdjacent()) {
-            //busca el índice en la lista de añadidos
-            int j = indices.Search(i);
-            //si la posición del posicionador no ha sido previamente agregada
-            if(j >= indices.getCount())
-                //añade el el índice a la lista de añadidos
-                indices.Add(i);
-        }
+    //determina la colisión de cada par de elementos adyacentes
+    //una sola vez
+    vector<bool> Collided;
+    searchCollided(Collided);
 
-        //desactiva la bandera para evitar que
-        //se vuelva a determinar la colisión
-        RP->getActuator()->Pending = false;
-    }
-
-    //ordena la lista de índices en sentido creciente
-    if(indices.getCount() > 1)
-        indices.SortInc(0, indices.getCount()-1);
+    //añade los índices en sentido creciente
+    for(int i=0; i<getCount(); i++)
+        if(Collided[i])
+            indices.Add(i);
 }
 /*//obtiene los conjuntos de RPs en colisión (Collision Cluster List)
 void TRoboticPositionerList1::getCollisionClusterList(TPointersList<TItemsList<TRoboticPositioner*> > &CCL)
@@ -29,6 +29,10 @@
 #include "PointersList.h"
 #include "PairPositionAngles.h"
 #include "MotionProgram.h"
+#include "AdjacencyGraph.h"
+
+#include <vector>
+#include <map>
 
 //---------------------------------------------------------------------------
 
@@ -67,6 +71,85 @@ protected:
     double p_Ret;
     double p_FiberDensity;
 
+    //INDEX OF THE RPs:
+
+    //position of the first RP with each identifier,
+    //indexed by identifier (-1 if there isn't RP with the identifier)
+    mutable vector<int> p_IdIndex;
+    //indicates if there are identifiers out of the index
+    mutable bool p_IdsOutOfIndex;
+    //position of each RP, indexed by pointer
+    mutable map<const TRoboticPositioner*, int> p_RPIndex;
+    //number of RPs indexed, or -1 if the index is invalid
+    mutable int p_IndexedCount;
+
+    //ADJACENCY GRAPH:
+
+    //graph of adjacency of the RPs of the list
+    mutable TAdjacencyGraph p_Adjacency;
+
+    //rebuild the index of the RPs
+    void buildIndex(void) const;
+    //add the RP in the position i to the index
+    void addToIndex(int i) const;
+    //search the first RP with an identifier in the index
+    //return -1 if the index doesn't correspond to the list
+    int searchIdInIndex(int Id) const;
+
+    //STATIC COLLISION SWEEP:
+
+public:
+    //pair of adjacent items whose collision shall be determined
+    struct TCollisionPair {
+        //position in the list of the RP
+        int i;
+        //actuator of the RP
+        TActuator *Actuator;
+        //actuator of the adjacent RP, or NULL if the adjacent is an EA
+        TActuator *A;
+        //adjacent EA, or NULL if the adjacent is a RP
+        TExclusionArea *EA;
+        //position in the list of the adjacent RP when it shall be
+        //marked as collided too, or -1
+        int j;
+    };
+
+protected:
+    //get the unique pairs of adjacent items of the RPs of the list
+    void getCollisionPairs(vector<TCollisionPair>& Pairs) const;
+    //determine the collision of each pair, concurrently when they are many
+    //  first: indicates if the sweep can finish at the first collision
+    //return true if some pair collides
+    static bool sweepCollisions(vector<char>& Collisions,
+                                const vector<TCollisionPair>& Pairs, bool first);
+    //determine the RPs of the list which collide with some adjacent
+    //return the number of collided RPs
+    int searchCollided(vector<bool>& Collided) const;
+
+    //ASSIGNMENT OF POSITIONS IN BATCH:
+
+    //buffers of the assignment of positions in batch,
+    //kept between calls for not allocate them in each call
+    struct TBatchBuffers {
+        //RPs to be moved and their positions in steps
+        vector<TRoboticPositioner*> RPs;
+        vector<double> p_1, p___3;
+        //positions in radians
+        vector<double> theta_1, theta___3;
+        //steps of the quantified rotors and their quantifiers
+        vector<double> x_1, x___3;
+        vector<const TQuantificator*> Q_1, Q___3;
+        //quantified steps
+        vector<int> n_1, n___3;
+    };
+    TBatchBuffers p_Batch;
+
+    //assign the positions in steps (p_Batch.p_1[k], p_Batch.p___3[k])
+    //to the RPs p_Batch.RPs[k], quantifying the angles of the rotors
+    //in batch, with the same result as:
+    //  p_Batch.RPs[k]->getActuator()->setAnglesSteps(p_Batch.p_1[k], p_Batch.p___3[k])
+    void setAnglesStepsInBatch(void);
+
 public:
     //TOLERANCE PROPERTIES:
 
@@ -278,9 +361,27 @@ public:
 
     //METHODS TO ADD OR DELETE RPs:
 
-    //Inherited methods:
-    //  Add(TRoboticPositioner *RP): dd a RP to the list.
-    //  Delete(int i): delete a RP of the list without destroy it.
+    //The inherited methods to add or delete RPs are redefined
+    //for keep the index of the RPs, which allows search the RPs
+    //by identifier or by pointer in constant time.
+
+    //add a RP to the list
+    void Add(TRoboticPositioner *RP);
+    //add the RPs of other list to the list
+    void Add(const TItemsList<TRoboticPositioner*>& RPL);
+    //insert a RP in the position i of the list
+    void Insert(int i, TRoboticPositioner *RP);
+    //delete a RP of the list without destroy it
+    void Delete(int i);
+    //delete all RPs of the list without destroy them
+    void Clear(void);
+
+    //invalidate the index of the RPs
+    void invalidateIndex(void) {p_IndexedCount = -1;}
+
+    //WARNING: when the list is modified through the methods of the
+    //base class, or when the identifier of a RP of the list is changed,
+    //the method invalidateIndex shall be called before searching a RP.
 
     //search and delete a RP of the list
     //return the position where the RP was found
@@ -376,6 +477,18 @@ public:
     //sentido levógiro empezando por el más próximo a 0
     void sortAdjacents(void);
 
+    //get the adjacency graph of the RPs of the list,
+    //building it if it has been invalidated
+    const TAdjacencyGraph& getAdjacency(void) const;
+    //invalidate the adjacency graph of the RPs
+    void invalidateAdjacency(void) {p_Adjacency.Clear();}
+
+    //The adjacency graph is invalidated when RPs are added or deleted
+    //and when the adjacents are determined or sorted, and it is rebuilt
+    //when the order of the RPs doesn't match the order of its nodes.
+    //When the lists of adjacents are modified from outside,
+    //invalidateAdjacency shall be called before getting the graph.
+
     //El método DetermineAdjacents() y los sucesivos
     //deberán ser invocados toda vez que se añadan o borren posicionadores,
     //o se modifique algún parámetro de posicionamiento o dimensionamiento,
@@ -583,6 +696,9 @@ public:
     //busca los RPs de la lista cuyo actuador colisiona con
     //algún actuador o barrera de algún RP o EA adyacente
     void searchCollinding(TVector<int> &indices);
+
+    //The collision of each pair of adjacent items is determined only once,
+    //concurrently when the list is large, and without use the flags Pending.
 /*    //obtiene los conjuntos de RPs en colisión (Collision Cluster List)
     void getCollisionClusterList(
             TPointersList<TItemsList<TRoboticPositioner*> > &CCL);
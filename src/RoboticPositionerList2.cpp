@@ -677,9 +677,7 @@ void TRoboticPositionerList2::copyCells(const TRoboticPositionerList2 *RPL)
             const TItemsList<TRoboticPositioner*> *RPs = RPL->p_Cells[i].GetPointer(j);
             for(int k=0; k<RPs->getCount(); k++) {
                 const TRoboticPositioner *RP = RPs->Get(k);
-                int l = 0;
-                while(l<getCount() && Items[l]->getActuator()->getId()!=RP->getActuator()->getId())
-                    l++;
+                int l = searchId(RP->getActuator()->getId());
                 p_Cells[i][j].Add(Items[l]);
             }
         }
@@ -856,9 +854,7 @@ void TRoboticPositionerList2::setMapCells(TPointersList<TPointersList<TItemsList
             TItemsList<TRoboticPositioner*> RPL = Cells[i][j];
             for(int k=0; k<RPL.getCount(); k++) {
                 TRoboticPositioner *RP = RPL.Get(k);
-                int l = 0;
-                while(l<getCount() && Items[l]!=RP)
-                    l++;
+                int l = search(RP);
                 if(l >= getCount())
                     throw EImproperArgument("all pointers to robotic positioners in the cell matrix should be in the list");
             }
@@ -880,6 +876,40 @@ void TRoboticPositionerList2::setMapCells(TPointersList<TPointersList<TItemsList
             p_Cells[i][j].Print = TRoboticPositioner::printId;
 }
 
+//access to the RP list of the cell (i, j) of the cell matrix
+const TItemsList<TRoboticPositioner*>& TRoboticPositionerList2::getMapCell(int i, int j) const
+{
+    //la celda (i, j) debería estar en la matriz de celdas
+    if(i<0 || getI()<=i || j<0 || getJ()<=j)
+        throw EImproperArgument("cell (i, j) should be in the cell matrix");
+
+    return p_Cells[i][j];
+}
+//set the content of the cell matrix from the indices in the list
+//of the RPs of each cell (Indices[i*J + j])
+void TRoboticPositionerList2::setMapCellsIndices(const vector<vector<int> >& Indices)
+{
+    //debería haber una lista de índices por cada celda
+    if(int(Indices.size()) != getI()*getJ())
+        throw EImproperArgument("number of lists of indices should be equal to number of cells");
+
+    //todos los índices deberían indicar a posicionadores de la lista
+    for(unsigned int k=0; k<Indices.size(); k++)
+        for(unsigned int l=0; l<Indices[k].size(); l++)
+            if(Indices[k][l]<0 || getCount()<=Indices[k][l])
+                throw EImproperArgument("all indices should point to robotic positioners in the list");
+
+    //asigna el contenido de cada celda
+    for(int i=0; i<getI(); i++)
+        for(int j=0; j<getJ(); j++) {
+            TItemsList<TRoboticPositioner*>& Cell = p_Cells[i][j];
+            const vector<int>& indices = Indices[i*getJ() + j];
+            Cell.Clear();
+            for(unsigned int l=0; l<indices.size(); l++)
+                Cell.Add(Items[indices[l]]);
+        }
+}
+
 //maps the RPs in the mapping interval
 void TRoboticPositionerList2::map(void)
 {
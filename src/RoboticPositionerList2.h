@@ -27,6 +27,8 @@
 
 #include "RoboticPositionerList1.h"
 
+#include <vector>
+
 //---------------------------------------------------------------------------
 
 //namespace for models
@@ -222,6 +224,12 @@ public:
     void setMapDimensions(int I, int J);
     //set the content of the cell matrix
     void setMapCells(TPointersList<TPointersList<TItemsList<TRoboticPositioner*> > > &_Cells);
+    //access to the RP list of the cell (i, j) of the cell matrix
+    const TItemsList<TRoboticPositioner*>& getMapCell(int i, int j) const;
+    //set the content of the cell matrix from the indices in the list
+    //of the RPs of each cell (Indices[i*J + j]), instead of map the RPs
+    //(used for restore a map previously generated)
+    void setMapCellsIndices(const vector<vector<int> >& Indices);
 
     //maps the RPs in the mapping interval
     void map(void);
@@ -711,10 +711,27 @@ void TRoboticPositionerList::invertTime(void)
 //por las funciones de movimiento en el instante t
 void TRoboticPositionerList::move(double t)
 {
+        //los RPs con los dos rotores programados se mueven en lote,
+        //cuantificando conjuntamente sus posiciones
+        p_Batch.RPs.clear();
+        p_Batch.p_1.clear();
+        p_Batch.p___3.clear();
+
         //por cada RP de la lista
-        for(int i=0; i<getCount(); i++)
-                //mueve el RP a su posición correspondiente al instante t
-                Items[i]->move(t);
+        for(int i=0; i<getCount(); i++) {
+                TRoboticPositioner *RP = Items[i];
+                if(RP->CMF.getMF1()!=NULL && RP->CMF.getMF2()!=NULL) {
+                        //añade el RP y su posición correspondiente al instante t al lote
+                        p_Batch.RPs.push_back(RP);
+                        p_Batch.p_1.push_back(RP->CMF.MF1p(t));
+                        p_Batch.p___3.push_back(RP->CMF.MF2p(t));
+                } else
+                        //mueve el RP a su posición correspondiente al instante t
+                        RP->move(t);
+        }
+
+        //mueve los RPs del lote
+        setAnglesStepsInBatch();
 }
 
 //mueve los RPs a sus posiciones inciales
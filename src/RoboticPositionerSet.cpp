@@ -0,0 +1,250 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: RoboticPositionerSet.cpp
+//Content: set of RPs with membership in constant time
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "RoboticPositionerSet.h"
+#include "RoboticPositionerList1.h"
+
+#include <algorithm> //std::max, std::find
+
+//---------------------------------------------------------------------------
+
+//namespace for models
+namespace Models {
+
+//---------------------------------------------------------------------------
+//TRoboticPositionerSet
+//---------------------------------------------------------------------------
+
+//build a set with the RPs of a list
+TRoboticPositionerSet::TRoboticPositionerSet(const TItemsList<TRoboticPositioner*>& RPL) :
+    p_Bits(), p_RPs(), p_Others(), p_Count(0)
+{
+    insert(RPL);
+}
+
+//METHODS TO SEARCH RPs:
+
+//determines if the set contains a RP
+bool TRoboticPositionerSet::contains(const TRoboticPositioner *RP) const
+{
+    if(RP == NULL)
+        return false;
+
+    int Id = RP->getActuator()->getId();
+    if(isSet(Id) && p_RPs[Id] == RP)
+        return true;
+
+    //search the RP among the RPs with duplicated identifier
+    return find(p_Others.begin(), p_Others.end(), RP) != p_Others.end();
+}
+
+//METHODS TO TRAVERSE THE SET:
+
+//get the next identifier of the set after an identifier,
+//or -1 if there isn't more identifiers
+int TRoboticPositionerSet::nextId(int Id) const
+{
+    int first = Id + 1;
+    if(first < 0)
+        first = 0;
+    if(first >= int(p_RPs.size()))
+        return -1;
+
+    //search the first word with some bit set, starting from the bit first
+    int w = first >> 5;
+    unsigned int bits = p_Bits[w] & (~0u << (first & 31));
+    while(bits == 0) {
+        w++;
+        if(w >= int(p_Bits.size()))
+            return -1;
+        bits = p_Bits[w];
+    }
+
+    return (w << 5) + __builtin_ctz(bits);
+}
+
+//METHODS TO INSERT OR ERASE RPs:
+
+//insert a RP in the set
+//returns false if the set already contains the RP
+bool TRoboticPositionerSet::insert(TRoboticPositioner *RP)
+{
+    //check the precondition
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
+
+    int Id = RP->getActuator()->getId();
+    if(Id < 0)
+        throw EImproperArgument("identifier of the RP should be nonnegative");
+
+    //if the set contains other RP with the identifier,
+    //keep the RP apart
+    if(isSet(Id)) {
+        if(p_RPs[Id]==RP || contains(RP))
+            return false;
+        p_Others.push_back(RP);
+        p_Count++;
+        return true;
+    }
+
+    //grow the set to contain the identifier
+    if(Id >= int(p_RPs.size())) {
+        p_RPs.resize(Id + 1, (TRoboticPositioner*)NULL);
+        p_Bits.resize((Id >> 5) + 1, 0u);
+    }
+
+    //insert the RP
+    p_Bits[Id >> 5] |= 1u << (Id & 31);
+    p_RPs[Id] = RP;
+    p_Count++;
+
+    return true;
+}
+//insert the RPs of a list in the set
+void TRoboticPositionerSet::insert(const TItemsList<TRoboticPositioner*>& RPL)
+{
+    for(int i=0; i<RPL.getCount(); i++)
+        insert(RPL[i]);
+}
+//erase a RP from the set
+//returns false if the set not contains the RP
+bool TRoboticPositionerSet::erase(const TRoboticPositioner *RP)
+{
+    if(RP == NULL)
+        return false;
+
+    int Id = RP->getActuator()->getId();
+
+    //if the RP is kept apart, erase it from the RPs with duplicated identifier
+    if(!isSet(Id) || p_RPs[Id]!=RP) {
+        vector<TRoboticPositioner*>::iterator it = find(p_Others.begin(), p_Others.end(), RP);
+        if(it == p_Others.end())
+            return false;
+        p_Others.erase(it);
+        p_Count--;
+        return true;
+    }
+
+    //erase the RP
+    p_Bits[Id >> 5] &= ~(1u << (Id & 31));
+    p_RPs[Id] = NULL;
+    p_Count--;
+
+    //replace it by other RP with the same identifier, if any
+    for(vector<TRoboticPositioner*>::iterator it=p_Others.begin(); it!=p_Others.end(); it++)
+        if((*it)->getActuator()->getId() == Id) {
+            p_Bits[Id >> 5] |= 1u << (Id & 31);
+            p_RPs[Id] = *it;
+            p_Others.erase(it);
+            break;
+        }
+
+    return true;
+}
+//erase the RPs of a list from the set
+void TRoboticPositionerSet::erase(const TItemsList<TRoboticPositioner*>& RPL)
+{
+    for(int i=0; i<RPL.getCount(); i++)
+        erase(RPL[i]);
+}
+//erase all RPs of the set
+void TRoboticPositionerSet::Clear(void)
+{
+    p_Bits.clear();
+    p_RPs.clear();
+    p_Others.clear();
+    p_Count = 0;
+}
+
+//SET OPERATIONS:
+
+//insert the RPs of other set
+void TRoboticPositionerSet::unite(const TRoboticPositionerSet& S)
+{
+    for(int Id=S.firstId(); Id>=0; Id=S.nextId(Id))
+        insert(S.p_RPs[Id]);
+    for(unsigned int k=0; k<S.p_Others.size(); k++)
+        insert(S.p_Others[k]);
+}
+//erase the RPs contained in other set
+void TRoboticPositionerSet::subtract(const TRoboticPositionerSet& S)
+{
+    for(int Id=S.firstId(); Id>=0; Id=S.nextId(Id))
+        erase(S.p_RPs[Id]);
+    for(unsigned int k=0; k<S.p_Others.size(); k++)
+        erase(S.p_Others[k]);
+}
+//erase the RPs not contained in other set
+void TRoboticPositionerSet::intersect(const TRoboticPositionerSet& S)
+{
+    //the RPs kept apart are filtered first, because when a RP is erased,
+    //other RP with the same identifier could replace it
+    unsigned int k = 0;
+    while(k < p_Others.size()) {
+        if(S.contains(p_Others[k]))
+            k++;
+        else
+            erase(p_Others[k]);
+    }
+    for(int Id=firstId(); Id>=0; Id=nextId(Id))
+        if(!S.contains(p_RPs[Id]))
+            erase(p_RPs[Id]);
+}
+
+//INTEROPERATION WITH RP LISTS:
+
+//get the RPs of the set in a list, sorted by identifier
+void TRoboticPositionerSet::getList(TRoboticPositionerList1& RPL) const
+{
+    RPL.Clear();
+    for(int Id=firstId(); Id>=0; Id=nextId(Id))
+        RPL.Add(p_RPs[Id]);
+
+    //the RPs kept apart are inserted after the RP with their identifier
+    for(unsigned int k=0; k<p_Others.size(); k++) {
+        int Id = p_Others[k]->getActuator()->getId();
+        int i = 0;
+        while(i<RPL.getCount() && RPL[i]->getActuator()->getId()<=Id)
+            i++;
+        RPL.Insert(i, p_Others[k]);
+    }
+}
+//delete from a list the RPs not contained in the set,
+//keeping the order of the list
+void TRoboticPositionerSet::retainIn(TRoboticPositionerList1& RPL) const
+{
+    TItemsList<TRoboticPositioner*> Retained(max(1, RPL.getCount()));
+    for(int i=0; i<RPL.getCount(); i++)
+        if(contains(RPL[i]))
+            Retained.Add(RPL[i]);
+
+    RPL.Clear();
+    RPL.Add(Retained);
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
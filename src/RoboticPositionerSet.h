@@ -0,0 +1,153 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: RoboticPositionerSet.h
+//Content: set of RPs with membership in constant time
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef ROBOTICPOSITIONERSET_H
+#define ROBOTICPOSITIONERSET_H
+
+#include "ItemsList.h"
+
+#include <vector>
+
+using namespace std;
+using namespace Lists;
+
+//---------------------------------------------------------------------------
+
+//namespace for models
+namespace Models {
+
+class TRoboticPositioner;
+class TRoboticPositionerList1;
+
+//---------------------------------------------------------------------------
+//TRoboticPositionerSet
+//---------------------------------------------------------------------------
+
+//The RP set contains pointers to RPs indexed by their identifiers:
+//a bit per identifier indicates the membership, so the RPs can be
+//searched, inserted and erased in constant time, and the set is
+//traversed in increasing order of identifier. E.g:
+//
+//  for(int Id=S.firstId(); Id>=0; Id=S.nextId(Id)) {
+//      TRoboticPositioner *RP = S.getById(Id);
+//      ...
+//  }
+//
+//The identifiers of the RPs of a Fiber MOS Model are usually different,
+//but the model allows duplicated identifiers. When a RP is inserted
+//with the identifier of other RP of the set, it is kept apart in a list
+//searched sequentially, so the set stays correct, and it is only slower
+//in the unusual case of duplicated identifiers. The RPs kept apart are
+//not traversed by identifier, but they are included in the operations
+//and in the lists. The space used by the set is proportional to
+//the maximun identifier.
+
+//class RP set
+class TRoboticPositionerSet {
+    //bits indicating the identifiers contained in the set
+    vector<unsigned int> p_Bits;
+    //RP contained in the set for each identifier (or NULL)
+    vector<TRoboticPositioner*> p_RPs;
+    //RPs of the set whose identifier is used by other RP of the set
+    vector<TRoboticPositioner*> p_Others;
+    //number of RPs of the set
+    int p_Count;
+
+    //determines if the bit of an identifier is set
+    bool isSet(int Id) const {
+        return Id>=0 && Id<int(p_RPs.size()) &&
+                (p_Bits[Id>>5] & (1u << (Id & 31))) != 0;
+    }
+
+public:
+    //number of RPs of the set
+    int getCount(void) const {return p_Count;}
+    //determines if the set is empty
+    bool isEmpty(void) const {return p_Count <= 0;}
+
+    //build an empty set
+    TRoboticPositionerSet(void) : p_Bits(), p_RPs(), p_Others(), p_Count(0) {;}
+    //build a set with the RPs of a list
+    TRoboticPositionerSet(const TItemsList<TRoboticPositioner*>& RPL);
+
+    //METHODS TO SEARCH RPs:
+
+    //determines if the set contains a RP
+    bool contains(const TRoboticPositioner *RP) const;
+    //determines if the set contains a RP with an identifier
+    bool containsId(int Id) const {return isSet(Id);}
+    //get the first RP inserted in the set with an identifier, or NULL
+    TRoboticPositioner *getById(int Id) const {
+        return isSet(Id) ? p_RPs[Id] : NULL;
+    }
+
+    //METHODS TO TRAVERSE THE SET:
+
+    //get the first identifier of the set, or -1 if the set is empty
+    int firstId(void) const {return nextId(-1);}
+    //get the next identifier of the set after an identifier,
+    //or -1 if there isn't more identifiers
+    int nextId(int Id) const;
+
+    //METHODS TO INSERT OR ERASE RPs:
+
+    //insert a RP in the set
+    //returns false if the set already contains the RP
+    //if the identifier of the RP is negative:
+    //  throw an exception EImproperArgument
+    bool insert(TRoboticPositioner *RP);
+    //insert the RPs of a list in the set
+    void insert(const TItemsList<TRoboticPositioner*>& RPL);
+    //erase a RP from the set
+    //returns false if the set not contains the RP
+    bool erase(const TRoboticPositioner *RP);
+    //erase the RPs of a list from the set
+    void erase(const TItemsList<TRoboticPositioner*>& RPL);
+    //erase all RPs of the set
+    void Clear(void);
+
+    //SET OPERATIONS:
+
+    //insert the RPs of other set
+    void unite(const TRoboticPositionerSet& S);
+    //erase the RPs contained in other set
+    void subtract(const TRoboticPositionerSet& S);
+    //erase the RPs not contained in other set
+    void intersect(const TRoboticPositionerSet& S);
+
+    //INTEROPERATION WITH RP LISTS:
+
+    //get the RPs of the set in a list, sorted by identifier
+    void getList(TRoboticPositionerList1& RPL) const;
+    //delete from a list the RPs not contained in the set,
+    //keeping the order of the list
+    void retainIn(TRoboticPositionerList1& RPL) const;
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
+#endif // ROBOTICPOSITIONERSET_H
@@ -0,0 +1,140 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: SharedItem.h
+//Content: template for item shared with copy-on-write
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef SHAREDITEM_H
+#define SHAREDITEM_H
+
+#include <cstddef> //NULL
+
+//---------------------------------------------------------------------------
+
+//namespace for lists
+namespace Lists {
+
+//---------------------------------------------------------------------------
+//class TSharedItem
+//---------------------------------------------------------------------------
+
+//The shared item allows several objects to refer to the same item
+//(like the templates of the RPs), instead of each object contain its
+//own copy. The item is copied only when it is going to be modified
+//by an object and it is shared with others (copy-on-write), and it
+//is destroyed with the last reference.
+//
+//The counter of references is atomic, so the objects which share
+//an item can be copied and destroyed from different threads.
+//But a same shared item shall not be modified from several threads.
+//
+//The type T shall have a default constructor and a method Clone(const T&).
+
+//class item shared with copy-on-write
+template <class T> class TSharedItem {
+    //node containing the item and the number of references to it
+    class TNode {
+    public:
+        T Item;
+        int Refs;
+        //function to free the dynamic memory referenced by the item
+        void (*Free)(T&);
+
+        TNode(void (*t_Free)(T&)) : Item(), Refs(1), Free(t_Free) {;}
+        ~TNode() {if(Free != NULL) Free(Item);}
+    };
+
+    //node of the shared item
+    TNode *p_Node;
+
+    //release the reference to the node
+    void release(void) {
+        if(__sync_sub_and_fetch(&p_Node->Refs, 1) == 0)
+            delete p_Node;
+        p_Node = NULL;
+    }
+
+public:
+    //number of references to the item (including this)
+    int getRefs(void) const {return p_Node->Refs;}
+    //determines if the item is shared with other objects
+    bool isShared(void) const {return getRefs() > 1;}
+    //determines if the item is shared with other shared item
+    bool sharesWith(const TSharedItem& SI) const {return p_Node == SI.p_Node;}
+
+    //build a shared item with an item by default
+    //  Free: function to free the dynamic memory referenced by the item
+    //      when it is destroyed, or NULL
+    TSharedItem(void (*Free)(T&)=NULL) : p_Node(new TNode(Free)) {;}
+    //build a shared item sharing the item of other shared item
+    TSharedItem(const TSharedItem& SI) : p_Node(SI.p_Node) {
+        __sync_add_and_fetch(&p_Node->Refs, 1);
+    }
+    //release the reference to the item
+    ~TSharedItem() {release();}
+
+    //share the item of other shared item
+    TSharedItem& operator=(const TSharedItem& SI) {
+        if(p_Node != SI.p_Node) {
+            __sync_add_and_fetch(&SI.p_Node->Refs, 1);
+            release();
+            p_Node = SI.p_Node;
+        }
+        return *this;
+    }
+
+    //access to the item for read it
+    const T& get(void) const {return p_Node->Item;}
+
+    //access to the item for modify it,
+    //copying the item if it is shared
+    T& getWritable(void) {
+        if(isShared()) {
+            TNode *N = new TNode(p_Node->Free);
+            try {
+                N->Item.Clone(p_Node->Item);
+            } catch(...) {
+                delete N;
+                throw;
+            }
+            release();
+            p_Node = N;
+        }
+        return p_Node->Item;
+    }
+    //access to the item for replace it completely,
+    //building a new item by default if it is shared
+    T& renew(void) {
+        if(isShared()) {
+            TNode *N = new TNode(p_Node->Free);
+            release();
+            p_Node = N;
+        }
+        return p_Node->Item;
+    }
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Lists
+
+//---------------------------------------------------------------------------
+#endif // SHAREDITEM_H
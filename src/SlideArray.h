@@ -27,6 +27,18 @@
 
 #include "Exceptions.h"
 
+#include <algorithm> //std::swap
+
+//the elements are moved instead of copied when the compiler
+//supports the move semantics
+#if __cplusplus >= 201103L
+#include <utility> //std::move, std::forward
+#define FMPT_MOVE(x) std::move(x)
+#define FMPT_MOVE_SEMANTICS
+#else
+#define FMPT_MOVE(x) (x)
+#endif
+
 //---------------------------------------------------------------------------
 
 //namespace for lists
@@ -76,7 +88,22 @@ public:
     //construye un clon de un array deslizante
     TSlideArray(TSlideArray &SA);
     //libera la memoria ocupada por el array deslizante
-    ~TSlideArray() {delete Items;}
+    ~TSlideArray() {delete[] Items;}
+
+    //clona un array deslizante
+    TSlideArray& operator=(const TSlideArray& SA) {Clone(SA); return *this;}
+
+#ifdef FMPT_MOVE_SEMANTICS
+    //construye un array deslizante tomando los elementos de otro,
+    //que queda vacío y sin capacidad
+    TSlideArray(TSlideArray&& SA);
+    //intercambia los elementos con otro array deslizante
+    TSlideArray& operator=(TSlideArray&& SA) {swap(SA); return *this;}
+#endif
+
+    //intercambia todas las propiedades con otro array deslizante,
+    //sin copiar los elementos
+    void swap(TSlideArray& SA);
 
     //ACCESO A ELEMENTOS:
 
@@ -117,6 +144,13 @@ public:
     //inserta un elemento en la posición indicada
     void Insert(int i, const T &item);
 
+#ifdef FMPT_MOVE_SEMANTICS
+    //añade un elemento por el final moviéndolo
+    void AddLast(T&& item);
+    //construye un elemento por el final con los argumentos indicados
+    template <class... Args> T& EmplaceLast(Args&&... args);
+#endif
+
     //COPIADO:
 
     //clona todas las propiedades del array incluidos sus elementos
@@ -138,23 +172,23 @@ template <class T> void TSlideArray<T>::setCapacity(int Capacity)
     //construye un nuevo array
     T *NewItems = new T[Capacity];
 
-    //copia los elementos en el nuevo array
+    //mueve los elementos al nuevo array
     if(p_Count) {
         int i = p_ifirst; //índice para Items
         int j=0; //índice para NewItems
         if(p_ifirst <= p_ilast)
             for(; i<=p_ilast; i++)
-                NewItems[j++] = Items[i];
+                NewItems[j++] = FMPT_MOVE(Items[i]);
         else {
             for(; i<p_Capacity; i++)
-                NewItems[j++] = Items[i];
+                NewItems[j++] = FMPT_MOVE(Items[i]);
             for(i=0; i<=p_ilast; i++)
-                NewItems[j++] = Items[i];
+                NewItems[j++] = FMPT_MOVE(Items[i]);
         }
     }
 
     //apunta el nuevo array
-    delete Items;
+    delete[] Items;
     Items = NewItems;
     p_Capacity = Capacity;
 
@@ -239,9 +273,39 @@ template <class T> TSlideArray<T>::TSlideArray(TSlideArray &SA)
     //reserva el array
     Items = new T[p_Capacity];
 
-    //copia los elementos
-    for(int i=0; i<p_Capacity; i++)
-        Items[i] = SA.Items[i];
+    //copia los elementos reservados
+    for(int i=0, j=p_ifirst; i<p_Count; i++) {
+        Items[j] = SA.Items[j];
+        if(++j >= p_Capacity)
+            j = 0;
+    }
+}
+
+#ifdef FMPT_MOVE_SEMANTICS
+//construye un array deslizante tomando los elementos de otro,
+//que queda vacío y sin capacidad
+template <class T> TSlideArray<T>::TSlideArray(TSlideArray&& SA) :
+    p_Capacity(SA.p_Capacity), p_Count(SA.p_Count),
+    p_ifirst(SA.p_ifirst), p_ilast(SA.p_ilast),
+    Items(SA.Items)
+{
+    SA.p_Capacity = 0;
+    SA.p_Count = 0;
+    SA.p_ifirst = 0;
+    SA.p_ilast = -1;
+    SA.Items = NULL;
+}
+#endif
+
+//intercambia todas las propiedades con otro array deslizante,
+//sin copiar los elementos
+template <class T> void TSlideArray<T>::swap(TSlideArray& SA)
+{
+    std::swap(p_Capacity, SA.p_Capacity);
+    std::swap(p_Count, SA.p_Count);
+    std::swap(p_ifirst, SA.p_ifirst);
+    std::swap(p_ilast, SA.p_ilast);
+    std::swap(Items, SA.Items);
 }
 
 //---------------------------------------------------------------------------
@@ -431,6 +495,27 @@ template <class T> void TSlideArray<T>::AddFirst(const T &item)
     //apunta el elemento
     Set(0, item);
 }
+#ifdef FMPT_MOVE_SEMANTICS
+//añade un elemento por el final moviéndolo
+template <class T> void TSlideArray<T>::AddLast(T&& item)
+{
+    //reserva un elemento por el final
+    NewLast();
+    //mueve el elemento
+    Items[p_ilast] = std::move(item);
+}
+//construye un elemento por el final con los argumentos indicados
+template <class T> template <class... Args>
+T& TSlideArray<T>::EmplaceLast(Args&&... args)
+{
+    //reserva un elemento por el final
+    NewLast();
+    //construye el elemento en su posición
+    Items[p_ilast] = T(std::forward<Args>(args)...);
+    return Items[p_ilast];
+}
+#endif
+
 //inserta un elemento en la posición indicada
 template <class T> void TSlideArray<T>::Insert(int i, const T &item)
 {
@@ -446,13 +531,13 @@ template <class T> void TSlideArray<T>::Insert(int i, const T &item)
         NewFirst();
         //Desplaza los elementos
         for(int j=0; j<i; j++)
-            Set(j, Get(j+1));
+            (*this)[j] = FMPT_MOVE((*this)[j+1]);
     } else { //el elemento está en la segunda mitad
         //reserva un elemento por el final
         NewLast();
         //Desplaza los elementos
         for(int j=p_Count-1; j>i; j--)
-            Set(j, Get(j-1));
+            (*this)[j] = FMPT_MOVE((*this)[j-1]);
     }
 
     //asigna el elemento
@@ -465,9 +550,13 @@ template <class T> void TSlideArray<T>::Insert(int i, const T &item)
 //clona todas las propiedades del array incluidos sus elementos
 template <class T> void TSlideArray<T>::Clone(const TSlideArray& SA)
 {
+    //un array deslizante es clon de sí mismo
+    if(&SA == this)
+        return;
+
     //cambia la longitud del array
     if(p_Capacity != SA.p_Capacity) {
-        delete Items;
+        delete[] Items;
         Items = new T[SA.p_Capacity];
     }
 
@@ -477,9 +566,12 @@ template <class T> void TSlideArray<T>::Clone(const TSlideArray& SA)
     p_ifirst = SA.p_ifirst;
     p_ilast = SA.p_ilast;
 
-    //copia los elementos
-    for(int i=0; i<p_Capacity; i++)
-        Items[i] = SA.Items[i];
+    //copia los elementos reservados
+    for(int i=0, j=p_ifirst; i<p_Count; i++) {
+        Items[j] = SA.Items[j];
+        if(++j >= p_Capacity)
+            j = 0;
+    }
 }
 //equipara el número de elementos reservados del array y los copia
 template <class T> void TSlideArray<T>::Copy(const TSlideArray& SA)
@@ -0,0 +1,210 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: SmallList.h
+//Content: template for small list with inline storage
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef SMALLLIST_H
+#define SMALLLIST_H
+
+#include "SlideArray.h" //FMPT_MOVE
+#include "Exceptions.h"
+
+//---------------------------------------------------------------------------
+
+//namespace for lists
+namespace Lists {
+
+//---------------------------------------------------------------------------
+//class TSmallList
+//---------------------------------------------------------------------------
+
+//The small list contains its items by value and contiguously, like
+//an array. The first N items are stored inside the list itself,
+//so a list which doesn't exceed N items doesn't use dynamic memory,
+//and its items are in the same cache lines than the list. When the
+//list exceed N items, they are moved to a dynamic array, which grows
+//doubling its capacity.
+//
+//The type T shall have a default constructor and the operator '='.
+
+//class small list with N items of inline storage
+template <class T, int N> class TSmallList {
+protected:
+    //inline storage of the items
+    T p_Buffer[N];
+    //array of items, which is the inline storage or a dynamic array
+    T *p_Items;
+    //number of items of the list
+    int p_Count;
+    //number of items which can contain the array
+    int p_Capacity;
+
+    //determines if the items are in the inline storage
+    bool isInline(void) const {return p_Items == p_Buffer;}
+
+public:
+    //number of items which can contain the list without grow
+    int getCapacity(void) const {return p_Capacity;}
+    //number of items of the list
+    int getCount(void) const {return p_Count;}
+
+    //build an empty list
+    TSmallList(void) : p_Items(p_Buffer), p_Count(0), p_Capacity(N) {;}
+    //build a copy of a list
+    TSmallList(const TSmallList& L) : p_Items(p_Buffer), p_Count(0), p_Capacity(N) {
+        Clone(L);
+    }
+    //free the dynamic array if any
+    ~TSmallList() {
+        if(!isInline())
+            delete[] p_Items;
+    }
+
+    //copy the items of a list
+    void Clone(const TSmallList& L);
+    //copy the items of a list
+    TSmallList& operator=(const TSmallList& L) {Clone(L); return *this;}
+    //exchange the items with other list
+    void swap(TSmallList& L);
+
+    //reserve space for Capacity items
+    void setCapacity(int Capacity);
+
+    //access to the indicated item
+    inline T& operator[](int i);
+    inline const T& operator[](int i) const;
+
+    //add an item at the end of the list
+    void Add(const T& item);
+    //delete the indicated item
+    void Delete(int i);
+    //delete all items of the list
+    void Clear(void) {p_Count = 0;}
+
+    //NOTE: the items deleted are not destroyed until the list
+    //is destroyed, or they are overwritten by new items.
+};
+
+//---------------------------------------------------------------------------
+//Methods of the class TSmallList:
+//---------------------------------------------------------------------------
+
+//copy the items of a list
+template <class T, int N> void TSmallList<T, N>::Clone(const TSmallList& L)
+{
+    if(&L == this)
+        return;
+
+    setCapacity(L.p_Count);
+    for(int i=0; i<L.p_Count; i++)
+        p_Items[i] = L.p_Items[i];
+    p_Count = L.p_Count;
+}
+//exchange the items with other list
+template <class T, int N> void TSmallList<T, N>::swap(TSmallList& L)
+{
+    //if both lists have dynamic arrays, only exchange the arrays
+    if(!isInline() && !L.isInline()) {
+        std::swap(p_Items, L.p_Items);
+        std::swap(p_Count, L.p_Count);
+        std::swap(p_Capacity, L.p_Capacity);
+        return;
+    }
+
+    //else exchange the items
+    TSmallList aux(L);
+    L = *this;
+    *this = aux;
+}
+
+//reserve space for Capacity items
+template <class T, int N> void TSmallList<T, N>::setCapacity(int Capacity)
+{
+    //if there is space enough, do nothing
+    if(Capacity <= p_Capacity)
+        return;
+
+    //build a new array with the double capacity almost
+    int NewCapacity = 2*p_Capacity;
+    if(NewCapacity < Capacity)
+        NewCapacity = Capacity;
+    T *NewItems = new T[NewCapacity];
+
+    //move the items to the new array
+    for(int i=0; i<p_Count; i++)
+        NewItems[i] = FMPT_MOVE(p_Items[i]);
+
+    //point the new array
+    if(!isInline())
+        delete[] p_Items;
+    p_Items = NewItems;
+    p_Capacity = NewCapacity;
+}
+
+//access to the indicated item
+template <class T, int N> inline T& TSmallList<T, N>::operator[](int i)
+{
+    //the index i should indicate an item of the list
+    if(i<0 || p_Count<=i)
+        throw EImproperArgument("index i should indicate an item of the list");
+
+    return p_Items[i];
+}
+template <class T, int N> inline const T& TSmallList<T, N>::operator[](int i) const
+{
+    //the index i should indicate an item of the list
+    if(i<0 || p_Count<=i)
+        throw EImproperArgument("index i should indicate an item of the list");
+
+    return p_Items[i];
+}
+
+//add an item at the end of the list
+template <class T, int N> void TSmallList<T, N>::Add(const T& item)
+{
+    //the item could be in the list
+    if(p_Count >= p_Capacity) {
+        T aux(item);
+        setCapacity(p_Count + 1);
+        p_Items[p_Count++] = aux;
+    } else
+        p_Items[p_Count++] = item;
+}
+//delete the indicated item
+template <class T, int N> void TSmallList<T, N>::Delete(int i)
+{
+    //the index i should indicate an item of the list
+    if(i<0 || p_Count<=i)
+        throw EImproperArgument("index i should indicate an item of the list");
+
+    //displace the next items
+    for(int j=i+1; j<p_Count; j++)
+        p_Items[j-1] = FMPT_MOVE(p_Items[j]);
+    p_Count--;
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Lists
+
+//---------------------------------------------------------------------------
+#endif // SMALLLIST_H
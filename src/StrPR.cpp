@@ -30,6 +30,8 @@
 #include <iostream> //ostringstream
 #include <iomanip> //put_time
 #include <ctime> //strftime
+#include <sstream> //istringstream
+#include <locale> //locale::classic
 
 //---------------------------------------------------------------------------
 
@@ -938,13 +940,38 @@ void strTravelSeparatorsIfAny(const string& str, unsigned int& i)
 //---------------------------------------------------------------------------
 //CONVERSION FUNCTIONS:
 
-//read an integer in the indicated position of a string
-void strReadIntStr(string& dst, const string& src, unsigned int& i)
+//The numeric values are segregated by a scanner, which only determines
+//the limits [first, last) of the value in the source string, and are
+//converted in place from the source string (without temporary strings),
+//using always '.' as decimal separator, independently of the locale.
+
+//travel the separators from the indicated position of a buffer
+//(like strTravelSeparatorsIfAny)
+static void travelSeparatorsIfAny(const char *src, unsigned int length,
+                                  unsigned int& i)
+{
+    while(i < length) {
+        if(src[i]==' ' || src[i]=='\t')
+            i++;
+        else if(src[i]=='\r' && i+1==length)
+            i++;
+        else if(src[i]=='\r' && src[i+1]=='\n')
+            i += 2;
+        else
+            break;
+    }
+}
+
+//scan an integer in the indicated position of a buffer
+//and get the limits [first, last) of the value
+static void strScanInt(unsigned int& first, unsigned int& last,
+                       const char *src, unsigned int length,
+                       unsigned int& i)
 {
     //Note that it is not required that source string is printable.
 
     //check the precondition
-    if(i > src.length())
+    if(i > length)
         throw EImproperArgument("index i should indicate a position of the string src");
 
     //reading status:
@@ -955,12 +982,13 @@ void strReadIntStr(string& dst, const string& src, unsigned int& i)
     //  4: value readed successfully
     int status = 0;
 
-    //tampon variable
-    string t_dst;
+    //tampon variables
+    unsigned int t_first = i;
+    unsigned int t_last = i;
 
     do {
         //if the index i indicates a char of the source string
-        if(i < src.length()) {
+        if(i < length) {
             char c = src[i++]; //get the next char
 
             //reacts according the status and the char
@@ -971,11 +999,13 @@ void strReadIntStr(string& dst, const string& src, unsigned int& i)
                 else if(c == '\r')
                     status++;
                 else if(c=='+' || c=='-') {
-                    t_dst += c;
+                    t_first = i - 1;
+                    t_last = i;
                     status = 2;
                 }
                 else if('0'<=c && c<='9') {
-                    t_dst += c;
+                    t_first = i - 1;
+                    t_last = i;
                     status = 3;
                 }
                 else
@@ -993,7 +1023,7 @@ void strReadIntStr(string& dst, const string& src, unsigned int& i)
                 if(c<'0' || '9'<c)
                     throw EImproperArgument("integer value not found");
                 else {
-                    t_dst += c;
+                    t_last = i;
                     status++;
                 }
                 break;
@@ -1003,7 +1033,7 @@ void strReadIntStr(string& dst, const string& src, unsigned int& i)
                     i--;
                     status++;
                 } else
-                    t_dst += c;
+                    t_last = i;
                 break;
 
             default:
@@ -1038,38 +1068,61 @@ void strReadIntStr(string& dst, const string& src, unsigned int& i)
     } while(status < 4);
 
     //set the tampon variables
-    dst = t_dst;
+    first = t_first;
+    last = t_last;
+}
+//convert the chars [first, last) of a string to int
+//if the chars can't be converted completely:
+//  throw EImproperArgument
+static int convertToInt(const char *first, const char *last)
+{
+    //the leading '+' is accepted by the scanner but not by from_chars
+    if(first<last && *first=='+')
+        first++;
+
+    int value = 0;
+#ifdef FMPT_CHARCONV
+    from_chars_result result = from_chars(first, last, value);
+    if(result.ec!=errc() || result.ptr!=last)
+        throw EImproperArgument(AnsiString("can't convert string to int"));
+#else
+    istringstream ss(string(first, last));
+    ss.imbue(locale::classic());
+    if(!bool(ss >> value) || !ss.eof())
+        throw EImproperArgument(AnsiString("can't convert string to int"));
+#endif
+    return value;
+}
+
+//read an integer in the indicated position of a string
+void strReadIntStr(string& dst, const string& src, unsigned int& i)
+{
+    unsigned int first, last;
+    strScanInt(first, last, src.data(), src.length(), i);
+    dst.assign(src, first, last - first);
 }
 //translate from string to int
 int strToInt(const string& str)
+{
+    return strToInt(str.data(), str.data() + str.length());
+}
+//translate from the chars [first, last) of a buffer to int
+int strToInt(const char *first, const char *last)
 {
     try {
-        //segregates the floating value in other string
+        //segregates the integer value
+        unsigned int length = (unsigned int)(last - first);
         unsigned int i = 0;
-        string dst;
-        strReadIntStr(dst, str, i);
+        unsigned int t_first, t_last;
+        strScanInt(t_first, t_last, first, length, i);
 
         //look for unexpected text
-        strTravelSeparatorsIfAny(str, i);
-        if(i < str.length())
-            throw EImproperArgument("unexpected text: \""+StrFirstChars(str.substr(i, str.length() - i)).str+"\"");
-
-        //convert to double
-        istringstream ss(dst);
-        int value;
-        bool ok = bool(ss >> value);
-        if(!ok) {
-            throw EImproperArgument(AnsiString("can't convert string to int"));
-        }
-
-        //Other way of translate to integer:
-        //  int value;
-        //  sscanf(dst.c_str(), "%d", &value);
+        travelSeparatorsIfAny(first, length, i);
+        if(i < length)
+            throw EImproperArgument("unexpected text: \""+StrFirstChars(string(first + i, last)).str+"\"");
 
-        //Other way of translate to integer:
-        //  int value = atoi(dst.c_str());
-
-        return value;
+        //convert to int
+        return convertToInt(first + t_first, first + t_last);
     }
     catch(Exception& E) {
         E.Message.Insert(1, "converting string to int: ");
@@ -1080,9 +1133,9 @@ int strToInt(const string& str)
 void strReadInt(int& value, const string& src, unsigned int& i)
 {
     try {
-        string dst;
-        strReadIntStr(dst, src, i);
-        value = strToInt(dst);
+        unsigned int first, last;
+        strScanInt(first, last, src.data(), src.length(), i);
+        value = convertToInt(src.data() + first, src.data() + last);
 
     } catch(Exception& E) {
         E.Message.Insert(1, "reading integer: ");
@@ -1287,13 +1340,16 @@ void StrReadHex(int& value, const AnsiString& S, int &i)
     i = int(_i + 1);
 }
 
-//read a float in the indicated position of a string
-void strReadFloatStr(string& dst, const string& src, unsigned int& i)
+//scan a float in the indicated position of a buffer
+//and get the limits [first, last) of the value
+static void strScanFloat(unsigned int& first, unsigned int& last,
+                         const char *src, unsigned int length,
+                         unsigned int& i)
 {
     //Note that it is not required that source string is printable.
 
     //check the precondition
-    if(i > src.length())
+    if(i > length)
         throw EImproperArgument("index i should indicate a position of the string src");
 
     //reading status:
@@ -1308,12 +1364,13 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
     //  8: floating point readed successfully
     int status = 0;
 
-    //tampon variable
-    string t_dst;
+    //tampon variables
+    unsigned int t_first = i;
+    unsigned int t_last = i;
 
     do {
         //if the index i indicates a char of the source string
-        if(i < src.length()) {
+        if(i < length) {
             char c = src[i++]; //get the next char
 
             //reacts according the status and the char
@@ -1324,10 +1381,12 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
                 else if(c == '\r')
                     status++;
                 else if(c=='+' || c=='-') {
-                    t_dst += c;
+                    t_first = i - 1;
+                    t_last = i;
                     status = 2;
                 } else if('0'<=c && c<='9') {
-                    t_dst += c;
+                    t_first = i - 1;
+                    t_last = i;
                     status = 3;
                 } else
                     throw EImproperArgument("floating point value not found");
@@ -1344,19 +1403,19 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
                 if(c<'0' || '9'<c)
                     throw EImproperArgument("floating point value not found");
                 else {
-                    t_dst += c;
+                    t_last = i;
                     status++;
                 }
                 break;
 
             case 3: //waiting decimal char or decimal separator or 'e'/'E' or other char
                 if('0'<=c && c <='9')
-                    t_dst += c;
-                else if(c == get_decimal_separator()) {
-                    t_dst += c;
+                    t_last = i;
+                else if(c == '.') {
+                    t_last = i;
                     status++;
                 } else if(c=='e' || c=='E') {
-                    t_dst += c;
+                    t_last = i;
                     status = 5;
                 } else {
                     i--;
@@ -1366,9 +1425,9 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
 
             case 4: //waiting decimal char or 'e'/'E' or other char
                 if('0'<=c && c<='9')
-                    t_dst += c;
+                    t_last = i;
                 else if(c=='e' || c=='E') {
-                    t_dst += c;
+                    t_last = i;
                     status++;
                 } else {
                     i--;
@@ -1378,10 +1437,10 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
 
             case 5: //waiting '+', '-' or first decimal char
                 if(c=='+' || c=='-') {
-                    t_dst += c;
+                    t_last = i;
                     status++;
                 } else if('0'<=c && c<='9') {
-                    t_dst += c;
+                    t_last = i;
                     status = 7;
                 } else {
                     i--;
@@ -1391,10 +1450,10 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
 
             case 6: //waiting first decimal char
                 if('0'<=c && c<='9') {
-                    t_dst += c;
+                    t_last = i;
                     status++;
                 } else {
-                    while(src[i]<'0' || '9'<src[i])
+                    while(i>=length || src[i]<'0' || '9'<src[i])
                         i--;
                     status = 8;
                 }
@@ -1405,7 +1464,7 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
                     i--;
                     status = 8;
                 } else
-                    t_dst += c;
+                    t_last = i;
                 break;
 
             default:
@@ -1433,7 +1492,7 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
                 break;
 
             case 6: //waiting first decimal char
-                while(src[i]<'0' || '9'<src[i])
+                while(i>=length || src[i]<'0' || '9'<src[i])
                     i--;
                 status = 8;
                 break;
@@ -1451,47 +1510,71 @@ void strReadFloatStr(string& dst, const string& src, unsigned int& i)
     } while(status < 8);
 
     //set the tampon variables
-    dst = t_dst;
+    first = t_first;
+    last = t_last;
+}
+//convert the chars [first, last) of a string to double
+//if the chars can't be converted completely:
+//  throw EImproperArgument
+static double convertToFloat(const char *first, const char *last)
+{
+    //the leading '+' is accepted by the scanner but not by from_chars
+    if(first<last && *first=='+')
+        first++;
+
+    double value = 0;
+#ifdef FMPT_CHARCONV
+    from_chars_result result = from_chars(first, last, value);
+    if(result.ec == errc::result_out_of_range && result.ptr == last) {
+        //the underflow is rounded to zero (like strtod),
+        //but the overflow can't be converted
+        const char *p = first;
+        while(p<last && *p!='e' && *p!='E')
+            p++;
+        if(last-p<2 || p[1]!='-')
+            throw EImproperArgument(AnsiString("can't convert string to double"));
+        value = (*first == '-') ? -0.0 : 0.0;
+    }
+    else if(result.ec!=errc() || result.ptr!=last)
+        throw EImproperArgument(AnsiString("can't convert string to double"));
+#else
+    istringstream ss(string(first, last));
+    ss.imbue(locale::classic());
+    if(!bool(ss >> value) || !ss.eof())
+        throw EImproperArgument(AnsiString("can't convert string to double"));
+#endif
+    return value;
+}
+
+//read a float in the indicated position of a string
+void strReadFloatStr(string& dst, const string& src, unsigned int& i)
+{
+    unsigned int first, last;
+    strScanFloat(first, last, src.data(), src.length(), i);
+    dst.assign(src, first, last - first);
 }
 //translate from string to double
 double strToFloat(const string& str)
+{
+    return strToFloat(str.data(), str.data() + str.length());
+}
+//translate from the chars [first, last) of a buffer to double
+double strToFloat(const char *first, const char *last)
 {
     try {
-        //segregate the value in other string
+        //segregate the value
+        unsigned int length = (unsigned int)(last - first);
         unsigned int i = 0;
-        string dst;
-        strReadFloatStr(dst, str, i);
+        unsigned int t_first, t_last;
+        strScanFloat(t_first, t_last, first, length, i);
 
         //look for unexpected text
-        strTravelSeparatorsIfAny(str, i);
-        if(i < str.length())
-            throw EImproperArgument("unexpected text: \""+StrFirstChars(str.substr(i, str.length() - i)).str+"\"");
+        travelSeparatorsIfAny(first, length, i);
+        if(i < length)
+            throw EImproperArgument("unexpected text: \""+StrFirstChars(string(first + i, last)).str+"\"");
 
         //translate the value to numerical type
-        stringstream ss(dst);
-        ss.precision(DBL_DIG);
-        double value;
-        bool ok = bool(ss >> value);
-        if(!ok) {
-            throw EImproperArgument(AnsiString("can't convert string to double"));
-        }
-
-        //Other way of translate to double:
-        //  double value;
-        //  sscanf(dst.c_str(), "%lf", &value);
-
-        //Other way of translate to double:
-        //  char *pEnd;
-        //  double value = strtod(dst.c_str(), &pEnd);
-
-        //WARNING: if precision is upper to DBL_DIG decimals, conversión to
-        //string can introduce numerial error for somevalues.Example:
-        //  value       ->  string
-        //  87.035553	->  "87.03555299999999"
-        //  -70.35		->  "-70.34999999999999"
-
-        //return the value
-        return value;
+        return convertToFloat(first + t_first, first + t_last);
     }
     catch(Exception& E) {
         E.Message.Insert(1, "converting string to float: ");
@@ -1502,9 +1585,9 @@ double strToFloat(const string& str)
 void strReadFloat(double& value, const string& src, unsigned int& i)
 {
     try {
-        string dst;
-        strReadFloatStr(dst, src, i);
-        value = strToFloat(dst);
+        unsigned int first, last;
+        strScanFloat(first, last, src.data(), src.length(), i);
+        value = convertToFloat(src.data() + first, src.data() + last);
 
     } catch(Exception& E) {
         E.Message.Insert(1, "reading float: ");
@@ -2367,7 +2450,8 @@ void ReadVector (TStringList *SL, const AnsiString &S, char c1, char c2)
 //translate from time_t to string in format en_EN
 string strfromtime_t(time_t t, string format)
 {
-    tm lt = *localtime(&t);
+    tm lt;
+    localtime_r(&t, &lt);
 
     char buffer[32];
     strftime(buffer, 32, format.c_str(), &lt);
@@ -194,6 +194,9 @@ void strTravelSeparatorsIfAny(const string&, unsigned int&);
 void strReadIntStr(string& dst, const string& src, unsigned int& i);
 //translate from string to int
 int strToInt(const string&);
+//translate from the chars [first, last) of a buffer to int
+//(without copy the chars)
+int strToInt(const char *first, const char *last);
 //read an integer in the indicated position of a string
 void strReadInt(int& value, const string& src, unsigned int& i);
 
@@ -223,6 +226,9 @@ void StrReadHex(int& value, const AnsiString& S, int &i);
 void strReadFloatStr(string& dst, const string& src, unsigned int& i);
 //translate from string to double
 double strToFloat(const string&);
+//translate from the chars [first, last) of a buffer to double
+//(without copy the chars)
+double strToFloat(const char *first, const char *last);
 //read a float in the indicated position of a string
 void strReadFloat(double& value, const string& src, unsigned int& i);
 
@@ -27,6 +27,9 @@
 #include "Exceptions.h"
 
 #include <dirent.h> //opendir, readdir, rewinddir, closedir
+#include <fcntl.h> //open
+#include <unistd.h> //write, close
+#include <errno.h> //errno, EINTR
 
 //---------------------------------------------------------------------------
 
@@ -438,6 +441,117 @@ void strAddToFile(const string& fileName, const string& str)
     }
 }
 
+//---------------------------------------------------------------------------
+//TTextOutputStream:
+//---------------------------------------------------------------------------
+
+//write the buffered chars in the file descriptor
+bool TTextOutputBuffer::flushBuffer(void)
+{
+    char *first = pbase();
+    char *last = pptr();
+
+    //discard the chars '\r' if any
+    if(p_clearCR) {
+        char *q = first;
+        for(char *p=first; p<last; p++)
+            if(*p != '\r')
+                *q++ = *p;
+        last = q;
+    }
+
+    //write all chars retrying the interrupted writings
+    while(first < last && !p_failed) {
+        ssize_t n = ::write(p_fd, first, last - first);
+        if(n < 0) {
+            if(errno != EINTR)
+                p_failed = true;
+        } else
+            first += n;
+    }
+
+    setp(p_buffer, p_buffer + sizeof(p_buffer));
+    return !p_failed;
+}
+
+int TTextOutputBuffer::overflow(int c)
+{
+    if(!flushBuffer())
+        return traits_type::eof();
+    if(c != traits_type::eof()) {
+        *pptr() = char(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+int TTextOutputBuffer::sync(void)
+{
+    return flushBuffer() ? 0 : -1;
+}
+
+//build a buffer attached to a file descriptor
+TTextOutputBuffer::TTextOutputBuffer(int fd, bool owner, bool clearCR) :
+    p_fd(fd), p_owner(owner), p_clearCR(clearCR), p_failed(false)
+{
+    setp(p_buffer, p_buffer + sizeof(p_buffer));
+}
+//write the buffered chars and close the file descriptor if owner
+TTextOutputBuffer::~TTextOutputBuffer()
+{
+    close();
+}
+
+//write the buffered chars and close the file descriptor if owner
+//return false if some writing has failed
+bool TTextOutputBuffer::close(void)
+{
+    if(p_fd >= 0) {
+        flushBuffer();
+        if(p_owner && ::close(p_fd) != 0)
+            p_failed = true;
+        p_fd = -1;
+    }
+    return !p_failed;
+}
+
+//open a new file for write
+//if the file can't be opened:
+//  throw ECantComplete
+static int openForWrite(const string& fileName)
+{
+    int fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0)
+        throw ECantComplete(AnsiString("can't open file: ")+AnsiString(fileName));
+    return fd;
+}
+
+//build a stream for write in a file descriptor,
+//which will not be closed
+TTextOutputStream::TTextOutputStream(int fd, bool clearCR) :
+    std::ostream(NULL), p_buffer(fd, false, clearCR), p_fileName()
+{
+    rdbuf(&p_buffer);
+}
+//build a stream for write in a new file,
+//discarding the chars '\r' (like strWriteToFile)
+TTextOutputStream::TTextOutputStream(const string& fileName) :
+    std::ostream(NULL), p_buffer(openForWrite(fileName), true, true),
+    p_fileName(fileName)
+{
+    rdbuf(&p_buffer);
+}
+
+//write the buffered chars and close the file (if any)
+void TTextOutputStream::close(void)
+{
+    if(!p_buffer.close() || fail()) {
+        setstate(ios::badbit);
+        if(p_fileName.length() > 0)
+            throw ECantComplete(AnsiString("can't write in file ")+AnsiString(p_fileName));
+        throw ECantComplete("can't write in file descriptor");
+    }
+}
+
 //---------------------------------------------------------------------------
 
 } //namespace Strings
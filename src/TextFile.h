@@ -28,6 +28,7 @@
 #include "VCLemu.h" //AnsiString
 
 #include <stdio.h>  //FILE
+#include <ostream> //ostream, streambuf
 
 //---------------------------------------------------------------------------
 
@@ -142,6 +143,61 @@ void strWriteToFile(const string& fileName, const string& str);
 //add a text string to afile
 void strAddToFile(const string& fileName, const string& str);
 
+//---------------------------------------------------------------------------
+//TTextOutputStream:
+//---------------------------------------------------------------------------
+
+//The text output stream writes a text in a file descriptor (a file,
+//a pipe or a socket) incrementally, through a reusable buffer,
+//so that large texts can be written without build them in memory.
+
+//buffer of a text output stream
+class TTextOutputBuffer : public std::streambuf {
+    int p_fd; //file descriptor
+    bool p_owner; //indicates if the file descriptor shall be closed
+    bool p_clearCR; //indicates if the chars '\r' shall be discarded
+    bool p_failed; //indicates if some writing has failed
+    char p_buffer[8192];
+
+    //write the buffered chars in the file descriptor
+    bool flushBuffer(void);
+
+protected:
+    int overflow(int c);
+    int sync(void);
+
+public:
+    //build a buffer attached to a file descriptor
+    TTextOutputBuffer(int fd, bool owner, bool clearCR);
+    //write the buffered chars and close the file descriptor if owner
+    ~TTextOutputBuffer();
+
+    //write the buffered chars and close the file descriptor if owner
+    //return false if some writing has failed
+    bool close(void);
+};
+
+//class text output stream
+class TTextOutputStream : public std::ostream {
+    TTextOutputBuffer p_buffer;
+    string p_fileName;
+
+public:
+    //build a stream for write in a file descriptor,
+    //which will not be closed
+    TTextOutputStream(int fd, bool clearCR=false);
+    //build a stream for write in a new file,
+    //discarding the chars '\r' (like strWriteToFile)
+    //if the file can't be opened:
+    //  throw ECantComplete
+    TTextOutputStream(const string& fileName);
+
+    //write the buffered chars and close the file (if any)
+    //if some writing has failed:
+    //  throw ECantComplete
+    void close(void);
+};
+
 //---------------------------------------------------------------------------
 
 } //namespace Strings
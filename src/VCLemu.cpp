@@ -39,6 +39,7 @@
 #include <locale.h> //struct lconv, localeconv()
 
 #include <sstream> //stringstream
+#include <locale> //locale::classic
 
 //WARNING:in GCC 2.95 not must be included:
 //sstring: because it is not linked the dynamic version of libstdc++.
@@ -305,22 +306,25 @@ int AnsiString::ToHex() const
 //translate from double to string
 string floattostr(double value)
 {
-    stringstream ss;
+    //The value is printed with DBL_DIG significant figures
+    //and without decimal zeros on the right (like "%.15g").
 
-    //convert to string
+#ifdef FMPT_CHARCONV
+    char c_str[32];
+    to_chars_result result = to_chars(c_str, c_str + sizeof(c_str), value,
+                                      chars_format::general, DBL_DIG);
+    if(result.ec != errc())
+        throw EImproperArgument(AnsiString("can't convert double to string"));
+    return string(c_str, result.ptr);
+#else
+    ostringstream ss;
+    ss.imbue(locale::classic());
     ss.precision(DBL_DIG);
     bool ok = bool(ss << value);
     if(!ok)
         throw EImproperArgument(AnsiString("can't convert double to string"));
     return ss.str();
-
-    //Othe way to do this:
-    //  char c_str[308];
-    //  string format = "%."+inttostr(DBL_DIG)+"lf";
-    //  string format = "%lf";
-    //  sprintf(c_str, format.c_str(), value);
-    //  return string(c_str);
-    //But this method print decimal zeros on the right.
+#endif
 
     //WARNING: if precision is upper to digits10 decimals, conversión to
     //string can introduce numerial error for somevalues.Example:
@@ -335,21 +339,26 @@ string floattostr_fixed(double value, int precision)
     if(precision<0 || DBL_DIG<precision)
         throw EImproperArgument("precision should be in [0, "+inttostr(DBL_DIG)+"]");
 
-    //convert to string
+    //The value is printed with precision decimals,
+    //including decimal zeros on the right (like "%.*f").
+
+#ifdef FMPT_CHARCONV
     char c_str[330];
-    string format = "%."+inttostr(precision)+"lf";
-    sprintf(c_str, format.c_str(), value);
-    return string(c_str);
-    //But this method print decimal zeros on the right.
-
-    //Othe way to do this:
-    //  stringstream ss;
-    //  ss.precision(precision);
-    //  bool ok = (ss << value);
-    //  if(!ok)
-    //      throw EImproperArgument(AnsiString("can't convert double to string"));
-    //  return ss.str();
-    //But in this metthod, precission is the number of significant figures.
+    to_chars_result result = to_chars(c_str, c_str + sizeof(c_str), value,
+                                      chars_format::fixed, precision);
+    if(result.ec != errc())
+        throw EImproperArgument(AnsiString("can't convert double to string"));
+    return string(c_str, result.ptr);
+#else
+    ostringstream ss;
+    ss.imbue(locale::classic());
+    ss.setf(ios::fixed, ios::floatfield);
+    ss.precision(precision);
+    bool ok = bool(ss << value);
+    if(!ok)
+        throw EImproperArgument(AnsiString("can't convert double to string"));
+    return ss.str();
+#endif
 
     //WARNING: if precision is upper to digits10 decimals, conversión to
     //string can introduce numerial error for somevalues.Example:
@@ -360,32 +369,40 @@ string floattostr_fixed(double value, int precision)
 //translate from int to string
 string inttostr(int value)
 {
-    stringstream ss;
+#ifdef FMPT_CHARCONV
+    char c_str[12];
+    to_chars_result result = to_chars(c_str, c_str + sizeof(c_str), value);
+    if(result.ec != errc())
+        throw EImproperArgument(AnsiString("can't convert int to string"));
+    return string(c_str, result.ptr);
+#else
+    ostringstream ss;
+    ss.imbue(locale::classic());
     bool ok = bool(ss << value);
     if(!ok)
         throw EImproperArgument(AnsiString("can't convert int to string"));
     return ss.str();
-
-    //Other way to do this:
-    //  char c_str[12];
-    //  sprintf(c_str, "%d", value);
-    //  return string(c_str);
+#endif
 }
 //translate from unsigned int to string
 string uinttostr(unsigned int value)
 {
-    //convert to string
-    stringstream ss;
+#ifdef FMPT_CHARCONV
+    char c_str[12];
+    to_chars_result result = to_chars(c_str, c_str + sizeof(c_str), value);
+    if(result.ec != errc())
+        throw EImproperArgument(AnsiString("can't convert int to string"));
+    return string(c_str, result.ptr);
+#else
+    ostringstream ss;
+    ss.imbue(locale::classic());
     bool ok = bool(ss << value);
     if(!ok)
         throw EImproperArgument(AnsiString("can't convert int to string"));
     return ss.str();
+#endif
 
-    //Other way to do this:
-    //  char c_str[12];
-    //  sprintf(c_str, "%d", value);
-    //  return string(c_str);
-    //But printf print "-1" for the UINT_MAX.
+    //Note that printf("%d") print "-1" for the UINT_MAX.
 }
 
 //translate from AnsiString to int
@@ -34,6 +34,15 @@
 #include <termios.h>
 #include <unistd.h>
 
+//the numeric conversion functions are built on std::from_chars and
+//std::to_chars when the standard library provides them for doubles
+#if __cplusplus >= 201703L
+#include <charconv> //from_chars, to_chars
+#ifdef __cpp_lib_to_chars
+#define FMPT_CHARCONV
+#endif
+#endif
+
 using namespace std; //string
 
 //---------------------------------------------------------------------------
@@ -197,6 +206,9 @@ public:
 //The more large double has 23 caracteres,
 //including the sign, the exponent and the sign of the exponent.
 
+//The conversion functions are independent of the locale:
+//the decimal separator is always '.'.
+
 //translate from double to string
 string floattostr(double value);
 string floattostr_fixed(double value, int precision=DBL_DIG);
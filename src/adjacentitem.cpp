@@ -101,12 +101,11 @@ void TAdjacentEA::printId(AnsiString &S, const TAdjacentEA *AEA)
 //---------------------------------------------------------------------------
 
 //build a list by default
-TAdjacentEAList::TAdjacentEAList(void) :
-    TPointersList<TAdjacentEA>(1, TAdjacentEA::compareIds, NULL, NULL, TAdjacentEA::printId, NULL)
+TAdjacentEAList::TAdjacentEAList(void) : TSmallList<TAdjacentEA, 2>()
 {
 }
 //build a clon of a list
-TAdjacentEAList::TAdjacentEAList(const TAdjacentEAList& AEA) : TPointersList<TAdjacentEA>(AEA)
+TAdjacentEAList::TAdjacentEAList(const TAdjacentEAList& AEA) : TSmallList<TAdjacentEA, 2>(AEA)
 {
 }
 
@@ -115,10 +114,10 @@ string TAdjacentEAList::getIdText(void) const
 {
     string str = "{";
     if(getCount() > 0) {
-        str += Items.getFirst()->EA->getIdText().str;
+        str += p_Items[0].EA->getIdText().str;
         for(int i=1; i<getCount(); i++) {
             str += ", ";
-            str += Items[i]->EA->getIdText().str;
+            str += p_Items[i].EA->getIdText().str;
         }
     }
     str += "}";
@@ -129,10 +128,10 @@ string TAdjacentEAList::getDminText(void) const
 {
     string str = "{";
     if(getCount() > 0) {
-        str += "(EA" + Items.getFirst()->EA->getIdText().str + ", " + floattostr(Items.getFirst()->Dmin) + ")";
+        str += "(EA" + p_Items[0].EA->getIdText().str + ", " + floattostr(p_Items[0].Dmin) + ")";
         for(int i=1; i<getCount(); i++) {
             str += ", ";
-            str += "(EA" + Items[i]->EA->getIdText().str + ", " + floattostr(Items[i]->Dmin) + ")";
+            str += "(EA" + p_Items[i].EA->getIdText().str + ", " + floattostr(p_Items[i].Dmin) + ")";
         }
     }
     str += "}";
@@ -143,10 +142,10 @@ string TAdjacentEAList::getDendText(void) const
 {
     string str = "{";
     if(getCount() > 0) {
-        str += "(EA" + Items.getFirst()->EA->getIdText().str + ", " + floattostr(Items.getFirst()->Dend) + ")";
+        str += "(EA" + p_Items[0].EA->getIdText().str + ", " + floattostr(p_Items[0].Dend) + ")";
         for(int i=1; i<getCount(); i++) {
             str += ", ";
-            str += "(EA" + Items[i]->EA->getIdText().str + ", " + floattostr(Items[i]->Dend) + ")";
+            str += "(EA" + p_Items[i].EA->getIdText().str + ", " + floattostr(p_Items[i].Dend) + ")";
         }
     }
     str += "}";
@@ -158,13 +157,13 @@ string TAdjacentEAList::getDendText(void) const
 void TAdjacentEAList::setAllDmins(double Dmin)
 {
     for(int i=0; i<getCount(); i++)
-        Items[i]->Dmin = Dmin;
+        p_Items[i].Dmin = Dmin;
 }
 //set a same value to all Dends
 void TAdjacentEAList::setAllDends(double Dend)
 {
     for(int i=0; i<getCount(); i++)
-        Items[i]->Dend = Dend;
+        p_Items[i].Dend = Dend;
 }
 
 //---------------------------------------------------------------------------
@@ -235,12 +234,11 @@ void TAdjacentRP::printId(AnsiString &S, const TAdjacentRP *ARP)
 //---------------------------------------------------------------------------
 
 //build a list by default
-TAdjacentRPList::TAdjacentRPList(void) :
-    TPointersList<TAdjacentRP>(6, TAdjacentRP::compareIds, NULL, NULL, TAdjacentRP::printId, NULL)
+TAdjacentRPList::TAdjacentRPList(void) : TSmallList<TAdjacentRP, 6>()
 {
 }
 //build a clon of a list
-TAdjacentRPList::TAdjacentRPList(const TAdjacentRPList& ARP) : TPointersList<TAdjacentRP>(ARP)
+TAdjacentRPList::TAdjacentRPList(const TAdjacentRPList& ARP) : TSmallList<TAdjacentRP, 6>(ARP)
 {
 }
 
@@ -249,10 +247,10 @@ string TAdjacentRPList::getIdText(void) const
 {
     string str = "{";
     if(getCount() > 0) {
-        str += Items.getFirst()->RP->getActuator()->getIdText().str;
+        str += p_Items[0].RP->getActuator()->getIdText().str;
         for(int i=1; i<getCount(); i++) {
             str += ", ";
-            str += Items[i]->RP->getActuator()->getIdText().str;
+            str += p_Items[i].RP->getActuator()->getIdText().str;
         }
     }
     str += "}";
@@ -263,10 +261,10 @@ string TAdjacentRPList::getDminText(void) const
 {
     string str = "{";
     if(getCount() > 0) {
-        str += "(RP" + Items.getFirst()->RP->getActuator()->getIdText().str + ", " + floattostr(Items.getFirst()->Dmin) + ")";
+        str += "(RP" + p_Items[0].RP->getActuator()->getIdText().str + ", " + floattostr(p_Items[0].Dmin) + ")";
         for(int i=1; i<getCount(); i++) {
             str += ", ";
-            str += "(RP" + Items[i]->RP->getActuator()->getIdText().str + ", " + floattostr(Items[i]->Dmin) + ")";
+            str += "(RP" + p_Items[i].RP->getActuator()->getIdText().str + ", " + floattostr(p_Items[i].Dmin) + ")";
         }
     }
     str += "}";
@@ -277,10 +275,10 @@ string TAdjacentRPList::getDendText(void) const
 {
     string str = "{";
     if(getCount() > 0) {
-        str += "(RP" + Items.getFirst()->RP->getActuator()->getIdText().str + ", " + floattostr(Items.getFirst()->Dend) + ")";
+        str += "(RP" + p_Items[0].RP->getActuator()->getIdText().str + ", " + floattostr(p_Items[0].Dend) + ")";
         for(int i=1; i<getCount(); i++) {
             str += ", ";
-            str += "(RP" + Items[i]->RP->getActuator()->getIdText().str + ", " + floattostr(Items[i]->Dend) + ")";
+            str += "(RP" + p_Items[i].RP->getActuator()->getIdText().str + ", " + floattostr(p_Items[i].Dend) + ")";
         }
     }
     str += "}";
@@ -292,13 +290,13 @@ string TAdjacentRPList::getDendText(void) const
 void TAdjacentRPList::setAllDmins(double Dmin)
 {
     for(int i=0; i<getCount(); i++)
-        Items[i]->Dmin = Dmin;
+        p_Items[i].Dmin = Dmin;
 }
 //set a same value to all Dends
 void TAdjacentRPList::setAllDends(double Dend)
 {
     for(int i=0; i<getCount(); i++)
-        Items[i]->Dend = Dend;
+        p_Items[i].Dend = Dend;
 }
 
 //---------------------------------------------------------------------------
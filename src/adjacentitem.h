@@ -25,7 +25,11 @@
 #ifndef ADJACENTITEM_H
 #define ADJACENTITEM_H
 
-#include "PointersList.h"
+#include "SmallList.h"
+#include "VCLemu.h" //AnsiString
+
+#include <float.h> //DBL_MAX
+#include <string>
 
 //---------------------------------------------------------------------------
 
@@ -72,14 +76,15 @@ public:
 //TAdjacentEAList
 //---------------------------------------------------------------------------
 
+//The adjacent EAs are contained by value in the list, and the first
+//two ones inside the list itself, so they are in the same cache lines.
+
 //cluss list of adjacent EAs
-class TAdjacentEAList : public TPointersList<TAdjacentEA> {
+class TAdjacentEAList : public TSmallList<TAdjacentEA, 2> {
 public:
     //Default values:
     //  Count = 0;
-    //  Capacity = 1;
-    //  Compare = TAdjacentEA::CompareIds;
-    //  Print = TAdjacentEA::PrintId;
+    //  Capacity = 2;
 
     //build a list by default
     TAdjacentEAList(void);
@@ -135,14 +140,16 @@ public:
 //TAdjacentRPList
 //---------------------------------------------------------------------------
 
+//The adjacent RPs are contained by value in the list, and the first
+//six ones (all in the MEGARA distribution) inside the list itself,
+//so they are in the same cache lines.
+
 //cluss list of adjacent RPs
-class TAdjacentRPList : public TPointersList<TAdjacentRP> {
+class TAdjacentRPList : public TSmallList<TAdjacentRP, 6> {
 public:
     //Default values:
     //  Count = 0;
     //  Capacity = 6;
-    //  Compare = TAdjacentRP::CompareIds;
-    //  Print = TAdjacentRP::PrintId;
 
     //build a list by default
     TAdjacentRPList(void);
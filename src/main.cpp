@@ -26,6 +26,8 @@
 #include "globalconsts.h"
 #include "Strings.h"
 #include "TextFile.h"
+#include "Log.h"
+#include "OutputWriter.h"
 #include "Geometry.h" //distanceSegmentPoint
 #include "TextFile.h"
 //includes for calculus
@@ -36,10 +38,17 @@
 #include "OutputsParkProg.h" //ParkProg
 #include "FileMethods.h"
 #include "roboticpositionertuner.h"
+#include "RequestServer.h"
 
 #include <clocale> //setlocale, LC_ALL
 #include <iostream> //std::cout, ios::fixed
 #include <stdio.h> //getchar
+#include <pthread.h> //pthread_create, pthread_join, pthread_mutex_t
+#include <sys/stat.h> //stat, S_ISDIR, S_ISREG
+#include <unistd.h> //sysconf
+#include <time.h> //clock_gettime
+#include <algorithm> //std::sort
+#include <vector> //std::vector
 
 //#include "tests/testFileMethods_copia.h"
 
@@ -50,30 +59,31 @@ using namespace Positioning;
 //---------------------------------------------------------------------------
 //GENERAL FUNCTIONS:
 
+//indicates if the functions append and append_without_endl
+//shall print the text in the standard output
+//(it is disabled during batch generation, where each job has its own log file)
+bool append_echo = true;
+
 //print a text line in the standard output and in the log file
-void append(const string& str, const char *log_path)
+//(the log file is written through its buffered sink)
+void append(const string& str, const char *log_path, TLogLevel level=llINFO)
 {
-    string str_aux = str;
-    str_aux += "\r\n";
-
-    std::cout << str_aux;
+    if(append_echo)
+        std::cout << str << "\r\n";
 
-    char mode[] = "a";
-    TTextFile TF(log_path, mode);
-    TF.Print(str_aux.c_str());
-    TF.Close();
+    logWrite(log_path, str, level);
 }
 
 //print a text line in the standard output and in the log file
-void append_without_endl(const string& str, const char *log_path)
+//(the log file is written through its buffered sink)
+void append_without_endl(const string& str, const char *log_path, TLogLevel level=llINFO)
 {
-    std::cout << str;
-    std::cout.flush();
+    if(append_echo) {
+        std::cout << str;
+        std::cout.flush();
+    }
 
-    char mode[] = "a";
-    TTextFile TF(log_path, mode);
-    TF.Print(str.c_str());
-    TF.Close();
+    logWriteWithoutEndl(log_path, str, level);
 }
 
 //gets a string containing the help
@@ -125,6 +135,32 @@ string help(void)
     str += "\r\n            the content of the input file type FMOSA,";
     str += "\r\n        Where <filename> is the name of the input file.";
     str += "\r\n";
+    str += "\r\n$ fmpt_saa generatePairPPDP_batch <FMOSA_list_or_dir> [jobs=<N>]";
+    str += "\r\n    Generate a pair (PP, DP) offline for each file type FMOSA of a set.";
+    str += "\r\n    <FMOSA_list_or_dir>: either a directory containing files type FMOSA,";
+    str += "\r\n        or a text file containing a path of file type FMOSA by line.";
+    str += "\r\n    jobs=<N>: number of pairs generated in parallel (by default the number of processors).";
+    str += "\r\n    The FMM Instance is loaded once, and each worker uses their own clone.";
+    str += "\r\n    For each input file are saved the same files than generatePairPPDP_offline,";
+    str += "\r\n    and the log file PairPPDP_log_from_<filename>.";
+    str += "\r\n    The summary table (validity and time of each pair) is saved in PairPPDP_batch_summary.txt.";
+    str += "\r\n    Optional arguments are the same than for generatePairPPDP_offline.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_saa daemon [socket=<path>] [jobs=<N>] [timeout=<s>] [instance=<name>:<dir>]...";
+    str += "\r\n    Keep the FMM Instance resident in memory and serve requests of generation and validation.";
+    str += "\r\n    Requests and responses are JSON objects, one per line (see the file RequestServer.h).";
+    str += "\r\n    socket=<path>: Unix domain socket where listen (by default stdin/stdout).";
+    str += "\r\n    jobs=<N>: number of requests processed in parallel (by default the number of processors).";
+    str += "\r\n    timeout=<s>: default maximun time to wait each response (by default without timeout).";
+    str += "\r\n    instance=<name>:<dir>: other FMM Instance to keep resident (the default is named 'default').";
+    str += "\r\n    The daemon finish when receives a request shutdown, or when the stdin is closed.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_saa daemon_client <socket_path> <requests_path>";
+    str += "\r\n    Send the requests of a file (one per line) to a daemon and print the responses.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_saa daemon_benchmark <socket_path> <requests_path> [repeat=<N>]";
+    str += "\r\n    Send the requests of a file to a daemon one by one, and print the statistics of the latency.";
+    str += "\r\n";
     str += "\r\nOnly offline generation function use files type FMOSA.";
     str += "\r\nIn the file type FMOSA:";
     str += "\r\n    The following parameters could be empty: Name, Mag, Pr, Bid and Comment.";
@@ -1140,13 +1176,13 @@ bool generateParkProg_offline(TFiberMOSModel& FMM, const string& input_path, con
 
         //check the limiting case when there aren't allocations
         if(MPG.getCount() <= 0)
-            append("WARNING: there aren't allocations. The generated parking program will be empty.", log_path.c_str());
+            append("WARNING: there aren't allocations. The generated parking program will be empty.", log_path.c_str(), llWARNING);
         //check the limiting case when all operative RPs are in the origin
         else if(FMM.RPL.allOperativeRPsAreInTheOrigin())
-            append("WARNING: all operative RPs are in the origin. The generated parking program will be empty.", log_path.c_str());
+            append("WARNING: all operative RPs are in the origin. The generated parking program will be empty.", log_path.c_str(), llWARNING);
         //else, check the limiting case when all operative RPs are in security positions
         else if(Outsiders.getCount() <= 0)
-            append("WARNING: all operative RPs are in security positions. The generated parking program will contain only a message-instruction list to go to the origin.", log_path.c_str());
+            append("WARNING: all operative RPs are in security positions. The generated parking program will contain only a message-instruction list to go to the origin.", log_path.c_str(), llWARNING);
 
         //Now are fulfilled the preconditions for the function TMotionProgramGenerator::generateParkProg:
         //  All RPs of the Fiber MOS Model:
@@ -1356,40 +1392,52 @@ bool generateParkProg_offline(TFiberMOSModel& FMM, const string& input_path, con
         bool suitable = outputs.suitable();
         if(suitable) {
             //save outputs
-            outputs.getText(str);
             output_path = output_dir+"/ParkProg_outputs_from_"+filename;
-            strWriteToFile(output_path, str);
+            {
+                TTextOutputStream os(output_path);
+                outputs.writeText(os);
+                os.close();
+            }
             append("Outputs in format MCS saved in file '"+output_path+"'.", log_path.c_str());
 
             //save outputs in format JSON
-            str = outputs.getJSONtext();
             output_path = output_dir + "/ParkProg_outputs_from_" + stem(filename) + ".json";
-            strWriteToFile(output_path, str);
+            {
+                TTextOutputStream os(output_path);
+                outputs.writeJSONtext(os);
+                os.close();
+            }
             append("Outputs in format JSON saved in file '"+output_path+"'.", log_path.c_str());
         }
         else { //not suitable
             //if force save outputs:
             if(saveOutputs) {
                 //warn about force saving file outputs
-                append("WARNING! Forced saving file outputs despite it is not suitable to be executed.", log_path.c_str());
+                append("WARNING! Forced saving file outputs despite it is not suitable to be executed.", log_path.c_str(), llWARNING);
                 append("Files outputs generated by force contain an initial uncommented text for dificult their execution.", log_path.c_str());
 
                 //save outputs
-                outputs.getText(str);
                 output_path = output_dir+"/ParkProg_outputs_from_"+filename;
-                strWriteToFile(output_path, str);
+                {
+                    TTextOutputStream os(output_path);
+                    outputs.writeText(os);
+                    os.close();
+                }
                 append("Outputs in format MCS saved in file '"+output_path+"'.", log_path.c_str());
 
                 //save outputs in format JSON
-                str = outputs.getJSONtext();
                 output_path = output_dir + "/ParkProg_outputs_from_" + stem(filename) + ".json";
-                strWriteToFile(output_path, str);
+                {
+                    TTextOutputStream os(output_path);
+                    outputs.writeJSONtext(os);
+                    os.close();
+                }
                 append("Outputs in format JSON saved in file '"+output_path+"'.", log_path.c_str());
             }
             //if not force save outputs:
             else {
                 //warn about force saving file outputs
-                append("WARNING! File outputs will not be saved, because it is not suitable to be executed. You can force write outputs typing argument outputs.", log_path.c_str());
+                append("WARNING! File outputs will not be saved, because it is not suitable to be executed. You can force write outputs typing argument outputs.", log_path.c_str(), llWARNING);
             }
         }
 
@@ -1785,23 +1833,187 @@ void test_generateParkProg_online(TFiberMOSModel& FMM, string& log_path)
 //FUNCTIONS FOR PAIR (PP, DP):
 //---------------------------------------------------------------------------------
 
+//flags indicating the optional files to be saved by generatePairPPDP_offline
+struct SavingPairPPDP {
+    bool OPL, OPL_S0, OPL_S1;
+    bool IPL, DispCorners1, DispCorners2;
+    bool PP_Dmin, PP_Dend, DP_Dmin, DP_Dend;
+    bool PP_FMPT, DP_FMPT, PP_MCS, DP_MCS;
+    bool MCS, outputs, other_outputs;
+
+    //build a structure with all flags disabled
+    SavingPairPPDP(void) :
+        OPL(false), OPL_S0(false), OPL_S1(false),
+        IPL(false), DispCorners1(false), DispCorners2(false),
+        PP_Dmin(false), PP_Dend(false), DP_Dmin(false), DP_Dend(false),
+        PP_FMPT(false), DP_FMPT(false), PP_MCS(false), DP_MCS(false),
+        MCS(false), outputs(false), other_outputs(false) {;}
+
+    //enable the flag indicated by an argument of the command line
+    //if the argument is unknown:
+    //  throw an exception EImproperArgument
+    void setArgument(const string& argument) {
+        if(argument == "all") {
+            OPL=true, OPL_S0=true, OPL_S1=true;
+            IPL=true, DispCorners1=true, DispCorners2=true;
+            PP_Dmin=true, PP_Dend=true, DP_Dmin=true, DP_Dend=true;
+            PP_FMPT=true, DP_FMPT=true, PP_MCS=true, DP_MCS=true;
+            MCS=true, outputs=true, other_outputs=true;
+        }
+        //------------------------------------
+        else if(argument == "OPL")
+            OPL = true;
+        else if(argument == "OPL-S0")
+            OPL_S0 = true;
+        else if(argument == "OPL-S1")
+            OPL_S1 = true;
+        //------------------------------------
+        else if(argument == "IPL")
+            IPL = true;
+        else if(argument == "DispCorners1")
+            DispCorners1 = true;
+        else if(argument == "DispCorners2")
+            DispCorners2 = true;
+        //------------------------------------
+        else if(argument == "PP-Dmin")
+            PP_Dmin = true;
+        else if(argument == "PP-Dend")
+            PP_Dend = true;
+        else if(argument == "DP-Dmin")
+            DP_Dmin = true;
+        else if(argument == "DP-Dend")
+            DP_Dend = true;
+        //------------------------------------
+        else if(argument == "PP-FMPT")
+            PP_FMPT = true;
+        else if(argument == "DP-FMPT")
+            DP_FMPT = true;
+        else if(argument == "PP-MCS")
+            PP_MCS = true;
+        else if(argument == "DP-MCS")
+            DP_MCS = true;
+        //------------------------------------
+        else if(argument == "MCS")
+            MCS = true;
+        else if(argument == "outputs")
+            outputs = true;
+        else if(argument == "other-outputs")
+            other_outputs = true;
+        //------------------------------------
+        else
+            throw EImproperArgument("unknown argument: "+argument);
+    }
+};
+
+//files of a pair (PP, DP) to be written by an output writer,
+//together with the messages to be annotated between them
+class PairPPDPFiles : public TOutputFiles {
+public:
+    //types of files
+    enum FileType {ftMESSAGE, ftTEXT, ftPP_DMIN, ftPP_DEND, ftDP_DMIN, ftDP_DEND,
+                   ftPP_FMPT, ftDP_FMPT, ftPP_MCS, ftDP_MCS, ftMCS,
+                   ftOUTPUTS, ftOUTPUTS_JSON, ftOTHER_OUTPUTS};
+
+    //file to be formatted from the outputs,
+    //or already formatted (type ftTEXT),
+    //or only a message (type ftMESSAGE)
+    struct File {
+        FileType type;
+        string path;
+        string message;
+        TLogLevel level;
+        string text;
+    };
+
+    //outputs from which the files are formatted
+    //(they are owned by the set, because the files are formatted
+    //while they are written in the background)
+    OutputsPairPPDP outputs;
+    //files to be written
+    vector<File> files;
+
+    //build an empty set of files of the outputs of a pair (PP, DP)
+    PairPPDPFiles(void) : outputs(), files() {;}
+
+    //add a file to be formatted from the outputs
+    void add(FileType type, const string& path, const string& message) {
+        File F;
+        F.type = type;
+        F.path = path;
+        F.message = message;
+        F.level = llINFO;
+        files.push_back(F);
+    }
+    //add a file already formatted
+    void add(const string& path, const string& message, const string& text) {
+        add(ftTEXT, path, message);
+        files.back().text = text;
+    }
+    //add a message to be annotated in its order
+    void note(const string& message, TLogLevel level=llINFO) {
+        add(ftMESSAGE, "", message);
+        files.back().level = level;
+    }
+
+    unsigned int getCount(void) const {return files.size();}
+    string getPath(unsigned int i) const {return files[i].path;}
+    string getMessage(unsigned int i) const {return files[i].message;}
+    TLogLevel getLevel(unsigned int i) const {return files[i].level;}
+
+    //write the content of the file i in a stream
+    void write(ostream& os, unsigned int i) const {
+        const File& F = files[i];
+        string str;
+        switch(F.type) {
+        case ftMESSAGE: break;
+        case ftTEXT: os << F.text; break;
+        case ftPP_DMIN: outputs.PP.getDminMCStext(str, "pos", outputs.Bid); os << str; break;
+        case ftPP_DEND: outputs.PP.getDendMCStext(str, "pos", outputs.Bid); os << str; break;
+        case ftDP_DMIN: outputs.DP.getDminMCStext(str, "depos", outputs.Bid); os << str; break;
+        case ftDP_DEND: outputs.DP.getDendMCStext(str, "depos", outputs.Bid); os << str; break;
+        case ftPP_FMPT: os << outputs.PP.getText().str; break;
+        case ftDP_FMPT: os << outputs.DP.getText().str; break;
+        case ftPP_MCS: outputs.PP.writeMCStext(os, "pos", outputs.Bid, outputs.IPL); break;
+        case ftDP_MCS: outputs.DP.writeMCStext(os, "depos", outputs.Bid, outputs.OPL); break;
+        case ftMCS:
+            outputs.PP.writeMCStext(os, "pos", outputs.Bid, outputs.IPL);
+            os << "\r\n";
+            outputs.DP.writeMCStext(os, "depos", outputs.Bid, outputs.OPL);
+            break;
+        case ftOUTPUTS: outputs.writeText(os); break;
+        case ftOUTPUTS_JSON: outputs.writeJSONtext(os); break;
+        case ftOTHER_OUTPUTS: outputs.getOtherText(str); os << str; break;
+        }
+    }
+};
+
 //Generate a pair (PP, DP) offline.
 //Inputs:
 //  FMM: the Fiber MOS Model
 //  input_path: path of the input file type FMOSA
 //  output_dir: path to the output dir where save the output files
 //  log_path: file name of the log file where anotate eevents
+//  writer: output writer where write the files in the background,
+//      or NULL for write them before return
 //Outputs:
 //  generatePairPPDP_offline: indicates if the generated pair (PP, DP) is valid
 //      and if there aren't neither collided nor obstructed RPs
+//Postconditions:
+//  When writer is not NULL, the files are written in the background from
+//  the status of the FMM, so the FMM shall not be modified until they
+//  have been waited (writer->wait) and annotated in the log by the caller.
 bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, const string& output_dir, const string& log_path,
                               //-------------------------------------------------------------------------------------------------
                               bool saveOPL, bool saveOPL_S0, bool saveOPL_S1,
                               bool saveIPL, bool saveDispCorners1, bool saveDispCorners2,
                               bool savePP_Dmin, bool savePP_Dend, bool saveDP_Dmin, bool saveDP_Dend,
                               bool savePP_FMPT, bool saveDP_FMPT, bool savePP_MCS, bool saveDP_MCS,
-                              bool saveMCS, bool saveOutputs, bool saveOtherOutputs)
+                              bool saveMCS, bool saveOutputs, bool saveOtherOutputs,
+                              TOutputWriter *writer=NULL)
 {
+    //set of files to be written, which contains the outputs
+    PairPPDPFiles *files = NULL;
+
     try {
         //get the list of EnabledNotOperative RPs
         TRoboticPositionerList EnabledNotOperative;
@@ -1822,7 +2034,8 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
 
         //load the FMOSA from the file input_path
         string str;
-        OutputsPairPPDP outputs;
+        files = new PairPPDPFiles();
+        OutputsPairPPDP& outputs = files->outputs;
         unsigned int Bid;
         try {
             strReadFromFileWithComments(str, input_path);
@@ -1889,13 +2102,13 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
 
         //check the limiting case when there aren't allocations
         if(MPG.getCount() <= 0)
-            append("WARNING: there aren't allocations. The generated parking program will be empty.", log_path.c_str());
+            append("WARNING: there aren't allocations. The generated parking program will be empty.", log_path.c_str(), llWARNING);
         //check the limiting case when all operative RPs are in the origin
         else if(FMM.RPL.allOperativeRPsAreInTheOrigin())
-            append("WARNING: all operative RPs are in the origin. The generated pair (PP, DP) will be empty.", log_path.c_str());
+            append("WARNING: all operative RPs are in the origin. The generated pair (PP, DP) will be empty.", log_path.c_str(), llWARNING);
         //else, check the limiting case when all operative RPs are in security positions
         else if(Outsiders.getCount() <= 0)
-            append("WARNING: all operative RPs are in security positions. The generated pair (PP, DP) will contains only a message-instruction list to go to the observing positions and back to the origin.", log_path.c_str());
+            append("WARNING: all operative RPs are in security positions. The generated pair (PP, DP) will contains only a message-instruction list to go to the observing positions and back to the origin.", log_path.c_str(), llWARNING);
 
         //Now are fulfilled the preconditions for the function TMotionProgramGenerator::generatePairPPDP:
         //  All RPs of the Fiber MOS Model:
@@ -1943,6 +2156,7 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
             append("A pair (PP, DP) is not valid when a collision is detected during the validation process.", log_path.c_str());
             append("You can force generation of the not valid pair (PP, DP), typing the argument outputs.", log_path.c_str());
             append("Files outputs generated by force will contain an initial uncommented text for dificult their execution.", log_path.c_str());
+            delete files;
             return false;
         }
 
@@ -1982,6 +2196,11 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
 
         //SAVE FILES:
 
+        //The files which depend on the status of the FMM are formatted here,
+        //and the other ones are formatted from the outputs by the output
+        //writer, directly in their files. The messages are annotated in
+        //the log in their order, when the files have been written.
+
         //save OPL, if any
         string output_path;
         if(saveOPL) {
@@ -1989,8 +2208,7 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
             str += "\r\n"+OPL.getColumnText().str;
             ForceDirectories(AnsiString(output_dir));
             output_path = output_dir+"/PairPPDP_OPL_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("Observing Position List in format PPA in steps saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(output_path, "Observing Position List in format PPA in steps saved in file '"+output_path+"'.", str);
         }
 
         //Other whay to obtain the observing position list directly in text format:
@@ -2002,8 +2220,7 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
             str += "\r\n";
             str += FMM.RPL.getPositionsP3TableText().str;
             output_path = output_dir+"/PairPPDP_OPL-S0_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("Observing Position List in format CC respect S0 saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(output_path, "Observing Position List in format CC respect S0 saved in file '"+output_path+"'.", str);
         }
 
         //save OPL in cartesian coordinates respect S1, if any
@@ -2012,8 +2229,7 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
             str += "\r\n";
             str += FMM.RPL.getPositionsP_3TableText().str;
             output_path = output_dir+"/PairPPDP_OPL-S1_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("Observing Position List in format CC respect S1 saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(output_path, "Observing Position List in format CC respect S1 saved in file '"+output_path+"'.", str);
         }
 
         //save IPL, if any
@@ -2022,19 +2238,17 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
             str += "\r\n"+IPL.getColumnText().str;
             if(PPvalid && DPvalid) {
                 //warn about invalidity of the generated pair (PP, DP)
-                append("Generated pair (PP, DP) have passed the validation process, so the FMM is in the initial position.", log_path.c_str());
+                files->note("Generated pair (PP, DP) have passed the validation process, so the FMM is in the initial position.");
 
                 output_path = output_dir + "/PairPPDP_IPL_from_" + filename;
-                strWriteToFile(output_path, str);
-                append("Initial Position List saved in file '"+output_path+"'.", log_path.c_str());
+                files->add(output_path, "Initial Position List saved in file '"+output_path+"'.", str);
             } else {
                 //warn about invalidity of the generated pair (PP, DP)
-                append("Generated pair (PP, DP) have not passed the validation process, so the FMM is in the colliding position, detected during validation process.", log_path.c_str());
-                append("Will be saved Colliding Position List instead Initial Position List.", log_path.c_str());
+                files->note("Generated pair (PP, DP) have not passed the validation process, so the FMM is in the colliding position, detected during validation process.");
+                files->note("Will be saved Colliding Position List instead Initial Position List.");
 
                 output_path = output_dir + "/PairPPDP_CPL_from_" + filename;
-                strWriteToFile(output_path, str);
-                append("Colliding Position List saved in file '"+output_path+"'.", log_path.c_str());
+                files->add(output_path, "Colliding Position List saved in file '"+output_path+"'.", str);
             }
         }
 
@@ -2062,8 +2276,7 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
                 str += DispCorners1[i].getRowText().str;
             }
             output_path = output_dir+"/PairPPDP_DispCorners1_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("Displacement corners 1 saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(output_path, "Displacement corners 1 saved in file '"+output_path+"'.", str);
         }
 
         //save DispCorners2, if any
@@ -2090,143 +2303,136 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
                 str += DispCorners2[i].getRowText().str;
             }
             output_path = output_dir+"/PairPPDP_DispCorners2_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("Displacement corners 2 saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(output_path, "Displacement corners 2 saved in file '"+output_path+"'.", str);
         }
 
         //save PP_Dmin, if any
         if(savePP_Dmin) {
-            PP.getDminMCStext(str, "pos", Bid);
             output_path = output_dir+"/PairPPDP_PP-Dmin_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("PP-Dmin saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftPP_DMIN, output_path, "PP-Dmin saved in file '"+output_path+"'.");
         }
 
         //save PP_Dend, if any
         if(savePP_Dend) {
-            PP.getDendMCStext(str, "pos", Bid);
             output_path = output_dir+"/PairPPDP_PP-Dend_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("PP-Dend saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftPP_DEND, output_path, "PP-Dend saved in file '"+output_path+"'.");
         }
 
         //save DP_Dmin, if any
         if(saveDP_Dmin) {
-            DP.getDminMCStext(str, "depos", Bid);
             output_path = output_dir+"/PairPPDP_DP-Dmin_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("DP-Dmin saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftDP_DMIN, output_path, "DP-Dmin saved in file '"+output_path+"'.");
         }
 
         //save DP_Dend, if any
         if(saveDP_Dend) {
-            DP.getDendMCStext(str, "depos", Bid);
             output_path = output_dir+"/PairPPDP_DP-Dend_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("DP-Dend saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftDP_DEND, output_path, "DP-Dend saved in file '"+output_path+"'.");
         }
 
         //SAVE FILES ABOUT MPs:
 
         //save PP_FMPT, if any
         if(savePP_FMPT) {
-            str = PP.getText().str;
             output_path = output_dir+"/PairPPDP_PP-FMPT_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("PP in format FMPT saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftPP_FMPT, output_path, "PP in format FMPT saved in file '"+output_path+"'.");
         }
 
         //save DP_FMPT, if any
         if(saveDP_FMPT) {
-            str = DP.getText().str;
             output_path = output_dir+"/PairPPDP_DP-FMPT_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("DP in format FMPT saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftDP_FMPT, output_path, "DP in format FMPT saved in file '"+output_path+"'.");
         }
 
         //save PP, if any
         if(savePP_MCS) {
-            PP.getMCStext(str, "pos", Bid, IPL);
             output_path = output_dir+"/PairPPDP_PP-MCS_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("PP in format MCS saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftPP_MCS, output_path, "PP in format MCS saved in file '"+output_path+"'.");
         }
 
         //save DP, if any
         if(saveDP_MCS) {
-            DP.getMCStext(str, "depos", Bid, OPL);
             output_path = output_dir+"/PairPPDP_DP-MCS_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("DP in format MCS saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftDP_MCS, output_path, "DP in format MCS saved in file '"+output_path+"'.");
         }
 
         //save PairPPDP, if any
         if(saveMCS) {
-            string PP_str;
-            PP.getMCStext(PP_str, "pos", Bid, IPL);
-            string DP_str;
-            DP.getMCStext(DP_str, "depos", Bid, OPL);
             output_path = output_dir+"/PairPPDP_MCS_from_"+filename;
-            strWriteToFile(output_path, PP_str + "\r\n" + DP_str);
-            append("Pair (PP, DP) in format MCS saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftMCS, output_path, "Pair (PP, DP) in format MCS saved in file '"+output_path+"'.");
         }
 
         //save file outputs, if any
         bool suitable = outputs.suitable();
         if(suitable) {
             //save outputs in format MCS
-            outputs.getText(str);
             output_path = output_dir+"/PairPPDP_outputs_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("Outputs in format MCS, and FMOSA, saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftOUTPUTS, output_path, "Outputs in format MCS, and FMOSA, saved in file '"+output_path+"'.");
 
             //save outputs in format JSON
-            str = outputs.getJSONtext();
             output_path = output_dir + "/PairPPDP_outputs_from_" + stem(filename) + ".json";
-            strWriteToFile(output_path, str);
-            append("Outputs in format JSON saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftOUTPUTS_JSON, output_path, "Outputs in format JSON saved in file '"+output_path+"'.");
         }
         else { //not suitable
             //if force save outputs:
             if(saveOutputs) {
                 //warn about force saving file outputs
-                append("WARNING! Forced saving file outputs despite it is not suitable to be executed.", log_path.c_str());
-                append("Files outputs generated by force contain an initial uncommented text for dificult their execution.", log_path.c_str());
+                files->note("WARNING! Forced saving file outputs despite it is not suitable to be executed.", llWARNING);
+                files->note("Files outputs generated by force contain an initial uncommented text for dificult their execution.");
 
                 //save outputs in format MCS
-                outputs.getText(str);
                 output_path = output_dir+"/PairPPDP_outputs_from_"+filename;
-                strWriteToFile(output_path, str);
-                append("Outputs in format MCS saved in file '"+output_path+"'.", log_path.c_str());
+                files->add(PairPPDPFiles::ftOUTPUTS, output_path, "Outputs in format MCS saved in file '"+output_path+"'.");
 
                 //save outputs in format JSON
-                str = outputs.getJSONtext();
                 output_path = output_dir + "/PairPPDP_outputs_from_" + stem(filename) + ".json";
-                strWriteToFile(output_path, str);
-                append("Outputs in format JSON saved in file '"+output_path+"'.", log_path.c_str());
+                files->add(PairPPDPFiles::ftOUTPUTS_JSON, output_path, "Outputs in format JSON saved in file '"+output_path+"'.");
             }
             //if not force save outputs:
             else {
                 //warn about force saving file outputs
-                append("WARNING! File outputs will not be saved, because it is not suitable to be executed. You can force write outputs typing argument outputs.", log_path.c_str());
+                files->note("WARNING! File outputs will not be saved, because it is not suitable to be executed. You can force write outputs typing argument outputs.", llWARNING);
             }
         }
 
         //save other-outputs, if any
         if(saveOtherOutputs) {
-            outputs.getOtherText(str);
             output_path = output_dir+"/PairPPDP_other-outputs_from_"+filename;
-            strWriteToFile(output_path, str);
-            append("Other-outputs saved in file '"+output_path+"'.", log_path.c_str());
+            files->add(PairPPDPFiles::ftOTHER_OUTPUTS, output_path, "Other-outputs saved in file '"+output_path+"'.");
+        }
+
+        //write the files (the writer takes the ownership of the set)
+        PairPPDPFiles *Files = files;
+        files = NULL;
+        if(writer != NULL) {
+            //the files will be written in the background,
+            //and annotated in the log by the caller
+            writer->add(Files);
+        } else {
+            TOutputWriter W;
+            long processors = sysconf(_SC_NPROCESSORS_ONLN);
+            if(Files->getCount() > 1 && processors > 1)
+                W.start(min((unsigned int)processors, Files->getCount()) - 1);
+            W.add(Files);
+            vector<string> messages;
+            vector<TLogLevel> levels;
+            W.wait(messages, levels);
+            for(unsigned int i=0; i<messages.size(); i++)
+                append(messages[i], log_path.c_str(), levels[i]);
         }
 
         //indicates if the generated pair (PP, DP) is suitable to be executed
         return suitable;
     }
     catch(Exception& E) {
+        delete files;
         E.Message.Insert(1, "generating pair (PP, DP) offline: ");
         throw;
     }
+    catch(...) {
+        delete files;
+        throw;
+    }
 }
 
 //Test the function generatePairPPDP_offline.
@@ -2935,15 +3141,21 @@ void validatePairPPDP(TFiberMOSModel& FMM, string& outputs_path, string output_d
                 //outputs.FMOSA set above
 
                 //save outputs in format MCS
-                outputs.getText(str, true);
                 output_path = output_dir+"/PairPPDP_outputs_from_"+filename;
-                strWriteToFile(output_path, str);
+                {
+                    TTextOutputStream os(output_path);
+                    outputs.writeText(os, true);
+                    os.close();
+                }
                 append("Pair (PP, DP) in format MCS saved in file '"+output_path+"'.", log_path.c_str());
 
                 //save outputs in format JSON
-                str = outputs.getJSONtext();
                 output_path = output_dir + "/PairPPDP_outputs_from_" + stem(filename) + ".json";
-                strWriteToFile(output_path, str);
+                {
+                    TTextOutputStream os(output_path);
+                    outputs.writeJSONtext(os);
+                    os.close();
+                }
                 append("PairPPDP in format JSON saved in file '"+output_path+"'.", log_path.c_str());
             }
         }
@@ -3068,9 +3280,13 @@ void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP
 
         //The OPL is useful to get the DP in the interface format.
 
+        //move the RPs to the initial positions, where the regenerated
+        //pair (PP, DP) will be validated
+        FMM.RPL.setPositions(IPL);
+
         //attempt regenerate the pair (PP, DP)
-        TVector<int> Excluded;
-        bool regenerated = MPG.attemptRegenerate(Excluded, PP, DP);
+        TVector<int> Excluded, Replaced, Replacements;
+        bool regenerated = MPG.attemptRegenerate(Excluded, Replaced, Replacements, PP, DP);
 
         string output_path;
 
@@ -3078,6 +3294,10 @@ void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP
         if(regenerated) {
             string aux = "# The pair (PP, DP) has been regenerated excluding the following RPs:";
             aux += "\r\n# Excluded: " + Excluded.getText().str;
+            if(Replaced.getCount() > 0) {
+                aux += "\r\n# Replaced: " + Replaced.getText().str;
+                aux += "\r\n# Replacements: " + Replacements.getText().str;
+            }
             append(aux, log_path.c_str());
 
             //save the regenerated PP in format MCS
@@ -3091,6 +3311,44 @@ void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP
             output_path = "PairPPDP_regenerated-DP-MCS_from_"+filename;
             strWriteToFile(output_path, aux + "\r\n" + str);
             append("Regenerated DP in format MCS saved in file '"+output_path+"'.", log_path.c_str());
+
+            //transfer the allocations of the replaced RPs to the replacement RPs
+            FMOSA.transferAllocations(Replaced, Replacements);
+            if(Replaced.getCount() > 0)
+                append("Allocations of the replaced RPs transferred to the replacement RPs in the FMOSA.", log_path.c_str());
+
+            //set values in the structure outputs
+            OutputsPairPPDP outputs;
+            outputs.FMOSA_filename = filename;
+            outputs.FMPT_version = FMPT_VERSION;
+            outputs.datetime = strfromtime_t(time(NULL), "%Y-%m-%dT%H:%M:%S");
+            outputs.PPvalid = true;
+            outputs.DPvalid = true;
+            outputs.DsecMax = 1;
+            outputs.Bid = PP_Bid;
+            outputs.IPL = IPL;
+            outputs.PP = PP;
+            outputs.OPL = OPL;
+            outputs.DP = DP;
+            outputs.FMOSA = FMOSA;
+
+            //save the regenerated outputs in format MCS
+            output_path = "PairPPDP_regenerated-outputs_from_"+filename;
+            {
+                TTextOutputStream os(output_path);
+                outputs.writeText(os, true);
+                os.close();
+            }
+            append("Regenerated outputs in format MCS, and FMOSA, saved in file '"+output_path+"'.", log_path.c_str());
+
+            //save the regenerated outputs in format JSON
+            output_path = "PairPPDP_regenerated-outputs_from_" + stem(filename) + ".json";
+            {
+                TTextOutputStream os(output_path);
+                outputs.writeJSONtext(os);
+                os.close();
+            }
+            append("Regenerated outputs in format JSON saved in file '"+output_path+"'.", log_path.c_str());
         }
         else
             append("The pair (PP, DP) can not be regenerated.", log_path.c_str());
@@ -3101,6 +3359,488 @@ void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP
     }
 }
 
+//---------------------------------------------------------------------------------
+//FUNCTIONS FOR BATCH GENERATION OF PAIRS (PP, DP):
+//---------------------------------------------------------------------------------
+
+//Get the paths of the files type FMOSA to be processed in batch.
+//Inputs:
+//  path: path to a directory containing files type FMOSA,
+//      or path to a text file containing a path to a file type FMOSA per line.
+//Outputs:
+//  paths: the absolute paths of the files type FMOSA.
+//Notes:
+//- The files of a directory are sorted by name. Hidden files are ignored.
+//- Relative paths of a list are relative to the directory of the list.
+//  Empty lines and lines starting by '#' of a list are ignored.
+void getFMOSApaths(vector<string>& paths, const string& path)
+{
+    try {
+        //CHECK THE PRECONDITIONS:
+
+        struct stat sb;
+        if(stat(path.c_str(), &sb) != 0)
+            throw EImproperArgument("path '"+path+"' should be an existent file or directory");
+
+        //MAKE ACTIONS:
+
+        paths.clear();
+
+        //if the path is a directory, get all regular files
+        if(S_ISDIR(sb.st_mode)) {
+            TStringList SL;
+            ReadDir(&SL, AnsiString(path));
+            for(int i=0; i<SL.getCount(); i++) {
+                string name = SL.Strings[i].str;
+                if(name.length() <= 0 || name[0] == '.')
+                    continue;
+                string file_path = path+"/"+name;
+                if(stat(file_path.c_str(), &sb) == 0 && S_ISREG(sb.st_mode))
+                    paths.push_back(file_path);
+            }
+            sort(paths.begin(), paths.end());
+        }
+        //else, get the paths listed in the file
+        else {
+            string str;
+            strReadFromFile(str, path);
+
+            string dir, filename;
+            splitpath(dir, filename, path);
+
+            TStrings Lines;
+            StrSplit(Lines, AnsiString(str), '\n');
+            for(int i=0; i<Lines.getCount(); i++) {
+                string file_path = StrTrim(Lines[i]).str;
+                if(file_path.length() <= 0 || file_path[0] == '#')
+                    continue;
+                if(file_path[0] != '/')
+                    file_path.insert(0, dir+"/");
+                paths.push_back(file_path);
+            }
+        }
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "getting paths of files type FMOSA: ");
+        throw;
+    }
+}
+
+//job of a batch generation of pairs (PP, DP)
+struct BatchJob {
+    //path of the input file type FMOSA
+    string input_path;
+    //indicates if the generated pair (PP, DP) is suitable to be executed
+    bool suitable;
+    //elapsed time generating the pair (PP, DP) in seconds
+    double elapsed;
+    //message of the error happened during the generation, if any
+    string error;
+
+    //build a job by default
+    BatchJob(void) : input_path(), suitable(false), elapsed(0), error() {;}
+};
+
+//context shared by the workers of a batch generation of pairs (PP, DP)
+struct BatchContext {
+    //Fiber MOS Model to be cloned for each job
+    const TFiberMOSModel *FMM;
+    //jobs to be processed
+    vector<BatchJob> Jobs;
+    //index to the next job to be processed
+    unsigned int next;
+    //number of processed jobs
+    unsigned int done;
+    //mutex for access to (next, done) and for write in the log file
+    pthread_mutex_t mutex;
+
+    //path to the output dir where save the output files
+    string output_dir;
+    //path of the log file of the batch
+    string log_path;
+    //optional files to be saved for each job
+    SavingPairPPDP saving;
+};
+
+//get the current value of a monotonic clock in seconds
+double monotonicTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) + double(ts.tv_nsec)/1e9;
+}
+
+//get the path of the log file of a job of a batch generation of pairs (PP, DP)
+string batchJobLogPath(const BatchContext *C, const BatchJob& J)
+{
+    string dir, filename;
+    splitpath(dir, filename, J.input_path);
+    return C->output_dir+"/PairPPDP_log_from_"+filename;
+}
+
+//Finish a job of a batch generation of pairs (PP, DP),
+//waiting until their files have been written.
+//Inputs:
+//  C: shared context of the batch
+//  J: job to be finished
+//  W: output writer where the files of the job have been added
+void finishBatchJob(BatchContext *C, BatchJob& J, TOutputWriter& W)
+{
+    string log_path = batchJobLogPath(C, J);
+
+    //wait until the files of the job have been written
+    try {
+        vector<string> messages;
+        vector<TLogLevel> levels;
+        W.wait(messages, levels);
+        for(unsigned int i=0; i<messages.size(); i++)
+            append(messages[i], log_path.c_str(), levels[i]);
+    }
+    catch(Exception& E) {
+        if(J.error.length() <= 0)
+            J.error = E.Message.str;
+    }
+    catch(...) {
+        if(J.error.length() <= 0)
+            J.error = "unknown exception";
+    }
+
+    //the log file of the job isn't necessary anymore
+    logClose(log_path);
+
+    //annotate the end of the job
+    string dir, filename;
+    splitpath(dir, filename, J.input_path);
+    pthread_mutex_lock(&C->mutex);
+    C->done++;
+    string str = "["+uinttostr(C->done)+"/"+uinttostr(C->Jobs.size())+"] "+filename+": ";
+    if(J.error.length() > 0)
+        str += "ERROR: "+J.error;
+    else if(J.suitable)
+        str += "suitable";
+    else
+        str += "not suitable";
+    str += " ("+floattostr_fixed(J.elapsed, 3)+" s)";
+    append(str, C->log_path.c_str(), J.error.length() > 0 ? llERROR : llINFO);
+    std::cout << str << "\r\n";
+    std::cout.flush();
+    pthread_mutex_unlock(&C->mutex);
+}
+
+//Worker of a batch generation of pairs (PP, DP).
+//Each worker holds its own clones of the Fiber MOS Model and processes
+//the pending jobs until the queue is empty. Each job is started from
+//a fresh clone, so the result does not depend on the previous jobs.
+//The files of each job are written in the background by one of two
+//alternating output writers, while the next job is generated on
+//the other clone, because the files are formatted from its status.
+//Inputs:
+//  arg: pointer to the shared context (BatchContext).
+void *generatePairPPDP_worker(void *arg)
+{
+    BatchContext *C = (BatchContext*)arg;
+
+    //Fiber MOS Models for the current job and for the previous job
+    TFiberMOSModel FMM[2];
+
+    //output writers for the current job and for the previous job
+    //(if their workers can't be started, the files will be written
+    //when the job is finished)
+    TOutputWriter W[2];
+    for(int k=0; k<2; k++)
+        try {
+            W[k].start(1);
+        }
+        catch(...) {
+        }
+
+    //job pending to be finished, if any
+    BatchJob *Previous = NULL;
+    unsigned int n = 0;
+
+    while(true) {
+        //get the next job
+        pthread_mutex_lock(&C->mutex);
+        unsigned int i = C->next;
+        if(i < C->Jobs.size())
+            C->next++;
+        pthread_mutex_unlock(&C->mutex);
+        if(i >= C->Jobs.size())
+            break;
+        BatchJob& J = C->Jobs[i];
+
+        //build the log file of the job
+        string log_path = batchJobLogPath(C, J);
+
+        double t0 = monotonicTime();
+        try {
+            logReset(log_path);
+
+            //restore the initial status of the Fiber MOS Model
+            //(the files of the job which used it have been written)
+            TFiberMOSModel& M = FMM[n%2];
+            M.Clone(C->FMM);
+            M.assimilate();
+
+            //generate the pair (PP, DP) and write the files in the background
+            const SavingPairPPDP& S = C->saving;
+            J.suitable = generatePairPPDP_offline(M, J.input_path, C->output_dir, log_path,
+                                                  S.OPL, S.OPL_S0, S.OPL_S1,
+                                                  S.IPL, S.DispCorners1, S.DispCorners2,
+                                                  S.PP_Dmin, S.PP_Dend, S.DP_Dmin, S.DP_Dend,
+                                                  S.PP_FMPT, S.DP_FMPT, S.PP_MCS, S.DP_MCS,
+                                                  S.MCS, S.outputs, S.other_outputs,
+                                                  &W[n%2]);
+        }
+        catch(Exception& E) {
+            J.error = E.Message.str;
+        }
+        catch(...) {
+            J.error = "unknown exception";
+        }
+        J.elapsed = monotonicTime() - t0;
+
+        //finish the previous job, whose files have been written
+        //while the current job was generated
+        if(Previous != NULL)
+            finishBatchJob(C, *Previous, W[(n+1)%2]);
+        Previous = &J;
+        n++;
+    }
+
+    //finish the last job
+    if(Previous != NULL)
+        finishBatchJob(C, *Previous, W[(n+1)%2]);
+
+    return NULL;
+}
+
+//Generate pairs (PP, DP) offline for a set of files type FMOSA.
+//The Fiber MOS Model is loaded once and cloned by each worker.
+//Inputs:
+//  FMM: the Fiber MOS Model in their initial status
+//  paths: paths of the input files type FMOSA
+//  output_dir: path to the output dir where save the output files
+//  log_path: file name of the log file where anotate events
+//  workers: number of workers generating pairs in parallel
+//  saving: optional files to be saved for each input file
+//Outputs:
+//  generatePairPPDP_batch: number of generated pairs suitable to be executed
+//Postconditions:
+//- For each input file are saved the same files than generatePairPPDP_offline,
+//  and the log file PairPPDP_log_from_<filename>.
+//- The summary table of the batch is saved in the file PairPPDP_batch_summary.txt.
+unsigned int generatePairPPDP_batch(const TFiberMOSModel& FMM, const vector<string>& paths,
+                                    const string& output_dir, const string& log_path,
+                                    unsigned int workers, const SavingPairPPDP& saving)
+{
+    try {
+        //CHECK THE PRECONDITIONS:
+
+        if(workers < 1)
+            throw EImproperArgument("number of workers should be upper zero");
+
+        //MAKE ACTIONS:
+
+        //build the context shared by the workers
+        BatchContext C;
+        C.FMM = &FMM;
+        C.Jobs.resize(paths.size());
+        for(unsigned int i=0; i<paths.size(); i++)
+            C.Jobs[i].input_path = paths[i];
+        C.next = 0;
+        C.done = 0;
+        pthread_mutex_init(&C.mutex, NULL);
+        C.output_dir = output_dir;
+        C.log_path = log_path;
+        C.saving = saving;
+
+        //there is no sense build more workers than jobs
+        if(workers > C.Jobs.size())
+            workers = C.Jobs.size();
+
+        ForceDirectories(AnsiString(output_dir));
+        append("Generating "+uinttostr(C.Jobs.size())+" pairs (PP, DP) with "+uinttostr(workers)+" workers...", log_path.c_str());
+
+        //the output of each job is written in their own log file
+        bool echo = append_echo;
+        append_echo = false;
+
+        //run the workers and wait until all jobs have been processed
+        double t0 = monotonicTime();
+        vector<pthread_t> threads(workers);
+        unsigned int started = 0;
+        for(unsigned int i=0; i<workers; i++)
+            if(pthread_create(&threads[i], NULL, generatePairPPDP_worker, &C) == 0)
+                started++;
+            else
+                break;
+        //if no worker can be started, process the jobs in this thread
+        if(started <= 0)
+            generatePairPPDP_worker(&C);
+        for(unsigned int i=0; i<started; i++)
+            pthread_join(threads[i], NULL);
+        double elapsed = monotonicTime() - t0;
+
+        append_echo = echo;
+        pthread_mutex_destroy(&C.mutex);
+
+        //build the summary table
+        unsigned int count = 0;
+        double total = 0;
+        string str = "FMOSA\tsuitable\ttime(s)\terror";
+        for(unsigned int i=0; i<C.Jobs.size(); i++) {
+            const BatchJob& J = C.Jobs[i];
+            string dir, filename;
+            splitpath(dir, filename, J.input_path);
+            str += "\r\n"+filename;
+            str += "\t"+string(J.suitable ? "true" : "false");
+            str += "\t"+floattostr_fixed(J.elapsed, 3);
+            str += "\t"+J.error;
+            if(J.suitable)
+                count++;
+            total += J.elapsed;
+        }
+        str += "\r\n# Suitable pairs: "+uinttostr(count)+"/"+uinttostr(C.Jobs.size());
+        str += "\r\n# Sum of job times: "+floattostr_fixed(total, 3)+" s";
+        str += "\r\n# Elapsed time: "+floattostr_fixed(elapsed, 3)+" s";
+
+        //print and save the summary table
+        append("", log_path.c_str());
+        append(str, log_path.c_str());
+        string output_path = output_dir+"/PairPPDP_batch_summary.txt";
+        strWriteToFile(output_path, str);
+        append("Summary of the batch saved in file '"+output_path+"'.", log_path.c_str());
+
+        return count;
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "generating pairs (PP, DP) in batch: ");
+        throw;
+    }
+}
+
+//---------------------------------------------------------------------------------
+//FUNCTIONS FOR THE REQUEST SERVER:
+//---------------------------------------------------------------------------------
+
+//Get the requests of a file, one per line.
+//Empty lines and lines starting with '#' are ignored.
+void getRequests(vector<string>& requests, const string& path)
+{
+    try {
+        string str;
+        strReadFromFile(str, path);
+
+        requests.clear();
+        size_t i = 0;
+        while(i < str.length()) {
+            size_t j = str.find('\n', i);
+            if(j == string::npos)
+                j = str.length();
+            string line = str.substr(i, j - i);
+            i = j + 1;
+
+            if(line.length() > 0 && line[line.length() - 1] == '\r')
+                line.erase(line.length() - 1);
+            if(line.find_first_not_of(" \t") == string::npos || line[0] == '#')
+                continue;
+            requests.push_back(line);
+        }
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "getting requests: ");
+        throw;
+    }
+}
+
+//Send the requests of a file to a daemon and print the responses.
+//Inputs:
+//  socket_path: path to the Unix domain socket where the daemon listen
+//  requests_path: path to the file of requests (one per line)
+void sendRequests(const string& socket_path, const string& requests_path)
+{
+    try {
+        vector<string> requests;
+        getRequests(requests, requests_path);
+
+        TRequestClient RC;
+        RC.connectTo(socket_path);
+
+        //send all requests, so the daemon can process them concurrently
+        for(unsigned int i=0; i<requests.size(); i++)
+            RC.send(requests[i]);
+        for(unsigned int i=0; i<requests.size(); i++)
+            cout << RC.receive() << endl;
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "sending requests: ");
+        throw;
+    }
+}
+
+//Send the requests of a file to a daemon one by one,
+//and print the statistics of the latency.
+//Inputs:
+//  socket_path: path to the Unix domain socket where the daemon listen
+//  requests_path: path to the file of requests (one per line)
+//  repeat: number of times that the requests are sent
+void benchmarkRequests(const string& socket_path, const string& requests_path,
+                       unsigned int repeat)
+{
+    try {
+        //CHECK THE PRECONDITIONS:
+
+        if(repeat < 1)
+            throw EImproperArgument("number of repetitions should be upper zero");
+
+        vector<string> requests;
+        getRequests(requests, requests_path);
+        if(requests.size() <= 0)
+            throw EImproperArgument("file '"+requests_path+"' should contains almost one request");
+
+        //MAKE ACTIONS:
+
+        TRequestClient RC;
+        RC.connectTo(socket_path);
+
+        //measure the time between send each request and receive their response
+        vector<double> latencies;
+        unsigned int failed = 0;
+        Json::Reader reader;
+        for(unsigned int k=0; k<repeat; k++)
+            for(unsigned int i=0; i<requests.size(); i++) {
+                double t0 = monotonicTime();
+                RC.send(requests[i]);
+                string response = RC.receive();
+                latencies.push_back(monotonicTime() - t0);
+
+                Json::Value R;
+                if(!reader.parse(response, R) || !R["ok"].asBool())
+                    failed++;
+            }
+
+        //calculates the statistics
+        std::sort(latencies.begin(), latencies.end());
+        double total = 0;
+        for(unsigned int i=0; i<latencies.size(); i++)
+            total += latencies[i];
+        unsigned int n = latencies.size();
+
+        //print the statistics in ms
+        cout << "Requests: " << n << " (failed: " << failed << ")" << endl;
+        cout << "Latency min: " << floattostr_fixed(latencies[0]*1000, 3) << " ms" << endl;
+        cout << "Latency median: " << floattostr_fixed(latencies[n/2]*1000, 3) << " ms" << endl;
+        cout << "Latency mean: " << floattostr_fixed(total/n*1000, 3) << " ms" << endl;
+        cout << "Latency p95: " << floattostr_fixed(latencies[(n*95)/100 < n ? (n*95)/100 : n - 1]*1000, 3) << " ms" << endl;
+        cout << "Latency max: " << floattostr_fixed(latencies[n - 1]*1000, 3) << " ms" << endl;
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "benchmarking requests: ");
+        throw;
+    }
+}
+
 //---------------------------------------------------------------------------------
 //MAIN FUNCTION:
 //---------------------------------------------------------------------------------
@@ -3205,6 +3945,19 @@ void getArguments(int& argc, char* argv[], const string& command)
     else if(command == "test_generatePairPPDP_online") {
         argc = 2;
     }
+    else if(command == "generatePairPPDP_batch") {
+        argc = 4;
+        string *arg2 = new string(getCurrentDir()+"/../megarafmpt/data/Samples");
+        argv[2] = (char*)arg2->c_str();
+        //-----------------------------
+        string *arg3 = new string("all");
+        argv[3] = (char*)arg3->c_str();
+    }
+    else if(command == "daemon") {
+        argc = 3;
+        string *arg2 = new string("jobs=1");
+        argv[2] = (char*)arg2->c_str();
+    }
     else if(command == "checkPairPPDP") {
         argc = 5;
         string *arg2 = new string(getCurrentDir()+"/PairPPDP_PP-MCS_from_megara-cb_90sources.txt");
@@ -3425,6 +4178,37 @@ int main(int argc, char *argv[])
             //indicates that the program has been executed without error
             return 0;
         }
+        else if(command == "daemon_client") {
+            //check the precondition
+            if(argc != 4)
+                throw EImproperArgument("command daemon_client should have 2 arguments: <socket_path> <requests_path>");
+
+            //send the requests and print the responses
+            sendRequests(string(argv[2]), string(argv[3]));
+            //indicates that the program has been executed without error
+            return 0;
+        }
+        else if(command == "daemon_benchmark") {
+            //check the precondition
+            if(argc!=4 && argc!=5)
+                throw EImproperArgument("command daemon_benchmark should have 2 or 3 arguments: <socket_path> <requests_path> [repeat=<N>]");
+
+            //get the number of repetitions
+            int repeat = 1;
+            if(argc == 5) {
+                string argument(argv[4]);
+                if(argument.find("repeat=") != 0)
+                    throw EImproperArgument("unknown argument: "+argument);
+                repeat = StrToInt(AnsiString(argument.substr(7)));
+                if(repeat < 1)
+                    throw EImproperArgument("number of repetitions should be upper zero");
+            }
+
+            //send the requests and print the statistics
+            benchmarkRequests(string(argv[2]), string(argv[3]), (unsigned int)repeat);
+            //indicates that the program has been executed without error
+            return 0;
+        }
         else if(command != "valuesSPM_EA" &&
                 command != "valuesSPM_RP" &&
                 command != "testRadialMotion" &&
@@ -3443,6 +4227,8 @@ int main(int argc, char *argv[])
                 command != "generatePairPPDP_offline" &&
                 command != "test_generatePairPPDP_offline" &&
                 command != "test_generatePairPPDP_online" &&
+                command != "generatePairPPDP_batch" &&
+                command != "daemon" &&
                 command != "checkPairPPDP" &&
                 command != "validatePairPPDP" &&
                 command != "regeneratePairPPDP") {
@@ -3457,11 +4243,22 @@ int main(int argc, char *argv[])
             return 0;
         }
 
+        //the daemon without socket uses the stdout for the responses
+        if(command == "daemon") {
+            bool socket = false;
+            for(int i=2; i<argc; i++)
+                if(string(argv[i]).find("socket=") == 0)
+                    socket = true;
+            if(!socket)
+                append_echo = false;
+        }
+
         //initalize the log file
         log_path = "fmpt_saa.log";
-        char mode[] = "w";
-        TTextFile TF(log_path.c_str(), mode);
-        TF.Close();
+        logReset(log_path);
+        //write the log files periodically,
+        //so they can be followed during the long executions
+        logStartFlusher();
     }
     catch(Exception &E) {
         //indicates that has happened an exception
@@ -3495,7 +4292,7 @@ int main(int argc, char *argv[])
         if(FMM_dir.length() <= 0) {
             try {
                 append("\r\nLoading FMM Instance from directory '"+FMM_dir1+"'.", log_path.c_str());
-                readInstanceFromDir(FMM, FMM_dir1);
+                readInstanceFromDirUsingSnapshot(FMM, FMM_dir1);
                 FMM_dir = FMM_dir1;
             }
             catch(ECantComplete& E) {
@@ -3522,7 +4319,7 @@ int main(int argc, char *argv[])
         //try load the FMM Instance from dir 1
         try {
             append("\r\nLoading FMM Instance from directory '"+FMM_dir1+"'.", log_path.c_str());
-            readInstanceFromDir(FMM, FMM_dir1);
+            readInstanceFromDirUsingSnapshot(FMM, FMM_dir1);
             FMM_dir = FMM_dir1;
         }
         catch(ECantComplete& E) {
@@ -3540,7 +4337,7 @@ int main(int argc, char *argv[])
         if(FMM_dir.length() <= 0) {
             try {
                 append("\r\nLoading FMM Instance from directory '"+FMM_dir2+"'.", log_path.c_str());
-                readInstanceFromDir(FMM, FMM_dir2);
+                readInstanceFromDirUsingSnapshot(FMM, FMM_dir2);
                 FMM_dir = FMM_dir2;
             }
             catch(ECantComplete& E) {
@@ -3902,77 +4699,123 @@ int main(int argc, char *argv[])
             if(arg1[0] != '/')
                 arg1.insert(0, getCurrentDir()+"/");
 
-            bool saveAll=false;
-            bool saveOPL=false, saveOPL_S0=false, saveOPL_S1=false;
-            bool saveIPL=false, saveDispCorners1=false, saveDispCorners2=false;
-            bool savePP_Dmin=false, savePP_Dend=false, saveDP_Dmin=false, saveDP_Dend=false;
-            bool savePP_FMPT=false, saveDP_FMPT=false, savePP_MCS=false, saveDP_MCS=false;
-            bool saveMCS=false, save_outputs=false, save_other_outputs=false;
+            //get the optional files to be saved
+            SavingPairPPDP S;
+            for(int i=3; i<argc; i++)
+                S.setArgument(string(argv[i]));
+
+            //generate a pair (PP, DP) from a path and write the events in the log file
+            generatePairPPDP_offline(FMM, arg1, ".", log_path,
+                                     //------------------------------------------------------------
+                                     S.OPL, S.OPL_S0, S.OPL_S1,
+                                     S.IPL, S.DispCorners1, S.DispCorners2,
+                                     S.PP_Dmin, S.PP_Dend, S.DP_Dmin, S.DP_Dend,
+                                     S.PP_FMPT, S.DP_FMPT, S.PP_MCS, S.DP_MCS,
+                                     S.MCS, S.outputs, S.other_outputs);
+        }
+        else if(command == "generatePairPPDP_batch") {
+            //check the precondition
+            if(argc < 3)
+                throw EImproperArgument("command generatePairPPDP_batch sould have almost 1 argument: <FMOSA_list_or_dir>");
+
+            //build a string for the argument 1
+            string arg1(argv[2]);
+
+            //make a rutinary check
+            if(arg1.length() <= 0)
+                throw EImpossibleError("lateral effect");
+
+            //reacts according the comands without log file
+            if(arg1 == "help") {
+                //print the help
+                cout << help_generatePairPPDP_offline() << endl;
+                cout << endl;
+                //indicates that the program has been executed without error
+                return 0;
+            }
+
+            //complete the relative path, if any
+            if(arg1[0] != '/')
+                arg1.insert(0, getCurrentDir()+"/");
+
+            //get the number of workers and the optional files to be saved
+            long workers = sysconf(_SC_NPROCESSORS_ONLN);
+            if(workers < 1)
+                workers = 1;
+            SavingPairPPDP S;
             for(int i=3; i<argc; i++) {
                 string argument(argv[i]);
-                //------------------------------------
-                if(argument == "all")
-                    saveAll = true;
-                //------------------------------------
-                else if(argument == "OPL")
-                    saveOPL = true;
-                else if(argument == "OPL-S0")
-                    saveOPL_S0 = true;
-                else if(argument == "OPL-S1")
-                    saveOPL_S1 = true;
-                //------------------------------------
-                else if(argument == "IPL")
-                    saveIPL = true;
-                else if(argument == "DispCorners1")
-                    saveDispCorners1 = true;
-                else if(argument == "DispCorners2")
-                    saveDispCorners2 = true;
-                //------------------------------------
-                else if(argument == "PP-Dmin")
-                    savePP_Dmin = true;
-                else if(argument == "PP-Dend")
-                    savePP_Dend = true;
-                else if(argument == "DP-Dmin")
-                    saveDP_Dmin = true;
-                else if(argument == "DP-Dend")
-                    saveDP_Dend = true;
-                //------------------------------------
-                else if(argument == "PP-FMPT")
-                    savePP_FMPT = true;
-                else if(argument == "DP-FMPT")
-                    saveDP_FMPT = true;
-                else if(argument == "PP-MCS")
-                    savePP_MCS = true;
-                else if(argument == "DP-MCS")
-                    saveDP_MCS = true;
-                //------------------------------------
-                else if(argument == "MCS")
-                    saveMCS = true;
-                else if(argument == "outputs")
-                    save_outputs = true;
-                else if(argument == "other-outputs")
-                    save_other_outputs = true;
-                //------------------------------------
+                if(argument.find("jobs=") == 0) {
+                    workers = StrToInt(AnsiString(argument.substr(5)));
+                    if(workers < 1)
+                        throw EImproperArgument("number of jobs should be upper zero");
+                }
+                else
+                    S.setArgument(argument);
+            }
+
+            //get the paths of the files type FMOSA
+            vector<string> paths;
+            getFMOSApaths(paths, arg1);
+            if(paths.size() <= 0)
+                throw EImproperArgument("there aren't files type FMOSA in '"+arg1+"'");
+            append("Got "+uinttostr(paths.size())+" files type FMOSA from '"+arg1+"'.", log_path.c_str());
+
+            //generate the pairs (PP, DP) and write the events in the log files
+            generatePairPPDP_batch(FMM, paths, ".", log_path, (unsigned int)workers, S);
+        }
+        else if(command == "daemon") {
+            //get the arguments
+            string socket_path;
+            long workers = sysconf(_SC_NPROCESSORS_ONLN);
+            if(workers < 1)
+                workers = 1;
+            double timeout = 0;
+            vector<string> names, dirs;
+            for(int i=2; i<argc; i++) {
+                string argument(argv[i]);
+                if(argument.find("socket=") == 0)
+                    socket_path = argument.substr(7);
+                else if(argument.find("jobs=") == 0) {
+                    workers = StrToInt(AnsiString(argument.substr(5)));
+                    if(workers < 1)
+                        throw EImproperArgument("number of jobs should be upper zero");
+                }
+                else if(argument.find("timeout=") == 0)
+                    timeout = StrToFloat(AnsiString(argument.substr(8)));
+                else if(argument.find("instance=") == 0) {
+                    size_t pos = argument.find(':', 9);
+                    if(pos == string::npos)
+                        throw EImproperArgument("argument instance should be <name>:<dir>");
+                    names.push_back(argument.substr(9, pos - 9));
+                    dirs.push_back(argument.substr(pos + 1));
+                }
                 else
                     throw EImproperArgument("unknown argument: "+argument);
             }
 
-            if(saveAll) {
-                saveOPL=true, saveOPL_S0=true, saveOPL_S1=true;
-                saveIPL=true, saveDispCorners1=true, saveDispCorners2=true;
-                savePP_Dmin=true, savePP_Dend=true, saveDP_Dmin=true, saveDP_Dend=true;
-                savePP_FMPT=true, saveDP_FMPT=true, savePP_MCS=true, saveDP_MCS=true;
-                saveMCS=true, save_outputs=true, save_other_outputs=true;
+            //build the server with the FMM Instances resident
+            TRequestServer RS;
+            RS.setTimeout(timeout);
+            RS.addInstance("default", FMM);
+            for(unsigned int i=0; i<names.size(); i++) {
+                TFiberMOSModel FMM_;
+                append("Loading FMM Instance '"+names[i]+"' from directory '"+dirs[i]+"'.", log_path.c_str());
+                readInstanceFromDirUsingSnapshot(FMM_, dirs[i]);
+                RS.addInstance(names[i], FMM_);
             }
+            RS.start((unsigned int)workers);
+            append("Request server started with "+inttostr(int(workers))+" workers.", log_path.c_str());
 
-            //generate a pair (PP, DP) from a path and write the events in the log file
-            generatePairPPDP_offline(FMM, arg1, ".", log_path,
-                                     //------------------------------------------------------------
-                                     saveOPL, saveOPL_S0, saveOPL_S1,
-                                     saveIPL, saveDispCorners1, saveDispCorners2,
-                                     savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend,
-                                     savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS,
-                                     saveMCS, save_outputs, save_other_outputs);
+            //serve the requests
+            if(socket_path.length() > 0) {
+                append("Listening in the Unix domain socket '"+socket_path+"'...", log_path.c_str());
+                RS.serveUnixSocket(socket_path);
+            }
+            else
+                RS.serve(0, 1);
+            RS.stop();
+            append("Request server stopped.", log_path.c_str());
         }
         else if(command == "test_generatePairPPDP_offline") {
             //check the precondition
@@ -4122,12 +4965,12 @@ int main(int argc, char *argv[])
     catch(Exception &E) {
         //indicates that has happened an exception
         //and show the message of the exception
-        append("ERROR: "+E.Message.str, log_path.c_str());
+        append("ERROR: "+E.Message.str, log_path.c_str(), llERROR);
         return 1;
     }
     catch(...) {
         //indicates that has happened an unknown exception
-        append("ERROR: unknown exception", log_path.c_str());
+        append("ERROR: unknown exception", log_path.c_str(), llERROR);
         return 2;
     }
 
@@ -0,0 +1,22 @@
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+int main()
+{
+    //get the top level suite from the registry
+    CppUnit::Test *suite = CppUnit::TestFactoryRegistry::getRegistry().makeTest();
+
+    //add the test to the list of test to run
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( suite );
+
+    //change the default outputter to a compiler error format outputter
+    runner.setOutputter(new CppUnit::CompilerOutputter(&runner.result(), std::cerr));
+
+    //run the tests
+    bool wasSucessful = runner.run();
+
+    //return error code 1 if the one of test failed
+    return wasSucessful ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testAdjacencyGraph.cpp
+//Content: test for the module AdjacencyGraph
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testAdjacencyGraph.h"
+#include "../src/AdjacencyGraph.h"
+#include "../src/RoboticPositionerList1.h"
+#include "../src/ExclusionArea.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+using namespace Models;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestAdjacencyGraph);
+
+//overide setUp(), init data, etc
+void TestAdjacencyGraph::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestAdjacencyGraph::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+void TestAdjacencyGraph::test_build()
+{
+    try {
+        //build a list of three RPs in a row and one isolated RP
+        TRoboticPositionerList1 RPL;
+        for(int Id=1; Id<=4; Id++)
+            RPL.Add(new TRoboticPositioner(Id, TDoublePoint(Id*10, 0)));
+        TExclusionArea EA(1, TDoublePoint(0, 0));
+
+        //set the adjacents
+        RPL[0]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[1]));
+        RPL[1]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[2]));
+        RPL[1]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[0]));
+        RPL[2]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[1]));
+        RPL[0]->getActuator()->AdjacentEAs.Add(TAdjacentEA(&EA));
+
+        //build the graph
+        const TAdjacencyGraph& G = RPL.getAdjacency();
+        if(!G.getBuilt() || G.getRPsCount()!=4 || G.getEAsCount()!=1 ||
+                G.getRPPairsCount()!=2 || G.getEAPairsCount()!=1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //check the edges between RPs
+        if(G.getRPDegree(0)!=1 || G.getRPDegree(1)!=2 || G.getRPDegree(2)!=1 ||
+                G.getRPDegree(3)!=0 || G.beginRPs(3)!=G.endRPs(3)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        const TAdjacencyEdge *E = G.beginRPs(1);
+        if(E[0].Target!=2 || E[0].Slot!=0 || E[1].Target!=0 || E[1].Slot!=1 ||
+                E[1].Pair!=G.beginRPs(0)->Pair || E[0].Pair!=G.beginRPs(2)->Pair ||
+                E[0].Pair==E[1].Pair || G.getRP(E[0].Target)!=RPL[2]) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //check the edges to EAs
+        if(G.endEAs(0)-G.beginEAs(0)!=1 || G.beginEAs(1)!=G.endEAs(1) ||
+                G.getEA(G.beginEAs(0)->Target)!=&EA) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the graph is invalidated when the list is modified
+        RPL.Destroy(3);
+        if(G.getBuilt() || RPL.getAdjacency().getRPsCount()!=3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        RPL.Destroy();
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestAdjacencyGraph::test_reorder()
+{
+    try {
+        //build a list of three RPs in a row
+        TRoboticPositionerList1 RPL;
+        for(int Id=1; Id<=3; Id++)
+            RPL.Add(new TRoboticPositioner(Id, TDoublePoint(Id*10, 0)));
+        RPL[0]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[1]));
+        RPL[1]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[0]));
+        RPL[1]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[2]));
+        RPL[2]->getActuator()->AdjacentRPs.Add(TAdjacentRP(RPL[1]));
+
+        //build the graph and reorder the list through the base class
+        RPL.getAdjacency();
+        RPL.SortDec();
+        if(RPL[0]->getActuator()->getId() != 3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the graph shall follow the new order of the list
+        const TAdjacencyGraph& G = RPL.getAdjacency();
+        for(int i=0; i<RPL.getCount(); i++) {
+            const TRoboticPositioner *RP = RPL[i];
+            if(G.getRP(i) != RP ||
+                    G.getRPDegree(i) != RP->getActuator()->AdjacentRPs.getCount()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(const TAdjacencyEdge *E=G.beginRPs(i); E!=G.endRPs(i); E++)
+                if(G.getRP(E->Target) != RP->getActuator()->AdjacentRPs[E->Slot].RP) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+
+        //and shall be rebuilt again when the order is restored
+        RPL.SortInc();
+        if(RPL.getAdjacency().getRP(0) != RPL[0] ||
+                RPL.getAdjacency().getRPDegree(1) != 2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        RPL.Destroy();
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -0,0 +1,208 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testArena.cpp
+//Content: test for the module Arena
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testArena.h"
+#include "../src/Arena.h"
+#include "../src/MotionProgram.h"
+#include "../src/ContourFigureList.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+using namespace Lists;
+using namespace Models;
+using namespace Positioning;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestArena);
+
+//overide setUp(), init data, etc
+void TestArena::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestArena::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+void TestArena::test_scope()
+{
+    try {
+        //without scope there isn't arena
+        if(TArena::getCurrent() != NULL) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        {
+            TArenaScope AS;
+            const TArena *A = TArena::getCurrent();
+            if(A==NULL || A->getChunksCount()!=0) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+
+            //the nested scopes use the same arena
+            {
+                TArenaScope AS2;
+                if(TArena::getCurrent() != A) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+            if(TArena::getCurrent() != A) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+
+            //the blocks are taken from the chunks of the arena
+            void *p1 = TArena::allocate(10);
+            void *p2 = TArena::allocate(10);
+            void *p3 = TArena::allocate(2*TArena::ChunkSize);
+            if(A->getChunksCount()!=2 || (char*)p2<=(char*)p1 || (char*)p1+64<(char*)p2 ||
+                    intptr_t(p1)%sizeof(double)!=0 || intptr_t(p2)%sizeof(double)!=0) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            TArena::deallocate(p1);
+            TArena::deallocate(p2);
+            TArena::deallocate(p3);
+        }
+
+        //closed the scope there isn't arena
+        if(TArena::getCurrent() != NULL) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the blocks allocated without arena are taken from the heap
+        void *p = TArena::allocate(10);
+        TArena::deallocate(p);
+        TArena::deallocate(NULL);
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestArena::test_items()
+{
+    try {
+        TMotionProgram *MP = new TMotionProgram();
+        TContourFigureList *CFL = new TContourFigureList();
+        {
+            TArenaScope AS;
+
+            //build a MP with MIs in the arena
+            for(int i=0; i<3; i++) {
+                TMessageList *ML = new TMessageList();
+                for(int j=1; j<=50; j++)
+                    ML->Add(new TMessageInstruction(j, "M2 0"));
+                MP->Add(ML);
+            }
+
+            //build a contour with figures in the arena
+            CFL->Add(new TSegment(TDoublePoint(0, 0), TDoublePoint(1, 0)));
+            CFL->Add(new TArc(TDoublePoint(1, 0), TDoublePoint(0, 1), TDoublePoint(0, 0), 1));
+
+            if(TArena::getCurrent()->getChunksCount() != 1) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+
+        //the objects survive to the scope
+        if(MP->getCount()!=3 || MP->Get(2).getCount()!=50 ||
+                MP->Get(2).Get(49).getId()!=50 || CFL->getCount()!=2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //destroy the objects, releasing the arena
+        MP->Delete(0);
+        delete MP;
+        delete CFL->Get(0);
+        delete CFL->Get(1);
+        delete CFL;
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestArena::test_reuse()
+{
+    try {
+        TArenaScope AS;
+        const TArena *A = TArena::getCurrent();
+
+        //the freed blocks are reused by the blocks of the same size class
+        void *p1 = TArena::allocate(10);
+        void *p2 = TArena::allocate(100);
+        TArena::deallocate(p1);
+        void *p3 = TArena::allocate(100);
+        void *p4 = TArena::allocate(16);
+        if(p3==p2 || p4!=p1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        TArena::deallocate(p2);
+        TArena::deallocate(p3);
+        TArena::deallocate(p4);
+
+        //the arena doesn't grow when a MP is copied and destroyed repeatedly
+        TMotionProgram MP;
+        for(int i=0; i<3; i++) {
+            TMessageList *ML = new TMessageList();
+            for(int j=1; j<=50; j++)
+                ML->Add(new TMessageInstruction(j, "M2 0"));
+            MP.Add(ML);
+        }
+        int count = 0;
+        for(int i=0; i<1000; i++) {
+            TMotionProgram *Copy = new TMotionProgram(MP);
+            delete Copy;
+
+            if(i == 0)
+                count = A->getChunksCount();
+            else if(A->getChunksCount() != count) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
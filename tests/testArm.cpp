@@ -387,3 +387,42 @@ void TestArm::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestArm::test_compiled()
+{
+    try {
+        //construye un brazo
+        TArm A(TDoublePoint(-5.8025, 0), 0);
+
+        //las funciones de cuantificación deben estar compiladas
+        if(!A.getF().getCompiled() || !A.getG().getCompiled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //cambia la cuantificación a un valor distinto del por defecto
+        A.setQuantification(A.getSB2()*2);
+
+        //las funciones reconstruidas deben estar compiladas
+        if(!A.getF().getCompiled() || !A.getG().getCompiled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //asigna F en formato texto
+        A.setFPointsText(A.getF().getPointsText());
+
+        //las funciones asignadas deben estar compiladas
+        if(!A.getF().getCompiled() || !A.getG().getCompiled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//---------------------------------------------------------------------------
@@ -531,3 +531,30 @@ void TestCilinder::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestCilinder::test_compiled()
+{
+    try {
+        //las funciones de cuantificación deben estar compiladas
+        if(!C->getF().getCompiled() || !C->getG().getCompiled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //asigna F en formato texto
+        C->setFPointsText(C->getF().getPointsText());
+
+        //las funciones asignadas deben estar compiladas
+        if(!C->getF().getCompiled() || !C->getG().getCompiled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//---------------------------------------------------------------------------
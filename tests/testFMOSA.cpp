@@ -159,3 +159,156 @@ void TestFMOSA::test_()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestFMOSA::test_setTableText()
+{
+    //build a string with the content of a little FMOSA file
+    string str;
+    str = "# Id| Ra| Dec| Pos";
+    str += "\r\n@@SOB@@";
+    str += "\r\n0| 15.027879| 45.000422| 0.060858";
+    str += "\r\n@@EOB@@";
+    str += "\r\n#      Name             RA         Dec    Mag        Type         Pr  Bid Pid   X(mm)     Y(mm)  Angle Enabled      Comment";
+    str += "\r\n@@SOS@@";
+    str += "\r\ns:751               |15.027787|45.017925|20.67|SOURCE          |6 |0  |1  |-0.137909 |51.932865 |0.0|1|foo comment         ";
+    str += "\r\n                    |15.003376|45.028110|     |UNKNOWN         |  |   |2  |-51.296480|82.217116 |0.0|0|                    ";
+    str += "\r\n@@EOS@@";
+
+    //set the string in a FMOSA
+    TFMOSA FMOSA;
+    unsigned int Bid = 1;
+    FMOSA.setTableText(Bid, str);
+    if(Bid != 0 || FMOSA.getCount() != 2 || FMOSA.comments.getCount() != 0 ||
+            FMOSA.Ra != 15.027879 || FMOSA.Dec != 45.000422 || FMOSA.Pos != 0.060858) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check an allocated item
+    TObservingSource *OS = FMOSA.GetPointer(0);
+    if("s:751" != OS->Name ||
+            15.027787 != OS->RA ||
+            45.017925 != OS->Dec ||
+            20.67 != OS->Mag ||
+            ptSOURCE != OS->Type ||
+            6 != OS->Pr ||
+            0 != OS->Bid ||
+            1 != OS->Pid ||
+            -0.137909 != OS->X ||
+            51.932865 != OS->Y ||
+            0 != OS->Angle ||
+            true != OS->Enabled ||
+            "foo comment" != OS->Comment ||
+            true != OS->there_is_Mag ||
+            true != OS->there_is_Pr ||
+            true != OS->there_is_Bid) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check a nonallocated item
+    OS = FMOSA.GetPointer(1);
+    if("" != OS->Name ||
+            15.003376 != OS->RA ||
+            ptUNKNOWN != OS->Type ||
+            2 != OS->Pid ||
+            -51.296480 != OS->X ||
+            false != OS->Enabled ||
+            "" != OS->Comment ||
+            false != OS->there_is_Mag ||
+            false != OS->there_is_Pr ||
+            false != OS->there_is_Bid) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the errors shall be reported indicating the row and the column
+    size_t i = str.find("45.028110");
+    str.replace(i, 9, "45.0281x0");
+    try {
+        TFMOSA FMOSA2;
+        FMOSA2.setTableText(Bid, str);
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(Exception& E) {
+        if(E.Message.str != "setting FMOSA in text format in row 8 and column 32: setting OS section: setting an OS: reading Dec: converting string to float: unexpected text: \"x0\"") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestFMOSA::test_transferAllocations()
+{
+    try {
+        //build a string with the content of a little FMOSA file
+        string str;
+        str = "# Id| Ra| Dec| Pos";
+        str += "\r\n@@SOB@@";
+        str += "\r\n0| 15.027879| 45.000422| 0.060858";
+        str += "\r\n@@EOB@@";
+        str += "\r\n#      Name             RA         Dec    Mag        Type         Pr  Bid Pid   X(mm)     Y(mm)  Angle Enabled      Comment";
+        str += "\r\n@@SOS@@";
+        str += "\r\ns:751               |15.027787|45.017925|20.67|SOURCE          |6 |0  |1  |-0.137909 |51.932865 |0.0|1|foo comment         ";
+        str += "\r\n                    |15.003376|45.028110|     |UNKNOWN         |  |   |2  |-51.296480|82.217116 |0.0|0|                    ";
+        str += "\r\n@@EOS@@";
+
+        //set the string in a FMOSA
+        TFMOSA FMOSA;
+        unsigned int Bid;
+        FMOSA.setTableText(Bid, str);
+
+        //transfer the allocation of the RP 1 to the RP 5
+        TVector<int> Replaced, Replacements;
+        Replaced.Add(1);
+        Replacements.Add(5);
+        FMOSA.transferAllocations(Replaced, Replacements);
+
+        //only the allocated OS shall be transferred
+        if(FMOSA.GetPointer(0)->Pid != 5 || FMOSA.GetPointer(1)->Pid != 2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the written FMOSA in text format shall contain the replacement RP
+        ostringstream os;
+        FMOSA.writeTableText(os);
+        TFMOSA FMOSA2;
+        FMOSA2.setTableText(Bid, os.str());
+        if(FMOSA2.getCount() != 2 || FMOSA2.GetPointer(0)->Pid != 5 ||
+                FMOSA2.GetPointer(0)->X != -0.137909 || FMOSA2.GetPointer(0)->Y != 51.932865 ||
+                FMOSA2.GetPointer(1)->Pid != 2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the written FMOSA in format JSON shall contain the replacement RP
+        Json::Value JSON = FMOSA.getJSON();
+        if(JSON["OS"][0]["Pid"].asInt() != 5 || JSON["OS"][1]["Pid"].asInt() != 2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the lists shall have the same length
+        Replacements.Add(6);
+        bool thrown = false;
+        try {
+            FMOSA.transferAllocations(Replaced, Replacements);
+        } catch(EImproperArgument&) {
+            thrown = true;
+        }
+        if(!thrown) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
@@ -35,6 +35,8 @@ class TestFMOSA : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_setTableText);
+    CPPUNIT_TEST(test_transferAllocations);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +49,8 @@ public:
 
     //test methods
     void test_();
+    void test_setTableText();
+    void test_transferAllocations();
 };
 
 #endif // TEST_FMOSA_H
@@ -39,6 +39,8 @@
 #include "../src/FileMethods.h"
 //#include "CPPUNIT_ASSERTemulator.h" //qmake only.
 
+#include <cstdlib> //setenv, unsetenv
+
 using namespace Strings;
 using namespace Models;
 
@@ -1013,3 +1015,129 @@ void TestFileMethods::test_readInstanceFromDir_FMM()
 
     CPPUNIT_ASSERT(true);
 }
+void TestFileMethods::test_readSnapshot_FMM()
+{
+    //read an original instance of a FMM from a directory
+    TFiberMOSModel FMM;
+    string dir = "../../../data/Models/MEGARA_FiberMOSModel_Instance";
+    ///string dir = "../megara-fmpt/data/Models/MEGARA_FiberMOSModel_Instance"; //Qt only
+    readInstanceFromDir(FMM, dir);
+
+    //write the snapshot of the FMM in a temporal file
+    string path = "../../data/MEGARA_FiberMOSModel_Instance_temporal.snapshot";
+    ///string path = "../megara-fmpt/data/MEGARA_FiberMOSModel_Instance_temporal.snapshot"; //Qt only
+    writeSnapshot(path, FMM, dir);
+
+    //the snapshot shall be up to date respect the directory
+    if(!snapshotIsUpToDate(path, dir)) {
+        remove(path.c_str());
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //read the snapshot using the function to test
+    //(twice, for check that the FMM can be reused)
+    TFiberMOSModel FMM_;
+    readSnapshot(FMM_, path);
+    readSnapshot(FMM_, path);
+    remove(path.c_str());
+
+    //--------------------------------------------------------------
+
+    //the instances and the assimilated properties shall match
+
+    if(FMM_.RPL.getCount() != FMM.RPL.getCount() ||
+            FMM_.EAL.getCount() != FMM.EAL.getCount() ||
+            FMM_.getInstanceText() != FMM.getInstanceText() ||
+            FMM_.RPL.getOriginsTableText() != FMM.RPL.getOriginsTableText() ||
+            FMM_.EAL.getOriginsTableText() != FMM.EAL.getOriginsTableText() ||
+            FMM_.RPL.getInstanceMapText() != FMM.RPL.getInstanceMapText()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //for each RP of the FMM
+    for(int i=0; i<FMM.RPL.getCount(); i++) {
+        TActuator *A = FMM.RPL[i]->getActuator();
+        TActuator *A_ = FMM_.RPL[i]->getActuator();
+
+        if(FMM_.RPL[i]->getInstanceText() != FMM.RPL[i]->getInstanceText() ||
+                FMM_.RPL[i]->getContour____Text() != FMM.RPL[i]->getContour____Text() ||
+                FMM_.RPL[i]->getContour_Text() != FMM.RPL[i]->getContour_Text() ||
+                FMM_.RPL[i]->getF1Text() != FMM.RPL[i]->getF1Text() ||
+                FMM_.RPL[i]->getF2Text() != FMM.RPL[i]->getF2Text()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        if(A_->AdjacentEAs.getIdText() != A->AdjacentEAs.getIdText() ||
+                A_->AdjacentRPs.getIdText() != A->AdjacentRPs.getIdText()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        if(A_->getr_min() != A->getr_min() ||
+                A_->getr_saf() != A->getr_saf() ||
+                A_->getr_2saf() != A->getr_2saf() ||
+                A_->gettheta___2saf() != A->gettheta___2saf() ||
+                A_->gettheta___3saf() != A->gettheta___3saf() ||
+                A_->gettheta_2rad() != A->gettheta_2rad() ||
+                A_->getSPMall_a() != A->getSPMall_a()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    //for each EA of the FMM
+    for(int i=0; i<FMM.EAL.getCount(); i++) {
+        TExclusionArea *EA = FMM.EAL[i];
+        TExclusionArea *EA_ = FMM_.EAL[i];
+
+        if(EA_->getInstanceText() != EA->getInstanceText() ||
+                EA_->getContour_Text() != EA->getContour_Text() ||
+                EA_->AdjacentRPs.getCount() != EA->AdjacentRPs.getCount()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int j=0; j<EA->AdjacentRPs.getCount(); j++)
+            if(EA_->AdjacentRPs[j]->getActuator()->getId() != EA->AdjacentRPs[j]->getActuator()->getId()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+    }
+
+    //--------------------------------------------------------------
+
+    //a file which isn't a snapshot shall be rejected
+    strWriteToFile(path, "this isn't a snapshot");
+    try {
+        readSnapshot(FMM_, path);
+        remove(path.c_str());
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    catch(EImproperFileLoadedValue&) {
+    }
+    remove(path.c_str());
+
+    //the FMM shall not be modified when the snapshot is rejected
+    if(FMM_.RPL.getCount() != FMM.RPL.getCount()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the snapshot in the cache of the user shall be identified
+    //by the absolute path of the directory
+    setenv("XDG_CACHE_HOME", "/tmp/fmpt_cache", 1);
+    string cache_path = getSnapshotCachePath(dir);
+    unsetenv("XDG_CACHE_HOME");
+    if(cache_path.find("/tmp/fmpt_cache/megara-fmpt/MEGARA_FiberMOSModel_Instance-") != 0 ||
+            cache_path.length() != string("/tmp/fmpt_cache/megara-fmpt/MEGARA_FiberMOSModel_Instance-").length() + 16 + 9 ||
+            getSnapshotCachePath(dir+"/") != getSnapshotCachePath(dir) ||
+            getSnapshotCachePath("nonexistent_dir") != "") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -55,6 +55,7 @@ class TestFileMethods: public CppUnit::TestFixture
     CPPUNIT_TEST(test_readInstanceFromDir_RPL);
     CPPUNIT_TEST(test_writeInstanceToDir_FMM);
     CPPUNIT_TEST(test_readInstanceFromDir_FMM);
+    CPPUNIT_TEST(test_readSnapshot_FMM);
 
     //Although they can be added several tweets, running make distcheck
     //all test of each class will be counted as single one.
@@ -90,6 +91,7 @@ public:
     void test_readInstanceFromDir_RPL();
     void test_writeInstanceToDir_FMM();
     void test_readInstanceFromDir_FMM();
+    void test_readSnapshot_FMM();
 };
 
 #endif // FMPT_TESTFILEMETHODS_H
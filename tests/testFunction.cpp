@@ -100,3 +100,111 @@ void TestFunction::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestFunction::test_Compile()
+{
+    try {
+        //build a monotone increasing function with uneven sample points
+        TVector<double> X, Y;
+        double x = -3, y = -1000;
+        for(int i=0; i<40; i++) {
+            X.Add(x);
+            Y.Add(y);
+            x += 0.01 + (i%7)*0.13;
+            y += 1 + (i%5)*37.5;
+        }
+        TFunction F;
+        F.Set(X, Y);
+
+        //build the same function without compile it
+        TFunction F_;
+        for(int i=0; i<X.getCount(); i++)
+            F_.Add(X[i], Y[i]);
+
+        if(!F.getCompiled() || !F.getCompiledInverse() || F_.getCompiled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the images shall be exact in the sample points
+        //and equal to the images without compile out of them
+        for(int i=0; i<X.getCount(); i++)
+            if(F.Image(X[i]) != Y[i] || F_.Image(X[i]) != Y[i] || F.InverseImage(Y[i]) != X[i]) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        TFunction G;
+        G.Inverse(F);
+        for(int k=0; k<=1000; k++) {
+            x = X.getFirst() + (X.getLast() - X.getFirst())*k/1000.;
+            if(F.Image(x) != F_.Image(x)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            y = Y.getFirst() + (Y.getLast() - Y.getFirst())*k/1000.;
+            if(F.InverseImage(y) != G.Image(y)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+
+        //the inverse of a decreasing function shall match its inverse function
+        TVector<double> Yd;
+        for(int i=0; i<Y.getCount(); i++)
+            Yd.Add(-2*Y[i]);
+        TFunction H;
+        H.Set(X, Yd);
+        G.Clear();
+        for(int i=0; i<X.getCount(); i++)
+            G.Add(Yd[i], X[i]);
+        if(!H.getCompiledInverse()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int k=0; k<=1000; k++) {
+            y = Yd.getLast() + (Yd.getFirst() - Yd.getLast())*k/1000.;
+            if(H.InverseImage(y) != G.Image(y)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+
+        //modify a sample point shall discard the compiled form
+        F.setY(3, F.getY(3) + 1);
+        if(F.getCompiled() || F.getCompiledInverse()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a not strictly monotone function is compiled without inverse
+        Y[5] = Y[4];
+        F.Set(X, Y);
+        if(!F.getCompiled() || F.getCompiledInverse()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        bool thrown = false;
+        try {
+            F.InverseImage(Y[10]);
+        } catch(...) {
+            thrown = true;
+        }
+        if(!thrown) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a not monotone function is not compiled
+        Y[6] = Y[0] - 1;
+        F.Set(X, Y);
+        if(F.getCompiled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
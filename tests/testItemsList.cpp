@@ -69,3 +69,57 @@ void TestItemsList::test_()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestItemsList::test_move()
+{
+    try {
+        TItemsList<int> L1;
+        for(int i=0; i<20; i++)
+            L1.Add(i);
+
+        //swap the lists
+        TItemsList<int> L2;
+        L2.Add(-1);
+        L1.swap(L2);
+        if(L1.getCount()!=1 || L1[0]!=-1 || L2.getCount()!=20 || L2[19]!=19) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //delete items of both halfs
+        L2.Delete(2);
+        L2.Delete(15);
+        if(L2.getCount()!=18 || L2[2]!=3 || L2[15]!=17) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+#ifdef FMPT_MOVE_SEMANTICS
+        //move the list
+        TItemsList<int> L3(std::move(L2));
+        if(L2.getCount()!=0 || L3.getCount()!=18 || L3[17]!=19) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //move assign the list
+        L2 = std::move(L3);
+        if(L2.getCount()!=18 || L2[0]!=0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //build an item at the end
+        L2.Emplace(100);
+        if(L2.getCount()!=19 || L2.getLast()!=100) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+#endif
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
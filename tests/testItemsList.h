@@ -35,6 +35,7 @@ class TestItemsList : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_move);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +48,7 @@ public:
 
     //test methods
     void test_();
+    void test_move();
 };
 
 #endif // FMPT_TESTITEMSLIST_H
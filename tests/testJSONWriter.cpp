@@ -0,0 +1,224 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testJSONWriter.cpp
+//Content: test for the module JSONWriter
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testJSONWriter.h"
+#include "../src/JSONWriter.h"
+#include "../src/Exceptions.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <jsoncpp/json/json.h>
+#include <sstream>
+#include <stdlib.h> //rand, srand
+#include <math.h> //ldexp, round
+
+using namespace Strings;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestJSONWriter);
+
+//overide setUp(), init data, etc
+void TestJSONWriter::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestJSONWriter::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//write a JSON object through a JSON writer
+static void writeValue(TJSONWriter& W, const Json::Value& value)
+{
+    switch(value.type()) {
+    case Json::nullValue: W.valueNull(); break;
+    case Json::intValue: W.value(value.asInt()); break;
+    case Json::uintValue: W.value(value.asUInt()); break;
+    case Json::realValue: W.value(value.asDouble()); break;
+    case Json::stringValue: W.value(value.asString()); break;
+    case Json::booleanValue: W.value(value.asBool()); break;
+    case Json::arrayValue:
+        W.beginArray();
+        for(Json::ArrayIndex i=0; i<value.size(); i++)
+            writeValue(W, value[i]);
+        W.endArray();
+        break;
+    case Json::objectValue: {
+        W.beginObject();
+        Json::Value::Members names = value.getMemberNames();
+        for(unsigned int i=0; i<names.size(); i++) {
+            W.name(names[i]);
+            writeValue(W, value[names[i]]);
+        }
+        W.endObject();
+    }
+    }
+}
+
+//determine if a JSON object is written as Json::StyledWriter
+static bool writtenAsStyled(const Json::Value& value)
+{
+    ostringstream os;
+    TJSONWriter W(os);
+    writeValue(W, value);
+    W.end();
+
+    Json::StyledWriter writer;
+    return os.str() == writer.write(value);
+}
+
+//build a random string (including control and non ASCII chars)
+static string randomString(void)
+{
+    string str;
+    int n = rand()%(rand()%4 == 0 ? 40 : 8);
+    for(int i=0; i<n; i++) {
+        int k = rand()%10;
+        if(k < 6)
+            str += char('a' + rand()%26);
+        else if(k < 8)
+            str += char(1 + rand()%255);
+        else
+            str += char(1 + rand()%127);
+    }
+    return str;
+}
+//build a random JSON object
+static Json::Value randomValue(int depth)
+{
+    switch(rand()%(depth > 4 ? 6 : 9)) {
+    case 0: return Json::Value();
+    case 1: return Json::Value(rand() - RAND_MAX/2);
+    case 2: return Json::Value((unsigned int)rand());
+    case 3:
+        if(rand()%2 == 0)
+            return Json::Value(ldexp(double(rand()), rand()%200 - 100));
+        return Json::Value(round((rand() - RAND_MAX/2)/7.0));
+    case 4: return Json::Value(randomString());
+    case 5: return Json::Value(rand()%2 == 0);
+    case 6:
+    case 7: {
+        Json::Value array(Json::arrayValue);
+        int n = rand()%(rand()%3 == 0 ? 30 : 5);
+        for(int i=0; i<n; i++)
+            array.append(randomValue(depth + 1));
+        return array;
+    }
+    default: {
+        Json::Value object(Json::objectValue);
+        int n = rand()%5;
+        for(int i=0; i<n; i++)
+            object[randomString()] = randomValue(depth + 1);
+        return object;
+    }
+    }
+}
+
+void TestJSONWriter::test_StyledFormat()
+{
+    //build an object with the cases of the styled format
+    Json::Value root;
+    root["null"] = Json::Value();
+    root["bool"] = true;
+    root["int"] = -12;
+    root["uint"] = 12u;
+    root["real"] = 0.060858;
+    root["integer real"] = 13838.0;
+    root["big real"] = -1e300;
+    root["string"] = "Dec\"\\\n\t\x01\xc3\xb1\xf0\x9f\x98\x80";
+    root["empty array"] = Json::Value(Json::arrayValue);
+    root["empty object"] = Json::Value(Json::objectValue);
+    for(int i=0; i<3; i++)
+        root["short array"].append(i);
+    for(int i=0; i<30; i++)
+        root["long array"].append(i);
+    for(int i=0; i<4; i++)
+        root["long strings"].append("# a comment of a JSON text");
+    root["array of empties"].append(Json::Value(Json::arrayValue));
+    root["array of empties"].append(Json::Value(Json::objectValue));
+    root["array of arrays"].append(root["short array"]);
+    root["array of arrays"].append(root["long array"]);
+    root["array of objects"].append(root);
+    if(!writtenAsStyled(root)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the single values shall be written as single values
+    if(!writtenAsStyled(Json::Value(1.5)) || !writtenAsStyled(Json::Value(Json::arrayValue))) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //random objects shall be written as Json::StyledWriter
+    for(int i=0; i<2000; i++) {
+        srand(i);
+        if(!writtenAsStyled(randomValue(0))) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestJSONWriter::test_Errors()
+{
+    ostringstream os;
+    TJSONWriter W(os);
+
+    //the members shall be written in lexicographic order
+    W.beginObject();
+    W.name("b");
+    W.value(1);
+    try {
+        W.name("a");
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(EImproperArgument& E) {
+    }
+
+    //the delimiters shall match
+    try {
+        W.endArray();
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(EImproperCall& E) {
+    }
+    try {
+        W.end();
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(EImproperCall& E) {
+    }
+    W.endObject();
+    W.end();
+    if(os.str() != "{\n   \"b\" : 1\n}\n") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -0,0 +1,173 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testLazyInstanceLoader.cpp
+//Content: test for the module LazyInstanceLoader
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testLazyInstanceLoader.h"
+#include "../src/LazyInstanceLoader.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <algorithm> //std::find
+
+using namespace Models;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestLazyInstanceLoader);
+
+//overide setUp(), init data, etc
+void TestLazyInstanceLoader::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestLazyInstanceLoader::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//instance directory for the tests
+static const string dir = "../../../data/Models/MEGARA_FiberMOSModel_Instance";
+///static const string dir = "../megara-fmpt/data/Models/MEGARA_FiberMOSModel_Instance"; //Qt only
+
+//determines if a RP loaded lazily is equal to the RP read completely
+static bool equalRPs(TRoboticPositioner *RP_, TRoboticPositioner *RP)
+{
+    TActuator *A_ = RP_->getActuator();
+    TActuator *A = RP->getActuator();
+    return RP_->getInstanceText() == RP->getInstanceText() &&
+            RP_->getContour____Text() == RP->getContour____Text() &&
+            RP_->getContour_Text() == RP->getContour_Text() &&
+            RP_->getF1Text() == RP->getF1Text() &&
+            RP_->getF2Text() == RP->getF2Text() &&
+            A_->AdjacentRPs.getIdText() == A->AdjacentRPs.getIdText() &&
+            A_->AdjacentEAs.getIdText() == A->AdjacentEAs.getIdText() &&
+            A_->getr_saf() == A->getr_saf() &&
+            A_->getr_2saf() == A->getr_2saf() &&
+            A_->getSPMall_a() == A->getSPMall_a();
+}
+
+void TestLazyInstanceLoader::test_touch()
+{
+    TFiberMOSModel FMM;
+    readInstanceFromDir(FMM, dir);
+
+    //open the instance without read the RPs
+    TFiberMOSModel FMM_;
+    TLazyInstanceLoader L;
+    L.open(FMM_, dir);
+    if(L.getFMM() != &FMM_ || L.getLoadedCount() != 0 || L.allLoaded() ||
+            FMM_.RPL.getCount() != FMM.RPL.getCount() ||
+            FMM_.EAL.getCount() != FMM.EAL.getCount() ||
+            FMM_.getInstanceText() != FMM.getInstanceText() ||
+            FMM_.RPL.getOriginsTableText() != FMM.RPL.getOriginsTableText()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //touch a RP shall load it and its neighbours only
+    int Id = FMM.RPL[0]->getActuator()->getId();
+    vector<int> Neighbours;
+    L.getNeighbours(Neighbours, Id);
+    int count = L.touch(Id);
+    if(Neighbours.size() <= 0 || count != int(Neighbours.size()) + 1 ||
+            L.getLoadedCount() != count || !L.isLoaded(Id) ||
+            count >= FMM.RPL.getCount()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    for(unsigned int i=0; i<Neighbours.size(); i++)
+        if(!L.isLoaded(Neighbours[i])) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    //the adjacents of the RP touched shall be neighbours of it
+    TActuator *A_ = FMM_.RPL[FMM_.RPL.searchId(Id)]->getActuator();
+    for(int i=0; i<A_->AdjacentRPs.getCount(); i++) {
+        int Id_ = A_->AdjacentRPs[i].RP->getActuator()->getId();
+        if(find(Neighbours.begin(), Neighbours.end(), Id_) == Neighbours.end()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    //the RP touched shall be equal to the RP read completely
+    if(!equalRPs(FMM_.RPL[FMM_.RPL.searchId(Id)], FMM.RPL[FMM.RPL.searchId(Id)])) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //touch a RP again shall not load anything
+    if(L.touch(Id) != 0 || L.getLoadedCount() != count) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //touch a RP which isn't in the FMM shall throw an exception
+    try {
+        L.touch(-1);
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(EImproperArgument&) {
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestLazyInstanceLoader::test_loadAll()
+{
+    TFiberMOSModel FMM;
+    readInstanceFromDir(FMM, dir);
+
+    TFiberMOSModel FMM_;
+    TLazyInstanceLoader L;
+    L.open(FMM_, dir);
+    L.touch(FMM.RPL[1]->getActuator()->getId());
+
+    //load all RPs shall produce the same instance as the complete reading
+    int count = L.getLoadedCount();
+    if(L.loadAll() != FMM.RPL.getCount() - count || !L.allLoaded() ||
+            L.loadAll() != 0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    for(int i=0; i<FMM.RPL.getCount(); i++)
+        if(!equalRPs(FMM_.RPL[i], FMM.RPL[i])) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    //open a directory which doesn't exist shall not change the loader
+    try {
+        L.open(FMM_, "nonexistent_dir");
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(ECantComplete&) {
+    }
+    if(L.getFMM() != &FMM_ || L.getDir() != dir || !L.allLoaded()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testLog.cpp
+//Content: test for the module Log
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testLog.h"
+#include "../src/Log.h"
+#include "../src/Strings.h"
+#include "../src/Exceptions.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <fstream> //ifstream
+#include <iterator> //istreambuf_iterator
+#include <stdio.h> //remove
+#include <pthread.h> //pthread_create, pthread_join
+
+using namespace Strings;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestLog);
+
+//overide setUp(), init data, etc
+void TestLog::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestLog::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//read the content of a file
+static string readFile(const string& path)
+{
+    ifstream ifs(path.c_str(), ios::binary);
+    return string((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+}
+
+void TestLog::test_logWrite()
+{
+    string path = "testLog_logWrite.log";
+
+    //the messages shall be kept in the buffer until flush
+    logReset(path);
+    logWriteWithoutEndl(path, "Generating...");
+    logWrite(path, "OK");
+    if(readFile(path) != "") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    logFlush(path);
+    if(readFile(path) != "Generating...OK\n") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the messages under the minimun level shall be discarded,
+    //and the errors shall be written immediately
+    logWrite(path, "debug message", llDEBUG);
+    logWrite(path, "\r\nwarning message", llWARNING);
+    logWrite(path, "error message", llERROR);
+    if(readFile(path) != "Generating...OK\n\nwarning message\nerror message\n") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //a reset shall truncate the file,
+    //and a close shall write the buffered text
+    logWrite(path, "discarded message");
+    logReset(path);
+    logWrite(path, "last message");
+    logClose(path);
+    if(readFile(path) != "last message\n") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //a log which can't be opened shall throw an exception
+    try {
+        logWrite("/nonexistent_dir/testLog.log", "message");
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(ECantComplete& E) {
+    }
+
+    remove(path.c_str());
+    CPPUNIT_ASSERT(true);
+}
+
+void TestLog::test_Timestamps()
+{
+    string path = "testLog_Timestamps.log";
+
+    logSetTimestamps(true);
+    logReset(path);
+    logWriteWithoutEndl(path, "first ");
+    logWrite(path, "line\r\nsecond line", llWARNING);
+    logClose(path);
+    logSetTimestamps(false);
+
+    //each line shall be prefixed with: "YYYY-MM-DD hh:mm:ss.mmm [LEVEL] "
+    string str = readFile(path);
+    remove(path.c_str());
+    string::size_type i = str.find('\n');
+    if(i == string::npos) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    string line1 = str.substr(0, i);
+    string line2 = str.substr(i + 1);
+    if(line1.length() < 23 || line1.substr(23) != " [INFO] first line" ||
+            line1[4] != '-' || line1[10] != ' ' || line1[19] != '.' ||
+            line2.length() < 23 || line2.substr(23) != " [WARNING] second line\n") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//write lines in a log file
+static void *writeLines(void *arg)
+{
+    const string& path = *(const string*)arg;
+    for(int i=0; i<1000; i++)
+        logWrite(path, "line number "+inttostr(i)+" of a thread");
+    return NULL;
+}
+
+void TestLog::test_Threads()
+{
+    string path = "testLog_Threads.log";
+    logReset(path);
+
+    //write lines from several threads, while the flusher is running
+    logStartFlusher(1);
+    pthread_t threads[4];
+    for(int i=0; i<4; i++)
+        if(pthread_create(&threads[i], NULL, writeLines, &path) != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    for(int i=0; i<4; i++)
+        pthread_join(threads[i], NULL);
+    logStopFlusher();
+    logClose(path);
+
+    //all lines shall be written complete
+    string str = readFile(path);
+    remove(path.c_str());
+    int count[1000] = {0};
+    string::size_type first = 0;
+    string::size_type last;
+    int n = 0;
+    while((last = str.find('\n', first)) != string::npos) {
+        string line = str.substr(first, last - first);
+        first = last + 1;
+        n++;
+        int i;
+        if(sscanf(line.c_str(), "line number %d of a thread", &i) != 1 || i < 0 || i >= 1000 ||
+                line != "line number "+inttostr(i)+" of a thread") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        count[i]++;
+    }
+    if(n != 4000 || first != str.length()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    for(int i=0; i<1000; i++)
+        if(count[i] != 4) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -29,6 +29,9 @@
 #include <iostream>
 #include <limits.h> //INT_MAX
 #include <float.h> //DBL_MAX
+#include <math.h> //signbit
+
+using namespace Positioning;
 
 //---------------------------------------------------------------------------
 
@@ -50,3 +53,79 @@ void TestMotionProgram::test_()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestMotionProgram::test_encode()
+{
+    //build a MP with all kinds of motion instructions,
+    //integer and non integer positions, and comments
+    TMotionProgram MP1;
+    TMessageList *ML = new TMessageList();
+    ML->Add(new TMessageInstruction(1, "M1 1200"));
+    ML->Add(new TMessageInstruction(2, "M2 -35"));
+    ML->Add(new TMessageInstruction(300, "MM 0.5 250"));
+    ML->GetPointer(2)->setCommentDsec("Dsec = 0.1");
+    ML->Add(new TMessageInstruction(100000, "M2 -20"));
+    MP1.Add(ML);
+    ML = new TMessageList();
+    ML->Add(new TMessageInstruction(1, "MM 1100 0"));
+    ML->Add(new TMessageInstruction(2, "MM 7 9007199254740994"));
+    ML->GetPointer(1)->Instruction.Args[0] = -0.0;
+    ML->GetPointer(1)->setCommentDmin("Dmin = 2");
+    ML->GetPointer(1)->setCommentDend("Dend = 3");
+    ML->Add(new TMessageInstruction(100000, "MM 15 -25"));
+    MP1.Add(ML);
+    MP1.Add(new TMessageList());
+
+    //encode and decode the MP
+    string bin;
+    MP1.encode(bin, "pos", 7);
+    TMotionProgram MP2;
+    string label;
+    unsigned int Bid;
+    MP2.decode(label, Bid, bin);
+    if(label != "pos" || Bid != 7 || MP2 != MP1 ||
+            !signbit(MP2[1][1].Instruction.Args[0])) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the encoded MP shall be rejected when it is truncated or altered
+    for(unsigned int i=0; i<bin.length(); i++)
+        try {
+            MP2.decode(label, Bid, bin.substr(0, i));
+            CPPUNIT_ASSERT(false);
+            return;
+        } catch(Exception& E) {
+            //the decoding failed without change the MP
+            if(MP2 != MP1) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    try {
+        MP2.decode(label, Bid, bin + '\0');
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(Exception& E) {
+    }
+
+    //convert a MP in the MCS format to binary and back
+    string str1 = "depos_3 {";
+    str1 += "\r\n\tgroup_1 {";
+    str1 += "\r\n\trp12 r1 -1500\r\n\trp12 r2 2350";
+    str1 += "\r\n\trp5 r1 0.25\r\n\trp5 r2 -0";
+    str1 += "\r\n\t}";
+    str1 += "\r\n\tgroup_2 {";
+    str1 += "\r\n\trp12 r1 -1400\r\n\trp12 r2 2300";
+    str1 += "\r\n\t}";
+    str1 += "\r\n}";
+    TMotionProgram::MCStextToBinary(bin, str1);
+    string str2;
+    TMotionProgram::binaryToMCStext(str2, bin);
+    if(str2 != str1) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -189,6 +189,357 @@ void TestMotionProgramGenerator::test_generateParkProg()
 
     CPPUNIT_ASSERT(true);
 }
+
+void TestMotionProgramGenerator::test_regeneratePairPPDP()
+{
+    //build a simple FMM with two adjacent RPs and other RP far of them
+    TFiberMOSModel FMM;
+    FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(6, TDoublePoint(60.3, 87.035553)));
+    FMM.assimilate();
+
+    //set an allocation for each RP
+    TMotionProgramGenerator MPG(&FMM);
+    MPG.Add(new TAllocation(FMM.RPL[0], -60.3, 97.035553));
+    MPG.Add(new TAllocation(FMM.RPL[1], -40.2, 77.035553));
+    MPG.Add(new TAllocation(FMM.RPL[2], 60.3, 97.035553));
+    MPG.MoveToTargetP3();
+
+    //generate the pair (PP, DP)
+    TRoboticPositionerList Outsiders;
+    FMM.RPL.segregateOperativeOutsiders(Outsiders);
+    bool PPvalid, DPvalid;
+    TRoboticPositionerList Collided;
+    TRoboticPositionerList Obstructed;
+    TMotionProgram PP, DP;
+    MPG.generatePairPPDP(PPvalid, DPvalid, Collided, Obstructed, PP, DP, Outsiders);
+    if(!PPvalid || !DPvalid) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //change the allocation of the RP 6
+    MPG[2]->PP.x = 60.3;
+    MPG[2]->PP.y = 77.035553;
+    MPG.MoveToTargetP3();
+    TRoboticPositionerList Changed;
+    Changed.Add(FMM.RPL[2]);
+
+    //captures the new observing positions of the RPs in a PPA list
+    TPairPositionAnglesList OPL;
+    FMM.RPL.getPositions(OPL);
+
+    //regenerate the pair (PP, DP)
+    FMM.RPL.segregateOperativeOutsiders(Outsiders);
+    bool incremental = MPG.regeneratePairPPDP(PPvalid, DPvalid, Collided, Obstructed, PP, DP,
+                                              Outsiders, Changed);
+
+    //check that the pair has been regenerated incrementally and is valid
+    if(!incremental || !PPvalid || !DPvalid) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //validate the regenerated MPs
+    FMM.RPL.moveToOrigins();
+    FMM.RPL.setPurpose(pValPP);
+    bool PPvalid_ = MPG.validateMotionProgram(PP);
+
+    //check that the PP goes to the new observing positions
+    TPairPositionAnglesList PPAL;
+    FMM.RPL.getPositions(PPAL);
+    if(!PPvalid_ || PPAL.getText().str != OPL.getText().str) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    FMM.RPL.setPurpose(pValDP);
+    bool DPvalid_ = MPG.validateMotionProgram(DP);
+    if(!DPvalid_ || FMM.RPL.thereIsSomeOutOrigin()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestMotionProgramGenerator::test_attemptRegenerate()
+{
+    //build a simple FMM
+    TFiberMOSModel FMM;
+    FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+    FMM.assimilate();
+
+    //allocate to the RP 2 a PP in the scope of both RPs
+    TMotionProgramGenerator MPG(&FMM);
+    MPG.Add(new TAllocation(FMM.RPL[0], -50.25, 87.035553));
+    MPG.MoveToTargetP3();
+
+    //generate the pair (PP, DP)
+    TRoboticPositionerList Outsiders;
+    FMM.RPL.segregateOperativeOutsiders(Outsiders);
+    bool PPvalid, DPvalid;
+    TRoboticPositionerList Collided;
+    TRoboticPositionerList Obstructed;
+    TMotionProgram PP, DP;
+    MPG.generatePairPPDP(PPvalid, DPvalid, Collided, Obstructed, PP, DP, Outsiders);
+    if(!PPvalid || !DPvalid) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //disable the RP 2 stopped in the origin
+    FMM.RPL.moveToOrigins();
+    FMM.RPL[0]->Disabled = true;
+
+    //attempt regenerate the pair (PP, DP)
+    TVector<int> Excluded, Replaced, Replacements;
+    bool regenerated = MPG.attemptRegenerate(Excluded, Replaced, Replacements, PP, DP);
+
+    //check that the allocation of type must has been reallocated to the RP 4
+    if(!regenerated || Excluded.getText().str!="{2}" ||
+            Replaced.getText().str!="{2}" || Replacements.getText().str!="{4}") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the RP 2 has been excluded from the pair
+    TVector<int> Ids;
+    PP.getAllIncludedIds(Ids);
+    if(Ids.getText().str != "{4}") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the PP is valid and it moves the RP 4 to the PP
+    FMM.RPL.setPurpose(pValPP);
+    if(!MPG.validateMotionProgram(PP)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    TDoublePoint P3 = FMM.RPL[1]->getActuator()->getArm()->getP3();
+    if(Mod(P3.x + 50.25, P3.y - 87.035553) > 0.1) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the DP is valid and it moves the RP 4 to the origin
+    FMM.RPL.setPurpose(pValDP);
+    if(!MPG.validateMotionProgram(DP) || FMM.RPL.thereIsSomeOutOrigin()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestMotionProgramGenerator::test_attemptRegenerate_collision()
+{
+    //build a simple FMM with two RPs in a row and other RP over them
+    TFiberMOSModel FMM;
+    FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(6, TDoublePoint(-50.25, 104.44925)));
+    FMM.assimilate();
+
+    //allocate to the RP 2 a PP in the scope of the RPs 2 and 4
+    TMotionProgramGenerator MPG(&FMM);
+    MPG.Add(new TAllocation(FMM.RPL[0], -50.25, 87.035553));
+    MPG.MoveToTargetP3();
+
+    //generate the pair (PP, DP)
+    TRoboticPositionerList Outsiders;
+    FMM.RPL.segregateOperativeOutsiders(Outsiders);
+    bool PPvalid, DPvalid;
+    TRoboticPositionerList Collided;
+    TRoboticPositionerList Obstructed;
+    TMotionProgram PP, DP;
+    MPG.generatePairPPDP(PPvalid, DPvalid, Collided, Obstructed, PP, DP, Outsiders);
+    if(!PPvalid || !DPvalid) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //disable the RP 2 stopped in the origin
+    FMM.RPL.moveToOrigins();
+    FMM.RPL[0]->Disabled = true;
+
+    //add to the PP a gesture which moves the RP 6 close to the PP,
+    //where the RP 4 will be moved as replacement RP
+    double theta_1, theta___3, p_1, p___3;
+    TActuator *A = FMM.RPL[2]->getActuator();
+    if(!A->anglesToGoP3(theta_1, theta___3, -50.25, 93)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    A->getNearestStablePosition(p_1, p___3, theta_1, theta___3);
+    TMessageInstruction *MI = new TMessageInstruction();
+    MI->setId(6);
+    MI->Instruction.setName("MM");
+    MI->Instruction.Args.setCount(2);
+    MI->Instruction.Args[0] = p_1;
+    MI->Instruction.Args[1] = p___3;
+    TMessageList *ML = new TMessageList();
+    ML->Add(MI);
+    PP.Add(ML);
+    int PPcount = PP.getCount();
+
+    //the pair can not be regenerated with a collision
+    TPairPositionAnglesList IPL;
+    FMM.RPL.getPositions(IPL);
+    TVector<int> Excluded, Replaced, Replacements;
+    bool regenerated = MPG.attemptRegenerate(Excluded, Replaced, Replacements, PP, DP);
+    if(regenerated || PP.getCount()!=PPcount) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    TVector<int> Ids;
+    PP.getAllIncludedIds(Ids);
+    if(Ids.getText().str != "{2, 6}") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the RPs stay in the initial positions
+    //with the quantifiers enabled
+    TPairPositionAnglesList PL;
+    FMM.RPL.getPositions(PL);
+    for(int i=0; i<PL.getCount(); i++)
+        if(PL[i].p_1!=IPL[i].p_1 || PL[i].p___3!=IPL[i].p___3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    if(!FMM.RPL[1]->getActuator()->getQuantify_() ||
+            !FMM.RPL[1]->getActuator()->getArm()->getQuantify___()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestMotionProgramGenerator::test_compactMotionProgram()
+{
+    //build a simple FMM with two adjacent RPs and other RP far of them
+    TFiberMOSModel FMM;
+    FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(6, TDoublePoint(60.3, 87.035553)));
+    FMM.assimilate();
+
+    //set an allocation for each RP
+    TMotionProgramGenerator MPG(&FMM);
+    MPG.Add(new TAllocation(FMM.RPL[0], -60.3, 97.035553));
+    MPG.Add(new TAllocation(FMM.RPL[1], -40.2, 77.035553));
+    MPG.Add(new TAllocation(FMM.RPL[2], 60.3, 97.035553));
+
+    //move the RPs to the more closer stable position to the allocated projection points
+    MPG.MoveToTargetP3();
+
+    //captures the starting positions of the RPs in a PPA list
+    TPairPositionAnglesList SPL;
+    FMM.RPL.getPositions(SPL);
+
+    //build a MP with a message list to go to the origin for each RP
+    TMotionProgram MP;
+    for(int i=0; i<FMM.RPL.getCount(); i++) {
+        TRoboticPositioner *RP = FMM.RPL[i];
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(RP->getActuator()->getId());
+        RP->getInstructionToGoToTheOrigin(MI->Instruction);
+        TMessageList *ML = new TMessageList();
+        ML->Add(MI);
+        MP.Add(ML);
+    }
+
+    //compact the MP
+    FMM.RPL.setPurpose(pValParPro);
+    double T = MPG.calculateDuration(MP);
+    bool compacted = MPG.compactMotionProgram(MP);
+
+    //check that the MI of the RP 6 has been moved to the first message list,
+    //and that the MI of the RP 4 stay after the MI of the adjacent RP 2
+    if(!compacted || MP.getCount()!=2 || MP[0].getCount()!=2 || MP[1].getCount()!=1 ||
+            MP[0][0].getId()!=2 || MP[0][1].getId()!=6 || MP[1][0].getId()!=4) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the RPs stay in the starting positions
+    TPairPositionAnglesList PPAL;
+    FMM.RPL.getPositions(PPAL);
+    if(PPAL.getText().str != SPL.getText().str) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the duration of the compacted MP is not upper
+    if(MPG.calculateDuration(MP) > T) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the compacted MP is valid
+    if(!MPG.validateMotionProgram(MP)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+void TestMotionProgramGenerator::test_compactMotionProgram_arena()
+{
+    //build a simple FMM with two adjacent RPs and other RP far of them
+    TFiberMOSModel FMM;
+    FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(6, TDoublePoint(60.3, 87.035553)));
+    FMM.assimilate();
+
+    //set an allocation for each RP, and move the RPs to them
+    TMotionProgramGenerator MPG(&FMM);
+    MPG.Add(new TAllocation(FMM.RPL[0], -60.3, 97.035553));
+    MPG.Add(new TAllocation(FMM.RPL[1], -40.2, 77.035553));
+    MPG.Add(new TAllocation(FMM.RPL[2], 60.3, 97.035553));
+    MPG.MoveToTargetP3();
+    FMM.RPL.setPurpose(pValParPro);
+
+    //compact repeatedly the same MP in an arena, like in a request
+    TArenaScope AS;
+    const TArena *A = TArena::getCurrent();
+    int count = 0;
+    for(int k=0; k<200; k++) {
+        //build a MP with a message list to go to the origin for each RP
+        TMotionProgram MP;
+        for(int i=0; i<FMM.RPL.getCount(); i++) {
+            TRoboticPositioner *RP = FMM.RPL[i];
+            TMessageInstruction *MI = new TMessageInstruction();
+            MI->setId(RP->getActuator()->getId());
+            RP->getInstructionToGoToTheOrigin(MI->Instruction);
+            TMessageList *ML = new TMessageList();
+            ML->Add(MI);
+            MP.Add(ML);
+        }
+
+        if(!MPG.compactMotionProgram(MP) || MP.getCount()!=2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the candidates copied during the compaction
+        //shall reuse the memory of the arena
+        if(k == 0)
+            count = A->getChunksCount();
+        else if(A->getChunksCount() != count) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    CPPUNIT_ASSERT(true);
+}
 /*void TestMotionProgramGenerator::test_generatePairPPDP_online()
 {
     //build a simple FMM
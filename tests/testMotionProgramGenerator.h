@@ -36,6 +36,11 @@ class TestMotionProgramGenerator : public CppUnit::TestFixture
     //add test methods
     CPPUNIT_TEST(test_generatePairPPDP);
     CPPUNIT_TEST(test_generateParkProg);
+    CPPUNIT_TEST(test_regeneratePairPPDP);
+    CPPUNIT_TEST(test_attemptRegenerate);
+    CPPUNIT_TEST(test_attemptRegenerate_collision);
+    CPPUNIT_TEST(test_compactMotionProgram);
+    CPPUNIT_TEST(test_compactMotionProgram_arena);
     //CPPUNIT_TEST(test_generatePairPPDP_online);
     //CPPUNIT_TEST(test_generateParkProg_online);
 
@@ -51,6 +56,11 @@ public:
     //test methods
     void test_generatePairPPDP();
     void test_generateParkProg();
+    void test_regeneratePairPPDP();
+    void test_attemptRegenerate();
+    void test_attemptRegenerate_collision();
+    void test_compactMotionProgram();
+    void test_compactMotionProgram_arena();
     void test_generatePairPPDP_online();
     void test_generateParkProg_online();
 };
@@ -0,0 +1,207 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testOutputWriter.cpp
+//Content: test for the module OutputWriter
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testOutputWriter.h"
+#include "../src/OutputWriter.h"
+#include "../src/Strings.h"
+#include "../src/Exceptions.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <fstream> //ifstream
+#include <iterator> //istreambuf_iterator
+#include <stdio.h> //remove
+
+using namespace Strings;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestOutputWriter);
+
+//overide setUp(), init data, etc
+void TestOutputWriter::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestOutputWriter::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//read the content of a file
+static string readFile(const string& path)
+{
+    ifstream ifs(path.c_str(), ios::binary);
+    return string((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+}
+
+//set of files with numbered lines,
+//followed by a message without file
+class TNumberedFiles : public TOutputFiles {
+public:
+    string prefix;
+    unsigned int count;
+
+    TNumberedFiles(const string& t_prefix, unsigned int t_count) :
+        prefix(t_prefix), count(t_count) {;}
+
+    unsigned int getCount(void) const {return count + 1;}
+    string getPath(unsigned int i) const {
+        if(i >= count)
+            return "";
+        return prefix+uinttostr(i)+".txt";
+    }
+    string getMessage(unsigned int i) const {
+        if(i >= count)
+            return prefix+" finished";
+        return "file "+uinttostr(i)+" saved";
+    }
+    TLogLevel getLevel(unsigned int i) const {return i >= count ? llWARNING : llINFO;}
+    void write(ostream& os, unsigned int i) const {
+        for(unsigned int j=0; j<=i; j++) {
+            if(j > 0)
+                os << "\r\n";
+            os << "line " << j << " of the file " << i;
+        }
+        if(i == 3)
+            throw EImproperArgument("the file 3 can't be formatted");
+    }
+};
+
+//get the expected content of a numbered file
+static string numberedFileText(unsigned int i)
+{
+    string str;
+    for(unsigned int j=0; j<=i; j++) {
+        if(j > 0)
+            str += "\n";
+        str += "line "+uinttostr(j)+" of the file "+uinttostr(i);
+    }
+    return str;
+}
+
+void TestOutputWriter::test_write()
+{
+    //write the files without workers, and with several workers
+    for(unsigned int workers=0; workers<=4; workers+=4) {
+        TOutputWriter W;
+        W.start(workers);
+        if(W.getWorkersCount() != workers) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the sets of files added by pointer are destroyed by the writer
+        W.add(new TNumberedFiles("testOutputWriter_", 3));
+        TNumberedFiles Files2("testOutputWriter_2_", 3);
+        W.add(Files2);
+
+        //the messages shall be returned in order of addition,
+        //including the messages without file
+        vector<string> messages;
+        vector<TLogLevel> levels;
+        W.wait(messages, levels);
+        if(messages.size() != 8 || levels.size() != 8) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(unsigned int k=0; k<8; k++) {
+            string prefix = (k < 4 ? "testOutputWriter_" : "testOutputWriter_2_");
+            unsigned int i = k%4;
+            if(i == 3) {
+                if(messages[k] != prefix+" finished" || levels[k] != llWARNING) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+                continue;
+            }
+            string path = prefix+uinttostr(i)+".txt";
+            if(messages[k] != "file "+uinttostr(i)+" saved" || levels[k] != llINFO ||
+                    readFile(path) != numberedFileText(i)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            remove(path.c_str());
+        }
+
+        //the writer shall be reusable after wait
+        W.wait(messages, levels);
+        if(messages.size() != 8) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    //the workers can't be started twice
+    TOutputWriter W;
+    W.start(1);
+    try {
+        W.start(1);
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(EImproperCall& E) {
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestOutputWriter::test_errors()
+{
+    TOutputWriter W;
+    W.start(2);
+
+    //the files which can't be formatted or written shall be reported,
+    //without leave them partially written, and the other files shall be written
+    TNumberedFiles Files("testOutputWriter_", 5);
+    TNumberedFiles Unwritable("/nonexistent_dir/testOutputWriter_", 1);
+    W.add(Files);
+    W.add(Unwritable);
+    vector<string> messages;
+    vector<TLogLevel> levels;
+    try {
+        W.wait(messages, levels);
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(ECantComplete& E) {
+        if(E.Message.str.find("the file 3 can't be formatted") == string::npos ||
+                E.Message.str.find("/nonexistent_dir/testOutputWriter_0.txt") == string::npos) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    if(messages.size() != 6 || messages[3] != "file 4 saved" || messages[4] != "testOutputWriter_ finished") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    for(unsigned int i=0; i<5; i++) {
+        string path = "testOutputWriter_"+uinttostr(i)+".txt";
+        if(readFile(path) != (i != 3 ? numberedFileText(i) : string())) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        remove(path.c_str());
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -604,3 +604,61 @@ void TestOutputsPairPPDP::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestOutputsPairPPDP::test_writeJSONtext()
+{
+    //build an outputs structure with a FMOSA
+    string str;
+    str = "# Id| Ra| Dec| Pos";
+    str += "\r\n@@SOB@@";
+    str += "\r\n0| 15.027879| 45.000422| 0.060858";
+    str += "\r\n@@EOB@@";
+    str += "\r\n#      Name             RA         Dec    Mag        Type         Pr  Bid Pid   X(mm)     Y(mm)  Angle Enabled      Comment";
+    str += "\r\n@@SOS@@";
+    str += "\r\ns:751               |15.027787|45.017925|20.67|SOURCE          |6 |0  |1  |-0.137909 |51.932865 |0.0|1|foo comment         ";
+    str += "\r\n                    |15.003376|45.028110|     |UNKNOWN         |  |   |2  |-51.296480|82.217116 |0.0|0|                    ";
+    str += "\r\n@@EOS@@";
+    OutputsPairPPDP outputs;
+    unsigned int Bid;
+    outputs.FMOSA.setTableText(Bid, str);
+    outputs.PPvalid = true;
+    outputs.DPvalid = true;
+
+    //get the outputs in format JSON
+    string JSON = outputs.getJSONtext();
+    if(!outputs.suitable()) {
+        size_t i = JSON.find("\r\n\r\n");
+        if(i == string::npos) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        JSON = JSON.substr(i + 4);
+    }
+
+    //the text shall contain the JSON objects
+    //(compared in text format, because the parsed integers are signed)
+    Json::Value root;
+    Json::Reader reader;
+    Json::StyledWriter writer;
+    if(!reader.parse(JSON, root) ||
+            writer.write(root["FMOSA"]) != writer.write(outputs.FMOSA.getJSON()) ||
+            writer.write(root["pos"]["PP"]) != writer.write(outputs.PP.getJSON(outputs.IPL)) ||
+            writer.write(root["depos"]["DP"]) != writer.write(outputs.DP.getJSON(outputs.OPL)) ||
+            root["instrument"] != "MEGARA") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the text shall be written in the format of Json::StyledWriter
+    if(writer.write(root) != JSON) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the text shall be written without the FMOSA
+    if(outputs.getJSONtext(false).find("\"FMOSA\"") != string::npos) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
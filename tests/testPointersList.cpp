@@ -70,3 +70,55 @@ void TestPointersList::test_()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestPointersList::test_move()
+{
+    try {
+        TPointersList<TItemsList<int> > L1;
+        for(int i=0; i<10; i++) {
+            TItemsList<int> *L = new TItemsList<int>();
+            L->Add(i);
+            L1.Add(L);
+        }
+        TItemsList<int> *L5 = L1.GetPointer(5);
+
+        //swap the lists, without clone the items
+        TPointersList<TItemsList<int> > L2;
+        L2.swap(L1);
+        if(L1.getCount()!=0 || L2.getCount()!=10 || L2.GetPointer(5)!=L5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+#ifdef FMPT_MOVE_SEMANTICS
+        //move the list, without clone the items
+        TPointersList<TItemsList<int> > L3(std::move(L2));
+        if(L2.getCount()!=0 || L3.getCount()!=10 || L3.GetPointer(5)!=L5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //build an item at the end
+        TItemsList<int>& L = L3.Emplace(4);
+        L.Add(7);
+        if(L3.getCount()!=11 || L3.getLast().getCount()!=1 || L3.getLast()[0]!=7 ||
+                L3.getLast().getCapacity()!=4) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //move assign the list, the previous items are destroyed with the other list
+        L1.Add(new TItemsList<int>());
+        L1 = std::move(L3);
+        if(L1.getCount()!=11 || L1.GetPointer(5)!=L5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+#endif
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
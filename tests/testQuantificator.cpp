@@ -29,6 +29,10 @@
 #include <iostream>
 #include <limits.h> //INT_MAX
 #include <float.h> //DBL_MAX
+#include <math.h> //fabs
+#include <stdlib.h> //rand, RAND_MAX
+
+using namespace Operators;
 
 //---------------------------------------------------------------------------
 
@@ -50,3 +54,60 @@ void TestQuantificator::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestQuantificator::test_batch()
+{
+    try {
+        //quantifiers with step power of two and without
+        double qs[] = {1, 0.25, -2, 0.3, -1.7};
+        for(int j=0; j<5; j++) {
+            TQuantificator Q(qs[j], -100, 100);
+
+            //values in the middle of the steps, out of the domain and random
+            const int N = 203;
+            double x[N];
+            for(int i=0; i<N; i++)
+                x[i] = (i - 101)*fabs(qs[j]) + 0.5*qs[j];
+            x[0] = -1000;
+            x[1] = 1000;
+            for(int i=2; i<20; i++)
+                x[i] = 300*(double(rand())/RAND_MAX - 0.5);
+
+            int n[N];
+            Q.Quantifice(n, x, N);
+            for(int i=0; i<N; i++)
+                if(n[i] != Q.Quantifice(x[i])) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+
+            double y[N];
+            Q.Reconstruct(y, n, N);
+            for(int i=0; i<N; i++)
+                if(y[i] != Q.Reconstruct(n[i])) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+
+        //the centroids out of the image domain can't be reconstructed
+        TQuantificator Q(1, -10, 10);
+        int n[2] = {0, 11};
+        double y[2];
+        bool thrown = false;
+        try {
+            Q.Reconstruct(y, n, 2);
+        } catch(...) {
+            thrown = true;
+        }
+        if(!thrown) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//---------------------------------------------------------------------------
+//File: testReachabilityIndex.cpp
+//Content: test for the module ReachabilityIndex
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testReachabilityIndex.h"
+#include "../src/ReachabilityIndex.h"
+#include "../src/FiberMOSModel.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <iostream>
+
+using namespace Models;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestReachabilityIndex);
+
+//overide setUp(), init data, etc
+void TestReachabilityIndex::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestReachabilityIndex::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+void TestReachabilityIndex::test_searchRPs()
+{
+    //build a square hive of RPs
+    TFiberMOSModel FMM;
+    int CountId = 1;
+    FMM.RPL.buildSquareHive(CountId);
+    FMM.assimilate();
+
+    //build the index
+    TReachabilityIndex RI;
+    RI.build(FMM.RPL);
+    if(RI.getSide()<=0 || RI.getNx()<=0 || RI.getNy()<=0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the index find the same RPs than the exhaustive search
+    //in a grid of points covering the hive
+    TRoboticPositionerList RPs;
+    for(double x=FMM.RPL.getx3min()-5; x<=FMM.RPL.getx3max()+5; x+=1.7) {
+        for(double y=FMM.RPL.gety3min()-5; y<=FMM.RPL.gety3max()+5; y+=1.7) {
+            TDoublePoint P(x, y);
+
+            RI.searchRPs(RPs, P);
+
+            TRoboticPositionerList RPs_;
+            for(int i=0; i<FMM.RPL.getCount(); i++)
+                if(FMM.RPL[i]->getActuator()->pointIsInDomainP3(P))
+                    RPs_.Add(FMM.RPL[i]);
+
+            if(RPs.getCount() != RPs_.getCount()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(int i=0; i<RPs.getCount(); i++)
+                if(RPs[i] != RPs_[i]) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+    }
+
+    //check that the empty index not find RPs
+    RI.clear();
+    RI.searchRPs(RPs, TDoublePoint(0, 0));
+    if(RPs.getCount() != 0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
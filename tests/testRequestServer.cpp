@@ -0,0 +1,206 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//---------------------------------------------------------------------------
+//File: testRequestServer.cpp
+//Content: test for the module RequestServer
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testRequestServer.h"
+#include "../src/RequestServer.h"
+#include "../src/FiberMOSModel.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <unistd.h> //pipe, read, write, close
+#include <iostream>
+
+using namespace Positioning;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestRequestServer);
+
+//overide setUp(), init data, etc
+void TestRequestServer::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestRequestServer::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//remove the line of the date of generation of the outputs,
+//which can change between two requests
+static string withoutDate(const string& outputs)
+{
+    size_t i = outputs.find("# Date of generation:");
+    if(i == string::npos)
+        return outputs;
+    size_t j = outputs.find('\n', i);
+    if(j == string::npos)
+        return outputs.substr(0, i);
+    return outputs.substr(0, i) + outputs.substr(j + 1);
+}
+
+void TestRequestServer::test_processRequest()
+{
+    //build a simple FMM
+    TFiberMOSModel FMM;
+    FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+    FMM.assimilate();
+
+    //build a server with the FMM resident
+    TRequestServer RS;
+    RS.addInstance("test", FMM);
+
+    //check the response to a request ping
+    Json::Value response;
+    Json::Reader reader;
+    if(!reader.parse(RS.processRequest("{\"id\":7,\"type\":\"ping\"}"), response) ||
+            !response["ok"].asBool() || response["id"].asInt() != 7) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check the response to a malformed request
+    if(!reader.parse(RS.processRequest("{\"id\":"), response) ||
+            response["ok"].asBool() || !response["error"].isString()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check the response to an unknown type of request
+    if(!reader.parse(RS.processRequest("{\"id\":\"a\",\"type\":\"none\"}"), response) ||
+            response["ok"].asBool() || response["id"].asString() != "a") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check the response to a request of an unknown FMM Instance
+    if(!reader.parse(RS.processRequest("{\"type\":\"park\",\"instance\":\"none\"}"), response) ||
+            response["ok"].asBool()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check the response to a request park
+    string request = "{\"id\":1,\"type\":\"park\",\"p_1s\":[129703,32226],\"p___3s\":[10156,10156]}";
+    if(!reader.parse(RS.processRequest(request), response) ||
+            !response["ok"].asBool() || !response["ParkProgValid"].asBool() ||
+            !response["outputs"].isString()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that the resident FMM Instance has not been changed,
+    //repeating the request
+    string outputs = response["outputs"].asString();
+    if(!reader.parse(RS.processRequest(request), response) ||
+            !response["ok"].asBool() ||
+            withoutDate(response["outputs"].asString()) != withoutDate(outputs)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestRequestServer::test_serve()
+{
+    //build a simple FMM
+    TFiberMOSModel FMM;
+    FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+    FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+    FMM.assimilate();
+
+    //build a server with the FMM resident and two workers
+    TRequestServer RS;
+    RS.addInstance("test", FMM);
+    RS.start(2);
+
+    //write the requests in a pipe
+    int in[2], out[2];
+    if(pipe(in)!=0 || pipe(out)!=0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    string requests = "{\"id\":1,\"type\":\"ping\"}\n"
+            "not a JSON\n"
+            "\n"
+            "{\"id\":2,\"type\":\"park\",\"p_1s\":[129703,32226],\"p___3s\":[10156,10156]}\n"
+            "{\"id\":3,\"type\":\"ping\"}";
+    if(write(in[1], requests.c_str(), requests.length()) != (ssize_t)requests.length()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    close(in[1]);
+
+    //serve the requests
+    RS.serve(in[0], out[1]);
+    close(in[0]);
+    close(out[1]);
+
+    //read the responses
+    string responses;
+    char buffer[4096];
+    ssize_t n;
+    while((n = read(out[0], buffer, sizeof(buffer))) > 0)
+        responses.append(buffer, n);
+    close(out[0]);
+
+    //check that there is a response for each request
+    //and that the ids has been echoed
+    Json::Reader reader;
+    int count = 0;
+    bool found[4] = {false, false, false, false};
+    size_t pos;
+    while((pos = responses.find('\n')) != string::npos) {
+        Json::Value response;
+        if(!reader.parse(responses.substr(0, pos), response)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        responses.erase(0, pos + 1);
+        count++;
+
+        if(response["id"].isNull()) {
+            if(response["ok"].asBool())
+                CPPUNIT_ASSERT(false);
+            found[0] = true;
+        }
+        else {
+            int id = response["id"].asInt();
+            if(id<1 || 3<id || !response["ok"].asBool()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            found[id] = true;
+        }
+    }
+    if(count != 4 || !found[0] || !found[1] || !found[2] || !found[3]) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -24,12 +24,15 @@
 
 #include "testRoboticPositionerList1.h"
 #include "../src/RoboticPositionerList1.h"
+#include "../src/ExclusionAreaList.h"
 //#include "cppunit_assert_emulator.h" //Qt only.
 
 #include <iostream>
 #include <limits.h> //INT_MAX
 #include <float.h> //DBL_MAX
 
+using namespace Models;
+
 //---------------------------------------------------------------------------
 
 //commented in Qt:
@@ -50,3 +53,304 @@ void TestRoboticPositionerList1::test_()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestRoboticPositionerList1::test_search()
+{
+    try {
+        TRoboticPositionerList1 RPL;
+        for(int Id=1; Id<=10; Id++)
+            RPL.Add(new TRoboticPositioner(Id, TDoublePoint(Id*10, 0)));
+
+        //search the RPs by identifier and by pointer
+        for(int i=0; i<RPL.getCount(); i++) {
+            TRoboticPositioner *RP = RPL[i];
+            if(RPL.searchId(RP->getActuator()->getId()) != i ||
+                    RPL.search(RP) != i || RPL.search(RP->getActuator()) != i ||
+                    RPL.searchIdPointer(RP->getActuator()->getId()) != RP) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+        if(RPL.searchId(11) != RPL.getCount() || RPL.searchFirstFreeId(1) != 11) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //delete a RP
+        TRoboticPositioner *RP3 = RPL[2];
+        RPL.Delete(2);
+        if(RPL.searchId(3)!=RPL.getCount() || RPL.search(RP3)!=RPL.getCount() ||
+                RPL.searchId(4)!=2 || RPL.searchId(10)!=8 || RPL.searchFirstFreeId(1)!=3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //insert the RP at the beginning, with a repeated identifier
+        RP3->getActuator()->setId(5);
+        RPL.Insert(0, RP3);
+        if(RPL.searchId(5)!=0 || RPL.search(RP3)!=0 || RPL.searchId(4)!=3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //change the identifier of a RP
+        RP3->getActuator()->setId(3);
+        RPL.invalidateIndex();
+        if(RPL.searchId(3)!=0 || RPL.searchId(5)!=4) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //add a RP with an anomalous identifier
+        TRoboticPositioner *RP = new TRoboticPositioner(1000000, TDoublePoint(0, 0));
+        RPL.Add(RP);
+        if(RPL.searchId(1000000)!=RPL.getCount()-1 || RPL.searchId(999999)!=RPL.getCount() ||
+                RPL.search(RP->getActuator())!=RPL.getCount()-1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //clone the list
+        TRoboticPositionerList1 Clon(&RPL);
+        for(int i=0; i<Clon.getCount(); i++)
+            if(Clon.searchId(Clon[i]->getActuator()->getId()) != RPL.searchId(RPL[i]->getActuator()->getId()) ||
+                    Clon.search(Clon[i])!=i || Clon.search(RPL[i])!=Clon.getCount()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+
+        //empty the lists
+        Clon.Destroy();
+        RPL.Destroy();
+        if(RPL.searchId(1)!=0 || Clon.searchId(1)!=0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestRoboticPositionerList1::test_determineAdjacents()
+{
+    try {
+        //build a hive with an EA in the center and other one outside
+        TRoboticPositionerList1 RPL;
+        int CountId = 1;
+        RPL.buildCircularHive(CountId, MEGARA_D, 7, 200);
+        TExclusionAreaList EAL;
+        EAL.Add(new TExclusionArea(1, TDoublePoint(0, 0)));
+        EAL.Add(new TExclusionArea(2, TDoublePoint(1000, 1000)));
+
+        //displace some RPs and add an isolated RP
+        RPL[3]->getActuator()->setP0(RPL[3]->getActuator()->getP0() + TDoublePoint(3.7, -1.1));
+        RPL[10]->getActuator()->setP0(RPL[4]->getActuator()->getP0());
+        RPL.Add(new TRoboticPositioner(CountId++, TDoublePoint(-5000, 300)));
+
+        RPL.determineAdjacents(EAL);
+
+        //compare with the adjacents determined comparing all pairs
+        for(int i=0; i<RPL.getCount(); i++) {
+            TActuator *Ai = RPL[i]->getActuator();
+            double ri = Ai->getr_max() + Ai->getSPMall_a();
+
+            vector<TExclusionArea*> EAs;
+            for(int j=0; j<EAL.getCount(); j++) {
+                TBarrier& B = EAL[j]->Barrier;
+                if(Mod(Ai->getP0() - B.getP0()) < (ri + B.getr_max() + B.getSPM()) + ERR_NUM)
+                    EAs.push_back(EAL[j]);
+            }
+            vector<TRoboticPositioner*> RPs;
+            for(int j=0; j<RPL.getCount(); j++) {
+                TActuator *Aj = RPL[j]->getActuator();
+                double d = Mod(Ai->getP0() - Aj->getP0());
+                double dmax = ri + Aj->getr_max() + Aj->getSPMall_a();
+                if(j!=i && (j<i ? d<dmax+ERR_NUM : d<dmax))
+                    RPs.push_back(RPL[j]);
+            }
+
+            if(int(EAs.size())!=Ai->AdjacentEAs.getCount() ||
+                    int(RPs.size())!=Ai->AdjacentRPs.getCount()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(unsigned int j=0; j<EAs.size(); j++)
+                if(Ai->AdjacentEAs[j].EA != EAs[j]) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            for(unsigned int j=0; j<RPs.size(); j++)
+                if(Ai->AdjacentRPs[j].RP != RPs[j]) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+
+        //the RPs of the hive shall have adjacents, but not the isolated RP
+        if(RPL[0]->getActuator()->AdjacentRPs.getCount()<=0 ||
+                RPL[0]->getActuator()->AdjacentEAs.getCount()!=1 ||
+                RPL.getLast()->getActuator()->AdjacentRPs.getCount()!=0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        RPL.Destroy();
+        EAL.Destroy();
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestRoboticPositionerList1::test_searchCollinding()
+{
+    try {
+        //build a hive with an EA in the center
+        TRoboticPositionerList1 RPL;
+        int CountId = 1;
+        RPL.buildCircularHive(CountId, MEGARA_D, 3, 200);
+        TExclusionAreaList EAL;
+        EAL.Add(new TExclusionArea(1, TDoublePoint(0, 0)));
+        RPL.determineAdjacents(EAL);
+
+        //the RPs with unknown position are represented by their barrier
+        for(int i=0; i<RPL.getCount(); i+=3)
+            RPL[i]->getActuator()->setPAkd(kdUnk);
+
+        //for several random positions
+        for(int k=0; k<20; k++) {
+            RPL.randomize();
+
+            //compare with the collisions determined RP by RP,
+            //in both senses, because the collision between
+            //actuators is not symmetric
+            TVector<int> indices;
+            RPL.searchCollinding(indices);
+            TVector<int> expected;
+            for(int i=0; i<RPL.getCount(); i++) {
+                TActuator *A = RPL[i]->getActuator();
+                bool collided = A->thereIsCollisionWithAdjacent();
+                for(int l=0; l<A->AdjacentRPs.getCount() && !collided; l++)
+                    collided = A->AdjacentRPs[l].RP->getActuator()->thereIsCollision(A);
+                if(collided)
+                    expected.Add(i);
+            }
+
+            if(indices.getCount() != expected.getCount() ||
+                    RPL.thereIsCollision() != (expected.getCount() > 0)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(int i=0; i<indices.getCount(); i++)
+                if(indices[i] != expected[i]) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+
+            TRoboticPositionerList1 Collided;
+            TRoboticPositionerList1 NotCollided;
+            RPL.segregateCollided(Collided, NotCollided);
+            if(Collided.getCount() != expected.getCount() ||
+                    Collided.getCount() + NotCollided.getCount() != RPL.getCount()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+
+        //randomize without collisions
+        for(int i=0; i<RPL.getCount(); i+=3)
+            RPL[i]->getActuator()->setPAkd(kdPre);
+        RPL.randomizeWithoutCollision();
+        if(RPL.thereIsCollision()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        RPL.Destroy();
+        EAL.Destroy();
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestRoboticPositionerList1::test_setPositions()
+{
+    try {
+        //build a hive
+        TRoboticPositionerList1 RPL;
+        int CountId = 1;
+        RPL.buildCircularHive(CountId, MEGARA_D, 2, 200);
+
+        //for several random positions out of the steps
+        for(int k=0; k<20; k++) {
+            RPL.randomize();
+            TPairPositionAnglesList PL;
+            RPL.getPositions(PL);
+            for(int i=0; i<PL.getCount(); i++) {
+                TActuator *A = RPL[i]->getActuator();
+                PL[i].p_1 = min(PL[i].p_1 + 0.37, A->getp_1max());
+                PL[i].p___3 = max(PL[i].p___3 - 0.61, A->getArm()->getp___3min());
+            }
+
+            //the positions assigned in batch shall be the same
+            //than the assigned RP by RP
+            RPL.setPositions(PL);
+            vector<double> theta_1(RPL.getCount()), theta___3(RPL.getCount());
+            for(int i=0; i<RPL.getCount(); i++) {
+                theta_1[i] = RPL[i]->getActuator()->gettheta_1();
+                theta___3[i] = RPL[i]->getActuator()->getArm()->gettheta___3();
+            }
+            RPL.randomize();
+            for(int i=0; i<RPL.getCount(); i++) {
+                TActuator *A = RPL[i]->getActuator();
+                A->setAnglesSteps(PL[i].p_1, PL[i].p___3);
+                if(A->gettheta_1()!=theta_1[i] || A->getArm()->gettheta___3()!=theta___3[i]) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+
+            //a position out of the domain shall not be assigned to any RP
+            PL[PL.getCount() - 1].p_1 = RPL.getLast()->getActuator()->getp_1max() + 10;
+            RPL.randomize();
+            TPairPositionAnglesList PL2;
+            RPL.getPositions(PL2);
+            bool thrown = false;
+            try {
+                RPL.setPositions(PL);
+            } catch(...) {
+                thrown = true;
+            }
+            if(!thrown) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(int i=0; i<RPL.getCount(); i++) {
+                TActuator *A = RPL[i]->getActuator();
+                if(A->getp_1()!=PL2[i].p_1 || A->getArm()->getp___3()!=PL2[i].p___3) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+        }
+
+        RPL.Destroy();
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -35,6 +35,10 @@ class TestRoboticPositionerList1 : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_search);
+    CPPUNIT_TEST(test_determineAdjacents);
+    CPPUNIT_TEST(test_searchCollinding);
+    CPPUNIT_TEST(test_setPositions);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +51,10 @@ public:
 
     //test methods
     void test_();
+    void test_search();
+    void test_determineAdjacents();
+    void test_searchCollinding();
+    void test_setPositions();
 };
 
 #endif // TEST_RoboticPositionerList1_H
@@ -0,0 +1,234 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testRoboticPositionerSet.cpp
+//Content: test for the module RoboticPositionerSet
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testRoboticPositionerSet.h"
+#include "../src/RoboticPositionerSet.h"
+#include "../src/RoboticPositionerList1.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+using namespace Models;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestRoboticPositionerSet);
+
+//overide setUp(), init data, etc
+void TestRoboticPositionerSet::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestRoboticPositionerSet::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+void TestRoboticPositionerSet::test_insert()
+{
+    try {
+        TRoboticPositioner RP1(1, TDoublePoint(0, 0));
+        TRoboticPositioner RP40(40, TDoublePoint(10, 0));
+        TRoboticPositioner RP40b(40, TDoublePoint(20, 0));
+
+        TRoboticPositionerSet S;
+        if(!S.isEmpty() || S.firstId()!=-1 || S.contains(&RP1)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //insert RPs in different words of bits
+        if(!S.insert(&RP40) || !S.insert(&RP1) || S.insert(&RP40)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        if(S.getCount()!=2 || !S.contains(&RP1) || !S.contains(&RP40) ||
+                S.contains(&RP40b) || !S.containsId(40) || S.containsId(2) ||
+                S.getById(40)!=&RP40 || S.getById(1000)!=NULL) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //traverse the set in increasing order of identifier
+        if(S.firstId()!=1 || S.nextId(1)!=40 || S.nextId(40)!=-1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a RP with a duplicated identifier is inserted apart
+        if(!S.insert(&RP40b) || S.insert(&RP40b) || S.getCount()!=3 ||
+                !S.contains(&RP40b) || S.getById(40)!=&RP40 || S.nextId(40)!=-1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        TRoboticPositionerList1 RPL;
+        S.getList(RPL);
+        if(RPL.getCount()!=3 || RPL[0]!=&RP1 || RPL[1]!=&RP40 || RPL[2]!=&RP40b) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        RPL.Clear();
+
+        //when the RP indexed by the identifier is erased,
+        //the other RP with the same identifier replaces it
+        if(!S.erase(&RP40) || S.getCount()!=2 || S.contains(&RP40) ||
+                !S.contains(&RP40b) || S.getById(40)!=&RP40b) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //erase the RPs
+        if(S.erase(&RP40) || !S.erase(&RP40b) || S.erase(&RP40b) ||
+                S.getCount()!=1 || S.contains(&RP40b) || S.nextId(1)!=-1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        S.Clear();
+        if(!S.isEmpty() || S.contains(&RP1)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the operations include the RPs with duplicated identifier
+        TRoboticPositionerSet S1, S2;
+        S1.insert(&RP1);
+        S1.insert(&RP40);
+        S1.insert(&RP40b);
+        S2.insert(&RP40b);
+        TRoboticPositionerSet D(S1), I(S1), U(S2);
+        D.subtract(S2);
+        I.intersect(S2);
+        U.unite(S1);
+        if(D.getCount()!=2 || D.contains(&RP40b) || !D.contains(&RP40) ||
+                I.getCount()!=1 || !I.contains(&RP40b) || I.getById(40)!=&RP40b ||
+                U.getCount()!=3 || !U.contains(&RP40) || !U.contains(&RP1)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestRoboticPositionerSet::test_operations()
+{
+    try {
+        TRoboticPositionerList1 RPL;
+        for(int Id=1; Id<=70; Id++)
+            RPL.Add(new TRoboticPositioner(Id, TDoublePoint(Id*10, 0)));
+
+        //S1: identifiers multiple of 2; S2: identifiers multiple of 3
+        TRoboticPositionerSet S1, S2;
+        for(int i=0; i<RPL.getCount(); i++) {
+            int Id = RPL[i]->getActuator()->getId();
+            if(Id%2 == 0)
+                S1.insert(RPL[i]);
+            if(Id%3 == 0)
+                S2.insert(RPL[i]);
+        }
+
+        TRoboticPositionerSet U(S1), D(S1), I(S1);
+        U.unite(S2);
+        D.subtract(S2);
+        I.intersect(S2);
+
+        for(int i=0; i<RPL.getCount(); i++) {
+            TRoboticPositioner *RP = RPL[i];
+            int Id = RP->getActuator()->getId();
+            bool in1 = (Id%2 == 0);
+            bool in2 = (Id%3 == 0);
+            if(U.contains(RP)!=(in1 || in2) || D.contains(RP)!=(in1 && !in2) ||
+                    I.contains(RP)!=(in1 && in2)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+        if(U.getCount()!=47 || D.getCount()!=24 || I.getCount()!=11) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        RPL.Destroy();
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestRoboticPositionerSet::test_lists()
+{
+    try {
+        //build a list not sorted by identifier
+        TRoboticPositionerList1 RPL;
+        int Ids[] = {5, 33, 2, 64, 17, 1};
+        for(int i=0; i<6; i++)
+            RPL.Add(new TRoboticPositioner(Ids[i], TDoublePoint(i*10, 0)));
+
+        TRoboticPositionerSet S(RPL);
+        if(S.getCount() != 6) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //get the list sorted by identifier
+        TRoboticPositionerList1 Sorted;
+        S.getList(Sorted);
+        if(Sorted.getCount() != 6) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int i=1; i<Sorted.getCount(); i++)
+            if(Sorted[i-1]->getActuator()->getId() >= Sorted[i]->getActuator()->getId()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+
+        //retain the RPs of the set in a copy of the list
+        S.erase(RPL[1]);
+        S.erase(RPL[4]);
+        TRoboticPositionerList1 Retained;
+        Retained.Add(RPL);
+        S.retainIn(Retained);
+        if(Retained.getCount()!=4 || Retained[0]!=RPL[0] || Retained[1]!=RPL[2] ||
+                Retained[2]!=RPL[3] || Retained[3]!=RPL[5] ||
+                Retained.search(RPL[3])!=2 || Retained.search(RPL[1])<Retained.getCount()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        RPL.Destroy();
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
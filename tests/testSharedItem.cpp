@@ -0,0 +1,184 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testSharedItem.cpp
+//Content: test for the module SharedItem
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testSharedItem.h"
+#include "../src/SharedItem.h"
+#include "../src/RoboticPositioner.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+using namespace Lists;
+using namespace Models;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSharedItem);
+
+//overide setUp(), init data, etc
+void TestSharedItem::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestSharedItem::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//item for test the shared items
+class TCounter {
+public:
+    int value;
+
+    TCounter(void) : value(0) {;}
+    void Clone(const TCounter& C) {value = C.value;}
+};
+
+//number of items freed
+static int freed = 0;
+//function to free an item
+static void freeCounter(TCounter& C)
+{
+    freed++;
+}
+
+void TestSharedItem::test_share()
+{
+    freed = 0;
+    {
+        TSharedItem<TCounter> A(freeCounter);
+        A.renew().value = 1;
+        if(A.getRefs() != 1 || A.isShared()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the copies shall share the item
+        TSharedItem<TCounter> B(A);
+        TSharedItem<TCounter> C;
+        C = B;
+        if(A.getRefs() != 3 || !A.sharesWith(B) || !A.sharesWith(C) || C.get().value != 1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        //the own item of C shall be freed with its own function (NULL)
+        if(freed != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //renew shall replace the item without copy it
+        C.renew().value = 2;
+        if(A.getRefs() != 2 || A.sharesWith(C) || C.get().value != 2 || A.get().value != 1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    //the shared item and the renewed item shall be freed once
+    if(freed != 2) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestSharedItem::test_copyOnWrite()
+{
+    freed = 0;
+    {
+        TSharedItem<TCounter> A(freeCounter);
+        A.getWritable().value = 1;
+        TSharedItem<TCounter> B(A);
+
+        //the item shall be copied when it is modified being shared
+        B.getWritable().value++;
+        if(A.sharesWith(B) || A.get().value != 1 || B.get().value != 2 ||
+                A.getRefs() != 1 || B.getRefs() != 1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        //the item shall not be copied when it isn't shared
+        const TCounter *P = &B.get();
+        B.getWritable().value++;
+        if(&B.get() != P || B.get().value != 3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    //the copy shall keep the function to free the item
+    if(freed != 2) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestSharedItem::test_templates()
+{
+    //the RPs built by default shall share their templates
+    TRoboticPositioner RP1(1, TDoublePoint(0, 0));
+    TRoboticPositioner RP2(2, TDoublePoint(20, 0));
+    TArm *Arm1 = RP1.getActuator()->getArm();
+    TArm *Arm2 = RP2.getActuator()->getArm();
+    if(&Arm1->getContour____() != &Arm2->getContour____() ||
+            &Arm1->getF() != &Arm2->getF() ||
+            &RP1.getActuator()->getF() != &RP2.getActuator()->getF() ||
+            &RP1.getActuator()->getBarrier()->getContour_() != &RP2.getActuator()->getBarrier()->getContour_()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    //but each RP shall have its own image of the contours
+    if(&Arm1->getContour() == &Arm2->getContour()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the template modified shall not affect to the other RPs
+    Arm1->setQuantification(Arm1->getSB2()*2);
+    if(&Arm1->getF() == &Arm2->getF() || Arm2->getSB2() == Arm1->getSB2() ||
+            Arm2->getF().getYLast() == Arm1->getF().getYLast()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    TContourFigureList Contour;
+    Contour.Copy(Arm2->getContour____());
+    Arm1->setContour____(Contour);
+    destroyFigures(Contour);
+    if(&Arm1->getContour____() == &Arm2->getContour____() ||
+            Arm1->getContour____().getCount() != Arm2->getContour____().getCount()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the clones shall share the templates
+    TRoboticPositioner RP3(&RP1);
+    TArm *Arm3 = RP3.getActuator()->getArm();
+    if(&Arm3->getContour____() != &Arm1->getContour____() || &Arm3->getF() != &Arm1->getF()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
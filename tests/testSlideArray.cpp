@@ -30,6 +30,7 @@
 #include <vector>
 //#include <stdlib.h>
 #include <limits> //std::numeric_limits
+#include <string>
 
 #include "../src/SlideArray.h"
 
@@ -115,3 +116,68 @@ void TestSlideArray::test_()
 */
     CPPUNIT_ASSERT(true);
 }
+
+void TestSlideArray::test_move()
+{
+    try {
+        //fill an array with items which has dynamic memory,
+        //so the growth of the array moves them
+        TSlideArray<std::string> SA(1);
+        for(int i=0; i<100; i++) {
+            SA.AddFirst(std::string(40, 'a' + i%26));
+            SA.AddLast(std::string(40, 'A' + i%26));
+        }
+
+        //clone the array and check the items
+        TSlideArray<std::string> SA2(SA);
+        if(SA2.getCount() != 200 ||
+                SA2.getFirst() != std::string(40, 'a' + 99%26) ||
+                SA2.getLast() != std::string(40, 'A' + 99%26)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //swap the arrays
+        TSlideArray<std::string> SA3;
+        SA3.swap(SA2);
+        if(SA2.getCount()!=0 || SA3.getCount()!=200 || SA3.Get(100)!=SA.Get(100)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //clone an array with assignment
+        SA2 = SA3;
+        for(int i=0; i<SA.getCount(); i++)
+            if(SA2[i] != SA[i]) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+
+#ifdef FMPT_MOVE_SEMANTICS
+        //move the array and reuse the empty array
+        TSlideArray<std::string> SA4(std::move(SA3));
+        if(SA3.getCount()!=0 || SA4.getCount()!=200 || SA4.Get(150)!=SA.Get(150)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        SA3.AddFirst("first");
+        SA3.AddLast("last");
+        if(SA3.getCount()!=2 || SA3.Get(0)!="first" || SA3.Get(1)!="last") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //build an item at the end
+        std::string &str = SA4.EmplaceLast(3, 'x');
+        if(SA4.getCount()!=201 || str!="xxx" || SA4.getLast()!="xxx") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+#endif
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -0,0 +1,183 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//File: testSmallList.cpp
+//Content: test for the module SmallList
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testSmallList.h"
+#include "../src/SmallList.h"
+#include "../src/RoboticPositioner.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <string>
+
+using namespace Lists;
+using namespace Models;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSmallList);
+
+//overide setUp(), init data, etc
+void TestSmallList::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestSmallList::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+void TestSmallList::test_inline()
+{
+    try {
+        TSmallList<int, 4> L;
+        for(int i=0; i<4; i++)
+            L.Add(i);
+
+        //the items shall be inside the list
+        const char *begin = (const char*)&L;
+        const char *end = begin + sizeof(L);
+        if(L.getCount()!=4 || L.getCapacity()!=4 ||
+                (const char*)&L[0]<begin || end<=(const char*)&L[3]) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //delete an item
+        L.Delete(1);
+        if(L.getCount()!=3 || L[0]!=0 || L[1]!=2 || L[2]!=3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //access out of the list
+        try {
+            L[3];
+            CPPUNIT_ASSERT(false);
+            return;
+        } catch(EImproperArgument&) {
+        }
+
+        //empty the list
+        L.Clear();
+        if(L.getCount() != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestSmallList::test_grow()
+{
+    try {
+        //grow the list out of the inline storage
+        TSmallList<std::string, 2> L;
+        for(int i=0; i<10; i++)
+            L.Add(std::string(i+1, 'a'));
+        //add an item of the list to itself
+        L.Add(L[0]);
+        if(L.getCount()!=11 || L.getCapacity()<11 || L[9]!=std::string(10, 'a') || L[10]!="a") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //copy the list
+        TSmallList<std::string, 2> L2(L);
+        if(L2.getCount()!=11 || L2[5]!=L[5] || &L2[5]==&L[5]) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //swap an inline list with a dynamic one
+        TSmallList<std::string, 2> L3;
+        L3.Add("x");
+        L3.swap(L2);
+        if(L2.getCount()!=1 || L2[0]!="x" || L3.getCount()!=11 || L3[10]!="a") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //swap two dynamic lists
+        L2.Add("y");
+        L2.Add("z");
+        L2.swap(L3);
+        if(L2.getCount()!=11 || L3.getCount()!=3 || L3[2]!="z") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //assign a dynamic list to an inline one
+        TSmallList<std::string, 2> L4;
+        L4 = L2;
+        L4.Delete(0);
+        if(L4.getCount()!=10 || L4[0]!="aa" || L2[0]!="a") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestSmallList::test_adjacents()
+{
+    try {
+        TRoboticPositioner RP1(1, TDoublePoint(0, 0));
+        TRoboticPositioner RP2(2, TDoublePoint(20.1, 0));
+        TRoboticPositioner RP3(3, TDoublePoint(-20.1, 0));
+
+        //add the adjacents by value
+        TAdjacentRPList &ARPs = RP1.getActuator()->AdjacentRPs;
+        ARPs.Clear();
+        ARPs.Add(TAdjacentRP(&RP3));
+        ARPs.Add(TAdjacentRP(&RP2, 1, 2));
+        ARPs[0].Dmin = 5;
+        if(ARPs.getCount()!=2 || ARPs[0].Dmin!=5 || ARPs[1].Dend!=2 ||
+                ARPs.getIdText()!="{3, 2}" || ARPs.getDminText()!="{(RP3, 5), (RP2, 1)}") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //clone the actuator with its adjacents
+        TActuator A(RP1.getActuator());
+        ARPs.setAllDends(7);
+        if(A.AdjacentRPs.getCount()!=2 || A.AdjacentRPs[1].RP!=&RP2 ||
+                A.AdjacentRPs[1].Dend!=2 || ARPs[1].Dend!=7) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
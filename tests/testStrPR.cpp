@@ -28,7 +28,7 @@
 
 #include <cmath> //abs
 #include <vector>
-//#include <stdlib.h>
+#include <stdlib.h> //strtod
 #include <limits> //std::numeric_limits
 
 #include "../src/StrPR.h"
@@ -497,3 +497,81 @@ void TestStrPR::test_Conversion()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestStrPR::test_NumericCodec()
+{
+    //the printing of doubles shall be equal to "%.15g" and "%.*f"
+    double values[] = {0, -0.0, 1, -4.74, 0.1, 87.035553, -70.35, 1e15, 1e16,
+                       123456789012345678.0, 1e308,
+                       2.2250738585072014E-308, 4.9406564584124654E-324};
+    char c_str[400];
+    for(unsigned int k=0; k<sizeof(values)/sizeof(double); k++) {
+        sprintf(c_str, "%.15g", values[k]);
+        if(floattostr(values[k]) != string(c_str)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int precision=0; precision<=DBL_DIG; precision+=5) {
+            sprintf(c_str, "%.*f", precision, values[k]);
+            if(floattostr_fixed(values[k], precision) != string(c_str)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+        //the printed values shall be readed like strtod
+        sprintf(c_str, "%.15g", values[k]);
+        if(strToFloat(floattostr(values[k])) != strtod(c_str, NULL)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    if(inttostr(-2147483647-1) != "-2147483648" ||
+            uinttostr(4294967295u) != "4294967295") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //read the values in place, from the middle of a text
+    string src = "x = +12, y = -3.5e-2; z";
+    unsigned int i = 3;
+    int n = 0;
+    strReadInt(n, src, i);
+    if(n != 12 || i != 7) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    i = 12;
+    double x = 0;
+    strReadFloat(x, src, i);
+    if(x != -3.5e-2 || i != 20) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the underflow is rounded to zero,
+    //but the overflow can't be converted
+    if(strToFloat("1e-400") != 0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    try {
+        strToFloat("1e400");
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(...) {
+    }
+    try {
+        strToInt("2147483648");
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(...) {
+    }
+    try {
+        strToFloat("1e");
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(...) {
+    }
+
+    CPPUNIT_ASSERT(true);
+}
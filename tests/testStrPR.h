@@ -36,6 +36,7 @@ class TestStrPR : public CppUnit::TestFixture
     //add test methods
     CPPUNIT_TEST(test_Text);
     CPPUNIT_TEST(test_Conversion);
+    CPPUNIT_TEST(test_NumericCodec);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -49,6 +50,7 @@ public:
     //test methods
     void test_Text();
     void test_Conversion();
+    void test_NumericCodec();
 };
 
 #endif // FMPT_TESTStrPR_H
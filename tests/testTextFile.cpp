@@ -30,8 +30,13 @@
 #include <vector>
 //#include <stdlib.h>
 #include <limits> //std::numeric_limits
+#include <algorithm> //std::remove
+#include <fstream> //ifstream
+#include <iterator> //istreambuf_iterator
+#include <unistd.h> //pipe, read, close
 
 #include "../src/TextFile.h"
+#include "../src/Exceptions.h"
 
 using namespace Strings;
 //using namespace Models;
@@ -81,3 +86,61 @@ void TestTextFile::test_ClearComments()
     CPPUNIT_ASSERT(true);
 }
 
+void TestTextFile::test_TextOutputStream()
+{
+    //build a text larger than the buffer of the stream
+    string str;
+    for(int i=0; i<2000; i++)
+        str += "line "+inttostr(i)+"\r\n";
+
+    //write the text in a file through the stream
+    string fileName = "testTextOutputStream.txt";
+    TTextOutputStream os(fileName);
+    for(unsigned int i=0; i<str.length(); i+=7)
+        os << str.substr(i, 7);
+    os.close();
+
+    //the text shall be written without the chars '\r' (like strWriteToFile)
+    string expected = str;
+    expected.erase(std::remove(expected.begin(), expected.end(), '\r'), expected.end());
+    ifstream ifs(fileName.c_str(), ios::binary);
+    string read((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    ifs.close();
+    remove(fileName.c_str());
+    if(read != expected) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //write the text in a pipe through the stream
+    int fds[2];
+    if(pipe(fds) != 0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    string text = "one\r\ntwo";
+    TTextOutputStream pos(fds[1]);
+    pos << text;
+    pos.close();
+    close(fds[1]);
+    char buffer[16];
+    ssize_t n = ::read(fds[0], buffer, sizeof(buffer));
+    close(fds[0]);
+    if(n != ssize_t(text.length()) || string(buffer, n) != text) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //a file which can't be opened shall be reported
+    try {
+        TTextOutputStream os2("/nonexistent_dir/file.txt");
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(ECantComplete& E) {
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -36,6 +36,7 @@ class TestTextFile : public CppUnit::TestFixture
     //add test methods
     CPPUNIT_TEST(test_TextFile);
     CPPUNIT_TEST(test_ClearComments);
+    CPPUNIT_TEST(test_TextOutputStream);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -49,6 +50,7 @@ public:
     //test methods
     void test_TextFile();
     void test_ClearComments();
+    void test_TextOutputStream();
 };
 
 #endif // FMPT_TESTTEXTFILE_H